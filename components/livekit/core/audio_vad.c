@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_vad.h"
+
+/// Mean energy of a full-scale square wave (0 dBFS).
+#define FULL_SCALE_ENERGY (1u << 30)
+
+/// Samples summed per block; full blocks have a constant trip count, so the
+/// compiler unrolls and vectorizes them.
+#define ENERGY_BLOCK_SAMPLES 64
+
+/// The noise floor rises by 1/2^shift of the difference per frame (about 20 s to
+/// adapt at 20 ms frames), and falls immediately.
+#define NOISE_RISE_SHIFT 10
+
+/// 10^(-k/10) in Q16 for k in [0, 9], to scale energy by fractions of 10 dB.
+static const uint32_t DB_STEP_Q16[10] = {
+    65536, 52057, 41350, 32845, 26090, 20724, 16462, 13076, 10387, 8250
+};
+
+static inline uint64_t sum_squares(const int16_t *restrict samples, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t s = samples[i];
+        sum += (uint32_t)(s * s);
+    }
+    return sum;
+}
+
+uint32_t audio_vad_energy(const int16_t *samples, size_t count)
+{
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t sum = 0;
+    size_t i = 0;
+    for (; i + ENERGY_BLOCK_SAMPLES <= count; i += ENERGY_BLOCK_SAMPLES) {
+        sum += sum_squares(samples + i, ENERGY_BLOCK_SAMPLES);
+    }
+    sum += sum_squares(samples + i, count - i);
+    return (uint32_t)(sum / count);
+}
+
+void audio_vad_init(audio_vad_t *vad, int threshold_dbfs, uint32_t hangover_ms)
+{
+    threshold_dbfs = threshold_dbfs > 0 ? 0 : threshold_dbfs < -96 ? -96 : threshold_dbfs;
+    uint32_t attenuation_db = (uint32_t)-threshold_dbfs;
+    uint64_t threshold = FULL_SCALE_ENERGY;
+    for (uint32_t i = 0; i < attenuation_db / 10; i++) {
+        threshold /= 10;
+    }
+    threshold = (threshold * DB_STEP_Q16[attenuation_db % 10]) >> 16;
+
+    *vad = (audio_vad_t){
+        .threshold = threshold > 0 ? (uint32_t)threshold : 1,
+        .hangover_ms = hangover_ms
+    };
+    audio_vad_reset(vad);
+}
+
+void audio_vad_reset(audio_vad_t *vad)
+{
+    // Start from the threshold; the first quieter frame lowers the floor.
+    vad->noise_floor = vad->threshold;
+    vad->silent_ms = vad->hangover_ms;
+    vad->is_speaking = false;
+}
+
+bool audio_vad_process(audio_vad_t *vad, const int16_t *samples, size_t count, uint32_t frame_ms)
+{
+    uint32_t energy = audio_vad_energy(samples, count);
+
+    bool is_voiced = energy >= vad->threshold &&
+        (energy >> AUDIO_VAD_NOISE_MARGIN_SHIFT) >= vad->noise_floor;
+    if (energy < vad->noise_floor) {
+        vad->noise_floor = energy;
+    } else {
+        vad->noise_floor += (energy - vad->noise_floor) >> NOISE_RISE_SHIFT;
+    }
+
+    if (is_voiced) {
+        vad->silent_ms = 0;
+        vad->is_speaking = true;
+    } else if (vad->is_speaking) {
+        vad->silent_ms += frame_ms;
+        vad->is_speaking = vad->silent_ms < vad->hangover_ms;
+    }
+    return vad->is_speaking;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Detects voice in 16-bit PCM frames.
+///
+/// A frame is voiced if its mean energy exceeds both an absolute threshold and the
+/// tracked noise floor by @ref AUDIO_VAD_NOISE_MARGIN_SHIFT. The noise floor
+/// follows quieter frames immediately and louder frames slowly, so that pauses
+/// between words keep it at the level of the background. Once voice is no longer
+/// detected, the speaking state is held for a hangover period so that speech is
+/// not cut between words.
+///
+/// Detection is integer only; the state is plain data and does not allocate.
+///
+typedef struct {
+    /// Mean energy (mean of squared samples) below which a frame is silent.
+    uint32_t threshold;
+    /// Tracked mean energy of background noise.
+    uint32_t noise_floor;
+    uint32_t hangover_ms;
+    /// Time since voice was last detected.
+    uint32_t silent_ms;
+    bool is_speaking;
+} audio_vad_t;
+
+/// Voiced frames are at least 2^shift times the noise floor's energy (6 dB).
+#define AUDIO_VAD_NOISE_MARGIN_SHIFT 2
+
+/// Initializes a detector.
+///
+/// @param threshold_dbfs Level below which frames are silent, relative to a
+///                       full-scale square wave, clamped to [-96, 0].
+/// @param hangover_ms    How long to keep reporting speech after voice was last detected.
+///
+void audio_vad_init(audio_vad_t *vad, int threshold_dbfs, uint32_t hangover_ms);
+
+/// Resets a detector to not speaking, keeping its configuration.
+void audio_vad_reset(audio_vad_t *vad);
+
+/// Returns the mean of the squared samples, from 0 to 2^30.
+uint32_t audio_vad_energy(const int16_t *samples, size_t count);
+
+/// Processes a frame.
+///
+/// @param samples   Interleaved samples of all channels.
+/// @param count     Number of samples.
+/// @param frame_ms  Duration of the frame.
+/// @returns Whether speech is ongoing after this frame.
+///
+bool audio_vad_process(audio_vad_t *vad, const int16_t *samples, size_t count, uint32_t frame_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -40,6 +40,15 @@ typedef struct {
     esp_peer_audio_stream_info_t audio_info;
     esp_peer_video_stream_info_t video_info;
 
+    /// Whether to drop published audio frames while no voice is detected, with the
+    /// level below which audio is silent and how long to keep sending after voice.
+    bool vad_enabled;
+    int8_t vad_threshold_dbfs;
+    uint16_t vad_hangover_ms;
+
+    /// Whether to capture audio from when connecting, to send to an agent.
+    bool pre_connect_audio;
+
     esp_capture_handle_t capturer;
     av_render_handle_t   renderer;
 } engine_media_options_t;
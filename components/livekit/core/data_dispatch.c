@@ -0,0 +1,277 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <stdlib.h>
+
+#include "data_dispatch.h"
+
+static const char *TAG = "livekit_data";
+
+/// Queue depth at which lossy packets start being dropped.
+#define LOSSY_QUEUE_LIMIT ((CONFIG_LK_DATA_QUEUE_SIZE * 3) / 4)
+
+/// Reliable packet waiting for space in the queue.
+typedef struct overflow_packet {
+    struct overflow_packet *next;
+    livekit_pb_data_packet_t *packet;
+} overflow_packet_t;
+
+typedef struct {
+    data_dispatch_options_t options;
+
+    TaskHandle_t task_handle;
+    bool is_running;
+    SemaphoreHandle_t task_exited;
+
+    /// Ring of pointers to packets awaiting dispatch; the number of packets in
+    /// it is `stats.queue_depth`.
+    livekit_pb_data_packet_t *packets[CONFIG_LK_DATA_QUEUE_SIZE];
+    uint32_t head;
+
+    /// Reliable packets received while the ring was full, moved into it in order
+    /// as space frees up; the number of packets in it is `stats.overflow_depth`.
+    overflow_packet_t *overflow_head;
+    overflow_packet_t *overflow_tail;
+
+    /// Given when a packet is queued or the task should exit.
+    SemaphoreHandle_t packet_ready;
+
+    data_dispatch_stats_t stats;
+
+    /// Guards the ring and stats.
+    SemaphoreHandle_t lock;
+} data_dispatch_t;
+
+/// Adds a packet to the end of the ring, which must not be full.
+///
+/// @note The caller must hold `lock`.
+///
+static void push_packet(data_dispatch_t *dispatch, livekit_pb_data_packet_t *packet)
+{
+    uint32_t depth = dispatch->stats.queue_depth;
+    dispatch->packets[(dispatch->head + depth) % CONFIG_LK_DATA_QUEUE_SIZE] = packet;
+    dispatch->stats.queue_depth = depth + 1;
+    if (depth + 1 > dispatch->stats.max_queue_depth) {
+        dispatch->stats.max_queue_depth = depth + 1;
+    }
+}
+
+/// Removes the oldest queued packet, or returns NULL if the queue is empty.
+///
+/// The oldest packet in the overflow list, if any, takes the freed slot.
+///
+static livekit_pb_data_packet_t *take_packet(data_dispatch_t *dispatch)
+{
+    livekit_pb_data_packet_t *packet = NULL;
+    xSemaphoreTake(dispatch->lock, portMAX_DELAY);
+    if (dispatch->stats.queue_depth > 0) {
+        packet = dispatch->packets[dispatch->head];
+        dispatch->head = (dispatch->head + 1) % CONFIG_LK_DATA_QUEUE_SIZE;
+        dispatch->stats.queue_depth--;
+    }
+    overflow_packet_t *moved = dispatch->overflow_head;
+    if (moved != NULL) {
+        dispatch->overflow_head = moved->next;
+        if (dispatch->overflow_head == NULL) {
+            dispatch->overflow_tail = NULL;
+        }
+        dispatch->stats.overflow_depth--;
+        push_packet(dispatch, moved->packet);
+    }
+    xSemaphoreGive(dispatch->lock);
+    free(moved);
+    return packet;
+}
+
+/// Adds a reliable packet to the end of the overflow list.
+///
+/// @note The caller must hold `lock`.
+/// @returns Whether the packet was added.
+///
+static bool push_overflow(data_dispatch_t *dispatch, livekit_pb_data_packet_t *packet)
+{
+    overflow_packet_t *item = malloc(sizeof(overflow_packet_t));
+    if (item == NULL) {
+        return false;
+    }
+    *item = (overflow_packet_t){ .packet = packet };
+    if (dispatch->overflow_tail != NULL) {
+        dispatch->overflow_tail->next = item;
+    } else {
+        dispatch->overflow_head = item;
+    }
+    dispatch->overflow_tail = item;
+    dispatch->stats.overflow_depth++;
+    if (dispatch->stats.overflow_depth > dispatch->stats.max_overflow_depth) {
+        dispatch->stats.max_overflow_depth = dispatch->stats.overflow_depth;
+    }
+    return true;
+}
+
+static inline void record_handler_time(data_dispatch_t *dispatch, uint32_t elapsed_us)
+{
+    xSemaphoreTake(dispatch->lock, portMAX_DELAY);
+    dispatch->stats.dispatched++;
+    dispatch->stats.handler_last_us = elapsed_us;
+    if (elapsed_us > dispatch->stats.handler_max_us) {
+        dispatch->stats.handler_max_us = elapsed_us;
+    }
+    dispatch->stats.handler_total_us += elapsed_us;
+    xSemaphoreGive(dispatch->lock);
+}
+
+static void dispatch_task(void *arg)
+{
+    data_dispatch_t *dispatch = (data_dispatch_t *)arg;
+    while (dispatch->is_running) {
+        livekit_pb_data_packet_t *packet = take_packet(dispatch);
+        if (packet == NULL) {
+            xSemaphoreTake(dispatch->packet_ready, portMAX_DELAY);
+            continue;
+        }
+        int64_t start_us = esp_timer_get_time();
+        dispatch->options.on_packet(packet, dispatch->options.ctx);
+        record_handler_time(dispatch, (uint32_t)(esp_timer_get_time() - start_us));
+
+        protocol_data_packet_free(packet);
+    }
+    xSemaphoreGive(dispatch->task_exited);
+    vTaskDelete(NULL);
+}
+
+data_dispatch_err_t data_dispatch_create(data_dispatch_handle_t *handle, const data_dispatch_options_t *options)
+{
+    if (handle == NULL || options == NULL || options->on_packet == NULL) {
+        return DATA_DISPATCH_ERR_INVALID_ARG;
+    }
+    data_dispatch_t *dispatch = (data_dispatch_t *)calloc(1, sizeof(data_dispatch_t));
+    if (dispatch == NULL) {
+        return DATA_DISPATCH_ERR_NO_MEM;
+    }
+    dispatch->options = *options;
+
+    int ret = DATA_DISPATCH_ERR_NO_MEM;
+    do {
+        dispatch->packet_ready = xSemaphoreCreateBinary();
+        dispatch->lock = xSemaphoreCreateMutex();
+        dispatch->task_exited = xSemaphoreCreateBinary();
+        if (dispatch->packet_ready == NULL ||
+            dispatch->lock         == NULL ||
+            dispatch->task_exited  == NULL) {
+            break;
+        }
+        dispatch->is_running = true;
+        if (xTaskCreate(
+            dispatch_task,
+            "lk_data_task",
+            CONFIG_LK_DATA_TASK_STACK_SIZE,
+            (void *)dispatch,
+            CONFIG_LK_DATA_TASK_PRIORITY,
+            &dispatch->task_handle
+        ) != pdPASS) {
+            dispatch->is_running = false;
+            ret = DATA_DISPATCH_ERR_OTHER;
+            break;
+        }
+        *handle = (data_dispatch_handle_t)dispatch;
+        return DATA_DISPATCH_ERR_NONE;
+    } while (0);
+
+    data_dispatch_destroy(dispatch);
+    return ret;
+}
+
+data_dispatch_err_t data_dispatch_destroy(data_dispatch_handle_t handle)
+{
+    if (handle == NULL) {
+        return DATA_DISPATCH_ERR_INVALID_ARG;
+    }
+    data_dispatch_t *dispatch = (data_dispatch_t *)handle;
+    if (dispatch->is_running) {
+        dispatch->is_running = false;
+        xSemaphoreGive(dispatch->packet_ready);
+        xSemaphoreTake(dispatch->task_exited, portMAX_DELAY);
+    }
+    if (dispatch->lock != NULL) {
+        livekit_pb_data_packet_t *packet;
+        while ((packet = take_packet(dispatch)) != NULL) {
+            protocol_data_packet_free(packet);
+        }
+    }
+    if (dispatch->packet_ready != NULL) {
+        vSemaphoreDelete(dispatch->packet_ready);
+    }
+    if (dispatch->lock != NULL) {
+        vSemaphoreDelete(dispatch->lock);
+    }
+    if (dispatch->task_exited != NULL) {
+        vSemaphoreDelete(dispatch->task_exited);
+    }
+    free(dispatch);
+    return DATA_DISPATCH_ERR_NONE;
+}
+
+bool data_dispatch_enqueue(data_dispatch_handle_t handle, livekit_pb_data_packet_t *packet, bool reliable)
+{
+    if (handle == NULL || packet == NULL) {
+        return false;
+    }
+    data_dispatch_t *dispatch = (data_dispatch_t *)handle;
+    bool queued = false;
+
+    xSemaphoreTake(dispatch->lock, portMAX_DELAY);
+    do {
+        uint32_t depth = dispatch->stats.queue_depth;
+        if (!reliable && depth >= LOSSY_QUEUE_LIMIT) {
+            dispatch->stats.dropped_lossy++;
+            break;
+        }
+        if (depth < CONFIG_LK_DATA_QUEUE_SIZE) {
+            push_packet(dispatch, packet);
+            queued = true;
+            break;
+        }
+        if (!dispatch->options.drop_reliable_on_overflow && push_overflow(dispatch, packet)) {
+            queued = true;
+            break;
+        }
+        dispatch->stats.dropped_reliable++;
+        ESP_LOGE(TAG, "Queue full, dropped reliable packet");
+    } while (0);
+    xSemaphoreGive(dispatch->lock);
+
+    if (queued) {
+        xSemaphoreGive(dispatch->packet_ready);
+    }
+    return queued;
+}
+
+data_dispatch_err_t data_dispatch_get_stats(data_dispatch_handle_t handle, data_dispatch_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return DATA_DISPATCH_ERR_INVALID_ARG;
+    }
+    data_dispatch_t *dispatch = (data_dispatch_t *)handle;
+    xSemaphoreTake(dispatch->lock, portMAX_DELAY);
+    *out_stats = dispatch->stats;
+    xSemaphoreGive(dispatch->lock);
+    return DATA_DISPATCH_ERR_NONE;
+}
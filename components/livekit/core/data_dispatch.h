@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *data_dispatch_handle_t;
+
+typedef enum {
+    DATA_DISPATCH_ERR_NONE        =  0,
+    DATA_DISPATCH_ERR_INVALID_ARG = -1,
+    DATA_DISPATCH_ERR_NO_MEM      = -2,
+    DATA_DISPATCH_ERR_OTHER       = -3
+} data_dispatch_err_t;
+
+typedef struct {
+    /// Invoked on the dispatch task for each received packet.
+    ///
+    /// The packet is freed after the handler returns.
+    ///
+    void (*on_packet)(livekit_pb_data_packet_t *packet, void *ctx);
+    void *ctx;
+    /// Drop reliable packets once the queue is full rather than holding them
+    /// in the overflow list.
+    bool drop_reliable_on_overflow;
+} data_dispatch_options_t;
+
+/// Incoming data packet dispatch metrics.
+typedef struct {
+    /// Number of packets waiting to be dispatched.
+    uint32_t queue_depth;
+    /// Highest number of packets waiting at once.
+    uint32_t max_queue_depth;
+    /// Number of reliable packets held in the overflow list because the queue was full.
+    uint32_t overflow_depth;
+    /// Highest number of reliable packets held in the overflow list at once.
+    uint32_t max_overflow_depth;
+    /// Number of packets dispatched.
+    uint32_t dispatched;
+    /// Number of lossy packets dropped because the queue was nearly full.
+    uint32_t dropped_lossy;
+    /// Number of reliable packets dropped because the queue was full and they
+    /// could not be held in the overflow list.
+    uint32_t dropped_reliable;
+    /// Time spent in the handler for the most recent packet in microseconds.
+    uint32_t handler_last_us;
+    /// Longest time spent in the handler in microseconds.
+    uint32_t handler_max_us;
+    /// Total time spent in the handler in microseconds, for computing the mean.
+    uint64_t handler_total_us;
+} data_dispatch_stats_t;
+
+/// Creates a dispatcher and starts its task.
+data_dispatch_err_t data_dispatch_create(data_dispatch_handle_t *handle, const data_dispatch_options_t *options);
+
+/// Stops the dispatch task and frees any packets still queued.
+data_dispatch_err_t data_dispatch_destroy(data_dispatch_handle_t handle);
+
+/// Queues a received packet for dispatch.
+///
+/// Never blocks, so the calling peer's loop is not held back by a slow handler.
+/// Lossy packets are dropped once the queue is nearly full, leaving the remaining
+/// space for reliable packets. Once it is full, reliable packets are held in an
+/// overflow list on the heap, in order, unless `drop_reliable_on_overflow` is set.
+///
+/// @returns Whether the packet was queued, in which case ownership of it is taken.
+///
+bool data_dispatch_enqueue(data_dispatch_handle_t handle, livekit_pb_data_packet_t *packet, bool reliable);
+
+/// Gets the dispatcher's metrics.
+data_dispatch_err_t data_dispatch_get_stats(data_dispatch_handle_t handle, data_dispatch_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,631 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <esp_log.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <khash.h>
+#include "esp_timer.h"
+#include "utils.h"
+#include "data_stream.h"
+
+static const char* TAG = "livekit_stream";
+
+/// Interval at which a blocked write checks whether the window has opened.
+#define WINDOW_POLL_MS 10
+
+/// Time a write waits for the window to open before failing.
+#define WRITE_TIMEOUT_MS 10000
+
+/// Time without packets after which an incoming stream may be closed to make room for another.
+#define INCOMING_IDLE_TIMEOUT_US (30 * 1000 * 1000LL)
+
+KHASH_MAP_INIT_STR(stream_handlers, livekit_data_stream_handler_t)
+
+/// Incoming stream being delivered to a handler.
+typedef struct {
+    /// Empty if the slot is unused.
+    char id[LIVEKIT_DATA_STREAM_ID_SIZE];
+    livekit_data_stream_handler_t handler;
+    void *stream_ctx;
+    uint64_t next_chunk_index;
+    uint64_t received_bytes;
+    bool has_total_length;
+    uint64_t total_length;
+    int64_t last_packet_us;
+} incoming_stream_t;
+
+typedef struct {
+    data_stream_manager_options_t options;
+
+    /// Handlers keyed by topic (owned copies), guarded by `handlers_lock`.
+    khash_t(stream_handlers) *handlers;
+    SemaphoreHandle_t handlers_lock;
+
+    /// Only accessed from the task handling packets.
+    incoming_stream_t incoming[CONFIG_LK_DATA_STREAM_MAX_INCOMING];
+
+    /// Whether the room is closed, so writes should not wait for the window.
+    _Atomic bool is_closed;
+} data_stream_manager_t;
+
+typedef struct {
+    data_stream_manager_t *manager;
+    char id[LIVEKIT_DATA_STREAM_ID_SIZE];
+    livekit_data_stream_kind_t kind;
+    uint64_t next_chunk_index;
+    uint64_t written_bytes;
+    uint64_t total_length;
+
+    int destination_identities_count;
+    char **destination_identities;
+
+    /// Content waiting to be sent; reused for every chunk.
+    pb_bytes_array_t *chunk;
+} data_stream_writer_t;
+
+// MARK: - Incoming
+
+static void close_incoming(incoming_stream_t *stream, livekit_data_stream_close_reason_t reason)
+{
+    ESP_LOGD(TAG, "Incoming stream closed: id=%s, reason=%d, bytes=%" PRIu64,
+        stream->id, reason, stream->received_bytes);
+    if (stream->handler.on_close != NULL) {
+        stream->handler.on_close(reason, stream->stream_ctx);
+    }
+    *stream = (incoming_stream_t){};
+}
+
+static incoming_stream_t *find_incoming(data_stream_manager_t *manager, const char *id)
+{
+    for (int i = 0; i < CONFIG_LK_DATA_STREAM_MAX_INCOMING; i++) {
+        if (manager->incoming[i].id[0] != '\0' && strcmp(manager->incoming[i].id, id) == 0) {
+            return &manager->incoming[i];
+        }
+    }
+    return NULL;
+}
+
+/// Finds an unused slot, closing the least recently active stream if it has gone idle.
+static incoming_stream_t *claim_incoming(data_stream_manager_t *manager)
+{
+    incoming_stream_t *oldest = NULL;
+    for (int i = 0; i < CONFIG_LK_DATA_STREAM_MAX_INCOMING; i++) {
+        incoming_stream_t *stream = &manager->incoming[i];
+        if (stream->id[0] == '\0') {
+            return stream;
+        }
+        if (oldest == NULL || stream->last_packet_us < oldest->last_packet_us) {
+            oldest = stream;
+        }
+    }
+    if (esp_timer_get_time() - oldest->last_packet_us < INCOMING_IDLE_TIMEOUT_US) {
+        return NULL;
+    }
+    ESP_LOGW(TAG, "Closing idle stream: id=%s", oldest->id);
+    close_incoming(oldest, LIVEKIT_DATA_STREAM_CLOSE_REASON_INTERRUPTED);
+    return oldest;
+}
+
+static void handle_header(data_stream_manager_t *manager, const livekit_pb_data_stream_header_t *header, char *sender_identity)
+{
+    if (header->stream_id[0] == '\0' || find_incoming(manager, header->stream_id) != NULL) {
+        ESP_LOGD(TAG, "Ignoring invalid or duplicate header");
+        return;
+    }
+    char *topic = header->topic != NULL ? header->topic : "";
+
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    khiter_t key = kh_get(stream_handlers, manager->handlers, topic);
+    bool has_handler = key != kh_end(manager->handlers);
+    livekit_data_stream_handler_t handler = has_handler ?
+        kh_value(manager->handlers, key) : (livekit_data_stream_handler_t){};
+    xSemaphoreGive(manager->handlers_lock);
+
+    if (!has_handler) {
+        ESP_LOGD(TAG, "No handler registered for topic '%s'", topic);
+        return;
+    }
+    incoming_stream_t *stream = claim_incoming(manager);
+    if (stream == NULL) {
+        ESP_LOGW(TAG, "Too many incoming streams, ignoring: id=%s", header->stream_id);
+        return;
+    }
+
+    bool is_text = header->which_content_header == LIVEKIT_PB_DATA_STREAM_HEADER_TEXT_HEADER_TAG;
+    livekit_data_stream_info_t info = {
+        .id = (char *)header->stream_id,
+        .topic = topic,
+        .mime_type = header->mime_type,
+        .name = header->which_content_header == LIVEKIT_PB_DATA_STREAM_HEADER_BYTE_HEADER_TAG ?
+            header->content_header.byte_header.name : NULL,
+        .sender_identity = sender_identity,
+        .kind = is_text ? LIVEKIT_DATA_STREAM_KIND_TEXT : LIVEKIT_DATA_STREAM_KIND_BYTE,
+        .has_total_length = header->has_total_length,
+        .total_length = header->total_length
+    };
+    void *stream_ctx = NULL;
+    if (handler.on_open != NULL && !handler.on_open(&info, &stream_ctx, handler.ctx)) {
+        ESP_LOGD(TAG, "Handler ignored stream: id=%s", header->stream_id);
+        return;
+    }
+    *stream = (incoming_stream_t){
+        .handler = handler,
+        .stream_ctx = stream_ctx,
+        .has_total_length = header->has_total_length,
+        .total_length = header->total_length,
+        .last_packet_us = esp_timer_get_time()
+    };
+    strncpy(stream->id, header->stream_id, sizeof(stream->id));
+    ESP_LOGD(TAG, "Incoming stream opened: id=%s, topic=%s", stream->id, topic);
+}
+
+static void handle_chunk(data_stream_manager_t *manager, const livekit_pb_data_stream_chunk_t *chunk)
+{
+    incoming_stream_t *stream = find_incoming(manager, chunk->stream_id);
+    if (stream == NULL) {
+        return;
+    }
+    stream->last_packet_us = esp_timer_get_time();
+
+    if (chunk->chunk_index < stream->next_chunk_index) {
+        ESP_LOGD(TAG, "Ignoring repeated chunk: id=%s, index=%" PRIu64, stream->id, chunk->chunk_index);
+        return;
+    }
+    if (chunk->chunk_index > stream->next_chunk_index) {
+        ESP_LOGW(TAG, "Missing chunk: id=%s, expected=%" PRIu64 ", received=%" PRIu64,
+            stream->id, stream->next_chunk_index, chunk->chunk_index);
+        close_incoming(stream, LIVEKIT_DATA_STREAM_CLOSE_REASON_INCOMPLETE);
+        return;
+    }
+    stream->next_chunk_index++;
+
+    size_t size = chunk->content != NULL ? chunk->content->size : 0;
+    if (size == 0) {
+        return;
+    }
+    stream->received_bytes += size;
+    if (stream->handler.on_chunk != NULL &&
+        !stream->handler.on_chunk(chunk->content->bytes, size, stream->stream_ctx)) {
+        close_incoming(stream, LIVEKIT_DATA_STREAM_CLOSE_REASON_REJECTED);
+    }
+}
+
+static void handle_trailer(data_stream_manager_t *manager, const livekit_pb_data_stream_trailer_t *trailer)
+{
+    incoming_stream_t *stream = find_incoming(manager, trailer->stream_id);
+    if (stream == NULL) {
+        return;
+    }
+    livekit_data_stream_close_reason_t reason = LIVEKIT_DATA_STREAM_CLOSE_REASON_COMPLETE;
+    if (trailer->reason[0] != '\0') {
+        ESP_LOGD(TAG, "Sender ended stream: id=%s, reason=%s", stream->id, trailer->reason);
+        reason = LIVEKIT_DATA_STREAM_CLOSE_REASON_INTERRUPTED;
+    } else if (stream->has_total_length && stream->received_bytes != stream->total_length) {
+        ESP_LOGW(TAG, "Length mismatch: id=%s, expected=%" PRIu64 ", received=%" PRIu64,
+            stream->id, stream->total_length, stream->received_bytes);
+        reason = LIVEKIT_DATA_STREAM_CLOSE_REASON_INCOMPLETE;
+    }
+    close_incoming(stream, reason);
+}
+
+// MARK: - Outgoing
+
+/// Number of bytes at the start of `data` that end on a UTF-8 character boundary.
+static size_t utf8_boundary(const uint8_t *data, size_t size)
+{
+    size_t start = size;
+    while (start > 0 && (data[start - 1] & 0xC0) == 0x80 && size - start < 3) {
+        start--;
+    }
+    if (start == 0) {
+        return size;
+    }
+    uint8_t lead = data[start - 1];
+    size_t length = lead < 0x80 ? 1 :
+                    (lead & 0xE0) == 0xC0 ? 2 :
+                    (lead & 0xF0) == 0xE0 ? 3 :
+                    (lead & 0xF8) == 0xF0 ? 4 : 1;
+    // Hold back the last character if it is incomplete.
+    return (start - 1) + length > size ? start - 1 : size;
+}
+
+/// Waits until the reliable data channel can accept `size` more bytes within the window.
+static data_stream_err_t wait_for_window(data_stream_manager_t *manager, size_t size)
+{
+    int64_t deadline_us = esp_timer_get_time() + WRITE_TIMEOUT_MS * 1000LL;
+    while (true) {
+        if (atomic_load(&manager->is_closed)) {
+            return DATA_STREAM_ERR_INVALID_STATE;
+        }
+        size_t buffered = manager->options.get_buffered_amount(manager->options.ctx);
+        // An empty channel always accepts a chunk, even one larger than the window.
+        if (buffered == 0 || buffered + size <= manager->options.window_size) {
+            return DATA_STREAM_ERR_NONE;
+        }
+        if (esp_timer_get_time() >= deadline_us) {
+            return DATA_STREAM_ERR_TIMEOUT;
+        }
+        vTaskDelay(pdMS_TO_TICKS(WINDOW_POLL_MS));
+    }
+}
+
+static data_stream_err_t send_stream_packet(data_stream_writer_t *writer, livekit_pb_data_packet_t *packet)
+{
+    packet->destination_identities_count = writer->destination_identities_count;
+    packet->destination_identities = writer->destination_identities;
+    if (!writer->manager->options.send_packet(packet, writer->manager->options.ctx)) {
+        return DATA_STREAM_ERR_SEND_FAILED;
+    }
+    return DATA_STREAM_ERR_NONE;
+}
+
+/// Sends the content waiting in the chunk buffer.
+///
+/// Unless `is_final`, an incomplete UTF-8 character at the end of a text chunk is
+/// kept for the next chunk.
+///
+static data_stream_err_t flush_chunk(data_stream_writer_t *writer, bool is_final)
+{
+    pb_bytes_array_t *chunk = writer->chunk;
+    size_t buffered_size = chunk->size;
+    size_t send_size = buffered_size;
+    if (writer->kind == LIVEKIT_DATA_STREAM_KIND_TEXT && !is_final) {
+        send_size = utf8_boundary(chunk->bytes, buffered_size);
+    }
+    if (send_size == 0) {
+        return DATA_STREAM_ERR_NONE;
+    }
+    data_stream_err_t ret = wait_for_window(writer->manager, send_size);
+    if (ret != DATA_STREAM_ERR_NONE) {
+        ESP_LOGE(TAG, "%s waiting to send: id=%s",
+            ret == DATA_STREAM_ERR_TIMEOUT ? "Timed out" : "Room closed", writer->id);
+        return ret;
+    }
+
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG,
+        .value.stream_chunk = {
+            .chunk_index = writer->next_chunk_index,
+            .content = chunk
+        }
+    };
+    strncpy(packet.value.stream_chunk.stream_id, writer->id, sizeof(packet.value.stream_chunk.stream_id));
+    chunk->size = send_size;
+    ret = send_stream_packet(writer, &packet);
+    chunk->size = buffered_size;
+    if (ret != DATA_STREAM_ERR_NONE) {
+        return ret;
+    }
+    writer->next_chunk_index++;
+    memmove(chunk->bytes, chunk->bytes + send_size, buffered_size - send_size);
+    chunk->size = buffered_size - send_size;
+    return DATA_STREAM_ERR_NONE;
+}
+
+static void free_writer(data_stream_writer_t *writer)
+{
+    free(writer->chunk);
+    free(writer->destination_identities);
+    free(writer);
+}
+
+/// Copies destination identities into a single allocation.
+static char **copy_identities(char **identities, int count)
+{
+    size_t size = count * sizeof(char *);
+    for (int i = 0; i < count; i++) {
+        size += strlen(identities[i]) + 1;
+    }
+    char **copy = malloc(size);
+    if (copy == NULL) {
+        return NULL;
+    }
+    char *strings = (char *)(copy + count);
+    for (int i = 0; i < count; i++) {
+        size_t length = strlen(identities[i]) + 1;
+        copy[i] = memcpy(strings, identities[i], length);
+        strings += length;
+    }
+    return copy;
+}
+
+// MARK: - Public
+
+data_stream_err_t data_stream_manager_create(data_stream_manager_handle_t *handle, const data_stream_manager_options_t *options)
+{
+    if (handle == NULL ||
+        options == NULL ||
+        options->send_packet == NULL ||
+        options->get_buffered_amount == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)calloc(1, sizeof(data_stream_manager_t));
+    if (manager == NULL) {
+        return DATA_STREAM_ERR_NO_MEM;
+    }
+    manager->options = *options;
+    manager->handlers = kh_init(stream_handlers);
+    manager->handlers_lock = xSemaphoreCreateMutex();
+    if (manager->handlers == NULL || manager->handlers_lock == NULL) {
+        data_stream_manager_destroy(manager);
+        return DATA_STREAM_ERR_NO_MEM;
+    }
+    *handle = (data_stream_manager_handle_t)manager;
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_manager_destroy(data_stream_manager_handle_t handle)
+{
+    if (handle == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+    for (int i = 0; i < CONFIG_LK_DATA_STREAM_MAX_INCOMING; i++) {
+        if (manager->incoming[i].id[0] != '\0') {
+            close_incoming(&manager->incoming[i], LIVEKIT_DATA_STREAM_CLOSE_REASON_INTERRUPTED);
+        }
+    }
+    if (manager->handlers != NULL) {
+        for (khiter_t key = kh_begin(manager->handlers); key != kh_end(manager->handlers); key++) {
+            if (kh_exist(manager->handlers, key)) {
+                free((char *)kh_key(manager->handlers, key));
+            }
+        }
+        kh_destroy(stream_handlers, manager->handlers);
+    }
+    if (manager->handlers_lock != NULL) {
+        vSemaphoreDelete(manager->handlers_lock);
+    }
+    free(manager);
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_manager_set_closed(data_stream_manager_handle_t handle, bool closed)
+{
+    if (handle == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+    atomic_store(&manager->is_closed, closed);
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_manager_register(data_stream_manager_handle_t handle, const char *topic, const livekit_data_stream_handler_t *handler)
+{
+    if (handle == NULL || topic == NULL || handler == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+
+    char *topic_copy = strdup(topic);
+    if (topic_copy == NULL) {
+        return DATA_STREAM_ERR_NO_MEM;
+    }
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    int put_flag;
+    khiter_t key = kh_put(stream_handlers, manager->handlers, topic_copy, &put_flag);
+    if (put_flag > 0) {
+        kh_value(manager->handlers, key) = *handler;
+    }
+    xSemaphoreGive(manager->handlers_lock);
+
+    if (put_flag <= 0) {
+        free(topic_copy);
+        return put_flag < 0 ? DATA_STREAM_ERR_NO_MEM : DATA_STREAM_ERR_INVALID_STATE;
+    }
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_manager_unregister(data_stream_manager_handle_t handle, const char *topic)
+{
+    if (handle == NULL || topic == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+
+    char *topic_copy = NULL;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    khiter_t key = kh_get(stream_handlers, manager->handlers, topic);
+    if (key != kh_end(manager->handlers)) {
+        topic_copy = (char *)kh_key(manager->handlers, key);
+        kh_del(stream_handlers, manager->handlers, key);
+    }
+    xSemaphoreGive(manager->handlers_lock);
+
+    if (topic_copy == NULL) {
+        return DATA_STREAM_ERR_INVALID_STATE;
+    }
+    free(topic_copy);
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_manager_handle_packet(data_stream_manager_handle_t handle, const livekit_pb_data_packet_t *packet)
+{
+    if (handle == NULL || packet == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+
+    switch (packet->which_value) {
+        case LIVEKIT_PB_DATA_PACKET_STREAM_HEADER_TAG:
+            handle_header(manager, &packet->value.stream_header, packet->participant_identity);
+            break;
+        case LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG:
+            handle_chunk(manager, &packet->value.stream_chunk);
+            break;
+        case LIVEKIT_PB_DATA_PACKET_STREAM_TRAILER_TAG:
+            handle_trailer(manager, &packet->value.stream_trailer);
+            break;
+        default:
+            return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_writer_open(data_stream_manager_handle_t handle, const livekit_data_stream_options_t *options, livekit_data_stream_writer_handle_t *out_writer)
+{
+    if (handle == NULL || options == NULL || options->topic == NULL || out_writer == NULL ||
+        (options->destination_identities_count > 0 && options->destination_identities == NULL) ||
+        (options->attributes_count > 0 && options->attributes == NULL)) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_manager_t *manager = (data_stream_manager_t *)handle;
+
+    data_stream_writer_t *writer = calloc(1, sizeof(data_stream_writer_t));
+    if (writer == NULL) {
+        return DATA_STREAM_ERR_NO_MEM;
+    }
+    writer->manager = manager;
+    writer->kind = options->kind;
+    writer->total_length = options->total_length;
+    writer->chunk = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(CONFIG_LK_DATA_STREAM_CHUNK_SIZE));
+    if (writer->chunk == NULL) {
+        free_writer(writer);
+        return DATA_STREAM_ERR_NO_MEM;
+    }
+    writer->chunk->size = 0;
+    if (options->destination_identities_count > 0) {
+        writer->destination_identities = copy_identities(
+            options->destination_identities,
+            options->destination_identities_count
+        );
+        if (writer->destination_identities == NULL) {
+            free_writer(writer);
+            return DATA_STREAM_ERR_NO_MEM;
+        }
+        writer->destination_identities_count = options->destination_identities_count;
+    }
+    generate_uuid(writer->id);
+
+    bool is_text = options->kind == LIVEKIT_DATA_STREAM_KIND_TEXT;
+    char *mime_type = options->mime_type;
+    if (mime_type == NULL) {
+        mime_type = is_text ? "text/plain" : "application/octet-stream";
+    }
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_HEADER_TAG,
+        .value.stream_header = {
+            .timestamp = get_unix_time_ms(),
+            .topic = options->topic,
+            .mime_type = mime_type,
+            .has_total_length = options->total_length > 0,
+            .total_length = options->total_length
+        }
+    };
+    livekit_pb_data_stream_header_t *header = &packet.value.stream_header;
+    strncpy(header->stream_id, writer->id, sizeof(header->stream_id));
+    if (is_text) {
+        header->which_content_header = LIVEKIT_PB_DATA_STREAM_HEADER_TEXT_HEADER_TAG;
+        header->content_header.text_header.operation_type = LIVEKIT_PB_DATA_STREAM_OPERATION_TYPE_CREATE;
+    } else {
+        header->which_content_header = LIVEKIT_PB_DATA_STREAM_HEADER_BYTE_HEADER_TAG;
+        header->content_header.byte_header.name = options->name;
+    }
+    livekit_pb_data_stream_header_attributes_entry_t *attributes = NULL;
+    if (options->attributes_count > 0) {
+        attributes = calloc(options->attributes_count, sizeof(*attributes));
+        if (attributes == NULL) {
+            free_writer(writer);
+            return DATA_STREAM_ERR_NO_MEM;
+        }
+        for (int i = 0; i < options->attributes_count; i++) {
+            attributes[i].key = options->attributes[i].key;
+            attributes[i].value = options->attributes[i].value;
+        }
+        header->attributes_count = options->attributes_count;
+        header->attributes = attributes;
+    }
+
+    data_stream_err_t ret = send_stream_packet(writer, &packet);
+    free(attributes);
+    if (ret != DATA_STREAM_ERR_NONE) {
+        free_writer(writer);
+        return ret;
+    }
+    ESP_LOGD(TAG, "Outgoing stream opened: id=%s, topic=%s", writer->id, options->topic);
+    *out_writer = (livekit_data_stream_writer_handle_t)writer;
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_writer_write(livekit_data_stream_writer_handle_t handle, const uint8_t *data, size_t size)
+{
+    if (handle == NULL || (data == NULL && size > 0)) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_writer_t *writer = (data_stream_writer_t *)handle;
+
+    while (size > 0) {
+        pb_bytes_array_t *chunk = writer->chunk;
+        size_t copy_size = CONFIG_LK_DATA_STREAM_CHUNK_SIZE - chunk->size;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy(chunk->bytes + chunk->size, data, copy_size);
+        chunk->size += copy_size;
+        writer->written_bytes += copy_size;
+        data += copy_size;
+        size -= copy_size;
+
+        if (chunk->size == CONFIG_LK_DATA_STREAM_CHUNK_SIZE) {
+            data_stream_err_t ret = flush_chunk(writer, false);
+            if (ret != DATA_STREAM_ERR_NONE) {
+                return ret;
+            }
+        }
+    }
+    return DATA_STREAM_ERR_NONE;
+}
+
+data_stream_err_t data_stream_writer_close(livekit_data_stream_writer_handle_t handle, const char *reason)
+{
+    if (handle == NULL) {
+        return DATA_STREAM_ERR_INVALID_ARG;
+    }
+    data_stream_writer_t *writer = (data_stream_writer_t *)handle;
+
+    data_stream_err_t ret = DATA_STREAM_ERR_NONE;
+    if (reason == NULL) {
+        ret = flush_chunk(writer, true);
+        if (ret != DATA_STREAM_ERR_NONE) {
+            // Let the receiver know the content is incomplete.
+            reason = "error";
+        } else if (writer->total_length > 0 && writer->written_bytes != writer->total_length) {
+            ESP_LOGW(TAG, "Length mismatch: id=%s, expected=%" PRIu64 ", written=%" PRIu64,
+                writer->id, writer->total_length, writer->written_bytes);
+        }
+    }
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_TRAILER_TAG
+    };
+    livekit_pb_data_stream_trailer_t *trailer = &packet.value.stream_trailer;
+    strncpy(trailer->stream_id, writer->id, sizeof(trailer->stream_id));
+    if (reason != NULL) {
+        strncpy(trailer->reason, reason, sizeof(trailer->reason) - 1);
+    }
+    data_stream_err_t trailer_ret = send_stream_packet(writer, &packet);
+    if (ret == DATA_STREAM_ERR_NONE) {
+        ret = trailer_ret;
+    }
+
+    ESP_LOGD(TAG, "Outgoing stream closed: id=%s, bytes=%" PRIu64, writer->id, writer->written_bytes);
+    free_writer(writer);
+    return ret;
+}
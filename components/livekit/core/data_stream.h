@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "livekit_data_stream.h"
+#include "protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *data_stream_manager_handle_t;
+
+typedef enum {
+    DATA_STREAM_ERR_NONE          =  0,
+    DATA_STREAM_ERR_INVALID_ARG   = -1,
+    DATA_STREAM_ERR_NO_MEM        = -2,
+    DATA_STREAM_ERR_INVALID_STATE = -3,
+    DATA_STREAM_ERR_SEND_FAILED   = -4,
+    DATA_STREAM_ERR_TIMEOUT       = -5
+} data_stream_err_t;
+
+typedef struct {
+    /// Sends a data packet over the reliable data channel.
+    bool (*send_packet)(const livekit_pb_data_packet_t* packet, void *ctx);
+
+    /// Returns the number of bytes queued for the reliable data channel that the peer
+    /// connection has not yet accepted.
+    ///
+    /// The peer rejects sends once its SCTP send buffer is full; rejected packets stay
+    /// queued and are retried, so this grows only while the channel is backed up.
+    ///
+    size_t (*get_buffered_amount)(void *ctx);
+
+    /// Most bytes an outgoing stream may have queued before writes wait.
+    size_t window_size;
+
+    void* ctx;
+} data_stream_manager_options_t;
+
+/// Creates a new data stream manager.
+data_stream_err_t data_stream_manager_create(data_stream_manager_handle_t *handle, const data_stream_manager_options_t *options);
+
+/// Destroys a data stream manager.
+///
+/// Incoming streams still open are closed as interrupted. Outgoing streams must
+/// be closed first.
+///
+data_stream_err_t data_stream_manager_destroy(data_stream_manager_handle_t handle);
+
+/// Sets whether the room is closed.
+///
+/// While closed, writes fail with `DATA_STREAM_ERR_INVALID_STATE` instead of waiting
+/// for the window, since the reliable data channel no longer drains.
+///
+data_stream_err_t data_stream_manager_set_closed(data_stream_manager_handle_t handle, bool closed);
+
+/// Registers a handler for incoming streams on a topic.
+data_stream_err_t data_stream_manager_register(data_stream_manager_handle_t handle, const char *topic, const livekit_data_stream_handler_t *handler);
+
+/// Unregisters the handler for a topic.
+///
+/// Streams already open continue to be delivered to the handler.
+///
+data_stream_err_t data_stream_manager_unregister(data_stream_manager_handle_t handle, const char *topic);
+
+/// Handles an incoming stream header, chunk, or trailer packet.
+///
+/// @note Packets must all be handled from the same task.
+///
+data_stream_err_t data_stream_manager_handle_packet(data_stream_manager_handle_t handle, const livekit_pb_data_packet_t *packet);
+
+/// Opens an outgoing stream, sending its header.
+data_stream_err_t data_stream_writer_open(data_stream_manager_handle_t handle, const livekit_data_stream_options_t *options, livekit_data_stream_writer_handle_t *out_writer);
+
+/// Writes content to an outgoing stream.
+///
+/// Content is sent in chunks of `CONFIG_LK_DATA_STREAM_CHUNK_SIZE` bytes. Blocks while
+/// the reliable data channel has more than the window size queued, until the room
+/// is closed.
+///
+data_stream_err_t data_stream_writer_write(livekit_data_stream_writer_handle_t writer, const uint8_t *data, size_t size);
+
+/// Sends any remaining content and the trailer, then frees the writer.
+///
+/// @param reason[in] Reason the stream ended early, or NULL if it is complete.
+///
+data_stream_err_t data_stream_writer_close(livekit_data_stream_writer_handle_t writer, const char *reason);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
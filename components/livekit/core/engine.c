@@ -20,19 +20,34 @@
 #include "freertos/event_groups.h"
 #include "media_lib_os.h"
 #include "esp_capture_sink.h"
+#include "esp_timer.h"
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include "esp_log.h"
 #include "url.h"
 #include "signaling.h"
 #include "peer.h"
+#include "reliable_buffer.h"
 #include "utils.h"
+#include "audio_vad.h"
+#include "video_layers.h"
+#include "data_dispatch.h"
 
 #include "engine.h"
 
 // MARK: - Constants
 static const char* TAG = "livekit_engine";
 
+/// Adds to a counter in `engine_counters_t`.
+#define COUNTER_ADD(counter, n) atomic_fetch_add_explicit(&(counter), (n), memory_order_relaxed)
+
+/// Adds to a count in `engine_byte_counts_t`, only from the task that writes it.
+#define BYTE_COUNT_ADD(eng, count, n) count64_add(&(eng)->byte_counts.count, (n))
+
+/// Delay before retrying reliable data packets that could not be sent.
+#define RELIABLE_RETRY_MS 50
+
 // MARK: - Type definitions
 
 /// Engine state machine state.
@@ -43,21 +58,38 @@ typedef enum {
     ENGINE_STATE_BACKOFF
 } engine_state_t;
 
+/// How reliable data packets are handled in the current state.
+typedef enum {
+    /// Rejected; neither connected nor reconnecting.
+    RELIABLE_MODE_REJECT,
+    /// Buffered while reconnecting, to be sent once connected again.
+    RELIABLE_MODE_BUFFER,
+    /// Sent once any buffered before them are.
+    RELIABLE_MODE_SEND
+} reliable_mode_t;
+
 /// Type of event processed by the engine state machine.
 typedef enum {
     EV_CMD_CONNECT,         /// User-initiated connect.
     EV_CMD_CLOSE,           /// User-initiated disconnect.
+    EV_CMD_SET_MUTED,       /// User-initiated mute or unmute of a published track.
+    EV_VAD_STATE,           /// Voice activity in published audio started or stopped.
     EV_SIG_STATE,           /// Signal state changed.
     EV_SIG_RES,             /// Signal response received.
     EV_PEER_STATE,          /// Peer state changed.
     EV_PEER_SDP,            /// Peer provided SDP.
     EV_TIMER_EXP,           /// Timer expired.
     EV_MAX_RETRIES_REACHED, /// Maximum number of retry attempts reached.
+    EV_RELIABLE_RETRY,      /// Retry sending pending reliable data packets.
     _EV_STATE_ENTER,        /// State enter hook (internal).
     _EV_STATE_EXIT,         /// State exit hook (internal).
 } engine_event_type_t;
 
 /// An event processed by the engine state machine.
+///
+/// Events are kept small so they can be stored in the engine's event pool; larger
+/// payloads are referenced by pointer and owned by the event until it is freed.
+///
 typedef struct {
     /// Type of event, determines which union member is valid in `detail`.
     engine_event_type_t type;
@@ -68,12 +100,21 @@ typedef struct {
             char *token;
         } cmd_connect;
 
-        /// Detail for `EV_SIG_RES`.
-        livekit_pb_signal_response_t res;
+        /// Detail for `EV_CMD_SET_MUTED`.
+        struct {
+            livekit_pb_track_type_t type;
+            bool muted;
+        } cmd_set_muted;
+
+        /// Detail for `EV_SIG_RES` (heap allocated).
+        livekit_pb_signal_response_t *res;
 
         /// Detail for `EV_SIG_STATE`.
         signal_state_t sig_state;
 
+        /// Detail for `EV_VAD_STATE`.
+        bool is_speaking;
+
         /// Detail for `EV_PEER_SDP`.
         struct {
             const char *sdp;
@@ -88,12 +129,147 @@ typedef struct {
     } detail;
 } engine_event_t;
 
+/// A remote audio track eligible for subscription.
+typedef struct {
+    livekit_pb_sid_t track_sid;
+    livekit_pb_sid_t participant_sid;
+    bool is_subscribed;
+
+    /// Speaking state of the participant, tracked when following active speakers.
+    bool is_speaking;
+    float level;
+    int64_t spoke_at_ms;
+} sub_track_t;
+
+/// Audio captured before tracks are published, kept to send to an agent.
+typedef struct {
+    /// Captured PCM; NULL unless capturing.
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    int64_t start_ms;
+} pre_connect_audio_t;
+
+/// A track published by the local participant.
+typedef struct {
+    /// SID assigned by the server, empty until the track is published.
+    livekit_pb_sid_t sid;
+
+    /// Whether the server was last told the track is muted.
+    bool is_muted;
+} pub_track_t;
+
 typedef struct {
     bool is_subscriber_primary;
     livekit_pb_sid_t local_participant_sid;
-    livekit_pb_sid_t sub_audio_track_sid;
+
+    pub_track_t pub_audio_track;
+    pub_track_t pub_video_track;
+
+    /// Remote audio tracks eligible for subscription, of which one is subscribed
+    /// to at a time since only one can be played back.
+    sub_track_t audio_tracks[CONFIG_LK_MAX_REMOTE_AUDIO_TRACKS];
+    size_t audio_track_count;
+    bool is_audio_subscribed;
 } session_state_t;
 
+/// Counters reported by `engine_get_stats`.
+///
+/// Counters are updated on whichever task the counted event occurs, without locking,
+/// so that counting never blocks the media or data paths. They are 32 bits wide since
+/// 64-bit atomics are not lock-free on the targets; byte counts are kept separately
+/// in `engine_byte_counts_t`.
+///
+typedef struct {
+    _Atomic uint32_t audio_frames_sent;
+    _Atomic uint32_t audio_frames_suppressed;
+    _Atomic uint32_t audio_frames_received;
+    _Atomic uint32_t video_frames_sent;
+    _Atomic uint32_t video_frames_received;
+    _Atomic uint32_t capture_send_failures;
+    _Atomic uint32_t render_failures;
+    _Atomic uint32_t reliable_packets_sent;
+    _Atomic uint32_t reliable_packets_received;
+    _Atomic uint32_t lossy_packets_sent;
+    _Atomic uint32_t lossy_packets_received;
+    _Atomic uint32_t queue_high_water;
+    _Atomic uint32_t reconnects;
+} engine_counters_t;
+
+/// A 64-bit count written by a single task and read from any task.
+///
+/// 64-bit atomics are not lock-free on the targets, so the halves are written
+/// between increments of a sequence number, which readers check to retry reads
+/// that overlapped a write. The writer never waits.
+///
+typedef struct {
+    _Atomic uint32_t seq;
+    _Atomic uint32_t low;
+    _Atomic uint32_t high;
+} engine_count64_t;
+
+/// Reads the count from any task.
+static inline uint64_t count64_load(engine_count64_t *count)
+{
+    uint32_t seq;
+    uint64_t value;
+    do {
+        seq = atomic_load_explicit(&count->seq, memory_order_acquire);
+        value = (uint64_t)atomic_load_explicit(&count->high, memory_order_relaxed) << 32 |
+            atomic_load_explicit(&count->low, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) != 0 || seq != atomic_load_explicit(&count->seq, memory_order_relaxed));
+    return value;
+}
+
+/// Sets the count; only from the task that writes it.
+static inline void count64_set(engine_count64_t *count, uint64_t value)
+{
+    uint32_t seq = atomic_load_explicit(&count->seq, memory_order_relaxed);
+    atomic_store_explicit(&count->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&count->low, (uint32_t)value, memory_order_relaxed);
+    atomic_store_explicit(&count->high, (uint32_t)(value >> 32), memory_order_relaxed);
+    atomic_store_explicit(&count->seq, seq + 2, memory_order_release);
+}
+
+/// Adds to the count; only from the task that writes it.
+static inline void count64_add(engine_count64_t *count, uint32_t n)
+{
+    count64_set(count, count64_load(count) + n);
+}
+
+/// Byte counts reported by `engine_get_stats`.
+///
+/// These exceed 32 bits in long sessions. Sent counts are written by the media
+/// stream task and received counts by the subscriber peer's task.
+///
+typedef struct {
+    engine_count64_t audio_sent;
+    engine_count64_t audio_received;
+    engine_count64_t video_sent;
+    engine_count64_t video_received;
+} engine_byte_counts_t;
+
+/// Latency between capture and send for published audio frames.
+///
+/// Latency is measured from a frame's capture PTS to the point it is handed to
+/// `peer_send_audio`. Fields are written only by the media stream task.
+///
+typedef struct {
+    /// Set when a new stream begins, for the media stream task to clear the
+    /// fields below before recording the next frame.
+    _Atomic bool is_reset_pending;
+    /// Number of frames measured.
+    _Atomic uint32_t frame_count;
+    /// Latency of the most recent frame in milliseconds.
+    _Atomic uint32_t last_ms;
+    /// Highest latency observed in milliseconds.
+    _Atomic uint32_t max_ms;
+    /// Sum of all measured latencies in milliseconds, for computing the mean.
+    engine_count64_t total_ms;
+} engine_pub_latency_t;
+
 typedef struct {
     engine_state_t state;
     engine_options_t options;
@@ -106,19 +282,113 @@ typedef struct {
     esp_capture_sink_handle_t capturer_path;
     bool is_media_streaming;
 
+    /// Published video layers, or NULL if video is not published.
+    video_layers_handle_t video_layers;
+
+    /// Whether the published tracks are muted, kept across sessions. While muted,
+    /// a track's capture path is disabled unless it is shared with the other track.
+    _Atomic bool is_audio_muted;
+    bool is_video_muted;
+
+    /// Capture path of PCM audio analyzed for voice activity and kept as pre-connect
+    /// audio, or NULL if neither is enabled.
+    esp_capture_sink_handle_t pcm_path;
+    audio_vad_t vad;
+
+    /// Whether captured frames are sent. Capture starts before tracks are published
+    /// when pre-connect audio is enabled, until which frames are only kept as PCM.
+    _Atomic bool is_publishing;
+
+    /// Pre-connect audio, guarded by `pre_connect_lock`.
+    pre_connect_audio_t pre_connect;
+    SemaphoreHandle_t pre_connect_lock;
+    /// Identity of the agent to send pre-connect audio to once the audio track is published.
+    char *pre_connect_agent;
+
+    int64_t capture_start_ms;
+    /// Latency of published audio.
+    engine_pub_latency_t pub_audio_latency;
+
     char* server_url;
     char* token;
     session_state_t session;
 
+    /// Reliable data packets waiting to be sent, guarded by `reliable_lock`.
+    reliable_buffer_t reliable_buffer;
+    SemaphoreHandle_t reliable_lock;
+    uint32_t reliable_sequence;
+    /// Set before entering each state, guarded by `reliable_lock`.
+    reliable_mode_t reliable_mode;
+    /// Retries sending pending reliable data packets after a failed send.
+    TimerHandle_t reliable_retry_timer;
+
+    /// Delivers received data packets on a dedicated task.
+    data_dispatch_handle_t data_dispatch;
+
     TaskHandle_t task_handle;
+
+    /// Queue of pointers to events in `event_pool` awaiting processing.
     QueueHandle_t event_queue;
+
+    /// Queue of pointers to unused events in `event_pool`.
+    QueueHandle_t free_events;
+
+    /// Storage for all events that can be enqueued at once.
+    engine_event_t event_pool[CONFIG_LK_ENGINE_QUEUE_SIZE];
+
     TimerHandle_t timer;
     bool is_running;
     uint16_t retry_count;
     livekit_failure_reason_t failure_reason;
+
+    /// Timeline of the current connection attempt, guarded by `timeline_lock`.
+    livekit_connect_timeline_t timeline;
+    SemaphoreHandle_t timeline_lock;
+    uint32_t connect_attempts;
+
+    engine_counters_t counters;
+
+    engine_byte_counts_t byte_counts;
 } engine_t;
 
-static bool event_enqueue(engine_t *eng, engine_event_t *ev, bool send_to_front);
+static bool event_enqueue(engine_t *eng, const engine_event_t *ev, bool send_to_front);
+static void event_free(engine_event_t *ev);
+
+// MARK: - Connection timeline
+
+/// Starts the timeline of a new connection attempt.
+static void timeline_begin(engine_t *eng)
+{
+    xSemaphoreTake(eng->timeline_lock, portMAX_DELAY);
+    eng->timeline.attempt = ++eng->connect_attempts;
+    if (eng->timeline.attempt > 1) {
+        COUNTER_ADD(eng->counters.reconnects, 1);
+    }
+    eng->timeline.start_us = esp_timer_get_time();
+    for (int i = 0; i < LIVEKIT_CONNECT_PHASE_MAX; i++) {
+        eng->timeline.phase_us[i] = -1;
+    }
+    xSemaphoreGive(eng->timeline_lock);
+}
+
+/// Records the time a phase is reached, unless already reached during the current attempt.
+///
+/// Phases are reached on the engine, signal, peer, and media tasks. Once a phase has
+/// been recorded, this returns without taking the lock, so it can be called per frame.
+///
+static void timeline_mark(engine_t *eng, livekit_connect_phase_t phase)
+{
+    if (eng->timeline.phase_us[phase] >= 0) {
+        return;
+    }
+    int64_t now_us = esp_timer_get_time();
+    xSemaphoreTake(eng->timeline_lock, portMAX_DELAY);
+    if (eng->timeline.phase_us[phase] < 0) {
+        eng->timeline.phase_us[phase] = now_us - eng->timeline.start_us;
+        ESP_LOGD(TAG, "Connect phase %d reached: %" PRId64 "us", phase, eng->timeline.phase_us[phase]);
+    }
+    xSemaphoreGive(eng->timeline_lock);
+}
 
 // MARK: - Subscribed media
 
@@ -147,26 +417,164 @@ static inline void convert_dec_aud_info(esp_peer_audio_stream_info_t *info, av_r
     dec_info->bits_per_sample = 16;
 }
 
-static engine_err_t subscribe_tracks(engine_t *eng, livekit_pb_track_info_t *tracks, int count)
+static inline bool track_is_published(const livekit_pb_participant_info_t *participant, const char *track_sid)
 {
-    if (tracks == NULL || count <= 0) {
-        return ENGINE_ERR_INVALID_ARG;
+    for (pb_size_t i = 0; i < participant->tracks_count; i++) {
+        if (strncmp(participant->tracks[i].sid, track_sid, sizeof(livekit_pb_sid_t)) == 0) {
+            return true;
+        }
     }
-    if (eng->session.sub_audio_track_sid[0] != '\0') {
-        return ENGINE_ERR_NONE;
+    return false;
+}
+
+static inline sub_track_t *find_audio_track(engine_t *eng, const char *track_sid)
+{
+    for (size_t i = 0; i < eng->session.audio_track_count; i++) {
+        if (strncmp(eng->session.audio_tracks[i].track_sid, track_sid, sizeof(livekit_pb_sid_t)) == 0) {
+            return &eng->session.audio_tracks[i];
+        }
+    }
+    return NULL;
+}
+
+static bool set_subscribed(engine_t *eng, sub_track_t *track, bool subscribe)
+{
+    ESP_LOGI(TAG, "%s audio track: sid=%s, participant=%s",
+        subscribe ? "Subscribing to" : "Unsubscribing from", track->track_sid, track->participant_sid);
+    if (signal_send_update_subscription(eng->signal_handle, track->track_sid, subscribe) != SIGNAL_ERR_NONE) {
+        return false;
+    }
+    track->is_subscribed = subscribe;
+    eng->session.is_audio_subscribed = subscribe;
+    return true;
+}
+
+/// Returns the unsubscribed track to subscribe to next: the loudest speaker if any
+/// is speaking, otherwise (unless `speaking_only`) any eligible track.
+static sub_track_t *next_unsubscribed_track(engine_t *eng, bool speaking_only)
+{
+    sub_track_t *next = NULL;
+    for (size_t i = 0; i < eng->session.audio_track_count; i++) {
+        sub_track_t *track = &eng->session.audio_tracks[i];
+        if (track->is_subscribed || (speaking_only && !track->is_speaking)) {
+            continue;
+        }
+        if (next == NULL || (track->is_speaking && (!next->is_speaking || track->level > next->level))) {
+            next = track;
+        }
     }
-    for (int i = 0; i < count; i++) {
-        livekit_pb_track_info_t *track = &tracks[i];
-        if (track->type != LIVEKIT_PB_TRACK_TYPE_AUDIO) {
+    return next;
+}
+
+/// Returns the subscribed track silent for longest, if it has been for at least
+/// `CONFIG_LK_SPEAKER_HOLD_MS`.
+static sub_track_t *quietest_subscribed_track(engine_t *eng, int64_t now_ms)
+{
+    sub_track_t *quietest = NULL;
+    for (size_t i = 0; i < eng->session.audio_track_count; i++) {
+        sub_track_t *track = &eng->session.audio_tracks[i];
+        if (!track->is_subscribed || track->is_speaking ||
+            now_ms - track->spoke_at_ms < CONFIG_LK_SPEAKER_HOLD_MS) {
             continue;
         }
-        // For now, subscribe to the first audio track.
-        ESP_LOGI(TAG, "Subscribing to audio track: sid=%s", track->sid);
-        signal_send_update_subscription(eng->signal_handle, track->sid, true);
-        strncpy(eng->session.sub_audio_track_sid, track->sid, sizeof(eng->session.sub_audio_track_sid));
-        break;
+        if (quietest == NULL || track->spoke_at_ms < quietest->spoke_at_ms) {
+            quietest = track;
+        }
+    }
+    return quietest;
+}
+
+/// Subscribes to an eligible track if none is subscribed to.
+static void fill_audio_subscription(engine_t *eng)
+{
+    if (eng->session.is_audio_subscribed) {
+        return;
+    }
+    sub_track_t *track = next_unsubscribed_track(eng, false);
+    if (track != NULL) {
+        set_subscribed(eng, track, true);
+    }
+}
+
+/// Updates the audio tracks eligible for subscription from a remote participant.
+///
+/// Tracks the participant no longer publishes, or all of them once it disconnects, are
+/// forgotten (the server ends those subscriptions itself). Audio tracks the policy selects
+/// become eligible, and one is subscribed to if none is.
+///
+static void subscribe_tracks(engine_t *eng, const livekit_pb_participant_info_t *participant)
+{
+    session_state_t *session = &eng->session;
+    bool is_disconnected = participant->state == LIVEKIT_PB_PARTICIPANT_INFO_STATE_DISCONNECTED;
+
+    for (size_t i = 0; i < session->audio_track_count;) {
+        sub_track_t *track = &session->audio_tracks[i];
+        if (strncmp(track->participant_sid, participant->sid, sizeof(livekit_pb_sid_t)) == 0 &&
+            (is_disconnected || !track_is_published(participant, track->track_sid))) {
+            ESP_LOGI(TAG, "Audio track ended: sid=%s", track->track_sid);
+            if (track->is_subscribed) {
+                session->is_audio_subscribed = false;
+            }
+            *track = session->audio_tracks[--session->audio_track_count];
+            continue;
+        }
+        i++;
+    }
+    if (!is_disconnected &&
+        (eng->options.should_subscribe == NULL ||
+         eng->options.should_subscribe(participant, eng->options.ctx))) {
+        for (pb_size_t i = 0; i < participant->tracks_count; i++) {
+            const livekit_pb_track_info_t *track = &participant->tracks[i];
+            if (track->type != LIVEKIT_PB_TRACK_TYPE_AUDIO || find_audio_track(eng, track->sid) != NULL) {
+                continue;
+            }
+            if (session->audio_track_count >= CONFIG_LK_MAX_REMOTE_AUDIO_TRACKS) {
+                ESP_LOGD(TAG, "Not considering audio track, limit reached: sid=%s", track->sid);
+                break;
+            }
+            sub_track_t *eligible = &session->audio_tracks[session->audio_track_count++];
+            *eligible = (sub_track_t){};
+            strncpy(eligible->track_sid, track->sid, sizeof(eligible->track_sid));
+            strncpy(eligible->participant_sid, participant->sid, sizeof(eligible->participant_sid));
+        }
+    }
+    fill_audio_subscription(eng);
+}
+
+/// Switches the audio subscription to the loudest active speaker.
+///
+/// The subscribed speaker keeps its subscription until it has been silent for
+/// `CONFIG_LK_SPEAKER_HOLD_MS`, so that pauses in speech do not cause switching.
+///
+static void handle_speakers_changed(engine_t *eng, livekit_pb_speakers_changed_t *speakers_changed)
+{
+    if (!eng->options.follow_active_speakers) {
+        return;
+    }
+    int64_t now_ms = esp_timer_get_time() / 1000;
+    for (pb_size_t i = 0; i < speakers_changed->speakers_count; i++) {
+        const livekit_pb_speaker_info_t *speaker = &speakers_changed->speakers[i];
+        for (size_t j = 0; j < eng->session.audio_track_count; j++) {
+            sub_track_t *track = &eng->session.audio_tracks[j];
+            if (strncmp(track->participant_sid, speaker->sid, sizeof(livekit_pb_sid_t)) != 0) {
+                continue;
+            }
+            track->is_speaking = speaker->active;
+            track->level = speaker->level;
+            if (speaker->active) {
+                track->spoke_at_ms = now_ms;
+            }
+        }
+    }
+    sub_track_t *speaker;
+    while ((speaker = next_unsubscribed_track(eng, true)) != NULL) {
+        sub_track_t *quietest = quietest_subscribed_track(eng, now_ms);
+        if (quietest == NULL ||
+            !set_subscribed(eng, quietest, false) ||
+            !set_subscribed(eng, speaker, true)) {
+            break;
+        }
     }
-    return ENGINE_ERR_NONE;
 }
 
 static void on_peer_sub_audio_info(esp_peer_audio_stream_info_t* info, void *ctx)
@@ -187,12 +595,174 @@ static void on_peer_sub_audio_info(esp_peer_audio_stream_info_t* info, void *ctx
 static void on_peer_sub_audio_frame(esp_peer_audio_frame_t* frame, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
+    timeline_mark(eng, LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_RECEIVED);
+    COUNTER_ADD(eng->counters.audio_frames_received, 1);
+    BYTE_COUNT_ADD(eng, audio_received, frame->size);
     av_render_audio_data_t audio_data = {
         .pts = frame->pts,
         .data = frame->data,
         .size = frame->size,
     };
-    av_render_add_audio_data(eng->renderer_handle, &audio_data);
+    if (av_render_add_audio_data(eng->renderer_handle, &audio_data) != ESP_MEDIA_ERR_OK) {
+        COUNTER_ADD(eng->counters.render_failures, 1);
+    }
+}
+
+static void on_peer_sub_video_frame(esp_peer_video_frame_t* frame, void *ctx)
+{
+    // Received video is not rendered; it is only counted.
+    engine_t *eng = (engine_t *)ctx;
+    COUNTER_ADD(eng->counters.video_frames_received, 1);
+    BYTE_COUNT_ADD(eng, video_received, frame->size);
+}
+
+// MARK: - Pre-connect audio
+
+static engine_err_t media_stream_begin(engine_t *eng);
+
+static bool pre_connect_is_capturing(engine_t *eng)
+{
+    xSemaphoreTake(eng->pre_connect_lock, portMAX_DELAY);
+    bool is_capturing = eng->pre_connect.data != NULL;
+    xSemaphoreGive(eng->pre_connect_lock);
+    return is_capturing;
+}
+
+/// Enables the PCM capture path while audio is unmuted and PCM is needed for
+/// voice activity detection or pre-connect audio.
+static void sync_pcm_path(engine_t *eng)
+{
+    if (eng->pcm_path == NULL) {
+        return;
+    }
+    bool enable = !atomic_load(&eng->is_audio_muted) &&
+        (eng->options.media.vad_enabled || pre_connect_is_capturing(eng));
+    if (esp_capture_sink_enable(
+        eng->pcm_path,
+        enable ? ESP_CAPTURE_RUN_MODE_ALWAYS : ESP_CAPTURE_RUN_MODE_DISABLE
+    ) != ESP_CAPTURE_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to %s PCM capture", enable ? "resume" : "suspend");
+    }
+}
+
+/// Stops capturing pre-connect audio, discarding any captured.
+static void pre_connect_end(engine_t *eng)
+{
+    xSemaphoreTake(eng->pre_connect_lock, portMAX_DELAY);
+    bool was_capturing = eng->pre_connect.data != NULL;
+    free(eng->pre_connect.data);
+    eng->pre_connect = (pre_connect_audio_t){};
+    xSemaphoreGive(eng->pre_connect_lock);
+    SAFE_FREE(eng->pre_connect_agent);
+    if (was_capturing) {
+        sync_pcm_path(eng);
+    }
+}
+
+/// Starts capture ahead of connecting, keeping audio until it can be sent to an agent.
+static void pre_connect_begin(engine_t *eng)
+{
+    if (!eng->options.media.pre_connect_audio || eng->pcm_path == NULL || eng->is_media_streaming) {
+        return;
+    }
+    const esp_peer_audio_stream_info_t *info = &eng->options.media.audio_info;
+    size_t frame_size = info->channel * sizeof(int16_t);
+    size_t capacity = (size_t)info->sample_rate * frame_size * CONFIG_LK_PRE_CONNECT_BUFFER_MS / 1000;
+    if (capacity > CONFIG_LK_PRE_CONNECT_BUFFER_SIZE) {
+        capacity = CONFIG_LK_PRE_CONNECT_BUFFER_SIZE / frame_size * frame_size;
+    }
+    uint8_t *data = malloc(capacity);
+    if (data == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate pre-connect audio: bytes=%zu", capacity);
+        return;
+    }
+    xSemaphoreTake(eng->pre_connect_lock, portMAX_DELAY);
+    eng->pre_connect = (pre_connect_audio_t){
+        .data = data,
+        .capacity = capacity,
+        .start_ms = esp_timer_get_time() / 1000
+    };
+    xSemaphoreGive(eng->pre_connect_lock);
+    sync_pcm_path(eng);
+    if (media_stream_begin(eng) != ENGINE_ERR_NONE) {
+        pre_connect_end(eng);
+    }
+}
+
+/// Keeps PCM taken on the media streaming task as pre-connect audio.
+///
+/// Once full, later audio is dropped so the start of speech is kept. If no agent
+/// is found in time, all of it is discarded.
+///
+static void pre_connect_append(engine_t *eng, const uint8_t *data, size_t size)
+{
+    xSemaphoreTake(eng->pre_connect_lock, portMAX_DELAY);
+    pre_connect_audio_t *audio = &eng->pre_connect;
+    bool is_expired = audio->data != NULL &&
+        esp_timer_get_time() / 1000 - audio->start_ms > CONFIG_LK_PRE_CONNECT_TIMEOUT_MS;
+    if (is_expired) {
+        free(audio->data);
+        *audio = (pre_connect_audio_t){};
+    } else if (audio->data != NULL) {
+        size_t copy_size = audio->capacity - audio->size;
+        if (copy_size > size) {
+            copy_size = size;
+        }
+        memcpy(audio->data + audio->size, data, copy_size);
+        audio->size += copy_size;
+    }
+    xSemaphoreGive(eng->pre_connect_lock);
+    if (is_expired) {
+        ESP_LOGW(TAG, "No agent found in time, discarding pre-connect audio");
+        sync_pcm_path(eng);
+    }
+}
+
+/// Sends pre-connect audio to the agent once one is found and the audio track the
+/// audio precedes is published.
+static void pre_connect_flush(engine_t *eng)
+{
+    const char *track_sid = eng->session.pub_audio_track.sid;
+    if (eng->pre_connect_agent == NULL || track_sid[0] == '\0') {
+        return;
+    }
+    xSemaphoreTake(eng->pre_connect_lock, portMAX_DELAY);
+    pre_connect_audio_t audio = eng->pre_connect;
+    eng->pre_connect = (pre_connect_audio_t){};
+    xSemaphoreGive(eng->pre_connect_lock);
+    if (audio.data != NULL) {
+        sync_pcm_path(eng);
+    }
+
+    if (audio.size > 0 && eng->options.on_pre_connect_audio != NULL) {
+        ESP_LOGI(TAG, "Sending pre-connect audio: bytes=%zu, agent=%s", audio.size, eng->pre_connect_agent);
+        engine_pre_connect_audio_t ready = {
+            .data = audio.data,
+            .size = audio.size,
+            .sample_rate = eng->options.media.audio_info.sample_rate,
+            .channel_count = eng->options.media.audio_info.channel,
+            .track_sid = track_sid,
+            .agent_identity = eng->pre_connect_agent
+        };
+        eng->options.on_pre_connect_audio(&ready, eng->options.ctx);
+    } else {
+        free(audio.data);
+    }
+    SAFE_FREE(eng->pre_connect_agent);
+}
+
+/// Checks whether a remote participant is an agent to send pre-connect audio to.
+static void pre_connect_find_agent(engine_t *eng, const livekit_pb_participant_info_t *participant)
+{
+    if (eng->pre_connect_agent != NULL ||
+        participant->kind != LIVEKIT_PB_PARTICIPANT_INFO_KIND_AGENT ||
+        participant->state != LIVEKIT_PB_PARTICIPANT_INFO_STATE_ACTIVE ||
+        participant->identity == NULL ||
+        !pre_connect_is_capturing(eng)) {
+        return;
+    }
+    eng->pre_connect_agent = strdup(participant->identity);
+    pre_connect_flush(eng);
 }
 
 // MARK: - Published media
@@ -218,64 +788,237 @@ static inline esp_capture_format_id_t capture_video_codec_type(esp_peer_video_co
     }
 }
 
-/// Captures and sends a single audio frame over the peer connection.
+/// Records the latency between a frame's capture and it being sent.
+///
+/// Capture PTS values are in milliseconds relative to when capture was started.
+///
+static inline void record_pub_latency(engine_t *eng, engine_pub_latency_t *latency, uint32_t pts)
+{
+    int64_t elapsed_ms = esp_timer_get_time() / 1000 - eng->capture_start_ms;
+    uint32_t latency_ms = elapsed_ms > pts ? (uint32_t)(elapsed_ms - pts) : 0;
+    uint32_t max_ms = atomic_load_explicit(&latency->max_ms, memory_order_relaxed);
+    if (atomic_exchange_explicit(&latency->is_reset_pending, false, memory_order_acquire)) {
+        count64_set(&latency->total_ms, 0);
+        atomic_store_explicit(&latency->frame_count, 0, memory_order_relaxed);
+        atomic_store_explicit(&latency->max_ms, 0, memory_order_relaxed);
+        max_ms = 0;
+    }
+    atomic_store_explicit(&latency->last_ms, latency_ms, memory_order_relaxed);
+    if (latency_ms > max_ms) {
+        atomic_store_explicit(&latency->max_ms, latency_ms, memory_order_relaxed);
+    }
+    count64_add(&latency->total_ms, latency_ms);
+    COUNTER_ADD(latency->frame_count, 1);
+}
+
+static inline void report_speaking(engine_t *eng, bool is_speaking)
+{
+    if (eng->options.on_speaking_changed == NULL) {
+        return;
+    }
+    engine_event_t ev = { .type = EV_VAD_STATE, .detail.is_speaking = is_speaking };
+    event_enqueue(eng, &ev, false);
+}
+
+/// Takes all PCM captured so far, running voice activity detection on it if
+/// publishing and keeping it as pre-connect audio if capturing it.
+__attribute__((always_inline))
+static inline void _media_stream_take_pcm(engine_t *eng, bool is_publishing)
+{
+    if (eng->pcm_path == NULL) {
+        return;
+    }
+    const esp_peer_audio_stream_info_t *info = &eng->options.media.audio_info;
+    uint32_t bytes_per_ms = info->sample_rate / 1000 * info->channel * sizeof(int16_t);
+    bool is_vad_enabled = is_publishing && eng->options.media.vad_enabled;
+    esp_capture_stream_frame_t pcm_frame = {
+        .stream_type = ESP_CAPTURE_STREAM_TYPE_AUDIO,
+    };
+    bool was_speaking = eng->vad.is_speaking;
+    while (esp_capture_sink_acquire_frame(eng->pcm_path, &pcm_frame, true) == ESP_CAPTURE_ERR_OK) {
+        if (is_vad_enabled) {
+            audio_vad_process(
+                &eng->vad,
+                (const int16_t *)pcm_frame.data,
+                pcm_frame.size / sizeof(int16_t),
+                bytes_per_ms > 0 ? pcm_frame.size / bytes_per_ms : 0
+            );
+        }
+        if (eng->options.media.pre_connect_audio) {
+            pre_connect_append(eng, pcm_frame.data, pcm_frame.size);
+        }
+        esp_capture_sink_release_frame(eng->pcm_path, &pcm_frame);
+    }
+    if (eng->vad.is_speaking != was_speaking) {
+        report_speaking(eng, eng->vad.is_speaking);
+    }
+}
+
+/// Takes the PCM captured so far and checks whether voice was detected.
+///
+/// @returns Whether the encoded audio frame captured alongside should be sent.
+///
+__attribute__((always_inline))
+static inline bool _media_stream_gate_audio(engine_t *eng)
+{
+    _media_stream_take_pcm(eng, true);
+    if (!eng->options.media.vad_enabled) {
+        return true;
+    }
+    if (eng->vad.is_speaking) {
+        return true;
+    }
+    COUNTER_ADD(eng->counters.audio_frames_suppressed, 1);
+    return false;
+}
+
+/// Captures and sends all available audio frames over the peer connection.
+///
+/// If `wait` is true, blocks until the first frame is available. Frames without
+/// voice are dropped if audio is gated on voice activity.
+///
+/// @returns Whether at least one frame was captured.
+///
 __attribute__((always_inline))
-static inline void _media_stream_send_audio(engine_t *eng)
+static inline bool _media_stream_send_audio(engine_t *eng, bool wait)
 {
     esp_capture_stream_frame_t audio_frame = {
         .stream_type = ESP_CAPTURE_STREAM_TYPE_AUDIO,
     };
-    while (esp_capture_sink_acquire_frame(eng->capturer_path, &audio_frame, true) == ESP_CAPTURE_ERR_OK) {
+    if (atomic_load_explicit(&eng->is_audio_muted, memory_order_relaxed)) {
+        // The path is either disabled or still capturing video; drain any frames
+        // without blocking, so unmuting takes effect on the next iteration.
+        while (esp_capture_sink_acquire_frame(eng->capturer_path, &audio_frame, true) == ESP_CAPTURE_ERR_OK) {
+            esp_capture_sink_release_frame(eng->capturer_path, &audio_frame);
+        }
+        if (eng->vad.is_speaking) {
+            audio_vad_reset(&eng->vad);
+            report_speaking(eng, false);
+        }
+        return false;
+    }
+    bool is_publishing = atomic_load_explicit(&eng->is_publishing, memory_order_relaxed);
+    bool sent = false;
+    while (esp_capture_sink_acquire_frame(eng->capturer_path, &audio_frame, !wait) == ESP_CAPTURE_ERR_OK) {
+        sent = true;
+        wait = false;
+        if (!is_publishing) {
+            // Until tracks are published, only the PCM is kept.
+            _media_stream_take_pcm(eng, false);
+            esp_capture_sink_release_frame(eng->capturer_path, &audio_frame);
+            continue;
+        }
+        if (!_media_stream_gate_audio(eng)) {
+            esp_capture_sink_release_frame(eng->capturer_path, &audio_frame);
+            continue;
+        }
         esp_peer_audio_frame_t audio_send_frame = {
             .pts = audio_frame.pts,
             .data = audio_frame.data,
             .size = audio_frame.size,
         };
-        peer_send_audio(eng->pub_peer_handle, &audio_send_frame);
+        record_pub_latency(eng, &eng->pub_audio_latency, audio_frame.pts);
+        if (peer_send_audio(eng->pub_peer_handle, &audio_send_frame) == PEER_ERR_NONE) {
+            timeline_mark(eng, LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_SENT);
+            COUNTER_ADD(eng->counters.audio_frames_sent, 1);
+            BYTE_COUNT_ADD(eng, audio_sent, audio_frame.size);
+        } else {
+            COUNTER_ADD(eng->counters.capture_send_failures, 1);
+        }
         esp_capture_sink_release_frame(eng->capturer_path, &audio_frame);
     }
+    return sent;
 }
 
 /// Captures and sends a single video frame over the peer connection.
+///
+/// If `wait` is true, blocks until the frame is available.
+///
+/// @returns Whether a frame was sent.
+///
 __attribute__((always_inline))
-static inline void _media_stream_send_video(engine_t *eng)
+static inline bool _media_stream_send_video(engine_t *eng, bool wait)
 {
+    bool send = false;
+    esp_capture_sink_handle_t path = video_layers_get_path(eng->video_layers, &send);
+    if (path == NULL) {
+        // Paused, no video is captured.
+        return false;
+    }
     esp_capture_stream_frame_t video_frame = {
         .stream_type = ESP_CAPTURE_STREAM_TYPE_VIDEO,
     };
-    if (esp_capture_sink_acquire_frame(eng->capturer_path, &video_frame, true) == ESP_CAPTURE_ERR_OK) {
+    if (esp_capture_sink_acquire_frame(path, &video_frame, !wait) == ESP_CAPTURE_ERR_OK) {
+        if (!send || !atomic_load_explicit(&eng->is_publishing, memory_order_relaxed)) {
+            // Paused or not yet published, but the path may also capture audio and
+            // must be drained.
+            esp_capture_sink_release_frame(path, &video_frame);
+            return true;
+        }
         esp_peer_video_frame_t video_send_frame = {
             .pts = video_frame.pts,
             .data = video_frame.data,
             .size = video_frame.size,
         };
-        peer_send_video(eng->pub_peer_handle, &video_send_frame);
-        esp_capture_sink_release_frame(eng->capturer_path, &video_frame);
+        if (peer_send_video(eng->pub_peer_handle, &video_send_frame) == PEER_ERR_NONE) {
+            COUNTER_ADD(eng->counters.video_frames_sent, 1);
+            BYTE_COUNT_ADD(eng, video_sent, video_frame.size);
+        } else {
+            COUNTER_ADD(eng->counters.capture_send_failures, 1);
+        }
+        esp_capture_sink_release_frame(path, &video_frame);
+        return true;
     }
+    return false;
 }
 
 static void media_stream_task(void *arg)
 {
     engine_t *eng = (engine_t *)arg;
+    bool has_audio = eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE;
+    bool has_video = eng->options.media.video_info.codec != ESP_PEER_VIDEO_CODEC_NONE;
     while (eng->is_media_streaming) {
-        if (eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE) {
-            _media_stream_send_audio(eng);
+#if CONFIG_LK_PUB_EVENT_DRIVEN
+        // Block on the stream that paces publishing (audio if present) and send
+        // any pending frames of the other stream after each wakeup.
+        bool sent = has_audio ?
+            _media_stream_send_audio(eng, true) :
+            _media_stream_send_video(eng, true);
+        if (has_audio && has_video) {
+            _media_stream_send_video(eng, false);
+        }
+        if (!sent && eng->is_media_streaming) {
+            // Capture is not producing frames; avoid spinning.
+            media_lib_thread_sleep(CONFIG_LK_PUB_INTERVAL_MS);
         }
-        if (eng->options.media.video_info.codec != ESP_PEER_VIDEO_CODEC_NONE) {
-            _media_stream_send_video(eng);
+#else
+        if (has_audio) {
+            _media_stream_send_audio(eng, false);
+        }
+        if (has_video) {
+            _media_stream_send_video(eng, false);
         }
         media_lib_thread_sleep(CONFIG_LK_PUB_INTERVAL_MS);
+#endif
     }
     media_lib_thread_destroy(NULL);
 }
 
 static engine_err_t media_stream_begin(engine_t *eng)
 {
+    atomic_store_explicit(&eng->pub_audio_latency.is_reset_pending, true, memory_order_release);
+    audio_vad_reset(&eng->vad);
+    if (eng->video_layers != NULL) {
+        // Subscribers of the new session have not requested any qualities yet.
+        video_layers_reset(eng->video_layers);
+    }
+    eng->capture_start_ms = esp_timer_get_time() / 1000;
     if (esp_capture_start(eng->options.media.capturer) != ESP_CAPTURE_ERR_OK) {
         ESP_LOGE(TAG, "Failed to start capture");
         return ENGINE_ERR_MEDIA;
     }
     media_lib_thread_handle_t handle = NULL;
+    atomic_store(&eng->is_publishing, false);
     eng->is_media_streaming = true;
     if (media_lib_thread_create_from_scheduler(&handle, "lk_eng_stream", media_stream_task, eng) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to create media stream thread");
@@ -285,91 +1028,299 @@ static engine_err_t media_stream_begin(engine_t *eng)
     return ENGINE_ERR_NONE;
 }
 
-static engine_err_t media_stream_end(engine_t *eng)
+static engine_err_t media_stream_end(engine_t *eng)
+{
+    if (!eng->is_media_streaming) {
+        return ENGINE_ERR_NONE;
+    }
+    eng->is_media_streaming = false;
+    atomic_store(&eng->is_publishing, false);
+    esp_capture_stop(eng->options.media.capturer);
+    pre_connect_end(eng);
+    return ENGINE_ERR_NONE;
+}
+
+static engine_err_t send_add_audio_track(engine_t *eng)
+{
+    livekit_pb_add_track_request_t req = {
+        .cid = "a0",
+        .name = CONFIG_LK_PUB_AUDIO_TRACK_NAME,
+        .type = LIVEKIT_PB_TRACK_TYPE_AUDIO,
+        .source = LIVEKIT_PB_TRACK_SOURCE_MICROPHONE,
+        .muted = atomic_load(&eng->is_audio_muted),
+        .audio_features_count = 0,
+        .layers_count = 0
+    };
+    if (eng->options.media.audio_info.channel == 2) {
+        req.audio_features[req.audio_features_count++] = LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_STEREO;
+    }
+    if (pre_connect_is_capturing(eng)) {
+        // Tells the agent to wait for the pre-connect audio.
+        req.audio_features[req.audio_features_count++] = LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_PRECONNECT_BUFFER;
+    }
+
+    if (signal_send_add_track(eng->signal_handle, &req) != SIGNAL_ERR_NONE) {
+        ESP_LOGE(TAG, "Failed to publish audio track");
+        return ENGINE_ERR_SIGNALING;
+    }
+    return ENGINE_ERR_NONE;
+}
+
+static engine_err_t send_add_video_track(engine_t *eng)
+{
+    livekit_pb_add_track_request_t req = {
+        .cid = "v0",
+        .name = CONFIG_LK_PUB_VIDEO_TRACK_NAME,
+        .type = LIVEKIT_PB_TRACK_TYPE_VIDEO,
+        .source = LIVEKIT_PB_TRACK_SOURCE_CAMERA,
+        .muted = eng->is_video_muted,
+        .layers_count = 1,
+        .layers = {{
+            .quality = LIVEKIT_PB_VIDEO_QUALITY_HIGH,
+            .width = eng->options.media.video_info.width,
+            .height = eng->options.media.video_info.height
+        }},
+        .audio_features_count = 0
+    };
+
+    if (signal_send_add_track(eng->signal_handle, &req) != SIGNAL_ERR_NONE) {
+        ESP_LOGE(TAG, "Failed to publish video track");
+        return ENGINE_ERR_SIGNALING;
+    }
+    return ENGINE_ERR_NONE;
+}
+
+/// Begins media streaming if not already started and sends add track requests.
+static engine_err_t publish_tracks(engine_t *eng)
+{
+    if (eng->options.media.audio_info.codec == ESP_PEER_AUDIO_CODEC_NONE &&
+        eng->options.media.video_info.codec == ESP_PEER_VIDEO_CODEC_NONE) {
+        ESP_LOGI(TAG, "No media tracks to publish");
+        return ENGINE_ERR_NONE;
+    }
+
+    int ret = ENGINE_ERR_OTHER;
+    do {
+        // Capture may have started early for pre-connect audio.
+        if (!eng->is_media_streaming && media_stream_begin(eng) != ENGINE_ERR_NONE) {
+            ret = ENGINE_ERR_MEDIA;
+            break;
+        }
+        atomic_store(&eng->is_publishing, true);
+        if (eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE &&
+            send_add_audio_track(eng) != ENGINE_ERR_NONE) {
+            ret = ENGINE_ERR_SIGNALING;
+            break;
+        }
+        if (eng->options.media.video_info.codec != ESP_PEER_VIDEO_CODEC_NONE &&
+            send_add_video_track(eng) != ENGINE_ERR_NONE) {
+            ret = ENGINE_ERR_SIGNALING;
+            break;
+        }
+        return ENGINE_ERR_NONE;
+    } while (0);
+
+    media_stream_end(eng);
+    return ret;
+}
+
+/// Tells the server whether a published track is muted, if the track has been
+/// published and the server was last told otherwise.
+static void sync_pub_track_muted(engine_t *eng, pub_track_t *track, bool muted)
+{
+    if (track->sid[0] == '\0' || track->is_muted == muted) {
+        return;
+    }
+    if (signal_send_mute_track(eng->signal_handle, track->sid, muted) != SIGNAL_ERR_NONE) {
+        ESP_LOGE(TAG, "Failed to send mute request: sid=%s", track->sid);
+        return;
+    }
+    track->is_muted = muted;
+}
+
+/// Tells the server the mute state of all published tracks.
+static void sync_pub_tracks_muted(engine_t *eng)
+{
+    sync_pub_track_muted(eng, &eng->session.pub_audio_track, atomic_load(&eng->is_audio_muted));
+    sync_pub_track_muted(eng, &eng->session.pub_video_track, eng->is_video_muted);
+}
+
+/// Mutes or unmutes a published track, suspending its capture while muted.
+static void set_track_muted(engine_t *eng, livekit_pb_track_type_t type, bool muted)
+{
+    if (type == LIVEKIT_PB_TRACK_TYPE_AUDIO) {
+        atomic_store(&eng->is_audio_muted, muted);
+        if (eng->video_layers != NULL) {
+            // Path 0 also captures video, which decides whether it keeps running.
+            video_layers_set_base_path_shared(eng->video_layers, !muted);
+        } else if (esp_capture_sink_enable(
+            eng->capturer_path,
+            muted ? ESP_CAPTURE_RUN_MODE_DISABLE : ESP_CAPTURE_RUN_MODE_ALWAYS
+        ) != ESP_CAPTURE_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to %s audio capture", muted ? "suspend" : "resume");
+        }
+        sync_pcm_path(eng);
+    } else {
+        eng->is_video_muted = muted;
+        video_layers_set_muted(eng->video_layers, muted);
+    }
+    ESP_LOGI(TAG, "%s %s track", muted ? "Muted" : "Unmuted",
+        type == LIVEKIT_PB_TRACK_TYPE_AUDIO ? "audio" : "video");
+    if (eng->state == ENGINE_STATE_CONNECTED) {
+        sync_pub_tracks_muted(eng);
+    }
+}
+
+static void handle_track_published(engine_t *eng, livekit_pb_track_published_response_t *published)
+{
+    if (!published->has_track || published->track.sid == NULL) {
+        return;
+    }
+    // Only one track of each type is published.
+    pub_track_t *track = published->track.type == LIVEKIT_PB_TRACK_TYPE_AUDIO ?
+        &eng->session.pub_audio_track : &eng->session.pub_video_track;
+    strncpy(track->sid, published->track.sid, sizeof(track->sid) - 1);
+    track->is_muted = published->track.muted;
+    ESP_LOGI(TAG, "Track published: cid=%s, sid=%s", published->cid, track->sid);
+
+    // The track may have been muted or unmuted since it was added.
+    sync_pub_tracks_muted(eng);
+    pre_connect_flush(eng);
+}
+
+// MARK: - Reliable data
+
+/// Sends buffered reliable data packets in order.
+///
+/// Stops at the first packet that cannot be sent and starts the retry timer, so
+/// the rest are not left waiting for the next packet or connection.
+///
+/// @note The caller must hold `reliable_lock`.
+/// @returns Whether the buffer is empty.
+///
+static bool send_pending_reliable_packets(engine_t *eng)
+{
+    if (eng->reliable_mode != RELIABLE_MODE_SEND) {
+        return eng->reliable_buffer.count == 0;
+    }
+    const uint8_t *data;
+    size_t size;
+    while (reliable_buffer_peek(&eng->reliable_buffer, &data, &size)) {
+        if (eng->pub_peer_handle == NULL ||
+            peer_send_encoded_data_packet(eng->pub_peer_handle, data, size, true) != PEER_ERR_NONE) {
+            xTimerStart(eng->reliable_retry_timer, 0);
+            return false;
+        }
+        reliable_buffer_pop(&eng->reliable_buffer);
+        COUNTER_ADD(eng->counters.reliable_packets_sent, 1);
+    }
+    return true;
+}
+
+static void flush_reliable_buffer(engine_t *eng)
 {
-    if (!eng->is_media_streaming) {
-        return ENGINE_ERR_NONE;
+    if (xSemaphoreTake(eng->reliable_lock, portMAX_DELAY) != pdTRUE) {
+        return;
     }
-    eng->is_media_streaming = false;
-    esp_capture_stop(eng->options.media.capturer);
-    return ENGINE_ERR_NONE;
+    send_pending_reliable_packets(eng);
+    xSemaphoreGive(eng->reliable_lock);
 }
 
-static engine_err_t send_add_audio_track(engine_t *eng)
+/// Sets how reliable data packets are handled in the state about to be entered.
+///
+/// Unsent packets are dropped in the same critical section as packets stop being
+/// accepted, so none are left for a later connection.
+///
+static void set_reliable_mode(engine_t *eng, engine_state_t state)
 {
-    bool is_stereo = eng->options.media.audio_info.channel == 2;
-    livekit_pb_add_track_request_t req = {
-        .cid = "a0",
-        .name = CONFIG_LK_PUB_AUDIO_TRACK_NAME,
-        .type = LIVEKIT_PB_TRACK_TYPE_AUDIO,
-        .source = LIVEKIT_PB_TRACK_SOURCE_MICROPHONE,
-        .muted = false,
-        .audio_features_count = is_stereo ? 1 : 0,
-        .audio_features = { LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_STEREO },
-        .layers_count = 0
-    };
-
-    if (signal_send_add_track(eng->signal_handle, &req) != SIGNAL_ERR_NONE) {
-        ESP_LOGE(TAG, "Failed to publish audio track");
-        return ENGINE_ERR_SIGNALING;
+    reliable_mode_t mode;
+    switch (state) {
+        case ENGINE_STATE_CONNECTED:
+            mode = RELIABLE_MODE_SEND;
+            break;
+        case ENGINE_STATE_BACKOFF:
+            mode = RELIABLE_MODE_BUFFER;
+            break;
+        case ENGINE_STATE_CONNECTING:
+            mode = eng->retry_count > 0 ? RELIABLE_MODE_BUFFER : RELIABLE_MODE_REJECT;
+            break;
+        default:
+            mode = RELIABLE_MODE_REJECT;
+            break;
     }
-    return ENGINE_ERR_NONE;
+    xSemaphoreTake(eng->reliable_lock, portMAX_DELAY);
+    eng->reliable_mode = mode;
+    if (mode == RELIABLE_MODE_REJECT) {
+        reliable_buffer_clear(&eng->reliable_buffer);
+    }
+    xSemaphoreGive(eng->reliable_lock);
 }
 
-static engine_err_t send_add_video_track(engine_t *eng)
+/// Sends a reliable data packet too large for the buffer right away.
+///
+/// Buffered packets are sent first so packets stay in order. The packet is not
+/// sent if they can't be or if the engine is not connected.
+///
+/// @note The caller must hold `reliable_lock`.
+///
+static engine_err_t send_unbuffered_reliable_packet(engine_t *eng, const livekit_pb_data_packet_t *packet, size_t encoded_size)
 {
-    livekit_pb_video_layer_t video_layer = {
-        .quality = LIVEKIT_PB_VIDEO_QUALITY_HIGH,
-        .width = eng->options.media.video_info.width,
-        .height = eng->options.media.video_info.height
-    };
-    livekit_pb_add_track_request_t req = {
-        .cid = "v0",
-        .name = CONFIG_LK_PUB_VIDEO_TRACK_NAME,
-        .type = LIVEKIT_PB_TRACK_TYPE_VIDEO,
-        .source = LIVEKIT_PB_TRACK_SOURCE_CAMERA,
-        .muted = false,
-        .layers_count = 1,
-        .layers = { video_layer },
-        .audio_features_count = 0
-    };
-
-    if (signal_send_add_track(eng->signal_handle, &req) != SIGNAL_ERR_NONE) {
-        ESP_LOGE(TAG, "Failed to publish video track");
-        return ENGINE_ERR_SIGNALING;
+    if (eng->reliable_mode != RELIABLE_MODE_SEND || !send_pending_reliable_packets(eng)) {
+        ESP_LOGE(TAG, "Reliable packet exceeds buffer size and can't be sent now: size=%zu", encoded_size);
+        return ENGINE_ERR_OTHER;
+    }
+    ESP_LOGW(TAG, "Reliable packet exceeds buffer size, sending without buffering: size=%zu", encoded_size);
+    if (peer_send_data_packet(eng->pub_peer_handle, packet, true) != PEER_ERR_NONE) {
+        return ENGINE_ERR_RTC;
     }
+    COUNTER_ADD(eng->counters.reliable_packets_sent, 1);
     return ENGINE_ERR_NONE;
 }
 
-/// Begins media streaming and sends add track requests.
-static engine_err_t publish_tracks(engine_t *eng)
+/// Assigns the next sequence number to a reliable data packet and adds it to the buffer.
+///
+/// A packet too large for the buffer is sent right away instead, if connected.
+///
+static engine_err_t buffer_reliable_packet(engine_t *eng, const livekit_pb_data_packet_t *packet)
 {
-    if (eng->options.media.audio_info.codec == ESP_PEER_AUDIO_CODEC_NONE &&
-        eng->options.media.video_info.codec == ESP_PEER_VIDEO_CODEC_NONE) {
-        ESP_LOGI(TAG, "No media tracks to publish");
-        return ENGINE_ERR_NONE;
+    if (xSemaphoreTake(eng->reliable_lock, portMAX_DELAY) != pdTRUE) {
+        return ENGINE_ERR_OTHER;
     }
-
-    int ret = ENGINE_ERR_OTHER;
+    int ret = ENGINE_ERR_NONE;
     do {
-        if (media_stream_begin(eng) != ENGINE_ERR_NONE) {
-            ret = ENGINE_ERR_MEDIA;
+        if (eng->reliable_mode == RELIABLE_MODE_REJECT) {
+            ret = ENGINE_ERR_OTHER;
             break;
         }
-        if (eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE &&
-            send_add_audio_track(eng) != ENGINE_ERR_NONE) {
-            ret = ENGINE_ERR_SIGNALING;
+        livekit_pb_data_packet_t sequenced = *packet;
+        sequenced.sequence = eng->reliable_sequence + 1;
+
+        size_t encoded_size = protocol_data_packet_encoded_size(&sequenced);
+        if (encoded_size == 0) {
+            ret = ENGINE_ERR_OTHER;
             break;
         }
-        if (eng->options.media.video_info.codec != ESP_PEER_VIDEO_CODEC_NONE &&
-            send_add_video_track(eng) != ENGINE_ERR_NONE) {
-            ret = ENGINE_ERR_SIGNALING;
+        if (!reliable_buffer_fits(&eng->reliable_buffer, encoded_size)) {
+            ret = send_unbuffered_reliable_packet(eng, &sequenced, encoded_size);
+            if (ret == ENGINE_ERR_NONE) {
+                eng->reliable_sequence = sequenced.sequence;
+            }
             break;
         }
-        return ENGINE_ERR_NONE;
+        uint8_t *dest = reliable_buffer_reserve(&eng->reliable_buffer, encoded_size);
+        if (dest == NULL) {
+            ret = ENGINE_ERR_NO_MEM;
+            break;
+        }
+        if (!protocol_data_packet_encode(&sequenced, dest, encoded_size)) {
+            ret = ENGINE_ERR_OTHER;
+            break;
+        }
+        reliable_buffer_commit(&eng->reliable_buffer, encoded_size);
+        eng->reliable_sequence = sequenced.sequence;
     } while (0);
 
-    media_stream_end(eng);
+    xSemaphoreGive(eng->reliable_lock);
     return ret;
 }
 
@@ -378,6 +1329,9 @@ static engine_err_t publish_tracks(engine_t *eng)
 static void on_signal_state_changed(signal_state_t state, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
+    if (state == SIGNAL_STATE_CONNECTED) {
+        timeline_mark(eng, LIVEKIT_CONNECT_PHASE_SIGNAL_CONNECTED);
+    }
     engine_event_t ev = {
         .type = EV_SIG_STATE,
         .detail.sig_state = state
@@ -388,9 +1342,23 @@ static void on_signal_state_changed(signal_state_t state, void *ctx)
 static bool on_signal_res(livekit_pb_signal_response_t *res, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
+    // Timed on receipt rather than once processed by the engine task.
+    switch (res->which_message) {
+        case LIVEKIT_PB_SIGNAL_RESPONSE_JOIN_TAG:
+            timeline_mark(eng, LIVEKIT_CONNECT_PHASE_JOIN_RECEIVED);
+            break;
+        case LIVEKIT_PB_SIGNAL_RESPONSE_ANSWER_TAG:
+            timeline_mark(eng, LIVEKIT_CONNECT_PHASE_ANSWER_RECEIVED);
+            break;
+        case LIVEKIT_PB_SIGNAL_RESPONSE_TRICKLE_TAG:
+            timeline_mark(eng, LIVEKIT_CONNECT_PHASE_FIRST_CANDIDATE);
+            break;
+        default:
+            break;
+    }
     engine_event_t ev = {
         .type = EV_SIG_RES,
-        .detail.res = *res
+        .detail.res = res
     };
     // Returning true takes ownership of the response; it will be freed later when the
     // queue is processed or flushed.
@@ -403,6 +1371,9 @@ static bool on_signal_res(livekit_pb_signal_response_t *res, void *ctx)
 static void on_peer_state_changed(connection_state_t state, peer_role_t role, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
+    if (state == CONNECTION_STATE_CONNECTED && role == PEER_ROLE_PUBLISHER) {
+        timeline_mark(eng, LIVEKIT_CONNECT_PHASE_DATA_CHANNELS_OPEN);
+    }
     engine_event_t ev = {
         .type = EV_PEER_STATE,
         .detail.peer_state = { .state = state, .role = role }
@@ -410,6 +1381,20 @@ static void on_peer_state_changed(connection_state_t state, peer_role_t role, vo
     event_enqueue(eng, &ev, true);
 }
 
+static void on_peer_rtc_state_changed(esp_peer_state_t state, peer_role_t role, void *ctx)
+{
+    engine_t *eng = (engine_t *)ctx;
+    bool is_primary = (role == PEER_ROLE_SUBSCRIBER) == eng->session.is_subscriber_primary;
+    if (!is_primary) {
+        return;
+    }
+    if (state == ESP_PEER_STATE_PAIRED) {
+        timeline_mark(eng, LIVEKIT_CONNECT_PHASE_ICE_CONNECTED);
+    } else if (state == ESP_PEER_STATE_CONNECTED) {
+        timeline_mark(eng, LIVEKIT_CONNECT_PHASE_DTLS_CONNECTED);
+    }
+}
+
 static void on_peer_sdp(const char *sdp, peer_role_t role, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
@@ -417,19 +1402,38 @@ static void on_peer_sdp(const char *sdp, peer_role_t role, void *ctx)
         .type = EV_PEER_SDP,
         .detail.peer_sdp = { .sdp = strdup(sdp), .role = role }
     };
-    event_enqueue(eng, &ev, false);
+    if (!event_enqueue(eng, &ev, false)) {
+        event_free(&ev);
+    }
 }
 
-static bool on_peer_data_packet(livekit_pb_data_packet_t* packet, void *ctx)
+static bool on_peer_data_packet(livekit_pb_data_packet_t* packet, bool reliable, void *ctx)
 {
     engine_t *eng = (engine_t *)ctx;
-    // TODO: Implement buffering for incoming data packets
-    if (eng->options.on_data_packet) {
-        eng->options.on_data_packet(packet, eng->options.ctx);
+    if (reliable) {
+        COUNTER_ADD(eng->counters.reliable_packets_received, 1);
+    } else {
+        COUNTER_ADD(eng->counters.lossy_packets_received, 1);
+    }
+    if (eng->options.on_data_packet == NULL) {
+        return false;
+    }
+    // Handlers run on the dispatch task so they can't stall the peer's connection loop.
+    if (data_dispatch_enqueue(eng->data_dispatch, packet, reliable)) {
+        return true;
+    }
+    if (reliable && eng->options.on_data_dropped != NULL) {
+        eng->options.on_data_dropped(eng->options.ctx);
     }
     return false;
 }
 
+static void on_dispatch_data_packet(livekit_pb_data_packet_t* packet, void *ctx)
+{
+    engine_t *eng = (engine_t *)ctx;
+    eng->options.on_data_packet(packet, eng->options.ctx);
+}
+
 // MARK: - Timer expired handler
 
 static void on_timer_expired(TimerHandle_t timer)
@@ -439,6 +1443,13 @@ static void on_timer_expired(TimerHandle_t timer)
     event_enqueue(eng, &ev, true);
 }
 
+static void on_reliable_retry_timer_expired(TimerHandle_t timer)
+{
+    engine_t *eng = (engine_t *)pvTimerGetTimerID(timer);
+    engine_event_t ev = { .type = EV_RELIABLE_RETRY };
+    event_enqueue(eng, &ev, false);
+}
+
 // MARK: - Peer lifecycle
 
 static inline void _create_and_connect_peer(peer_options_t *options, peer_handle_t *peer)
@@ -461,7 +1472,10 @@ static inline void _disconnect_and_destroy_peer(peer_handle_t *peer)
 
 static void destroy_peer_connections(engine_t *eng)
 {
+    // Holding the lock ensures the publisher isn't in use by a sender.
+    xSemaphoreTake(eng->reliable_lock, portMAX_DELAY);
     _disconnect_and_destroy_peer(&eng->pub_peer_handle);
+    xSemaphoreGive(eng->reliable_lock);
     _disconnect_and_destroy_peer(&eng->sub_peer_handle);
 }
 
@@ -515,15 +1529,16 @@ static bool establish_peer_connections(engine_t *eng, livekit_pb_join_response_t
     }
 
     peer_options_t options = {
-        .force_relay      = join->client_configuration.force_relay
+        .force_relay          = join->client_configuration.force_relay
             == LIVEKIT_PB_CLIENT_CONFIG_SETTING_ENABLED,
-        .media            = &eng->options.media,
-        .server_list      = server_list,
-        .server_count     = server_count,
-        .on_state_changed = on_peer_state_changed,
-        .on_sdp           = on_peer_sdp,
-        .on_data_packet   = on_peer_data_packet,
-        .ctx              = eng
+        .media                = &eng->options.media,
+        .server_list          = server_list,
+        .server_count         = server_count,
+        .on_state_changed     = on_peer_state_changed,
+        .on_rtc_state_changed = on_peer_rtc_state_changed,
+        .on_sdp               = on_peer_sdp,
+        .on_data_packet       = on_peer_data_packet,
+        .ctx                  = eng
     };
 
     // 1. Publisher
@@ -536,6 +1551,7 @@ static bool establish_peer_connections(engine_t *eng, livekit_pb_join_response_t
     options.role           = PEER_ROLE_SUBSCRIBER;
     options.on_audio_info  = on_peer_sub_audio_info;
     options.on_audio_frame = on_peer_sub_audio_frame;
+    options.on_video_frame = on_peer_sub_video_frame;
 
     _create_and_connect_peer(&options, &eng->sub_peer_handle);
     if (eng->sub_peer_handle == NULL) {
@@ -625,7 +1641,8 @@ static void event_free(engine_event_t *ev)
             SAFE_FREE(ev->detail.cmd_connect.token);
             break;
         case EV_SIG_RES:
-            protocol_signal_response_free(&ev->detail.res);
+            protocol_signal_response_free(ev->detail.res);
+            ev->detail.res = NULL;
             break;
         case EV_PEER_SDP:
             SAFE_FREE(ev->detail.peer_sdp.sdp);
@@ -634,24 +1651,53 @@ static void event_free(engine_event_t *ev)
     }
 }
 
+/// Returns an event to the pool.
+///
+/// The event's dynamically allocated fields must already have been freed or
+/// had their ownership transferred.
+///
+static inline void event_release(engine_t *eng, engine_event_t *ev)
+{
+    xQueueSend(eng->free_events, &ev, 0);
+}
+
 /// Enqueues an event.
-static bool event_enqueue(engine_t *eng, engine_event_t *ev, bool send_to_front)
+///
+/// The event is copied into a slot from the event pool. On success, ownership of its
+/// dynamically allocated fields passes to the queue; otherwise, it remains with the caller.
+///
+static bool event_enqueue(engine_t *eng, const engine_event_t *ev, bool send_to_front)
 {
+    engine_event_t *slot = NULL;
+    if (xQueueReceive(eng->free_events, &slot, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Event pool exhausted: type=%d", ev->type);
+        return false;
+    }
+    *slot = *ev;
     bool enqueued = (send_to_front ?
-        xQueueSendToFront(eng->event_queue, ev, 0) :
-        xQueueSend(eng->event_queue, ev, 0)) == pdPASS;
+        xQueueSendToFront(eng->event_queue, &slot, 0) :
+        xQueueSend(eng->event_queue, &slot, 0)) == pdPASS;
     if (!enqueued) {
         ESP_LOGE(TAG, "Failed to enqueue event: type=%d", ev->type);
+        event_release(eng, slot);
+        return false;
     }
-    return enqueued;
+    // Events taken from the pool are either queued or being processed.
+    uint32_t depth = CONFIG_LK_ENGINE_QUEUE_SIZE - uxQueueMessagesWaiting(eng->free_events);
+    uint32_t high_water = atomic_load_explicit(&eng->counters.queue_high_water, memory_order_relaxed);
+    while (depth > high_water &&
+           !atomic_compare_exchange_weak_explicit(&eng->counters.queue_high_water,
+                &high_water, depth, memory_order_relaxed, memory_order_relaxed)) {}
+    return true;
 }
 
 /// Dequeues all events from the queue and frees them.
 static void flush_event_queue(engine_t *eng)
 {
-    engine_event_t ev;
+    engine_event_t *ev;
     while (xQueueReceive(eng->event_queue, &ev, 0) == pdPASS) {
-        event_free(&ev);
+        event_free(ev);
+        event_release(eng, ev);
     }
 }
 
@@ -701,19 +1747,33 @@ static bool handle_join(engine_t *eng, livekit_pb_join_response_t *join)
         ESP_LOGE(TAG, "Failed to establish peer connections");
         return false;
     }
+    timeline_mark(eng, LIVEKIT_CONNECT_PHASE_PEERS_CREATED);
+
+    // 6. Subscribe to tracks already published
+    for (pb_size_t i = 0; i < join->other_participants_count; i++) {
+        subscribe_tracks(eng, &join->other_participants[i]);
+        pre_connect_find_agent(eng, &join->other_participants[i]);
+    }
     return true;
 }
 
 static void handle_trickle(engine_t *eng, livekit_pb_trickle_request_t *trickle)
 {
-    char* candidate = NULL;
-    if (!protocol_signal_trickle_get_candidate(trickle, &candidate)) {
+    protocol_ice_candidate_t ice;
+    if (!protocol_signal_trickle_get_candidate(trickle, &ice)) {
+        return;
+    }
+    // The engine owns the response until it is freed, so rather than copying the
+    // candidate, it is unescaped and terminated within `candidate_init` (overwriting
+    // its closing quote).
+    char *candidate = trickle->candidate_init + (ice.candidate - trickle->candidate_init);
+    if (!protocol_json_string_copy(ice.candidate, ice.candidate_len, candidate, ice.candidate_len + 1)) {
+        ESP_LOGE(TAG, "Invalid ICE candidate");
         return;
     }
     peer_handle_t target_peer = trickle->target == LIVEKIT_PB_SIGNAL_TARGET_PUBLISHER ?
         eng->pub_peer_handle : eng->sub_peer_handle;
     peer_handle_ice_candidate(target_peer, candidate);
-    free(candidate);
 }
 
 static void handle_room_update(engine_t *eng, livekit_pb_room_update_t *room_update)
@@ -736,7 +1796,8 @@ static void handle_participant_update(engine_t *eng, livekit_pb_participant_upda
         if (is_local) {
             found_local = true;
         } else {
-            subscribe_tracks(eng, participant->tracks, participant->tracks_count);
+            subscribe_tracks(eng, participant);
+            pre_connect_find_agent(eng, participant);
         }
         if (eng->options.on_participant_info) {
             eng->options.on_participant_info(participant, is_local, eng->options.ctx);
@@ -744,6 +1805,22 @@ static void handle_participant_update(engine_t *eng, livekit_pb_participant_upda
     }
 }
 
+/// Handles a leave request, transitioning to the state given by its action.
+static void handle_leave(engine_t *eng, livekit_pb_leave_request_t *leave)
+{
+    eng->failure_reason = map_disconnect_reason(leave->reason);
+    switch (leave->action) {
+        case LIVEKIT_PB_LEAVE_REQUEST_ACTION_RESUME:
+        case LIVEKIT_PB_LEAVE_REQUEST_ACTION_RECONNECT:
+            // Sessions are not resumed; both are handled with a full reconnect.
+            eng->state = ENGINE_STATE_BACKOFF;
+            break;
+        default:
+            eng->state = ENGINE_STATE_DISCONNECTED;
+            break;
+    }
+}
+
 /// Cleans up resources and state from the previous connection.
 static void cleanup_previous_connection(engine_t *eng)
 {
@@ -769,6 +1846,8 @@ static bool handle_state_disconnected(engine_t *eng, const engine_event_t *ev)
             eng->server_url = ev->detail.cmd_connect.server_url;
             eng->token = ev->detail.cmd_connect.token;
             eng->failure_reason = LIVEKIT_FAILURE_REASON_NONE;
+            eng->connect_attempts = 0;
+            pre_connect_begin(eng);
             eng->state = ENGINE_STATE_CONNECTING;
             return true;
         default:
@@ -784,7 +1863,10 @@ static bool handle_state_connecting(engine_t *eng, const engine_event_t *ev)
 {
     switch (ev->type) {
         case _EV_STATE_ENTER:
-            signal_connect(eng->signal_handle, eng->server_url, eng->token);
+            timeline_begin(eng);
+            if (signal_connect(eng->signal_handle, eng->server_url, eng->token) == SIGNAL_ERR_NONE) {
+                timeline_mark(eng, LIVEKIT_CONNECT_PHASE_URL_BUILT);
+            }
             break;
         case EV_CMD_CLOSE:
             signal_send_leave(eng->signal_handle);
@@ -794,12 +1876,11 @@ static bool handle_state_connecting(engine_t *eng, const engine_event_t *ev)
             ESP_LOGW(TAG, "Engine already connecting, ignoring connect command");
             break;
         case EV_SIG_RES:
-            livekit_pb_signal_response_t *res = &ev->detail.res;
+            livekit_pb_signal_response_t *res = ev->detail.res;
             switch (res->which_message) {
                 case LIVEKIT_PB_SIGNAL_RESPONSE_LEAVE_TAG:
                     livekit_pb_leave_request_t *leave = &res->message.leave;
-                    eng->failure_reason = map_disconnect_reason(leave->reason);
-                    eng->state = ENGINE_STATE_DISCONNECTED;
+                    handle_leave(eng, leave);
                     break;
                 case LIVEKIT_PB_SIGNAL_RESPONSE_ROOM_UPDATE_TAG:
                     livekit_pb_room_update_t *room_update = &res->message.room_update;
@@ -866,10 +1947,12 @@ static bool handle_state_connecting(engine_t *eng, const engine_event_t *ev)
             const char *sdp = ev->detail.peer_sdp.sdp;
             peer_role_t sdp_role = ev->detail.peer_sdp.role;
             if (sdp_role == PEER_ROLE_PUBLISHER) {
-                signal_send_offer(eng->signal_handle, sdp);
-            } else {
-                signal_send_answer(eng->signal_handle, sdp);
+                if (signal_send_offer(eng->signal_handle, sdp) == SIGNAL_ERR_NONE) {
+                    timeline_mark(eng, LIVEKIT_CONNECT_PHASE_OFFER_SENT);
+                }
+                break;
             }
+            signal_send_answer(eng->signal_handle, sdp);
             break;
         default:
             break;
@@ -886,7 +1969,12 @@ static bool handle_state_connected(engine_t *eng, const engine_event_t *ev)
         case _EV_STATE_ENTER:
             eng->retry_count = 0;
             eng->failure_reason = LIVEKIT_FAILURE_REASON_NONE;
+            ESP_LOGI(TAG, "Connected in %" PRId64 "ms: attempt=%" PRIu32,
+                (esp_timer_get_time() - eng->timeline.start_us) / 1000,
+                eng->timeline.attempt);
             publish_tracks(eng);
+            sync_pub_tracks_muted(eng);
+            flush_reliable_buffer(eng);
             break;
         case EV_CMD_CLOSE:
             signal_send_leave(eng->signal_handle);
@@ -896,12 +1984,11 @@ static bool handle_state_connected(engine_t *eng, const engine_event_t *ev)
             ESP_LOGW(TAG, "Engine already connected, ignoring connect command");
             break;
         case EV_SIG_RES:
-            livekit_pb_signal_response_t *res = &ev->detail.res;
-            switch (ev->detail.res.which_message) {
+            livekit_pb_signal_response_t *res = ev->detail.res;
+            switch (res->which_message) {
                 case LIVEKIT_PB_SIGNAL_RESPONSE_LEAVE_TAG:
                     livekit_pb_leave_request_t *leave = &res->message.leave;
-                    eng->failure_reason = map_disconnect_reason(leave->reason);
-                    eng->state = ENGINE_STATE_DISCONNECTED;
+                    handle_leave(eng, leave);
                     break;
                 case LIVEKIT_PB_SIGNAL_RESPONSE_ROOM_UPDATE_TAG:
                     livekit_pb_room_update_t *room_update = &res->message.room_update;
@@ -911,6 +1998,18 @@ static bool handle_state_connected(engine_t *eng, const engine_event_t *ev)
                     livekit_pb_participant_update_t *update = &res->message.update;
                     handle_participant_update(eng, update);
                     break;
+                case LIVEKIT_PB_SIGNAL_RESPONSE_TRACK_PUBLISHED_TAG:
+                    livekit_pb_track_published_response_t *track_published = &res->message.track_published;
+                    handle_track_published(eng, track_published);
+                    break;
+                case LIVEKIT_PB_SIGNAL_RESPONSE_SPEAKERS_CHANGED_TAG:
+                    livekit_pb_speakers_changed_t *speakers_changed = &res->message.speakers_changed;
+                    handle_speakers_changed(eng, speakers_changed);
+                    break;
+                case LIVEKIT_PB_SIGNAL_RESPONSE_SUBSCRIBED_QUALITY_UPDATE_TAG:
+                    livekit_pb_subscribed_quality_update_t *quality_update = &res->message.subscribed_quality_update;
+                    video_layers_handle_update(eng->video_layers, quality_update);
+                    break;
                 case LIVEKIT_PB_SIGNAL_RESPONSE_ANSWER_TAG:
                     livekit_pb_session_description_t *answer = &res->message.answer;
                     peer_handle_sdp(eng->pub_peer_handle, answer->sdp);
@@ -950,6 +2049,11 @@ static bool handle_state_connected(engine_t *eng, const engine_event_t *ev)
                     role == PEER_ROLE_PUBLISHER ? "Publisher" : "Subscriber");
                 eng->failure_reason = LIVEKIT_FAILURE_REASON_RTC;
                 eng->state = ENGINE_STATE_BACKOFF;
+                break;
+            }
+            // The publisher's data channels may open after the primary peer connects.
+            if (peer_state == CONNECTION_STATE_CONNECTED && role == PEER_ROLE_PUBLISHER) {
+                flush_reliable_buffer(eng);
             }
             break;
         case EV_PEER_SDP:
@@ -1018,39 +2122,72 @@ static inline bool handle_state(engine_t *eng, engine_event_t *ev, engine_state_
 
 // MARK: - FSM task
 
+/// Handles events that are processed the same in every state.
+///
+/// @returns Whether the event was handled; such events own no dynamically
+///          allocated fields.
+///
+static bool handle_any_state(engine_t *eng, const engine_event_t *ev)
+{
+    switch (ev->type) {
+        case EV_CMD_SET_MUTED:
+            // The mute state outlives sessions.
+            set_track_muted(eng, ev->detail.cmd_set_muted.type, ev->detail.cmd_set_muted.muted);
+            return true;
+        case EV_VAD_STATE:
+            if (eng->options.on_speaking_changed != NULL) {
+                eng->options.on_speaking_changed(ev->detail.is_speaking, eng->options.ctx);
+            }
+            return true;
+        case EV_RELIABLE_RETRY:
+            flush_reliable_buffer(eng);
+            return true;
+        default:
+            return false;
+    }
+}
+
 static void engine_task(void *arg)
 {
     engine_t *eng = (engine_t *)arg;
     while (eng->is_running) {
-        engine_event_t ev;
+        engine_event_t *ev;
         if (!xQueueReceive(eng->event_queue, &ev, portMAX_DELAY)) {
             ESP_LOGE(TAG, "Failed to receive event");
             continue;
         }
         // Internal events are not allowed to be enqueued.
-        assert(ev.type != _EV_STATE_ENTER && ev.type != _EV_STATE_EXIT);
-        ESP_LOGD(TAG, "Event: type=%d", ev.type);
+        assert(ev->type != _EV_STATE_ENTER && ev->type != _EV_STATE_EXIT);
+        ESP_LOGD(TAG, "Event: type=%d", ev->type);
 
         engine_state_t state = eng->state;
 
+        if (handle_any_state(eng, ev)) {
+            event_release(eng, ev);
+            continue;
+        }
+
         // Invoke the handler for the current state, passing the event that woke up the
-        // state machine. If the handler returns true, it takes ownership of the event
-        // and is responsible for freeing it, otherwise, it will be freed after the handler
-        // returns.
-        if (!handle_state(eng, &ev, state)) {
-            event_free(&ev);
+        // state machine. If the handler returns true, it takes ownership of the event's
+        // dynamically allocated fields and is responsible for freeing them, otherwise,
+        // they will be freed after the handler returns. Either way, the event itself
+        // is returned to the pool.
+        if (!handle_state(eng, ev, state)) {
+            event_free(ev);
         }
+        event_release(eng, ev);
 
         // If the state changed, invoke the exit handler for the old state,
         // the enter handler for the new state, and notify.
         if (eng->state != state) {
-            ESP_LOGD(TAG, "State changed: %d -> %d", state, eng->state);
+            engine_state_t new_state = eng->state;
+            ESP_LOGD(TAG, "State changed: %d -> %d", state, new_state);
 
-            state = eng->state;
             handle_state(eng, &(engine_event_t){ .type = _EV_STATE_EXIT }, state);
-            assert(eng->state == state);
-            handle_state(eng, &(engine_event_t){ .type = _EV_STATE_ENTER }, eng->state);
-            assert(eng->state == state);
+            assert(eng->state == new_state);
+            set_reliable_mode(eng, new_state);
+            handle_state(eng, &(engine_event_t){ .type = _EV_STATE_ENTER }, new_state);
+            assert(eng->state == new_state);
 
             if (eng->options.on_state_changed) {
                 livekit_connection_state_t ext_state;
@@ -1080,11 +2217,49 @@ engine_handle_t engine_init(const engine_options_t *options)
 
     eng->event_queue = xQueueCreate(
         CONFIG_LK_ENGINE_QUEUE_SIZE,
-        sizeof(engine_event_t)
+        sizeof(engine_event_t *)
     );
     if (eng->event_queue == NULL) {
         goto _init_failed;
     }
+    eng->free_events = xQueueCreate(
+        CONFIG_LK_ENGINE_QUEUE_SIZE,
+        sizeof(engine_event_t *)
+    );
+    if (eng->free_events == NULL) {
+        goto _init_failed;
+    }
+    for (int i = 0; i < CONFIG_LK_ENGINE_QUEUE_SIZE; i++) {
+        event_release(eng, &eng->event_pool[i]);
+    }
+
+    eng->timeline_lock = xSemaphoreCreateMutex();
+    if (eng->timeline_lock == NULL) {
+        goto _init_failed;
+    }
+    for (int i = 0; i < LIVEKIT_CONNECT_PHASE_MAX; i++) {
+        eng->timeline.phase_us[i] = -1;
+    }
+
+    eng->pre_connect_lock = xSemaphoreCreateMutex();
+    if (eng->pre_connect_lock == NULL) {
+        goto _init_failed;
+    }
+
+    eng->reliable_lock = xSemaphoreCreateMutex();
+    if (eng->reliable_lock == NULL ||
+        !reliable_buffer_init(&eng->reliable_buffer, CONFIG_LK_RELIABLE_BUFFER_SIZE)) {
+        goto _init_failed;
+    }
+
+    data_dispatch_options_t dispatch_options = {
+        .on_packet = on_dispatch_data_packet,
+        .ctx = eng,
+        .drop_reliable_on_overflow = eng->options.drop_reliable_on_overflow
+    };
+    if (data_dispatch_create(&eng->data_dispatch, &dispatch_options) != DATA_DISPATCH_ERR_NONE) {
+        goto _init_failed;
+    }
 
     if (xTaskCreate(
         engine_task,
@@ -1108,6 +2283,17 @@ engine_handle_t engine_init(const engine_options_t *options)
         goto _init_failed;
     }
 
+    eng->reliable_retry_timer = xTimerCreate(
+        "lk_reliable_retry",
+        pdMS_TO_TICKS(RELIABLE_RETRY_MS),
+        pdFALSE,
+        (void *)eng,
+        on_reliable_retry_timer_expired
+    );
+    if (eng->reliable_retry_timer == NULL) {
+        goto _init_failed;
+    }
+
     signal_options_t signal_options = {
         .ctx = eng,
         .on_state_changed = on_signal_state_changed,
@@ -1125,13 +2311,16 @@ engine_handle_t engine_init(const engine_options_t *options)
             .channel = eng->options.media.audio_info.channel,
             .bits_per_sample = 16,
         },
-        .video_info = {
+    };
+    bool has_video = eng->options.media.video_info.codec != ESP_PEER_VIDEO_CODEC_NONE;
+    if (has_video) {
+        sink_cfg.video_info = (esp_capture_video_info_t){
             .format_id = capture_video_codec_type(eng->options.media.video_info.codec),
             .width = eng->options.media.video_info.width,
             .height = eng->options.media.video_info.height,
             .fps = eng->options.media.video_info.fps,
-        },
-    };
+        };
+    }
     if (options->media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE) {
         // TODO: Can we ensure the renderer is valid? If not, return error.
         eng->renderer_handle = options->media.renderer;
@@ -1151,6 +2340,37 @@ engine_handle_t engine_init(const engine_options_t *options)
     ) != ESP_CAPTURE_ERR_OK) {
         goto _init_failed;
     }
+    video_layers_options_t layers_options = {
+        .base_path = eng->capturer_path,
+        .is_base_path_shared = eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE
+    };
+    if (has_video &&
+        video_layers_create(&eng->video_layers, &layers_options) != VIDEO_LAYERS_ERR_NONE) {
+        goto _init_failed;
+    }
+    if ((options->media.vad_enabled || options->media.pre_connect_audio) &&
+        options->media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE) {
+        // PCM is captured on its own path after path 0.
+        esp_capture_sink_cfg_t pcm_cfg = {
+            .audio_info = {
+                .format_id = ESP_CAPTURE_FMT_ID_PCM,
+                .sample_rate = eng->options.media.audio_info.sample_rate,
+                .channel = eng->options.media.audio_info.channel,
+                .bits_per_sample = 16,
+            },
+        };
+        if (esp_capture_sink_setup(
+            eng->options.media.capturer,
+            1, // Path index
+            &pcm_cfg,
+            &eng->pcm_path
+        ) != ESP_CAPTURE_ERR_OK) {
+            ESP_LOGE(TAG, "Failed to set up PCM capture path");
+            goto _init_failed;
+        }
+        sync_pcm_path(eng);
+        audio_vad_init(&eng->vad, options->media.vad_threshold_dbfs, options->media.vad_hangover_ms);
+    }
     return eng;
 
 _init_failed:
@@ -1173,9 +2393,18 @@ engine_err_t engine_destroy(engine_handle_t handle)
     if (eng->timer != NULL) {
         xTimerDelete(eng->timer, portMAX_DELAY);
     }
+    if (eng->reliable_retry_timer != NULL) {
+        xTimerDelete(eng->reliable_retry_timer, portMAX_DELAY);
+    }
     if (eng->event_queue != NULL) {
+        if (eng->free_events != NULL) {
+            flush_event_queue(eng);
+        }
         vQueueDelete(eng->event_queue);
     }
+    if (eng->free_events != NULL) {
+        vQueueDelete(eng->free_events);
+    }
     if (eng->signal_handle != NULL) {
         signal_destroy(eng->signal_handle);
     }
@@ -1185,6 +2414,24 @@ engine_err_t engine_destroy(engine_handle_t handle)
     if (eng->sub_peer_handle != NULL) {
         peer_destroy(eng->sub_peer_handle);
     }
+    if (eng->data_dispatch != NULL) {
+        data_dispatch_destroy(eng->data_dispatch);
+    }
+    if (eng->video_layers != NULL) {
+        video_layers_destroy(eng->video_layers);
+    }
+    SAFE_FREE(eng->pre_connect.data);
+    SAFE_FREE(eng->pre_connect_agent);
+    if (eng->pre_connect_lock != NULL) {
+        vSemaphoreDelete(eng->pre_connect_lock);
+    }
+    reliable_buffer_deinit(&eng->reliable_buffer);
+    if (eng->reliable_lock != NULL) {
+        vSemaphoreDelete(eng->reliable_lock);
+    }
+    if (eng->timeline_lock != NULL) {
+        vSemaphoreDelete(eng->timeline_lock);
+    }
     SAFE_FREE(eng->server_url);
     SAFE_FREE(eng->token);
     free(eng);
@@ -1232,13 +2479,42 @@ livekit_failure_reason_t engine_get_failure_reason(engine_handle_t handle)
     return eng->failure_reason;
 }
 
-engine_err_t engine_send_data_packet(engine_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable)
+engine_err_t engine_set_track_muted(engine_handle_t handle, livekit_pb_track_type_t type, bool muted)
 {
     if (handle == NULL) {
         return ENGINE_ERR_INVALID_ARG;
     }
     engine_t *eng = (engine_t *)handle;
-    // TODO: Implement buffering for reliable packets
+    bool is_published = type == LIVEKIT_PB_TRACK_TYPE_AUDIO ?
+        eng->options.media.audio_info.codec != ESP_PEER_AUDIO_CODEC_NONE :
+        type == LIVEKIT_PB_TRACK_TYPE_VIDEO && eng->video_layers != NULL;
+    if (!is_published) {
+        return ENGINE_ERR_INVALID_ARG;
+    }
+    engine_event_t ev = {
+        .type = EV_CMD_SET_MUTED,
+        .detail.cmd_set_muted = { .type = type, .muted = muted }
+    };
+    if (!event_enqueue(eng, &ev, false)) {
+        return ENGINE_ERR_OTHER;
+    }
+    return ENGINE_ERR_NONE;
+}
+
+engine_err_t engine_send_data_packet(engine_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable)
+{
+    if (handle == NULL || packet == NULL) {
+        return ENGINE_ERR_INVALID_ARG;
+    }
+    engine_t *eng = (engine_t *)handle;
+    if (reliable) {
+        // Reliable packets are buffered while reconnecting and sent once connected.
+        engine_err_t ret = buffer_reliable_packet(eng, packet);
+        if (ret == ENGINE_ERR_NONE) {
+            flush_reliable_buffer(eng);
+        }
+        return ret;
+    }
     if (eng->state != ENGINE_STATE_CONNECTED) {
         return ENGINE_ERR_OTHER;
     }
@@ -1246,5 +2522,105 @@ engine_err_t engine_send_data_packet(engine_handle_t handle, const livekit_pb_da
         peer_send_data_packet(eng->pub_peer_handle, packet, reliable) != PEER_ERR_NONE) {
         return ENGINE_ERR_RTC;
     }
+    COUNTER_ADD(eng->counters.lossy_packets_sent, 1);
+    return ENGINE_ERR_NONE;
+}
+
+engine_err_t engine_get_reliable_buffer_stats(engine_handle_t handle, engine_reliable_buffer_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return ENGINE_ERR_INVALID_ARG;
+    }
+    engine_t *eng = (engine_t *)handle;
+    if (xSemaphoreTake(eng->reliable_lock, portMAX_DELAY) != pdTRUE) {
+        return ENGINE_ERR_OTHER;
+    }
+    reliable_buffer_t *buf = &eng->reliable_buffer;
+    *out_stats = (engine_reliable_buffer_stats_t){
+        .count = buf->count,
+        .used_bytes = buf->used,
+        .high_water_bytes = buf->high_water,
+        .capacity_bytes = buf->capacity,
+        .dropped = buf->dropped
+    };
+    xSemaphoreGive(eng->reliable_lock);
+    return ENGINE_ERR_NONE;
+}
+
+engine_err_t engine_get_connect_timeline(engine_handle_t handle, livekit_connect_timeline_t *out_timeline)
+{
+    if (handle == NULL || out_timeline == NULL) {
+        return ENGINE_ERR_INVALID_ARG;
+    }
+    engine_t *eng = (engine_t *)handle;
+    if (xSemaphoreTake(eng->timeline_lock, portMAX_DELAY) != pdTRUE) {
+        return ENGINE_ERR_OTHER;
+    }
+    *out_timeline = eng->timeline;
+    xSemaphoreGive(eng->timeline_lock);
+    return ENGINE_ERR_NONE;
+}
+
+engine_err_t engine_get_stats(engine_handle_t handle, livekit_room_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return ENGINE_ERR_INVALID_ARG;
+    }
+    engine_t *eng = (engine_t *)handle;
+    engine_counters_t *c = &eng->counters;
+    *out_stats = (livekit_room_stats_t){
+        .signal_rtt_ms = signal_get_rtt(eng->signal_handle),
+        .audio_frames_sent = atomic_load_explicit(&c->audio_frames_sent, memory_order_relaxed),
+        .audio_frames_suppressed = atomic_load_explicit(&c->audio_frames_suppressed, memory_order_relaxed),
+        .audio_frames_received = atomic_load_explicit(&c->audio_frames_received, memory_order_relaxed),
+        .video_frames_sent = atomic_load_explicit(&c->video_frames_sent, memory_order_relaxed),
+        .video_frames_received = atomic_load_explicit(&c->video_frames_received, memory_order_relaxed),
+        .capture_send_failures = atomic_load_explicit(&c->capture_send_failures, memory_order_relaxed),
+        .render_failures = atomic_load_explicit(&c->render_failures, memory_order_relaxed),
+        .reliable_packets_sent = atomic_load_explicit(&c->reliable_packets_sent, memory_order_relaxed),
+        .reliable_packets_received = atomic_load_explicit(&c->reliable_packets_received, memory_order_relaxed),
+        .lossy_packets_sent = atomic_load_explicit(&c->lossy_packets_sent, memory_order_relaxed),
+        .lossy_packets_received = atomic_load_explicit(&c->lossy_packets_received, memory_order_relaxed),
+        .engine_queue_high_water = atomic_load_explicit(&c->queue_high_water, memory_order_relaxed),
+        .reconnects = atomic_load_explicit(&c->reconnects, memory_order_relaxed)
+    };
+    xSemaphoreTake(eng->reliable_lock, portMAX_DELAY);
+    out_stats->reliable_packets_dropped = eng->reliable_buffer.dropped;
+    out_stats->reliable_buffer_high_water = eng->reliable_buffer.high_water;
+    xSemaphoreGive(eng->reliable_lock);
+    signal_send_stats_t send_stats = {};
+    if (signal_get_send_stats(eng->signal_handle, &send_stats) == SIGNAL_ERR_NONE) {
+        out_stats->signal_queue_high_water = send_stats.max_queue_depth;
+        out_stats->signal_requests_dropped = send_stats.dropped;
+        out_stats->signal_requests_failed = send_stats.failed;
+        out_stats->signal_send_latency_max_us = send_stats.latency_max_us;
+        if (send_stats.sent > 0) {
+            out_stats->signal_send_latency_mean_us = (uint32_t)(send_stats.latency_total_us / send_stats.sent);
+        }
+    }
+    data_dispatch_stats_t dispatch_stats = {};
+    if (data_dispatch_get_stats(eng->data_dispatch, &dispatch_stats) == DATA_DISPATCH_ERR_NONE) {
+        out_stats->received_lossy_dropped = dispatch_stats.dropped_lossy;
+        out_stats->received_reliable_dropped = dispatch_stats.dropped_reliable;
+        out_stats->data_queue_high_water = dispatch_stats.max_queue_depth;
+        out_stats->data_overflow_high_water = dispatch_stats.max_overflow_depth;
+        out_stats->data_handler_max_us = dispatch_stats.handler_max_us;
+        if (dispatch_stats.dispatched > 0) {
+            out_stats->data_handler_mean_us = (uint32_t)(dispatch_stats.handler_total_us / dispatch_stats.dispatched);
+        }
+    }
+    out_stats->audio_bytes_sent = count64_load(&eng->byte_counts.audio_sent);
+    out_stats->audio_bytes_received = count64_load(&eng->byte_counts.audio_received);
+    out_stats->video_bytes_sent = count64_load(&eng->byte_counts.video_sent);
+    out_stats->video_bytes_received = count64_load(&eng->byte_counts.video_received);
+    engine_pub_latency_t *latency = &eng->pub_audio_latency;
+    if (!atomic_load_explicit(&latency->is_reset_pending, memory_order_acquire)) {
+        uint32_t frame_count = atomic_load_explicit(&latency->frame_count, memory_order_relaxed);
+        out_stats->audio_send_latency_ms = atomic_load_explicit(&latency->last_ms, memory_order_relaxed);
+        out_stats->audio_send_latency_max_ms = atomic_load_explicit(&latency->max_ms, memory_order_relaxed);
+        if (frame_count > 0) {
+            out_stats->audio_send_latency_mean_ms = (uint32_t)(count64_load(&latency->total_ms) / frame_count);
+        }
+    }
     return ENGINE_ERR_NONE;
-}
\ No newline at end of file
+}
@@ -19,6 +19,7 @@
 #include "livekit_types.h"
 #include "common.h"
 #include "protocol.h"
+#include "signaling.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,12 +47,56 @@ typedef struct {
     av_render_handle_t   player;  /*!< Player handle */
 } engine_media_provider_t;
 
+/// Occupancy of the buffer holding reliable data packets until they are sent.
+typedef struct {
+    /// Number of packets waiting to be sent.
+    uint32_t count;
+    /// Bytes used by packets waiting to be sent.
+    uint32_t used_bytes;
+    /// Highest number of bytes in use at once.
+    uint32_t high_water_bytes;
+    /// Size of the buffer in bytes (`CONFIG_LK_RELIABLE_BUFFER_SIZE`).
+    uint32_t capacity_bytes;
+    /// Number of packets evicted or rejected before they were sent.
+    uint32_t dropped;
+} engine_reliable_buffer_stats_t;
+
+/// Audio captured before connecting, ready to be sent to an agent.
+typedef struct {
+    /// Interleaved 16-bit PCM. The receiver takes ownership and must free it.
+    uint8_t *data;
+    size_t size;
+    uint32_t sample_rate;
+    uint8_t channel_count;
+    /// SID of the published audio track the audio precedes.
+    const char *track_sid;
+    /// Identity of the agent to send the audio to.
+    const char *agent_identity;
+} engine_pre_connect_audio_t;
+
 typedef struct {
     void *ctx;
     void (*on_state_changed)(livekit_connection_state_t state, void *ctx);
     void (*on_data_packet)(livekit_pb_data_packet_t* packet, void *ctx);
+    /// Invoked on the receiving peer's thread when a reliable data packet is dropped
+    /// because `on_data_packet` fell behind; only if `drop_reliable_on_overflow`,
+    /// or if the packet could not be held.
+    void (*on_data_dropped)(void *ctx);
+    /// Whether to drop received reliable data packets once the dispatch queue is
+    /// full rather than holding them until `on_data_packet` catches up.
+    bool drop_reliable_on_overflow;
     void (*on_room_info)(const livekit_pb_room_t* info, void *ctx);
     void (*on_participant_info)(const livekit_pb_participant_info_t* info, bool is_local, void *ctx);
+    /// Whether to subscribe to a remote participant's audio tracks; all are if not set.
+    bool (*should_subscribe)(const livekit_pb_participant_info_t* info, void *ctx);
+    /// Invoked on the engine task when voice activity in published audio starts or
+    /// stops; only if `media.vad_enabled`.
+    void (*on_speaking_changed)(bool is_speaking, void *ctx);
+    /// Invoked on the engine task when pre-connect audio is ready to be sent to an
+    /// agent; only if `media.pre_connect_audio`.
+    void (*on_pre_connect_audio)(const engine_pre_connect_audio_t *audio, void *ctx);
+    /// Whether to switch audio subscriptions to the active speakers.
+    bool follow_active_speakers;
     engine_media_options_t media;
 } engine_options_t;
 
@@ -71,9 +116,33 @@ engine_err_t engine_close(engine_handle_t handle);
 /// Returns the reason why the engine connection failed.
 livekit_failure_reason_t engine_get_failure_reason(engine_handle_t handle);
 
+/// Mutes or unmutes a published track.
+///
+/// Capture of the track is suspended while muted. The state is kept across
+/// sessions and reported to the server once the track is published.
+///
+engine_err_t engine_set_track_muted(engine_handle_t handle, livekit_pb_track_type_t type, bool muted);
+
 /// Sends a data packet to the remote peer.
+///
+/// Reliable packets are numbered and buffered, so those sent while reconnecting
+/// after the connection was lost are sent once connected again. Packets sent over a
+/// session are not resent after reconnecting, and reliable packets are rejected
+/// while disconnected or connecting for the first time. A reliable packet larger
+/// than `CONFIG_LK_RELIABLE_BUFFER_SIZE` is not buffered: it is only sent while
+/// connected. Lossy packets are only sent while connected.
+///
 engine_err_t engine_send_data_packet(engine_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable);
 
+/// Returns the occupancy of the reliable data packet buffer.
+engine_err_t engine_get_reliable_buffer_stats(engine_handle_t handle, engine_reliable_buffer_stats_t *out_stats);
+
+/// Returns the timeline of the most recent connection attempt.
+engine_err_t engine_get_connect_timeline(engine_handle_t handle, livekit_connect_timeline_t *out_timeline);
+
+/// Returns counters describing how the connection is doing.
+engine_err_t engine_get_stats(engine_handle_t handle, livekit_room_stats_t *out_stats);
+
 #ifdef __cplusplus
 }
 #endif
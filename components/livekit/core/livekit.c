@@ -14,29 +14,68 @@
  * limitations under the License.
  */
 
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <esp_log.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "esp_peer.h"
 #include "engine.h"
 #include "rpc_manager.h"
+#include "data_stream.h"
 #include "system.h"
 #include "livekit.h"
 
 static const char *TAG = "livekit";
 
+/// Topic agents receive pre-connect audio on.
+#define PRE_CONNECT_AUDIO_TOPIC "lk.agent.pre-connect-audio-buffer"
+
 typedef struct {
+    /// Cleared under `rpc_lock` before the manager is destroyed, so packets still
+    /// being dispatched no longer reach it.
     rpc_manager_handle_t rpc_manager;
+    SemaphoreHandle_t rpc_lock;
+    data_stream_manager_handle_t data_stream_manager;
     engine_handle_t engine;
     livekit_room_options_t options;
     livekit_connection_state_t state;
+
+    /// Whether pre-connect audio is being sent on its own task.
+    _Atomic bool is_sending_pre_connect;
 } livekit_room_t;
 
+/// Pre-connect audio to send to an agent, with the strings it refers to stored after it.
+typedef struct {
+    livekit_room_t *room;
+    uint8_t *data;
+    size_t size;
+    char sample_rate[11];
+    char channel_count[4];
+    char *track_sid;
+    char *agent_identity;
+} pre_connect_send_t;
+
 static bool send_reliable_packet(const livekit_pb_data_packet_t* packet, void *ctx)
 {
     livekit_room_t *room = (livekit_room_t *)ctx;
     return engine_send_data_packet(room->engine, packet, true) == ENGINE_ERR_NONE;
 }
 
+static size_t get_reliable_buffered_amount(void *ctx)
+{
+    livekit_room_t *room = (livekit_room_t *)ctx;
+    engine_reliable_buffer_stats_t stats;
+    if (engine_get_reliable_buffer_stats(room->engine, &stats) != ENGINE_ERR_NONE) {
+        return 0;
+    }
+    return stats.used_bytes;
+}
+
 static void on_rpc_result(const livekit_rpc_result_t* result, void* ctx)
 {
     livekit_room_t *room = (livekit_room_t *)ctx;
@@ -88,6 +127,14 @@ static void populate_media_options(
         media_options->audio_info.codec = codec;
         media_options->audio_info.sample_rate = pub_options->audio_encode.sample_rate;
         media_options->audio_info.channel = pub_options->audio_encode.channel_count;
+
+        const livekit_audio_vad_options_t *vad = &pub_options->audio_vad;
+        media_options->vad_enabled = vad->enabled;
+        media_options->vad_threshold_dbfs = vad->threshold_dbfs != 0 ?
+            vad->threshold_dbfs : CONFIG_LK_VAD_THRESHOLD_DBFS;
+        media_options->vad_hangover_ms = vad->hangover_ms != 0 ?
+            vad->hangover_ms : CONFIG_LK_VAD_HANGOVER_MS;
+        media_options->pre_connect_audio = pub_options->pre_connect_audio;
     }
     if (pub_options->kind & LIVEKIT_MEDIA_TYPE_VIDEO) {
         media_options->video_dir |= ESP_PEER_MEDIA_DIR_SEND_ONLY;
@@ -134,7 +181,16 @@ static void on_eng_data_packet(livekit_pb_data_packet_t* packet, void *ctx)
         case LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG:
         case LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG:
         case LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG:
-            rpc_manager_handle_packet(room->rpc_manager, packet);
+            xSemaphoreTake(room->rpc_lock, portMAX_DELAY);
+            if (room->rpc_manager != NULL) {
+                rpc_manager_handle_packet(room->rpc_manager, packet);
+            }
+            xSemaphoreGive(room->rpc_lock);
+            break;
+        case LIVEKIT_PB_DATA_PACKET_STREAM_HEADER_TAG:
+        case LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG:
+        case LIVEKIT_PB_DATA_PACKET_STREAM_TRAILER_TAG:
+            data_stream_manager_handle_packet(room->data_stream_manager, packet);
             break;
         default:
             break;
@@ -175,6 +231,114 @@ static void on_eng_participant_info(const livekit_pb_participant_info_t* info, b
     room->options.on_participant_info(&participant_info, room->options.ctx);
 }
 
+static void on_eng_speaking_changed(bool is_speaking, void *ctx)
+{
+    livekit_room_t *room = (livekit_room_t *)ctx;
+    room->options.on_speaking_changed(is_speaking, room->options.ctx);
+}
+
+static void on_eng_data_dropped(void *ctx)
+{
+    livekit_room_t *room = (livekit_room_t *)ctx;
+    room->options.on_data_dropped(room->options.ctx);
+}
+
+/// Sends pre-connect audio as a byte stream, on its own task since writes wait
+/// for the data channel to catch up.
+static void pre_connect_send_task(void *arg)
+{
+    pre_connect_send_t *send = (pre_connect_send_t *)arg;
+    livekit_data_stream_attribute_t attributes[] = {
+        { .key = "sampleRate", .value = send->sample_rate },
+        { .key = "channels", .value = send->channel_count },
+        { .key = "trackId", .value = send->track_sid }
+    };
+    livekit_data_stream_options_t options = {
+        .topic = PRE_CONNECT_AUDIO_TOPIC,
+        .kind = LIVEKIT_DATA_STREAM_KIND_BYTE,
+        .mime_type = "audio/pcm",
+        .total_length = send->size,
+        .destination_identities = &send->agent_identity,
+        .destination_identities_count = 1,
+        .attributes = attributes,
+        .attributes_count = sizeof(attributes) / sizeof(attributes[0])
+    };
+    livekit_data_stream_writer_handle_t writer = NULL;
+    data_stream_err_t ret = data_stream_writer_open(send->room->data_stream_manager, &options, &writer);
+    if (ret == DATA_STREAM_ERR_NONE) {
+        ret = data_stream_writer_write(writer, send->data, send->size);
+        data_stream_writer_close(writer, ret == DATA_STREAM_ERR_NONE ? NULL : "Send failed");
+    }
+    if (ret != DATA_STREAM_ERR_NONE) {
+        ESP_LOGE(TAG, "Failed to send pre-connect audio: err=%d", ret);
+    }
+    atomic_store(&send->room->is_sending_pre_connect, false);
+    free(send->data);
+    free(send);
+    vTaskDelete(NULL);
+}
+
+static void on_eng_pre_connect_audio(const engine_pre_connect_audio_t *audio, void *ctx)
+{
+    livekit_room_t *room = (livekit_room_t *)ctx;
+    size_t track_sid_size = strlen(audio->track_sid) + 1;
+    size_t identity_size = strlen(audio->agent_identity) + 1;
+    pre_connect_send_t *send = malloc(sizeof(pre_connect_send_t) + track_sid_size + identity_size);
+    if (send == NULL || atomic_exchange(&room->is_sending_pre_connect, true)) {
+        ESP_LOGE(TAG, "Cannot send pre-connect audio");
+        free(send);
+        free(audio->data);
+        return;
+    }
+    *send = (pre_connect_send_t){
+        .room = room,
+        .data = audio->data,
+        .size = audio->size,
+        .track_sid = (char *)(send + 1),
+    };
+    send->agent_identity = send->track_sid + track_sid_size;
+    memcpy(send->track_sid, audio->track_sid, track_sid_size);
+    memcpy(send->agent_identity, audio->agent_identity, identity_size);
+    snprintf(send->sample_rate, sizeof(send->sample_rate), "%" PRIu32, audio->sample_rate);
+    snprintf(send->channel_count, sizeof(send->channel_count), "%u", audio->channel_count);
+
+    if (xTaskCreate(
+        pre_connect_send_task,
+        "lk_pre_connect",
+        CONFIG_LK_DATA_TASK_STACK_SIZE,
+        send,
+        CONFIG_LK_DATA_TASK_PRIORITY,
+        NULL
+    ) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create pre-connect audio task");
+        atomic_store(&room->is_sending_pre_connect, false);
+        free(send->data);
+        free(send);
+    }
+}
+
+static bool on_eng_should_subscribe(const livekit_pb_participant_info_t* info, void *ctx)
+{
+    livekit_room_t *room = (livekit_room_t *)ctx;
+    const livekit_sub_options_t *sub_options = &room->options.subscribe;
+    switch (sub_options->audio_policy) {
+        case LIVEKIT_SUB_AUDIO_POLICY_KIND:
+            return (livekit_participant_kind_t)info->kind == sub_options->audio_participant_kind;
+        case LIVEKIT_SUB_AUDIO_POLICY_IDENTITY:
+            if (info->identity == NULL) {
+                return false;
+            }
+            for (size_t i = 0; i < sub_options->audio_identity_count; i++) {
+                if (strcmp(sub_options->audio_identities[i], info->identity) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return true;
+    }
+}
+
 livekit_err_t livekit_room_create(livekit_room_handle_t *handle, const livekit_room_options_t *options)
 {
     if (handle == NULL || options == NULL) {
@@ -196,6 +360,12 @@ livekit_err_t livekit_room_create(livekit_room_handle_t *handle, const livekit_r
         ESP_LOGE(TAG, "Renderer must be set for subscribing to media");
         return LIVEKIT_ERR_INVALID_ARG;
     }
+    if (options->subscribe.audio_policy == LIVEKIT_SUB_AUDIO_POLICY_IDENTITY &&
+        options->subscribe.audio_identity_count > 0 &&
+        options->subscribe.audio_identities == NULL) {
+        ESP_LOGE(TAG, "Identities must be set for subscribing by identity");
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
     if ((options->publish.kind & LIVEKIT_MEDIA_TYPE_AUDIO) &&
         (options->publish.audio_encode.codec == LIVEKIT_AUDIO_CODEC_NONE)) {
         ESP_LOGE(TAG, "Encode options must be set for audio publishing");
@@ -221,8 +391,14 @@ livekit_err_t livekit_room_create(livekit_room_handle_t *handle, const livekit_r
         .media = media_options,
         .on_state_changed = on_eng_state_changed,
         .on_data_packet = on_eng_data_packet,
+        .on_data_dropped = options->on_data_dropped != NULL ? on_eng_data_dropped : NULL,
+        .drop_reliable_on_overflow = options->drop_reliable_on_overflow,
         .on_room_info = on_eng_room_info,
         .on_participant_info = on_eng_participant_info,
+        .should_subscribe = on_eng_should_subscribe,
+        .on_speaking_changed = options->on_speaking_changed != NULL ? on_eng_speaking_changed : NULL,
+        .on_pre_connect_audio = on_eng_pre_connect_audio,
+        .follow_active_speakers = options->subscribe.audio_follow_speakers,
         .ctx = room
     };
 
@@ -234,6 +410,11 @@ livekit_err_t livekit_room_create(livekit_room_handle_t *handle, const livekit_r
             ret = LIVEKIT_ERR_ENGINE;
             break;
         }
+        room->rpc_lock = xSemaphoreCreateMutex();
+        if (room->rpc_lock == NULL) {
+            ret = LIVEKIT_ERR_NO_MEM;
+            break;
+        }
         rpc_manager_options_t rpc_manager_options = {
             .on_result = on_rpc_result,
             .send_packet = send_reliable_packet,
@@ -244,10 +425,32 @@ livekit_err_t livekit_room_create(livekit_room_handle_t *handle, const livekit_r
             ret = LIVEKIT_ERR_OTHER;
             break;
         }
+        data_stream_manager_options_t data_stream_options = {
+            .send_packet = send_reliable_packet,
+            .get_buffered_amount = get_reliable_buffered_amount,
+            // Leave room in the reliable buffer so queued chunks are never evicted.
+            .window_size = CONFIG_LK_DATA_STREAM_WINDOW_SIZE < CONFIG_LK_RELIABLE_BUFFER_SIZE / 2 ?
+                CONFIG_LK_DATA_STREAM_WINDOW_SIZE : CONFIG_LK_RELIABLE_BUFFER_SIZE / 2,
+            .ctx = room
+        };
+        if (data_stream_manager_create(&room->data_stream_manager, &data_stream_options) != DATA_STREAM_ERR_NONE) {
+            ESP_LOGE(TAG, "Failed to create data stream manager");
+            ret = LIVEKIT_ERR_OTHER;
+            break;
+        }
         *handle = (livekit_room_handle_t)room;
         return LIVEKIT_ERR_NONE;
     } while (0);
 
+    if (room->rpc_manager != NULL) {
+        rpc_manager_destroy(room->rpc_manager);
+    }
+    if (room->engine != NULL) {
+        engine_destroy(room->engine);
+    }
+    if (room->rpc_lock != NULL) {
+        vSemaphoreDelete(room->rpc_lock);
+    }
     free(room);
     return ret;
 }
@@ -259,7 +462,20 @@ livekit_err_t livekit_room_destroy(livekit_room_handle_t handle)
         return LIVEKIT_ERR_INVALID_ARG;
     }
     livekit_room_close(handle);
+    // Closing makes the stream's writes fail instead of waiting for the window.
+    while (atomic_load(&room->is_sending_pre_connect)) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    // Handlers may still be sending results through the engine, so the RPC
+    // manager's workers are joined before the engine goes away.
+    xSemaphoreTake(room->rpc_lock, portMAX_DELAY);
+    rpc_manager_handle_t rpc_manager = room->rpc_manager;
+    room->rpc_manager = NULL;
+    xSemaphoreGive(room->rpc_lock);
+    rpc_manager_destroy(rpc_manager);
     engine_destroy(room->engine);
+    data_stream_manager_destroy(room->data_stream_manager);
+    vSemaphoreDelete(room->rpc_lock);
     free(room);
     return LIVEKIT_ERR_NONE;
 }
@@ -271,6 +487,7 @@ livekit_err_t livekit_room_connect(livekit_room_handle_t handle, const char *ser
     }
     livekit_room_t *room = (livekit_room_t *)handle;
 
+    data_stream_manager_set_closed(room->data_stream_manager, false);
     if (engine_connect(room->engine, server_url, token) != ENGINE_ERR_NONE) {
         ESP_LOGE(TAG, "Failed to connect engine");
         return LIVEKIT_ERR_OTHER;
@@ -284,6 +501,7 @@ livekit_err_t livekit_room_close(livekit_room_handle_t handle)
         return LIVEKIT_ERR_INVALID_ARG;
     }
     livekit_room_t *room = (livekit_room_t *)handle;
+    data_stream_manager_set_closed(room->data_stream_manager, true);
     engine_close(room->engine);
     return LIVEKIT_ERR_NONE;
 }
@@ -346,6 +564,69 @@ livekit_failure_reason_t livekit_room_get_failure_reason(livekit_room_handle_t h
     return engine_get_failure_reason(room->engine);
 }
 
+livekit_err_t livekit_room_get_connect_timeline(livekit_room_handle_t handle, livekit_connect_timeline_t *out_timeline)
+{
+    if (handle == NULL || out_timeline == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    if (engine_get_connect_timeline(room->engine, out_timeline) != ENGINE_ERR_NONE) {
+        return LIVEKIT_ERR_OTHER;
+    }
+    return LIVEKIT_ERR_NONE;
+}
+
+const char* livekit_connect_phase_str(livekit_connect_phase_t phase)
+{
+    switch (phase) {
+        case LIVEKIT_CONNECT_PHASE_URL_BUILT:            return "URL Built";
+        case LIVEKIT_CONNECT_PHASE_SIGNAL_CONNECTED:     return "Signal Connected";
+        case LIVEKIT_CONNECT_PHASE_JOIN_RECEIVED:        return "Join Received";
+        case LIVEKIT_CONNECT_PHASE_PEERS_CREATED:        return "Peers Created";
+        case LIVEKIT_CONNECT_PHASE_OFFER_SENT:           return "Offer Sent";
+        case LIVEKIT_CONNECT_PHASE_ANSWER_RECEIVED:      return "Answer Received";
+        case LIVEKIT_CONNECT_PHASE_FIRST_CANDIDATE:      return "First Candidate";
+        case LIVEKIT_CONNECT_PHASE_ICE_CONNECTED:        return "ICE Connected";
+        case LIVEKIT_CONNECT_PHASE_DTLS_CONNECTED:       return "DTLS Connected";
+        case LIVEKIT_CONNECT_PHASE_DATA_CHANNELS_OPEN:   return "Data Channels Open";
+        case LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_SENT:     return "First Audio Sent";
+        case LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_RECEIVED: return "First Audio Received";
+        default:                                         return "Unknown";
+    }
+}
+
+livekit_err_t livekit_room_get_stats(livekit_room_handle_t handle, livekit_room_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    if (engine_get_stats(room->engine, out_stats) != ENGINE_ERR_NONE) {
+        return LIVEKIT_ERR_OTHER;
+    }
+    return LIVEKIT_ERR_NONE;
+}
+
+livekit_err_t livekit_room_set_track_muted(livekit_room_handle_t handle, livekit_media_kind_t kind, bool muted)
+{
+    if (handle == NULL || kind == LIVEKIT_MEDIA_TYPE_NONE || (kind & ~LIVEKIT_MEDIA_TYPE_BOTH) != 0) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    engine_err_t ret = ENGINE_ERR_NONE;
+    if (kind & LIVEKIT_MEDIA_TYPE_AUDIO) {
+        ret = engine_set_track_muted(room->engine, LIVEKIT_PB_TRACK_TYPE_AUDIO, muted);
+    }
+    if (ret == ENGINE_ERR_NONE && (kind & LIVEKIT_MEDIA_TYPE_VIDEO)) {
+        ret = engine_set_track_muted(room->engine, LIVEKIT_PB_TRACK_TYPE_VIDEO, muted);
+    }
+    switch (ret) {
+        case ENGINE_ERR_NONE:        return LIVEKIT_ERR_NONE;
+        case ENGINE_ERR_INVALID_ARG: return LIVEKIT_ERR_INVALID_ARG;
+        default:                     return LIVEKIT_ERR_ENGINE;
+    }
+}
+
 livekit_err_t livekit_room_publish_data(livekit_room_handle_t handle, livekit_data_publish_options_t *options)
 {
     if (handle == NULL || options == NULL || options->payload == NULL) {
@@ -382,14 +663,68 @@ livekit_err_t livekit_room_publish_data(livekit_room_handle_t handle, livekit_da
     return LIVEKIT_ERR_NONE;
 }
 
+static livekit_err_t map_data_stream_err(data_stream_err_t err)
+{
+    switch (err) {
+        case DATA_STREAM_ERR_NONE:          return LIVEKIT_ERR_NONE;
+        case DATA_STREAM_ERR_INVALID_ARG:   return LIVEKIT_ERR_INVALID_ARG;
+        case DATA_STREAM_ERR_NO_MEM:        return LIVEKIT_ERR_NO_MEM;
+        case DATA_STREAM_ERR_INVALID_STATE: return LIVEKIT_ERR_INVALID_STATE;
+        case DATA_STREAM_ERR_SEND_FAILED:   return LIVEKIT_ERR_ENGINE;
+        default:                            return LIVEKIT_ERR_OTHER;
+    }
+}
+
+livekit_err_t livekit_room_data_stream_register(livekit_room_handle_t handle, const char* topic, const livekit_data_stream_handler_t* handler)
+{
+    if (handle == NULL || topic == NULL || handler == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    return map_data_stream_err(data_stream_manager_register(room->data_stream_manager, topic, handler));
+}
+
+livekit_err_t livekit_room_data_stream_unregister(livekit_room_handle_t handle, const char* topic)
+{
+    if (handle == NULL || topic == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    return map_data_stream_err(data_stream_manager_unregister(room->data_stream_manager, topic));
+}
+
+livekit_err_t livekit_room_data_stream_open(livekit_room_handle_t handle, const livekit_data_stream_options_t* options, livekit_data_stream_writer_handle_t* out_writer)
+{
+    if (handle == NULL || options == NULL || out_writer == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+    return map_data_stream_err(data_stream_writer_open(room->data_stream_manager, options, out_writer));
+}
+
+livekit_err_t livekit_data_stream_write(livekit_data_stream_writer_handle_t writer, const uint8_t* data, size_t size)
+{
+    return map_data_stream_err(data_stream_writer_write(writer, data, size));
+}
+
+livekit_err_t livekit_data_stream_close(livekit_data_stream_writer_handle_t writer, const char* reason)
+{
+    return map_data_stream_err(data_stream_writer_close(writer, reason));
+}
+
 livekit_err_t livekit_room_rpc_register(livekit_room_handle_t handle, const char* method, livekit_rpc_handler_t handler)
+{
+    return livekit_room_rpc_register_with_options(handle, method, handler, NULL);
+}
+
+livekit_err_t livekit_room_rpc_register_with_options(livekit_room_handle_t handle, const char* method, livekit_rpc_handler_t handler, const livekit_rpc_handler_options_t* options)
 {
     if (handle == NULL || method == NULL || handler == NULL) {
         return LIVEKIT_ERR_INVALID_ARG;
     }
     livekit_room_t *room = (livekit_room_t *)handle;
 
-    if (rpc_manager_register(room->rpc_manager, method, handler) != RPC_MANAGER_ERR_NONE) {
+    if (rpc_manager_register(room->rpc_manager, method, handler, options) != RPC_MANAGER_ERR_NONE) {
         ESP_LOGE(TAG, "Failed to register RPC method '%s'", method);
         return LIVEKIT_ERR_INVALID_STATE;
     }
@@ -410,6 +745,41 @@ livekit_err_t livekit_room_rpc_unregister(livekit_room_handle_t handle, const ch
     return LIVEKIT_ERR_NONE;
 }
 
+livekit_err_t livekit_room_rpc_get_method_stats(livekit_room_handle_t handle, const char* method, livekit_rpc_method_stats_t* out_stats)
+{
+    if (handle == NULL || method == NULL || out_stats == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+
+    if (rpc_manager_get_method_stats(room->rpc_manager, method, out_stats) != RPC_MANAGER_ERR_NONE) {
+        return LIVEKIT_ERR_INVALID_STATE;
+    }
+    return LIVEKIT_ERR_NONE;
+}
+
+livekit_err_t livekit_room_rpc_invoke(livekit_room_handle_t handle, const livekit_rpc_invoke_options_t* options, char* out_id)
+{
+    if (handle == NULL || options == NULL) {
+        return LIVEKIT_ERR_INVALID_ARG;
+    }
+    livekit_room_t *room = (livekit_room_t *)handle;
+
+    switch (rpc_manager_invoke(room->rpc_manager, options, out_id)) {
+        case RPC_MANAGER_ERR_NONE:
+            return LIVEKIT_ERR_NONE;
+        case RPC_MANAGER_ERR_INVALID_ARG:
+            return LIVEKIT_ERR_INVALID_ARG;
+        case RPC_MANAGER_ERR_NO_MEM:
+            return LIVEKIT_ERR_NO_MEM;
+        case RPC_MANAGER_ERR_SEND_FAILED:
+            ESP_LOGE(TAG, "Failed to send RPC invocation");
+            return LIVEKIT_ERR_INVALID_STATE;
+        default:
+            return LIVEKIT_ERR_OTHER;
+    }
+}
+
 livekit_err_t livekit_system_init(void)
 {
     esp_err_t ret = system_init();
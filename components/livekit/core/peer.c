@@ -30,11 +30,16 @@ static const char *PUB_TAG = "livekit_peer.pub";
 #define RELIABLE_CHANNEL_LABEL "_reliable"
 #define LOSSY_CHANNEL_LABEL "_lossy"
 #define STREAM_ID_INVALID 0xFFFF
+#define PEER_ENC_BUFFER_SIZE 512
 
 #define PC_EXIT_BIT      (1 << 0)
 #define PC_PAUSED_BIT    (1 << 1)
 #define PC_RESUME_BIT    (1 << 2)
 #define PC_SEND_QUIT_BIT (1 << 3)
+#define PC_WAKE_BIT      (1 << 4)
+
+/// Longest interval between connection loop iterations.
+#define PEER_LOOP_INTERVAL_MS 10
 
 typedef struct {
     peer_options_t options;
@@ -50,9 +55,9 @@ typedef struct {
     uint16_t reliable_stream_id;
     uint16_t lossy_stream_id;
 
-#if CONFIG_LK_BENCHMARK
-    uint64_t start_time;
-#endif
+    /// Reusable buffer for encoding data packets, guarded by `enc_lock`.
+    protocol_enc_buf_t enc_buf;
+    media_lib_mutex_handle_t enc_lock;
 } peer_t;
 
 static esp_peer_media_dir_t get_media_direction(esp_peer_media_dir_t direction, peer_role_t role) {
@@ -63,6 +68,14 @@ static esp_peer_media_dir_t get_media_direction(esp_peer_media_dir_t direction,
     }
 }
 
+/// Wakes the connection loop so that pending work is processed without delay.
+static inline void wake_loop(peer_t *peer)
+{
+#if CONFIG_LK_PEER_LOOP_ADAPTIVE
+    media_lib_event_group_set_bits(peer->wait_event, PC_WAKE_BIT);
+#endif
+}
+
 static void peer_task(void *ctx)
 {
     peer_t *peer = (peer_t *)ctx;
@@ -73,8 +86,18 @@ static void peer_task(void *ctx)
             media_lib_event_group_clr_bits(peer->wait_event, PC_RESUME_BIT);
             continue;
         }
+#if CONFIG_LK_PEER_LOOP_ADAPTIVE
         esp_peer_main_loop(peer->connection);
-        media_lib_thread_sleep(10);
+
+        // esp_peer does not expose its sockets or timer deadlines, so inbound data
+        // is only noticed by polling; keep the normal interval as the upper bound
+        // and wake immediately when there is something to send.
+        media_lib_event_group_wait_bits(peer->wait_event, PC_WAKE_BIT, PEER_LOOP_INTERVAL_MS);
+        media_lib_event_group_clr_bits(peer->wait_event, PC_WAKE_BIT);
+#else
+        esp_peer_main_loop(peer->connection);
+        media_lib_thread_sleep(PEER_LOOP_INTERVAL_MS);
+#endif
     }
     media_lib_event_group_set_bits(peer->wait_event, PC_EXIT_BIT);
     media_lib_thread_destroy(NULL);
@@ -106,6 +129,9 @@ static int on_state(esp_peer_state_t rtc_state, void *ctx)
 {
     peer_t *peer = (peer_t *)ctx;
     ESP_LOGD(TAG(peer), "RTC state changed to %d", rtc_state);
+    if (peer->options.on_rtc_state_changed != NULL) {
+        peer->options.on_rtc_state_changed(rtc_state, peer->options.role, peer->options.ctx);
+    }
 
     connection_state_t new_state = peer->state;
     switch (rtc_state) {
@@ -128,10 +154,6 @@ static int on_state(esp_peer_state_t rtc_state, void *ctx)
             if (peer->reliable_stream_id == STREAM_ID_INVALID ||
                 peer->lossy_stream_id    == STREAM_ID_INVALID ) break;
             new_state = CONNECTION_STATE_CONNECTED;
-#if CONFIG_LK_BENCHMARK
-            ESP_LOGI(TAG(peer), "[BENCH] Connected in %" PRIu64 "ms",
-                get_unix_time_ms() - peer->start_time);
-#endif
             break;
         default:
             break;
@@ -237,19 +259,20 @@ static int on_data(esp_peer_data_frame_t *frame, void *ctx)
         return -1;
     }
 
-    livekit_pb_data_packet_t packet = {};
+    livekit_pb_data_packet_t *packet = NULL;
     if (!protocol_data_packet_decode((const uint8_t *)frame->data, frame->size, &packet)) {
         ESP_LOGE(TAG(peer), "Failed to decode data packet");
         return -1;
     }
-    if (packet.which_value == 0) {
+    if (packet->which_value == 0) {
         // Packet type is not supported yet.
-        protocol_data_packet_free(&packet);
+        protocol_data_packet_free(packet);
         return -1;
     }
-    if (!peer->options.on_data_packet(&packet, peer->options.ctx)) {
+    bool reliable = frame->stream_id == peer->reliable_stream_id;
+    if (!peer->options.on_data_packet(packet, reliable, peer->options.ctx)) {
         // Ownership was not taken.
-        protocol_data_packet_free(&packet);
+        protocol_data_packet_free(packet);
     }
     return 0;
 }
@@ -275,6 +298,13 @@ peer_err_t peer_create(peer_handle_t *handle, peer_options_t *options)
         free(peer);
         return PEER_ERR_NO_MEM;
     }
+    media_lib_mutex_create(&peer->enc_lock);
+    if (peer->enc_lock == NULL ||
+        !protocol_enc_buf_init(&peer->enc_buf, PEER_ENC_BUFFER_SIZE)) {
+        media_lib_event_group_destroy(peer->wait_event);
+        peer_destroy(peer);
+        return PEER_ERR_NO_MEM;
+    }
 
     peer->options = *options;
     peer->ice_role = options->role == PEER_ROLE_SUBSCRIBER ?
@@ -326,7 +356,7 @@ peer_err_t peer_create(peer_handle_t *handle, peer_options_t *options)
     if (esp_peer_open(&peer_cfg, esp_peer_get_default_impl(), &peer->connection) != ESP_PEER_ERR_NONE) {
         ESP_LOGE(TAG(peer), "Failed to open peer");
         media_lib_event_group_destroy(peer->wait_event);
-        free(peer);
+        peer_destroy(peer);
         return PEER_ERR_RTC;
     }
     *handle = (peer_handle_t)peer;
@@ -339,6 +369,10 @@ peer_err_t peer_destroy(peer_handle_t handle)
         return PEER_ERR_INVALID_ARG;
     }
     peer_t *peer = (peer_t *)handle;
+    if (peer->enc_lock != NULL) {
+        media_lib_mutex_destroy(peer->enc_lock);
+    }
+    protocol_enc_buf_free(&peer->enc_buf);
     free(peer);
     return PEER_ERR_NONE;
 }
@@ -349,9 +383,6 @@ peer_err_t peer_connect(peer_handle_t handle)
         return PEER_ERR_INVALID_ARG;
     }
     peer_t *peer = (peer_t *)handle;
-#if CONFIG_LK_BENCHMARK
-    peer->start_time = get_unix_time_ms();
-#endif
 
     peer->running = true;
     media_lib_thread_handle_t thread;
@@ -384,6 +415,7 @@ peer_err_t peer_disconnect(peer_handle_t handle)
             media_lib_event_group_set_bits(peer->wait_event, PC_RESUME_BIT);
         }
         peer->running = false;
+        wake_loop(peer);
         if (still_running) {
             media_lib_event_group_wait_bits(peer->wait_event, PC_EXIT_BIT, MEDIA_LIB_MAX_LOCK_TIME);
             media_lib_event_group_clr_bits(peer->wait_event, PC_EXIT_BIT);
@@ -414,6 +446,7 @@ peer_err_t peer_handle_sdp(peer_handle_t handle, const char *sdp)
         ESP_LOGE(TAG(peer), "Failed to handle answer");
         return PEER_ERR_RTC;
     }
+    wake_loop(peer);
     return PEER_ERR_NONE;
 }
 
@@ -433,16 +466,13 @@ peer_err_t peer_handle_ice_candidate(peer_handle_t handle, const char *candidate
         ESP_LOGE(TAG(peer), "Failed to handle ICE candidate");
         return PEER_ERR_RTC;
     }
+    wake_loop(peer);
     return PEER_ERR_NONE;
 }
 
-peer_err_t peer_send_data_packet(peer_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable)
+/// Sends an encoded data packet over the data channel for the given reliability.
+static peer_err_t send_data(peer_t *peer, uint8_t *data, size_t size, bool reliable)
 {
-    if (handle == NULL || packet == NULL) {
-        return PEER_ERR_INVALID_ARG;
-    }
-    peer_t *peer = (peer_t *)handle;
-
     uint16_t stream_id = reliable ?
         peer->reliable_stream_id : peer->lossy_stream_id;
     if (stream_id == STREAM_ID_INVALID) {
@@ -451,36 +481,51 @@ peer_err_t peer_send_data_packet(peer_handle_t handle, const livekit_pb_data_pac
     }
     esp_peer_data_frame_t frame_info = {
         .type = ESP_PEER_DATA_CHANNEL_DATA,
-        .stream_id = stream_id
+        .stream_id = stream_id,
+        .data = data,
+        .size = size
     };
+    if (esp_peer_send_data(peer->connection, &frame_info) != ESP_PEER_ERR_NONE) {
+        ESP_LOGE(TAG(peer), "Data channel send failed");
+        return PEER_ERR_RTC;
+    }
+    wake_loop(peer);
+    return PEER_ERR_NONE;
+}
 
-    size_t encoded_size = protocol_data_packet_encoded_size(packet);
-    if (encoded_size == 0) {
-        return PEER_ERR_MESSAGE;
+peer_err_t peer_send_data_packet(peer_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable)
+{
+    if (handle == NULL || packet == NULL) {
+        return PEER_ERR_INVALID_ARG;
     }
-    uint8_t *enc_buf = (uint8_t *)malloc(encoded_size);
-    if (enc_buf == NULL) {
-        return PEER_ERR_NO_MEM;
+    peer_t *peer = (peer_t *)handle;
+
+    if (media_lib_mutex_lock(peer->enc_lock, MEDIA_LIB_MAX_LOCK_TIME) != 0) {
+        return PEER_ERR_INVALID_STATE;
     }
     int ret = PEER_ERR_NONE;
     do {
-        if (!protocol_data_packet_encode(packet, enc_buf, encoded_size)) {
+        size_t encoded_size = protocol_data_packet_encode_into(packet, &peer->enc_buf);
+        if (encoded_size == 0) {
             ret = PEER_ERR_MESSAGE;
             break;
         }
-        frame_info.data = enc_buf;
-        frame_info.size = encoded_size;
-        if (esp_peer_send_data(peer->connection, &frame_info) != ESP_PEER_ERR_NONE) {
-            ESP_LOGE(TAG(peer), "Data channel send failed");
-            ret = PEER_ERR_RTC;
-            break;
-        }
+        ret = send_data(peer, peer->enc_buf.data, encoded_size, reliable);
     } while (0);
 
-    free(enc_buf);
+    media_lib_mutex_unlock(peer->enc_lock);
     return ret;
 }
 
+peer_err_t peer_send_encoded_data_packet(peer_handle_t handle, const uint8_t *data, size_t size, bool reliable)
+{
+    if (handle == NULL || data == NULL) {
+        return PEER_ERR_INVALID_ARG;
+    }
+    peer_t *peer = (peer_t *)handle;
+    return send_data(peer, (uint8_t *)data, size, reliable);
+}
+
 peer_err_t peer_send_audio(peer_handle_t handle, esp_peer_audio_frame_t* frame)
 {
     if (handle == NULL) {
@@ -490,6 +535,8 @@ peer_err_t peer_send_audio(peer_handle_t handle, esp_peer_audio_frame_t* frame)
     assert(peer->options.role == PEER_ROLE_PUBLISHER);
 
     esp_peer_send_audio(peer->connection, frame);
+    // Let the loop transmit the queued packets now rather than on its next poll.
+    wake_loop(peer);
     return PEER_ERR_NONE;
 }
 
@@ -502,5 +549,6 @@ peer_err_t peer_send_video(peer_handle_t handle, esp_peer_video_frame_t* frame)
     assert(peer->options.role == PEER_ROLE_PUBLISHER);
 
     esp_peer_send_video(peer->connection, frame);
+    wake_loop(peer);
     return PEER_ERR_NONE;
 }
\ No newline at end of file
@@ -59,13 +59,18 @@ typedef struct {
     /// Invoked when the peer's connection state changes.
     void (*on_state_changed)(connection_state_t state, peer_role_t role, void *ctx);
 
+    /// Invoked when the underlying RTC connection's state changes (e.g., ICE
+    /// connected or DTLS handshake completed). Optional.
+    void (*on_rtc_state_changed)(esp_peer_state_t state, peer_role_t role, void *ctx);
+
     /// Invoked when a data packet is received over the data channel.
     ///
+    /// `reliable` indicates which data channel the packet was received on.
     /// The receiver returns true to take ownership of the packet. If
     /// ownership is not taken (false), the packet will be freed with
     /// `protocol_data_packet_free` internally.
     ///
-    bool (*on_data_packet)(livekit_pb_data_packet_t* packet, void *ctx);
+    bool (*on_data_packet)(livekit_pb_data_packet_t* packet, bool reliable, void *ctx);
 
     /// Invoked when an SDP message is available. This can be either
     /// an offer or answer depending on target configuration.
@@ -102,6 +107,9 @@ peer_err_t peer_handle_ice_candidate(peer_handle_t handle, const char *candidate
 /// Sends a data packet to the remote peer.
 peer_err_t peer_send_data_packet(peer_handle_t handle, const livekit_pb_data_packet_t* packet, bool reliable);
 
+/// Sends an already encoded data packet to the remote peer.
+peer_err_t peer_send_encoded_data_packet(peer_handle_t handle, const uint8_t *data, size_t size, bool reliable);
+
 /// Sends an audio frame to the remote peer.
 /// @warning Only use on publisher peer.
 peer_err_t peer_send_audio(peer_handle_t handle, esp_peer_audio_frame_t* frame);
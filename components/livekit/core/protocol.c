@@ -15,10 +15,12 @@
  */
 
 #include <inttypes.h>
+#include <string.h>
 #include "esp_log.h"
-#include "cJSON.h"
+#include "protocol_arena.h"
 #include "pb_encode.h"
 #include "pb_decode.h"
+#include "pb_common.h"
 
 #include "protocol.h"
 
@@ -36,24 +38,302 @@ static int32_t decode_first_tag(const pb_byte_t *buf, size_t len)
     return (int32_t)tag;
 }
 
-// MARK: - Data packet
+// MARK: - Decode arena
 
-__attribute__((always_inline))
-inline bool protocol_data_packet_decode(const uint8_t *buf, size_t len, livekit_pb_data_packet_t *out)
+#if CONFIG_LK_PROTOCOL_ARENA
+
+#define ARENA_ALIGN 8
+#define ARENA_ALIGN_UP(size) (((size) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+
+/// Smallest block added once the first block of an arena is full.
+#define ARENA_MIN_BLOCK_SIZE 256
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t capacity;
+    size_t used;
+} arena_block_t;
+
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN_UP(sizeof(arena_block_t))
+
+/// Allocations made for nanopb are preceded by their capacity so they can be
+/// grown without knowing their previous size.
+#define ARENA_ALLOC_HEADER_SIZE ARENA_ALIGN_UP(sizeof(size_t))
+
+typedef struct {
+    arena_block_t *head;
+    arena_block_t *tail;
+    /// Most recent allocation for nanopb, which is at the end of `tail` and can
+    /// therefore grow in place.
+    uint8_t *last;
+} arena_t;
+
+/// Arena nanopb allocates from while decoding on the current thread.
+static __thread arena_t *decode_arena;
+
+static arena_block_t *arena_add_block(arena_t *arena, size_t capacity)
+{
+    arena_block_t *block = malloc(ARENA_BLOCK_HEADER_SIZE + capacity);
+    if (block == NULL) {
+        return NULL;
+    }
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    if (arena->tail != NULL) {
+        arena->tail->next = block;
+    } else {
+        arena->head = block;
+    }
+    arena->tail = block;
+    return block;
+}
+
+static void *arena_alloc(arena_t *arena, size_t size)
+{
+    size = ARENA_ALIGN_UP(size);
+    arena_block_t *block = arena->tail;
+    if (block == NULL || block->capacity - block->used < size) {
+        // Blocks double in size so a message needs few of them.
+        size_t capacity = block != NULL ? block->capacity * 2 : ARENA_MIN_BLOCK_SIZE;
+        block = arena_add_block(arena, capacity > size ? capacity : size);
+        if (block == NULL) {
+            return NULL;
+        }
+    }
+    uint8_t *ptr = (uint8_t *)block + ARENA_BLOCK_HEADER_SIZE + block->used;
+    block->used += size;
+    return ptr;
+}
+
+static void arena_release(arena_block_t *block)
+{
+    while (block != NULL) {
+        arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+void *protocol_arena_realloc(void *ptr, size_t size)
+{
+    arena_t *arena = decode_arena;
+    if (arena == NULL) {
+        // Only reachable through livekit's copy of the decoder.
+        ESP_LOGE(TAG, "Allocation outside of decode");
+        return NULL;
+    }
+    size = ARENA_ALIGN_UP(size);
+    size_t *capacity = ptr != NULL ? (size_t *)((uint8_t *)ptr - ARENA_ALLOC_HEADER_SIZE) : NULL;
+    if (capacity != NULL) {
+        if (size <= *capacity) {
+            return ptr;
+        }
+        arena_block_t *block = arena->tail;
+        if (ptr == arena->last && block->capacity - block->used >= size - *capacity) {
+            block->used += size - *capacity;
+            *capacity = size;
+            return ptr;
+        }
+        // Repeated fields grow one item at a time; leave room for more.
+        if (size < *capacity * 2) {
+            size = *capacity * 2;
+        }
+    }
+    uint8_t *alloc = arena_alloc(arena, ARENA_ALLOC_HEADER_SIZE + size);
+    if (alloc == NULL) {
+        return NULL;
+    }
+    *(size_t *)alloc = size;
+    uint8_t *new_ptr = alloc + ARENA_ALLOC_HEADER_SIZE;
+    if (capacity != NULL) {
+        memcpy(new_ptr, ptr, *capacity);
+    }
+    arena->last = new_ptr;
+    return new_ptr;
+}
+
+void protocol_arena_free(void *ptr)
+{
+    // Memory is released with the whole arena.
+}
+
+#else
+
+void *protocol_arena_realloc(void *ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+void protocol_arena_free(void *ptr)
+{
+    free(ptr);
+}
+
+#endif
+
+typedef bool (*decode_fn_t)(pb_istream_t *stream, const pb_msgdesc_t *fields, void *msg);
+
+static bool decode_all_fields(pb_istream_t *stream, const pb_msgdesc_t *fields, void *msg)
 {
+    return pb_decode_ex(stream, fields, msg, PB_DECODE_NOINIT);
+}
+
+/// Decodes only the first field of a message into its oneof storage.
+///
+/// For a message that is a single oneof of submessages, such as a signal
+/// response, this is the field that is set. The submessage is decoded directly,
+/// without visiting the other fields of the message. A field missing from the
+/// bindings is skipped, leaving the oneof unset.
+///
+static bool decode_oneof_field(pb_istream_t *stream, const pb_msgdesc_t *fields, void *msg)
+{
+    pb_wire_type_t wire_type;
+    uint32_t tag;
+    bool eof = false;
+    if (!pb_decode_tag(stream, &wire_type, &tag, &eof) || eof) {
+        PB_RETURN_ERROR(stream, "missing field");
+    }
+    pb_field_iter_t iter;
+    if (wire_type != PB_WT_STRING ||
+        !pb_field_iter_begin(&iter, fields, msg) ||
+        !pb_field_iter_find(&iter, tag) ||
+        PB_HTYPE(iter.type) != PB_HTYPE_ONEOF ||
+        !PB_LTYPE_IS_SUBMSG(iter.type)) {
+        return true;
+    }
+    if (!pb_decode_ex(stream, iter.submsg_desc, iter.pData, PB_DECODE_DELIMITED | PB_DECODE_NOINIT)) {
+        return false;
+    }
+    *(pb_size_t *)iter.pSize = iter.tag;
+    return true;
+}
+
+/// Decodes a message into newly allocated storage.
+///
+/// With the arena enabled, the message and all of its pointer fields are placed
+/// in one arena, the message at the start of its first block, so the message is
+/// released in a single step by `free_message`. The storage is zeroed, which
+/// is the default value of every field in the proto3 bindings, so decoders do
+/// not need to initialize fields.
+///
+static bool decode_message(const pb_msgdesc_t *fields, size_t msg_size, decode_fn_t decode, const uint8_t *buf, size_t len, void **out, const char **error)
+{
+#if CONFIG_LK_PROTOCOL_ARENA
+    arena_t arena = {};
+    // Fields usually fit in 1.25 times the encoded size; more blocks are added if not.
+    size_t capacity = ARENA_ALIGN_UP(msg_size) + ARENA_ALIGN_UP(len + len / 4);
+    if (arena_add_block(&arena, capacity) == NULL) {
+        *error = "out of memory";
+        return false;
+    }
+    void *msg = arena_alloc(&arena, msg_size);
+    memset(msg, 0, msg_size);
+
+    decode_arena = &arena;
+    pb_istream_t stream = pb_istream_from_buffer((const pb_byte_t *)buf, len);
+    bool decoded = decode(&stream, fields, msg);
+    decode_arena = NULL;
+    if (!decoded) {
+        *error = PB_GET_ERROR(&stream);
+        arena_release(arena.head);
+        return false;
+    }
+#else
+    void *msg = calloc(1, msg_size);
+    if (msg == NULL) {
+        *error = "out of memory";
+        return false;
+    }
     pb_istream_t stream = pb_istream_from_buffer((const pb_byte_t *)buf, len);
-    if (!pb_decode(&stream, LIVEKIT_PB_DATA_PACKET_FIELDS, out)) {
+    if (!decode(&stream, fields, msg)) {
+        // Fields allocated before the failure are released by nanopb.
+        *error = PB_GET_ERROR(&stream);
+        free(msg);
+        return false;
+    }
+#endif
+    *out = msg;
+    return true;
+}
+
+static void free_message(const pb_msgdesc_t *fields, void *msg)
+{
+    if (msg == NULL) {
+        return;
+    }
+#if CONFIG_LK_PROTOCOL_ARENA
+    arena_release((arena_block_t *)((uint8_t *)msg - ARENA_BLOCK_HEADER_SIZE));
+#else
+    pb_release(fields, msg);
+    free(msg);
+#endif
+}
+
+// MARK: - Encode buffer
+
+bool protocol_enc_buf_init(protocol_enc_buf_t *buf, size_t capacity)
+{
+    buf->data = malloc(capacity);
+    buf->capacity = buf->data != NULL ? capacity : 0;
+    return buf->data != NULL;
+}
+
+void protocol_enc_buf_free(protocol_enc_buf_t *buf)
+{
+    free(buf->data);
+    buf->data = NULL;
+    buf->capacity = 0;
+}
+
+/// Encodes a message into the buffer, growing it only if the message does not fit.
+static size_t encode_into(const pb_msgdesc_t *fields, const void *msg, protocol_enc_buf_t *buf)
+{
+    pb_ostream_t stream = pb_ostream_from_buffer(buf->data, buf->capacity);
+    if (pb_encode(&stream, fields, msg)) {
+        return stream.bytes_written;
+    }
+
+    // Size the message to tell a full buffer apart from a message that cannot be encoded.
+    size_t encoded_size = 0;
+    if (!pb_get_encoded_size(&encoded_size, fields, msg) || encoded_size <= buf->capacity) {
+        ESP_LOGE(TAG, "Encode failed: error=%s", PB_GET_ERROR(&stream));
+        return 0;
+    }
+    size_t new_capacity = buf->capacity * 2 > encoded_size ? buf->capacity * 2 : encoded_size;
+    uint8_t *new_data = realloc(buf->data, new_capacity);
+    if (new_data == NULL) {
+        ESP_LOGE(TAG, "Failed to grow encode buffer: size=%zu", new_capacity);
+        return 0;
+    }
+    buf->data = new_data;
+    buf->capacity = new_capacity;
+
+    stream = pb_ostream_from_buffer(buf->data, buf->capacity);
+    if (!pb_encode(&stream, fields, msg)) {
+        ESP_LOGE(TAG, "Encode failed: error=%s", PB_GET_ERROR(&stream));
+        return 0;
+    }
+    return stream.bytes_written;
+}
+
+// MARK: - Data packet
+
+bool protocol_data_packet_decode(const uint8_t *buf, size_t len, livekit_pb_data_packet_t **out)
+{
+    const char *error = NULL;
+    if (!decode_message(LIVEKIT_PB_DATA_PACKET_FIELDS, sizeof(livekit_pb_data_packet_t), decode_all_fields,
+            buf, len, (void **)out, &error)) {
         ESP_LOGE(TAG, "Failed to decode data packet: type=%" PRId32 ", error=%s",
-            decode_first_tag(buf, len), stream.errmsg);
+            decode_first_tag(buf, len), error);
         return false;
     }
     return true;
 }
 
-__attribute__((always_inline))
-inline void protocol_data_packet_free(livekit_pb_data_packet_t *packet)
+void protocol_data_packet_free(livekit_pb_data_packet_t *packet)
 {
-    pb_release(LIVEKIT_PB_DATA_PACKET_FIELDS, packet);
+    free_message(LIVEKIT_PB_DATA_PACKET_FIELDS, packet);
 }
 
 __attribute__((always_inline))
@@ -78,61 +358,423 @@ inline bool protocol_data_packet_encode(const livekit_pb_data_packet_t *packet,
     return stream.bytes_written == encoded_size;
 }
 
+size_t protocol_data_packet_encode_into(const livekit_pb_data_packet_t *packet, protocol_enc_buf_t *buf)
+{
+    size_t encoded_size = encode_into(LIVEKIT_PB_DATA_PACKET_FIELDS, packet, buf);
+    if (encoded_size == 0) {
+        ESP_LOGE(TAG, "Failed to encode data packet: type=%" PRIu16, packet->which_value);
+    }
+    return encoded_size;
+}
+
 // MARK: - Signal response
 
-__attribute__((always_inline))
-inline bool protocol_signal_response_decode(const uint8_t *buf, size_t len, livekit_pb_signal_response_t* out)
+pb_size_t protocol_signal_response_peek_type(const uint8_t *buf, size_t len)
 {
-    pb_istream_t stream = pb_istream_from_buffer((const pb_byte_t *)buf, len);
-    if (!pb_decode(&stream, LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, out)) {
+    int32_t tag = decode_first_tag(buf, len);
+    return tag > 0 ? (pb_size_t)tag : 0;
+}
+
+bool protocol_signal_response_decode(const uint8_t *buf, size_t len, livekit_pb_signal_response_t **out)
+{
+    const char *error = NULL;
+    if (!decode_message(LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, sizeof(livekit_pb_signal_response_t), decode_oneof_field,
+            buf, len, (void **)out, &error)) {
         ESP_LOGE(TAG, "Failed to decode signal res: type=%" PRId32 ", error=%s",
-            decode_first_tag(buf, len), stream.errmsg);
+            decode_first_tag(buf, len), error);
         return false;
     }
     return true;
 }
 
-__attribute__((always_inline))
-inline void protocol_signal_response_free(livekit_pb_signal_response_t *res)
+void protocol_signal_response_free(livekit_pb_signal_response_t *res)
+{
+    free_message(LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, res);
+}
+
+// MARK: - ICE candidate
+
+// The candidate is parsed by scanning the JSON in place rather than building a
+// tree: values of interest are returned as slices and everything else is only
+// validated and skipped.
+
+/// Maximum nesting of objects and arrays, including the top-level object.
+#define JSON_MAX_DEPTH 16
+
+typedef struct {
+    const char *pos;
+    const char *end;
+} json_scanner_t;
+
+static inline bool json_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static int json_hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/// Reads the four hex digits following "\u" at `p`, returning -1 if invalid.
+static int32_t json_read_utf16(const char *p, const char *end)
+{
+    if (end - p < 6 || p[0] != '\\' || p[1] != 'u') {
+        return -1;
+    }
+    int32_t unit = 0;
+    for (int i = 2; i < 6; i++) {
+        int digit = json_hex_value(p[i]);
+        if (digit < 0) {
+            return -1;
+        }
+        unit = (unit << 4) | digit;
+    }
+    return unit;
+}
+
+/// Reads a "\u" escape, combining a surrogate pair into a single code point.
+///
+/// @returns The code point or -1 if the escape is invalid; `*escape_len` is set to
+///          the number of bytes consumed.
+///
+static int32_t json_read_code_point(const char *p, const char *end, size_t *escape_len)
 {
-    pb_release(LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, res);
+    int32_t high = json_read_utf16(p, end);
+    if (high < 0 || (high >= 0xDC00 && high <= 0xDFFF)) {
+        return -1;
+    }
+    *escape_len = 6;
+    if (high < 0xD800 || high > 0xDBFF) {
+        return high;
+    }
+    int32_t low = json_read_utf16(p + 6, end);
+    if (low < 0xDC00 || low > 0xDFFF) {
+        return -1;
+    }
+    *escape_len = 12;
+    return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
 }
 
-bool protocol_signal_trickle_get_candidate(const livekit_pb_trickle_request_t *trickle, char **candidate_out)
+static void json_skip_whitespace(json_scanner_t *s)
 {
-    if (trickle == NULL || candidate_out == NULL) {
+    while (s->pos < s->end &&
+           (*s->pos == ' ' || *s->pos == '\t' || *s->pos == '\n' || *s->pos == '\r')) {
+        s->pos++;
+    }
+}
+
+/// Consumes `c` after any whitespace.
+static bool json_consume(json_scanner_t *s, char c)
+{
+    json_skip_whitespace(s);
+    if (s->pos >= s->end || *s->pos != c) {
         return false;
     }
-    if (trickle->candidate_init == NULL) {
-        ESP_LOGE(TAG, "candidate_init is NULL");
+    s->pos++;
+    return true;
+}
+
+/// Scans a string, returning its contents without the quotes.
+static bool json_scan_string(json_scanner_t *s, const char **str, size_t *len)
+{
+    if (!json_consume(s, '"')) {
+        return false;
+    }
+    const char *start = s->pos;
+    for (;;) {
+        while (s->pos < s->end && *s->pos != '"' && *s->pos != '\\' && (unsigned char)*s->pos >= 0x20) {
+            s->pos++;
+        }
+        if (s->pos >= s->end || (unsigned char)*s->pos < 0x20) {
+            return false;
+        }
+        if (*s->pos == '"') {
+            *str = start;
+            *len = s->pos - start;
+            s->pos++;
+            return true;
+        }
+        if (s->end - s->pos < 2) {
+            return false;
+        }
+        switch (s->pos[1]) {
+            case '"': case '\\': case '/':
+            case 'b': case 'f': case 'n': case 'r': case 't':
+                s->pos += 2;
+                break;
+            case 'u': {
+                size_t escape_len;
+                if (json_read_code_point(s->pos, s->end, &escape_len) < 0) {
+                    return false;
+                }
+                s->pos += escape_len;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+}
+
+/// Scans a number, returning its value if it is a non-negative integer that
+/// fits in `int32_t` or -1 otherwise.
+static bool json_scan_number(json_scanner_t *s, int32_t *value)
+{
+    json_skip_whitespace(s);
+    const char *p = s->pos;
+    bool is_index = true;
+    int64_t result = 0;
+
+    if (p < s->end && *p == '-') {
+        is_index = false;
+        p++;
+    }
+    if (p >= s->end || !json_is_digit(*p)) {
         return false;
     }
+    if (*p == '0') {
+        p++;
+    } else {
+        while (p < s->end && json_is_digit(*p)) {
+            result = result * 10 + (*p - '0');
+            if (result > INT32_MAX) {
+                is_index = false;
+                result = 0;
+            }
+            p++;
+        }
+    }
+    if (p < s->end && *p == '.') {
+        is_index = false;
+        if (++p >= s->end || !json_is_digit(*p)) {
+            return false;
+        }
+        while (p < s->end && json_is_digit(*p)) p++;
+    }
+    if (p < s->end && (*p == 'e' || *p == 'E')) {
+        is_index = false;
+        p++;
+        if (p < s->end && (*p == '+' || *p == '-')) p++;
+        if (p >= s->end || !json_is_digit(*p)) {
+            return false;
+        }
+        while (p < s->end && json_is_digit(*p)) p++;
+    }
+    s->pos = p;
+    *value = is_index ? (int32_t)result : -1;
+    return true;
+}
 
-    bool ret = false;
-    cJSON *candidate_init = NULL;
+/// Consumes the literal `word` (e.g., "null") after any whitespace.
+static bool json_consume_literal(json_scanner_t *s, const char *word)
+{
+    json_skip_whitespace(s);
+    size_t len = strlen(word);
+    if ((size_t)(s->end - s->pos) < len || memcmp(s->pos, word, len) != 0) {
+        return false;
+    }
+    s->pos += len;
+    return true;
+}
+
+static bool json_skip_value(json_scanner_t *s, int depth);
+
+/// Skips the members of an object or elements of an array after its opening bracket.
+static bool json_skip_container(json_scanner_t *s, char close, int depth)
+{
+    if (depth > JSON_MAX_DEPTH) {
+        return false;
+    }
+    if (json_consume(s, close)) {
+        return true;
+    }
     do {
-        candidate_init = cJSON_Parse(trickle->candidate_init);
-        if (candidate_init == NULL) {
-            const char *error_ptr = cJSON_GetErrorPtr();
-            if (error_ptr != NULL) {
-                ESP_LOGE(TAG, "Failed to parse candidate_init: %s", error_ptr);
+        if (close == '}') {
+            const char *key;
+            size_t key_len;
+            if (!json_scan_string(s, &key, &key_len) || !json_consume(s, ':')) {
+                return false;
             }
-            break;
         }
-        cJSON *candidate = cJSON_GetObjectItemCaseSensitive(candidate_init, "candidate");
-        if (!cJSON_IsString(candidate) || (candidate->valuestring == NULL)) {
-            ESP_LOGE(TAG, "Missing candidate key in candidate_init");
-            break;
+        if (!json_skip_value(s, depth)) {
+            return false;
         }
-        *candidate_out = strdup(candidate->valuestring);
-        if (*candidate_out == NULL) {
-            break;
+    } while (json_consume(s, ','));
+    return json_consume(s, close);
+}
+
+static bool json_skip_value(json_scanner_t *s, int depth)
+{
+    json_skip_whitespace(s);
+    if (s->pos >= s->end) {
+        return false;
+    }
+    const char *str;
+    size_t len;
+    int32_t number;
+    switch (*s->pos) {
+        case '"': return json_scan_string(s, &str, &len);
+        case '{': s->pos++; return json_skip_container(s, '}', depth + 1);
+        case '[': s->pos++; return json_skip_container(s, ']', depth + 1);
+        case 't': return json_consume_literal(s, "true");
+        case 'f': return json_consume_literal(s, "false");
+        case 'n': return json_consume_literal(s, "null");
+        default:  return json_scan_number(s, &number);
+    }
+}
+
+/// Maximum unescaped length of a key compared against the keys of interest.
+#define JSON_KEY_MAX_LEN 16
+
+static bool json_key_equals(const char *key, size_t key_len, const char *name)
+{
+    if (memchr(key, '\\', key_len) == NULL) {
+        return key_len == strlen(name) && memcmp(key, name, key_len) == 0;
+    }
+    char unescaped[JSON_KEY_MAX_LEN + 1];
+    return protocol_json_string_copy(key, key_len, unescaped, sizeof(unescaped)) &&
+           strcmp(unescaped, name) == 0;
+}
+
+bool protocol_ice_candidate_parse(const char *json, size_t len, protocol_ice_candidate_t *out)
+{
+    if (json == NULL || out == NULL) {
+        return false;
+    }
+    *out = (protocol_ice_candidate_t){ .sdp_mline_index = -1 };
+
+    json_scanner_t s = { .pos = json, .end = json + len };
+    bool has_candidate = false, has_sdp_mid = false, has_sdp_mline_index = false;
+
+    if (!json_consume(&s, '{')) {
+        return false;
+    }
+    if (!json_consume(&s, '}')) {
+        do {
+            const char *key;
+            size_t key_len;
+            if (!json_scan_string(&s, &key, &key_len) || !json_consume(&s, ':')) {
+                return false;
+            }
+            bool ok;
+            if (!has_candidate && json_key_equals(key, key_len, "candidate")) {
+                ok = has_candidate = json_scan_string(&s, &out->candidate, &out->candidate_len);
+            } else if (!has_sdp_mid && json_key_equals(key, key_len, "sdpMid")) {
+                has_sdp_mid = true;
+                ok = json_consume_literal(&s, "null") ||
+                     json_scan_string(&s, &out->sdp_mid, &out->sdp_mid_len);
+            } else if (!has_sdp_mline_index && json_key_equals(key, key_len, "sdpMLineIndex")) {
+                has_sdp_mline_index = true;
+                ok = json_consume_literal(&s, "null") ||
+                     (json_scan_number(&s, &out->sdp_mline_index) && out->sdp_mline_index >= 0);
+            } else {
+                ok = json_skip_value(&s, 1);
+            }
+            if (!ok) {
+                return false;
+            }
+        } while (json_consume(&s, ','));
+
+        if (!json_consume(&s, '}')) {
+            return false;
         }
-        ret = true;
-    } while(0);
+    }
+    // Anything after the object is ignored.
+    return has_candidate;
+}
 
-    cJSON_Delete(candidate_init);
-    return ret;
+bool protocol_signal_trickle_get_candidate(const livekit_pb_trickle_request_t *trickle, protocol_ice_candidate_t *out)
+{
+    if (trickle == NULL || out == NULL) {
+        return false;
+    }
+    if (trickle->candidate_init == NULL) {
+        ESP_LOGE(TAG, "candidate_init is NULL");
+        return false;
+    }
+    if (!protocol_ice_candidate_parse(trickle->candidate_init, strlen(trickle->candidate_init), out)) {
+        ESP_LOGE(TAG, "Failed to parse candidate_init: %s", trickle->candidate_init);
+        return false;
+    }
+    return true;
+}
+
+bool protocol_json_string_copy(const char *str, size_t len, char *dest, size_t dest_size)
+{
+    if (str == NULL || dest == NULL || dest_size == 0) {
+        return false;
+    }
+    const char *end = str + len;
+    size_t out = 0;
+    for (;;) {
+        // Each escape is at least as long as what it decodes to, so writing never
+        // overtakes reading when `dest` is `str`.
+        const char *escape = memchr(str, '\\', end - str);
+        size_t run = (escape != NULL ? escape : end) - str;
+        if (dest_size - out <= run) {
+            return false;
+        }
+        memmove(dest + out, str, run);
+        out += run;
+        str += run;
+        if (str == end) {
+            break;
+        }
+        char buf[4];
+        size_t buf_len = 1;
+        if (end - str < 2) {
+            return false;
+        } else if (str[1] != 'u') {
+            switch (str[1]) {
+                case '"':  buf[0] = '"';  break;
+                case '\\': buf[0] = '\\'; break;
+                case '/':  buf[0] = '/';  break;
+                case 'b':  buf[0] = '\b'; break;
+                case 'f':  buf[0] = '\f'; break;
+                case 'n':  buf[0] = '\n'; break;
+                case 'r':  buf[0] = '\r'; break;
+                case 't':  buf[0] = '\t'; break;
+                default: return false;
+            }
+            str += 2;
+        } else {
+            size_t escape_len;
+            int32_t cp = json_read_code_point(str, end, &escape_len);
+            if (cp <= 0) {
+                return false;
+            }
+            if (cp < 0x80) {
+                buf[0] = (char)cp;
+            } else if (cp < 0x800) {
+                buf[0] = (char)(0xC0 | (cp >> 6));
+                buf[1] = (char)(0x80 | (cp & 0x3F));
+                buf_len = 2;
+            } else if (cp < 0x10000) {
+                buf[0] = (char)(0xE0 | (cp >> 12));
+                buf[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                buf[2] = (char)(0x80 | (cp & 0x3F));
+                buf_len = 3;
+            } else {
+                buf[0] = (char)(0xF0 | (cp >> 18));
+                buf[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+                buf[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                buf[3] = (char)(0x80 | (cp & 0x3F));
+                buf_len = 4;
+            }
+            str += escape_len;
+        }
+        if (dest_size - out <= buf_len) {
+            return false;
+        }
+        memcpy(dest + out, buf, buf_len);
+        out += buf_len;
+    }
+    dest[out] = '\0';
+    return true;
 }
 
 // MARK: - Signal request
@@ -158,3 +800,21 @@ inline bool protocol_signal_request_encode(const livekit_pb_signal_request_t *re
     }
     return stream.bytes_written == encoded_size;
 }
+
+size_t protocol_signal_request_try_encode(const livekit_pb_signal_request_t *req, uint8_t *dest, size_t capacity)
+{
+    pb_ostream_t stream = pb_ostream_from_buffer((pb_byte_t *)dest, capacity);
+    if (!pb_encode(&stream, LIVEKIT_PB_SIGNAL_REQUEST_FIELDS, req)) {
+        return 0;
+    }
+    return stream.bytes_written;
+}
+
+size_t protocol_signal_request_encode_into(const livekit_pb_signal_request_t *req, protocol_enc_buf_t *buf)
+{
+    size_t encoded_size = encode_into(LIVEKIT_PB_SIGNAL_REQUEST_FIELDS, req, buf);
+    if (encoded_size == 0) {
+        ESP_LOGE(TAG, "Failed to encode signal req: type=%" PRIu16, req->which_message);
+    }
+    return encoded_size;
+}
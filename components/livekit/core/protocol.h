@@ -28,15 +28,32 @@ extern "C" {
 /// Server identifier (SID) type.
 typedef char livekit_pb_sid_t[16];
 
+/// Growable buffer reused across encode calls.
+typedef struct {
+    uint8_t *data;
+    size_t capacity;
+} protocol_enc_buf_t;
+
+// MARK: - Encode buffer
+
+/// Allocates an encode buffer with the given initial capacity.
+bool protocol_enc_buf_init(protocol_enc_buf_t *buf, size_t capacity);
+
+/// Frees an encode buffer.
+void protocol_enc_buf_free(protocol_enc_buf_t *buf);
+
 // MARK: - Data packet
 
-/// Decodes a data packet.
+/// Decodes a data packet into newly allocated storage.
 ///
 /// When the packet is no longer needed, free using `protocol_data_packet_free`.
 ///
-bool protocol_data_packet_decode(const uint8_t *buf, size_t len, livekit_pb_data_packet_t *out);
+bool protocol_data_packet_decode(const uint8_t *buf, size_t len, livekit_pb_data_packet_t **out);
 
-/// Frees a data packet.
+/// Frees a decoded data packet, including the packet itself.
+///
+/// Fields of the packet must not be freed or replaced individually.
+///
 void protocol_data_packet_free(livekit_pb_data_packet_t *packet);
 
 /// Returns the encoded size of a data packet.
@@ -48,26 +65,85 @@ size_t protocol_data_packet_encoded_size(const livekit_pb_data_packet_t *packet)
 /// Encodes a data packet into the provided buffer.
 bool protocol_data_packet_encode(const livekit_pb_data_packet_t *packet, uint8_t *dest, size_t encoded_size);
 
+/// Encodes a data packet into a reusable buffer in a single pass.
+///
+/// The encoded size is only computed when the packet does not fit, in which case
+/// the buffer is grown before encoding again.
+///
+/// @returns The number of bytes written to `buf->data` or 0 on failure.
+///
+size_t protocol_data_packet_encode_into(const livekit_pb_data_packet_t *packet, protocol_enc_buf_t *buf);
+
 // MARK: - Signal response
 
-/// Decodes a signal response.
+/// Returns the type of an encoded signal response without decoding it.
+///
+/// @returns The tag of the response's message (e.g., `LIVEKIT_PB_SIGNAL_RESPONSE_JOIN_TAG`)
+///          or 0 if it cannot be read.
+///
+pb_size_t protocol_signal_response_peek_type(const uint8_t *buf, size_t len);
+
+/// Decodes a signal response into newly allocated storage.
 ///
 /// When the response is no longer needed, free using `protocol_signal_response_free`.
 ///
-bool protocol_signal_response_decode(const uint8_t *buf, size_t len, livekit_pb_signal_response_t* out);
+bool protocol_signal_response_decode(const uint8_t *buf, size_t len, livekit_pb_signal_response_t **out);
 
-/// Frees a signal response.
+/// Frees a decoded signal response, including the response itself.
+///
+/// Fields of the response must not be freed or replaced individually.
+///
 void protocol_signal_response_free(livekit_pb_signal_response_t *res);
 
-/// Extract ICE candidate string from a trickle request.
+/// ICE candidate parsed from the `candidate_init` JSON of a trickle request.
+///
+/// Strings are slices of the JSON they were parsed from: they are not NUL-terminated
+/// and JSON escapes are not yet resolved. Use `protocol_json_string_copy` to get a
+/// C string.
+///
+typedef struct {
+    /// Candidate attribute (e.g., "candidate:1 1 udp ...").
+    const char *candidate;
+    size_t candidate_len;
+
+    /// Media stream identification tag, or NULL if absent or null.
+    const char *sdp_mid;
+    size_t sdp_mid_len;
+
+    /// Index of the media description, or -1 if absent or null.
+    int32_t sdp_mline_index;
+} protocol_ice_candidate_t;
+
+/// Parses an `RTCIceCandidateInit` JSON object without allocating.
+///
+/// The whole object is validated, but at most `len` bytes are read and nesting
+/// is limited. Unknown keys are skipped; for repeated keys the first one is used.
 ///
-/// The caller is responsible for freeing the candidate string if it is not NULL.
+/// @returns False if the JSON is malformed, `candidate` is missing or not a string,
+///          or `sdpMid` or `sdpMLineIndex` has an unexpected type.
+///
+bool protocol_ice_candidate_parse(const char *json, size_t len, protocol_ice_candidate_t *out);
+
+/// Parses the ICE candidate of a trickle request.
+///
+/// Strings in `out` point into `trickle->candidate_init`.
 ///
 bool protocol_signal_trickle_get_candidate(
     const livekit_pb_trickle_request_t *trickle,
-    char **candidate_out
+    protocol_ice_candidate_t *out
 );
 
+/// Copies a string slice from `protocol_ice_candidate_t` into `dest`, resolving
+/// JSON escapes and NUL-terminating it.
+///
+/// The result is never longer than the slice, so `dest` may be the slice itself
+/// when its storage is writable and has room for the terminator.
+///
+/// @returns False if the string does not fit in `dest_size` bytes or contains an
+///          invalid escape (including an escaped NUL).
+///
+bool protocol_json_string_copy(const char *str, size_t len, char *dest, size_t dest_size);
+
 // MARK: - Signal request
 
 /// Returns the encoded size of a signal request.
@@ -79,6 +155,25 @@ size_t protocol_signal_request_encoded_size(const livekit_pb_signal_request_t *r
 /// Encodes a signal request into the provided buffer.
 bool protocol_signal_request_encode(const livekit_pb_signal_request_t *req, uint8_t *dest, size_t encoded_size);
 
+/// Encodes a signal request into a fixed-size buffer in a single pass.
+///
+/// Unlike `protocol_signal_request_encode`, the encoded size need not be known and a
+/// request that does not fit is not logged as an error.
+///
+/// @returns The number of bytes written to `dest` or 0 if the request does not fit
+///          or cannot be encoded.
+///
+size_t protocol_signal_request_try_encode(const livekit_pb_signal_request_t *req, uint8_t *dest, size_t capacity);
+
+/// Encodes a signal request into a reusable buffer in a single pass.
+///
+/// The encoded size is only computed when the request does not fit, in which case
+/// the buffer is grown before encoding again.
+///
+/// @returns The number of bytes written to `buf->data` or 0 on failure.
+///
+size_t protocol_signal_request_encode_into(const livekit_pb_signal_request_t *req, protocol_enc_buf_t *buf);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
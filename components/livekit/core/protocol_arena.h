@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+// Included ahead of nanopb's headers by protocol.c and by protocol_decode.c,
+// which compiles livekit's own copy of nanopb's decoder. In that copy, memory
+// for pointer fields is taken from the arena of the message being decoded
+// rather than allocated field by field. Its functions are renamed so they do
+// not clash with the shared nanopb library, whose allocator is left as is for
+// other users. Implemented in protocol.c.
+
+#include <stddef.h>
+
+void *protocol_arena_realloc(void *ptr, size_t size);
+void protocol_arena_free(void *ptr);
+
+#define pb_realloc(ptr, size) protocol_arena_realloc(ptr, size)
+#define pb_free(ptr) protocol_arena_free(ptr)
+
+#define pb_read                    lk_pb_read
+#define pb_istream_from_buffer     lk_pb_istream_from_buffer
+#define pb_decode_varint32         lk_pb_decode_varint32
+#define pb_decode_varint           lk_pb_decode_varint
+#define pb_decode_tag              lk_pb_decode_tag
+#define pb_skip_field              lk_pb_skip_field
+#define pb_make_string_substream   lk_pb_make_string_substream
+#define pb_close_string_substream  lk_pb_close_string_substream
+#define pb_decode_ex               lk_pb_decode_ex
+#define pb_decode                  lk_pb_decode
+#define pb_release                 lk_pb_release
+#define pb_decode_bool             lk_pb_decode_bool
+#define pb_decode_svarint          lk_pb_decode_svarint
+#define pb_decode_fixed32          lk_pb_decode_fixed32
+#define pb_decode_fixed64          lk_pb_decode_fixed64
+#define pb_decode_double_as_float  lk_pb_decode_double_as_float
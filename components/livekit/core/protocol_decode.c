@@ -0,0 +1,28 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// LiveKit's own copy of nanopb's decoder, used by protocol.c. Pointer fields
+// are allocated from the decode arena and functions are renamed (see
+// protocol_arena.h), so the shared nanopb library is not affected. Built with
+// the same options as the shared library. The renames depend on the decoder's
+// internals, so the nanopb version is pinned in idf_component.yml.
+
+#define PB_BUFFER_ONLY 1
+#define PB_VALIDATE_UTF8 1
+#define PB_ENABLE_MALLOC 1
+
+#include "protocol_arena.h"
+#include "pb_decode.c"
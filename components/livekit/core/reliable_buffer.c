@@ -0,0 +1,164 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include "reliable_buffer.h"
+
+#define ENTRY_ALIGN 4
+
+/// Size value marking that the next entry starts at offset zero.
+#define WRAP_MARKER UINT32_MAX
+
+typedef struct {
+    uint32_t size;
+} entry_header_t;
+
+static inline size_t entry_length(size_t size)
+{
+    return (sizeof(entry_header_t) + size + ENTRY_ALIGN - 1) & ~(size_t)(ENTRY_ALIGN - 1);
+}
+
+static inline entry_header_t *header_at(const reliable_buffer_t *buf, size_t offset)
+{
+    return (entry_header_t *)(buf->data + offset);
+}
+
+/// Removes the oldest entry.
+static void remove_oldest(reliable_buffer_t *buf)
+{
+    buf->used -= entry_length(header_at(buf, buf->head)->size);
+    buf->count--;
+    if (buf->count == 0) {
+        buf->head = buf->tail = 0;
+        return;
+    }
+    buf->head += entry_length(header_at(buf, buf->head)->size);
+    if (buf->head + sizeof(entry_header_t) > buf->capacity ||
+        header_at(buf, buf->head)->size == WRAP_MARKER) {
+        buf->head = 0;
+    }
+}
+
+/// Finds an offset with `length` contiguous free bytes.
+static bool find_space(reliable_buffer_t *buf, size_t length, size_t *offset)
+{
+    if (buf->count == 0) {
+        *offset = 0;
+        return true;
+    }
+    if (buf->tail > buf->head) {
+        // Free space is at the end and before the oldest entry.
+        if (buf->capacity - buf->tail >= length) {
+            *offset = buf->tail;
+            return true;
+        }
+        if (buf->head >= length) {
+            *offset = 0;
+            return true;
+        }
+        return false;
+    }
+    // Wrapped; free space is between the newest and oldest entries.
+    if (buf->head - buf->tail >= length) {
+        *offset = buf->tail;
+        return true;
+    }
+    return false;
+}
+
+bool reliable_buffer_init(reliable_buffer_t *buf, size_t capacity)
+{
+    if (buf == NULL) {
+        return false;
+    }
+    *buf = (reliable_buffer_t){};
+    buf->capacity = capacity & ~(size_t)(ENTRY_ALIGN - 1);
+    buf->data = malloc(buf->capacity);
+    return buf->data != NULL;
+}
+
+void reliable_buffer_deinit(reliable_buffer_t *buf)
+{
+    if (buf == NULL) {
+        return;
+    }
+    free(buf->data);
+    *buf = (reliable_buffer_t){};
+}
+
+bool reliable_buffer_fits(const reliable_buffer_t *buf, size_t size)
+{
+    return size < WRAP_MARKER && entry_length(size) <= buf->capacity;
+}
+
+uint8_t *reliable_buffer_reserve(reliable_buffer_t *buf, size_t size)
+{
+    size_t length = entry_length(size);
+    if (!reliable_buffer_fits(buf, size)) {
+        buf->dropped++;
+        return NULL;
+    }
+    size_t offset;
+    while (!find_space(buf, length, &offset)) {
+        remove_oldest(buf);
+        buf->dropped++;
+    }
+    buf->reserved = offset;
+    return (uint8_t *)(header_at(buf, offset) + 1);
+}
+
+void reliable_buffer_commit(reliable_buffer_t *buf, size_t size)
+{
+    size_t offset = buf->reserved;
+    if (buf->count == 0) {
+        buf->head = offset;
+    } else if (offset != buf->tail && buf->tail + sizeof(entry_header_t) <= buf->capacity) {
+        header_at(buf, buf->tail)->size = WRAP_MARKER;
+    }
+    *header_at(buf, offset) = (entry_header_t){ .size = size };
+    buf->tail = offset + entry_length(size);
+    buf->count++;
+    buf->used += entry_length(size);
+    if (buf->used > buf->high_water) {
+        buf->high_water = buf->used;
+    }
+}
+
+bool reliable_buffer_peek(const reliable_buffer_t *buf, const uint8_t **data, size_t *size)
+{
+    if (buf->count == 0) {
+        return false;
+    }
+    entry_header_t *header = header_at(buf, buf->head);
+    *data = (const uint8_t *)(header + 1);
+    *size = header->size;
+    return true;
+}
+
+void reliable_buffer_pop(reliable_buffer_t *buf)
+{
+    if (buf->count == 0) {
+        return;
+    }
+    remove_oldest(buf);
+}
+
+void reliable_buffer_clear(reliable_buffer_t *buf)
+{
+    buf->head = buf->tail = 0;
+    buf->count = 0;
+    buf->used = 0;
+}
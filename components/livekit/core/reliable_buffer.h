@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Ring of encoded reliable data packets waiting to be sent.
+///
+/// Entries are stored back to back in a single allocation in the order they are
+/// added and removed from the front once sent. When space is needed, the oldest
+/// entries are evicted.
+///
+/// @note Not thread-safe; callers must synchronize access.
+///
+typedef struct {
+    uint8_t *data;
+    size_t capacity;
+
+    /// Offset of the oldest entry.
+    size_t head;
+    /// Offset at which the next entry will be written.
+    size_t tail;
+    /// Offset of the space returned by the last reservation.
+    size_t reserved;
+
+    size_t count;
+    size_t used;
+
+    /// Highest number of bytes in use at once.
+    size_t high_water;
+    /// Number of entries evicted or rejected before being sent.
+    uint32_t dropped;
+} reliable_buffer_t;
+
+/// Allocates storage for the buffer.
+bool reliable_buffer_init(reliable_buffer_t *buf, size_t capacity);
+
+/// Frees the buffer's storage.
+void reliable_buffer_deinit(reliable_buffer_t *buf);
+
+/// Whether an entry of the given size can fit in the buffer once older entries are evicted.
+bool reliable_buffer_fits(const reliable_buffer_t *buf, size_t size);
+
+/// Reserves space for a new entry, evicting the oldest entries if needed.
+///
+/// The entry is added once written with `reliable_buffer_commit`.
+///
+/// @returns Pointer to `size` bytes to write the encoded packet into, or NULL if the
+///          entry can never fit (counted as dropped).
+///
+uint8_t *reliable_buffer_reserve(reliable_buffer_t *buf, size_t size);
+
+/// Adds the entry written to the space returned by the last call to `reliable_buffer_reserve`.
+void reliable_buffer_commit(reliable_buffer_t *buf, size_t size);
+
+/// Gets the oldest entry.
+///
+/// @returns Whether there is an entry.
+///
+bool reliable_buffer_peek(const reliable_buffer_t *buf, const uint8_t **data, size_t *size);
+
+/// Removes the oldest entry once it has been sent.
+void reliable_buffer_pop(reliable_buffer_t *buf);
+
+/// Removes all entries without counting them as dropped.
+void reliable_buffer_clear(reliable_buffer_t *buf);
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,20 +14,171 @@
  * limitations under the License.
  */
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
 #include <esp_log.h>
 #include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <khash.h>
 #include "esp_timer.h"
+#include "timer_wheel.h"
+#include "utils.h"
 #include "rpc_manager.h"
 
 static const char* TAG = "livekit_rpc";
 
-KHASH_MAP_INIT_STR(handlers, livekit_rpc_handler_t)
+/// Resolution of outbound invocation timeouts.
+#define TIMEOUT_TICK_MS 100
 
+/// Time allowed for the recipient to acknowledge an invocation.
+#define ACK_TIMEOUT_MS 7000
+
+/// Response timeout used when none is specified.
+#define DEFAULT_RESPONSE_TIMEOUT_MS 15000
+
+/// Outbound invocation awaiting a response.
+typedef struct {
+    /// Ack deadline until acknowledged, then the response deadline.
+    timer_wheel_node_t timeout;
+    char id[LIVEKIT_RPC_ID_SIZE];
+    bool is_acked;
+    /// Wheel tick at which the response is due.
+    uint32_t response_deadline;
+} pending_call_t;
+
+/// Registered RPC method.
+///
+/// Entries are kept until the manager is destroyed so invocations in flight
+/// can always reach them; unregistering only clears `handler`.
+///
+typedef struct {
+    char *name;
+    livekit_rpc_handler_t handler;
+    uint32_t max_concurrent;
+    livekit_rpc_method_stats_t stats;
+} rpc_method_t;
+
+KHASH_MAP_INIT_STR(handlers, rpc_method_t *)
+KHASH_MAP_INIT_STR(pending, pending_call_t *)
+
+typedef struct rpc_manager rpc_manager_t;
+
+/// Inbound invocation, kept until its handler has returned and its result is sent.
 typedef struct {
+    livekit_rpc_invocation_t invocation;
+    rpc_manager_t *manager;
+    rpc_method_t *method;
+    int64_t received_us;
+    uint8_t refs;
+    bool is_result_sent;
+    char id[LIVEKIT_RPC_ID_SIZE];
+    // Followed by the method name, caller identity, and payload.
+} rpc_request_t;
+
+struct rpc_manager {
     rpc_manager_options_t options;
+
+    /// Registered methods keyed by name, guarded by `handlers_lock` along with
+    /// the state of inbound invocations.
     khash_t(handlers) *handlers;
-} rpc_manager_t;
+    SemaphoreHandle_t handlers_lock;
+
+#if CONFIG_LK_RPC_WORKER_COUNT > 0
+    /// Queue of inbound invocations awaiting a worker.
+    QueueHandle_t request_queue;
+    bool is_running;
+    int worker_count;
+    SemaphoreHandle_t worker_exited;
+#endif
+
+    /// Outbound invocations keyed by ID, guarded by `pending_lock`.
+    khash_t(pending) *pending;
+    timer_wheel_t timeouts;
+    SemaphoreHandle_t pending_lock;
+
+    /// Advances `timeouts`; a one-shot timer re-armed by each tick while there
+    /// are pending invocations.
+    TimerHandle_t timeout_timer;
+    /// Whether `timeout_timer` is armed or its tick is running, guarded by `pending_lock`.
+    bool is_ticking;
+    /// Set under `pending_lock` once destruction begins so ticks no longer re-arm the timer.
+    bool is_closing;
+    /// Given on the timer task once `timeout_timer` has been deleted.
+    SemaphoreHandle_t timer_drained;
+};
+
+static void record_latency(livekit_rpc_method_stats_t *stats, int64_t latency_us)
+{
+    uint32_t latency_ms = (uint32_t)(latency_us / 1000);
+    if (latency_ms > stats->max_latency_ms) {
+        stats->max_latency_ms = latency_ms;
+    }
+    int bucket = 0;
+    while (latency_ms > 0 && bucket < LIVEKIT_RPC_LATENCY_BUCKET_COUNT - 1) {
+        latency_ms >>= 1;
+        bucket++;
+    }
+    stats->latency_histogram[bucket]++;
+}
+
+/// Drops a reference to an inbound invocation.
+///
+/// Must be called with `handlers_lock` held.
+///
+static void release_request(rpc_request_t *request)
+{
+    if (--request->refs == 0) {
+        free(request);
+    }
+}
+
+/// Claims the right to send the result of an inbound invocation.
+///
+/// @return False if the result was already sent.
+///
+static bool claim_result(rpc_request_t *request)
+{
+    rpc_manager_t *manager = request->manager;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    bool is_claimed = !request->is_result_sent;
+    request->is_result_sent = true;
+    xSemaphoreGive(manager->handlers_lock);
+    return is_claimed;
+}
+
+/// Records the completion of an inbound invocation once its result is sent.
+static void finish_request(rpc_request_t *request)
+{
+    rpc_manager_t *manager = request->manager;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    request->method->stats.in_flight--;
+    record_latency(&request->method->stats, esp_timer_get_time() - request->received_us);
+    release_request(request);
+    xSemaphoreGive(manager->handlers_lock);
+}
+
+static bool send_error_response(rpc_manager_t *manager, const char *id, livekit_rpc_result_code_t code, char *message)
+{
+    livekit_pb_data_packet_t res_packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG,
+        .value.rpc_response = {
+            .which_value = LIVEKIT_PB_RPC_RESPONSE_ERROR_TAG,
+            .value.error = {
+                .code = code,
+                .data = message
+            }
+        }
+    };
+    strncpy(res_packet.value.rpc_response.request_id,
+            id,
+            sizeof(res_packet.value.rpc_response.request_id));
+    return manager->options.send_packet(&res_packet, manager->options.ctx);
+}
 
 static bool on_result(const livekit_rpc_result_t* result, void* ctx)
 {
@@ -35,11 +186,16 @@ static bool on_result(const livekit_rpc_result_t* result, void* ctx)
         ESP_LOGE(TAG, "Send result missing required arguments");
         return false;
     }
-    rpc_manager_t *manager = (rpc_manager_t *)ctx;
+    rpc_request_t *request = (rpc_request_t *)ctx;
+    rpc_manager_t *manager = request->manager;
     if (result->payload != NULL && strlen(result->payload) >= LIVEKIT_RPC_MAX_PAYLOAD_BYTES) {
         ESP_LOGE(TAG, "Payload too large");
         return false;
     }
+    if (!claim_result(request)) {
+        ESP_LOGE(TAG, "Result already sent: id=%s", request->id);
+        return false;
+    }
 
     bool is_ok = result->code == LIVEKIT_RPC_RESULT_OK;
     if (is_ok && result->error_message != NULL) {
@@ -51,7 +207,7 @@ static bool on_result(const livekit_rpc_result_t* result, void* ctx)
         .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG
     };
     strncpy(res_packet.value.rpc_response.request_id,
-            result->id,
+            request->id,
             sizeof(res_packet.value.rpc_response.request_id));
 
     if (is_ok) {
@@ -62,11 +218,58 @@ static bool on_result(const livekit_rpc_result_t* result, void* ctx)
         res_packet.value.rpc_response.value.error.code = result->code;
         res_packet.value.rpc_response.value.error.data = result->error_message;
     }
-    if (!manager->options.send_packet(&res_packet, manager->options.ctx)) {
-        return false;
+    bool is_sent = manager->options.send_packet(&res_packet, manager->options.ctx);
+    finish_request(request);
+    return is_sent;
+}
+
+static void run_handler(rpc_request_t *request)
+{
+    rpc_manager_t *manager = request->manager;
+
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    livekit_rpc_handler_t handler = request->method->handler;
+    xSemaphoreGive(manager->handlers_lock);
+
+    if (handler != NULL) {
+        // TODO: Pass through context
+        int64_t start_time = esp_timer_get_time();
+        handler(&request->invocation, NULL);
+
+        int64_t exec_duration = esp_timer_get_time() - start_time;
+        ESP_LOGD(TAG, "Handler for method '%s' took %" PRIu64 "us", request->invocation.method, exec_duration);
+    } else {
+        // Unregistered while queued.
+        on_result(&(livekit_rpc_result_t){
+            .id = request->id,
+            .code = LIVEKIT_RPC_RESULT_UNSUPPORTED_METHOD
+        }, request);
+    }
+
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    release_request(request);
+    xSemaphoreGive(manager->handlers_lock);
+}
+
+#if CONFIG_LK_RPC_WORKER_COUNT > 0
+static void worker_task(void *arg)
+{
+    rpc_manager_t *manager = (rpc_manager_t *)arg;
+    while (manager->is_running) {
+        rpc_request_t *request;
+        if (!xQueueReceive(manager->request_queue, &request, portMAX_DELAY)) {
+            continue;
+        }
+        if (request == NULL) {
+            // Woken up to exit.
+            continue;
+        }
+        run_handler(request);
     }
-    return true;
+    xSemaphoreGive(manager->worker_exited);
+    vTaskDelete(NULL);
 }
+#endif
 
 static rpc_manager_err_t handle_request_packet(rpc_manager_t *manager, const livekit_pb_rpc_request_t* request, const char* caller_identity)
 {
@@ -89,82 +292,196 @@ static rpc_manager_err_t handle_request_packet(rpc_manager_t *manager, const liv
 
     if (request->version != 1) {
         ESP_LOGD(TAG, "Unsupported version: %" PRIu32, request->version);
-        livekit_pb_data_packet_t res_packet = {
-            .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG,
-            .value.rpc_response = {
-                .which_value = LIVEKIT_PB_RPC_RESPONSE_ERROR_TAG,
-                .value.error = {
-                    .code = LIVEKIT_RPC_RESULT_UNSUPPORTED_VERSION
-                }
-            }
-        };
-        strncpy(res_packet.value.rpc_response.request_id,
-                request->id,
-                sizeof(res_packet.value.rpc_response.request_id));
-
-        if (!manager->options.send_packet(&res_packet, manager->options.ctx)) {
+        if (!send_error_response(manager, request->id, LIVEKIT_RPC_RESULT_UNSUPPORTED_VERSION, NULL)) {
             return RPC_MANAGER_ERR_SEND_FAILED;
         }
         return RPC_MANAGER_ERR_NONE;
     }
 
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
     khiter_t key = kh_get(handlers, manager->handlers, request->method);
-    if (key == kh_end(manager->handlers)) {
+    rpc_method_t *method = key != kh_end(manager->handlers) ?
+        kh_value(manager->handlers, key) : NULL;
+    if (method == NULL || method->handler == NULL) {
+        xSemaphoreGive(manager->handlers_lock);
         ESP_LOGD(TAG, "No handler registered for method '%s'", request->method);
-        livekit_pb_data_packet_t res_packet = {
-            .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG,
-            .value.rpc_response = {
-                .which_value = LIVEKIT_PB_RPC_RESPONSE_ERROR_TAG,
-                .value.error = {
-                    .code = LIVEKIT_RPC_RESULT_UNSUPPORTED_METHOD
-                }
-            }
-        };
-        strncpy(res_packet.value.rpc_response.request_id,
-                request->id,
-                sizeof(res_packet.value.rpc_response.request_id));
-
-        if (!manager->options.send_packet(&res_packet, manager->options.ctx)) {
+        if (!send_error_response(manager, request->id, LIVEKIT_RPC_RESULT_UNSUPPORTED_METHOD, NULL)) {
             return RPC_MANAGER_ERR_SEND_FAILED;
         }
         return RPC_MANAGER_ERR_NONE;
     }
-    livekit_rpc_handler_t handler = kh_value(manager->handlers, key);
-
-    livekit_rpc_invocation_t invocation = {
-        .id = (char *)request->id,
-        .method = request->method,
-        .caller_identity = (char *)caller_identity,
-        .payload = request->payload,
-        .send_result = on_result,
-        .ctx = manager
+    if (method->max_concurrent > 0 && method->stats.in_flight >= method->max_concurrent) {
+        method->stats.rejected++;
+        xSemaphoreGive(manager->handlers_lock);
+        ESP_LOGW(TAG, "Too many concurrent invocations of '%s'", request->method);
+        if (!send_error_response(manager, request->id, LIVEKIT_RPC_RESULT_APPLICATION, "Too many concurrent invocations")) {
+            return RPC_MANAGER_ERR_SEND_FAILED;
+        }
+        return RPC_MANAGER_ERR_NONE;
+    }
+    method->stats.in_flight++;
+    method->stats.invocations++;
+    xSemaphoreGive(manager->handlers_lock);
+
+    // The packet is freed once this returns, so the request keeps its own copy of the strings.
+    size_t method_size = strlen(request->method) + 1;
+    size_t caller_size = strlen(caller_identity) + 1;
+    size_t payload_size = request->payload != NULL ? strlen(request->payload) + 1 : 0;
+    rpc_request_t *inbound = malloc(sizeof(rpc_request_t) + method_size + caller_size + payload_size);
+    if (inbound == NULL) {
+        xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+        method->stats.in_flight--;
+        xSemaphoreGive(manager->handlers_lock);
+        send_error_response(manager, request->id, LIVEKIT_RPC_RESULT_APPLICATION, NULL);
+        return RPC_MANAGER_ERR_NO_MEM;
+    }
+    char *strings = (char *)(inbound + 1);
+    *inbound = (rpc_request_t){
+        .invocation = {
+            .id = inbound->id,
+            .method = memcpy(strings, request->method, method_size),
+            .caller_identity = memcpy(strings + method_size, caller_identity, caller_size),
+            .payload = payload_size > 0 ?
+                memcpy(strings + method_size + caller_size, request->payload, payload_size) : NULL,
+            .send_result = on_result,
+            .ctx = inbound
+        },
+        .manager = manager,
+        .method = method,
+        .received_us = esp_timer_get_time(),
+        // One for the handler, one for the result.
+        .refs = 2
     };
+    strncpy(inbound->id, request->id, sizeof(inbound->id));
+
+#if CONFIG_LK_RPC_WORKER_COUNT > 0
+    if (xQueueSend(manager->request_queue, &inbound, 0) != pdPASS) {
+        ESP_LOGW(TAG, "Request queue full, rejecting '%s'", request->method);
+        xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+        method->stats.invocations--;
+        method->stats.in_flight--;
+        method->stats.rejected++;
+        xSemaphoreGive(manager->handlers_lock);
+        free(inbound);
+        if (!send_error_response(manager, request->id, LIVEKIT_RPC_RESULT_APPLICATION, "Too many concurrent invocations")) {
+            return RPC_MANAGER_ERR_SEND_FAILED;
+        }
+    }
+#else
+    run_handler(inbound);
+#endif
+    return RPC_MANAGER_ERR_NONE;
+}
 
-    // TODO: Pass through context
-
-    int64_t start_time = esp_timer_get_time();
-    handler(&invocation, NULL);
-
-    int64_t exec_duration = esp_timer_get_time() - start_time;
-    ESP_LOGD(TAG, "Handler for method '%s' took %" PRIu64 "us", request->method, exec_duration / 1000);
-
-    // After, record should be deleted or be marked pending
+/// Removes and returns the pending invocation with the given ID (if any).
+///
+/// Must be called with `pending_lock` held.
+///
+static pending_call_t *take_pending(rpc_manager_t *manager, const char *id)
+{
+    khiter_t key = kh_get(pending, manager->pending, id);
+    if (key == kh_end(manager->pending)) {
+        return NULL;
+    }
+    pending_call_t *call = kh_value(manager->pending, key);
+    kh_del(pending, manager->pending, key);
+    timer_wheel_cancel(&manager->timeouts, &call->timeout);
+    return call;
+}
 
-    return RPC_MANAGER_ERR_NONE;
+static void deliver_result(rpc_manager_t *manager, const char *id, livekit_rpc_result_code_t code)
+{
+    livekit_rpc_result_t result = {
+        .id = (char *)id,
+        .code = code
+    };
+    manager->options.on_result(&result, manager->options.ctx);
 }
 
 static rpc_manager_err_t handle_response_packet(rpc_manager_t *manager, const livekit_pb_rpc_response_t* response)
 {
-    // TODO: Implement
+    xSemaphoreTake(manager->pending_lock, portMAX_DELAY);
+    pending_call_t *call = take_pending(manager, response->request_id);
+    xSemaphoreGive(manager->pending_lock);
+
+    if (call == NULL) {
+        ESP_LOGD(TAG, "Response for unknown or expired request: id=%s", response->request_id);
+        return RPC_MANAGER_ERR_NONE;
+    }
+    livekit_rpc_result_t result = {
+        .id = call->id
+    };
+    if (response->which_value == LIVEKIT_PB_RPC_RESPONSE_ERROR_TAG) {
+        result.code = (livekit_rpc_result_code_t)response->value.error.code;
+        result.error_message = response->value.error.data;
+    } else {
+        result.code = LIVEKIT_RPC_RESULT_OK;
+        result.payload = response->value.payload;
+    }
+    manager->options.on_result(&result, manager->options.ctx);
+    free(call);
     return RPC_MANAGER_ERR_NONE;
 }
 
 static rpc_manager_err_t handle_ack_packet(rpc_manager_t *manager, const livekit_pb_rpc_ack_t* ack)
 {
-    // TODO: Implement
+    xSemaphoreTake(manager->pending_lock, portMAX_DELAY);
+    khiter_t key = kh_get(pending, manager->pending, ack->request_id);
+    if (key != kh_end(manager->pending)) {
+        pending_call_t *call = kh_value(manager->pending, key);
+        if (!call->is_acked) {
+            call->is_acked = true;
+            // The response timeout is measured from the invocation.
+            int32_t remaining_ticks = (int32_t)(call->response_deadline - manager->timeouts.current_tick);
+            timer_wheel_cancel(&manager->timeouts, &call->timeout);
+            timer_wheel_schedule(&manager->timeouts, &call->timeout, remaining_ticks > 0 ? remaining_ticks : 0);
+        }
+    }
+    xSemaphoreGive(manager->pending_lock);
     return RPC_MANAGER_ERR_NONE;
 }
 
+static void on_timeout_tick(TimerHandle_t timer)
+{
+    rpc_manager_t *manager = (rpc_manager_t *)pvTimerGetTimerID(timer);
+
+    xSemaphoreTake(manager->pending_lock, portMAX_DELAY);
+    if (manager->is_closing) {
+        xSemaphoreGive(manager->pending_lock);
+        return;
+    }
+    timer_wheel_node_t *expired = timer_wheel_advance(&manager->timeouts);
+    for (timer_wheel_node_t *node = expired; node != NULL; node = node->next) {
+        pending_call_t *call = (pending_call_t *)node;
+        kh_del(pending, manager->pending, kh_get(pending, manager->pending, call->id));
+    }
+    // The timer is never stopped; it is left to lapse once the wheel is empty, so an
+    // invocation that sees `is_ticking` cleared under the lock can always start it.
+    manager->is_ticking = false;
+    if (!timer_wheel_is_empty(&manager->timeouts)) {
+        manager->is_ticking = xTimerStart(timer, 0) == pdPASS;
+        if (!manager->is_ticking) {
+            ESP_LOGE(TAG, "Failed to re-arm timeout timer");
+        }
+    }
+    xSemaphoreGive(manager->pending_lock);
+
+    while (expired != NULL) {
+        pending_call_t *call = (pending_call_t *)expired;
+        expired = expired->next;
+        ESP_LOGD(TAG, "Invocation timed out: id=%s, acked=%d", call->id, call->is_acked);
+        deliver_result(manager, call->id, call->is_acked ?
+            LIVEKIT_RPC_RESULT_RESPONSE_TIMEOUT :
+            LIVEKIT_RPC_RESULT_CONNECTION_TIMEOUT);
+        free(call);
+    }
+}
+
+static void on_timer_drained(void *param1, uint32_t param2)
+{
+    xSemaphoreGive((SemaphoreHandle_t)param1);
+}
+
 rpc_manager_err_t rpc_manager_create(rpc_manager_handle_t *handle, const rpc_manager_options_t *options)
 {
     if (handle  == NULL ||
@@ -178,13 +495,59 @@ rpc_manager_err_t rpc_manager_create(rpc_manager_handle_t *handle, const rpc_man
         return RPC_MANAGER_ERR_NO_MEM;
     }
 
+    rpc->options = *options;
+    timer_wheel_init(&rpc->timeouts);
+
     rpc->handlers = kh_init(handlers);
-    if (rpc->handlers == NULL) {
-        free(rpc);
+    rpc->handlers_lock = xSemaphoreCreateMutex();
+    rpc->pending = kh_init(pending);
+    rpc->pending_lock = xSemaphoreCreateMutex();
+    rpc->timer_drained = xSemaphoreCreateBinary();
+    rpc->timeout_timer = xTimerCreate(
+        "lk_rpc_timer",
+        pdMS_TO_TICKS(TIMEOUT_TICK_MS),
+        pdFALSE,
+        (void *)rpc,
+        on_timeout_tick
+    );
+    if (rpc->handlers      == NULL ||
+        rpc->handlers_lock == NULL ||
+        rpc->pending       == NULL ||
+        rpc->pending_lock  == NULL ||
+        rpc->timer_drained == NULL ||
+        rpc->timeout_timer == NULL) {
+        rpc_manager_destroy(rpc);
         return RPC_MANAGER_ERR_NO_MEM;
     }
 
-    rpc->options = *options;
+#if CONFIG_LK_RPC_WORKER_COUNT > 0
+    // Queue holds one extra item per worker so wakeups can always be sent on exit.
+    rpc->request_queue = xQueueCreate(
+        CONFIG_LK_RPC_QUEUE_SIZE + CONFIG_LK_RPC_WORKER_COUNT,
+        sizeof(rpc_request_t *)
+    );
+    rpc->worker_exited = xSemaphoreCreateCounting(CONFIG_LK_RPC_WORKER_COUNT, 0);
+    if (rpc->request_queue == NULL || rpc->worker_exited == NULL) {
+        rpc_manager_destroy(rpc);
+        return RPC_MANAGER_ERR_NO_MEM;
+    }
+    rpc->is_running = true;
+    for (int i = 0; i < CONFIG_LK_RPC_WORKER_COUNT; i++) {
+        if (xTaskCreate(
+            worker_task,
+            "lk_rpc_worker",
+            CONFIG_LK_RPC_WORKER_STACK_SIZE,
+            (void *)rpc,
+            CONFIG_LK_RPC_WORKER_PRIORITY,
+            NULL
+        ) != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create worker task");
+            rpc_manager_destroy(rpc);
+            return RPC_MANAGER_ERR_NO_MEM;
+        }
+        rpc->worker_count++;
+    }
+#endif
     *handle = (rpc_manager_handle_t)rpc;
     return RPC_MANAGER_ERR_NONE;
 }
@@ -195,27 +558,191 @@ rpc_manager_err_t rpc_manager_destroy(rpc_manager_handle_t handle)
         return RPC_MANAGER_ERR_INVALID_ARG;
     }
     rpc_manager_t *rpc = (rpc_manager_t *)handle;
+#if CONFIG_LK_RPC_WORKER_COUNT > 0
+    if (rpc->worker_count > 0) {
+        rpc->is_running = false;
+        rpc_request_t *wakeup = NULL;
+        for (int i = 0; i < rpc->worker_count; i++) {
+            xQueueSendToFront(rpc->request_queue, &wakeup, portMAX_DELAY);
+        }
+        for (int i = 0; i < rpc->worker_count; i++) {
+            xSemaphoreTake(rpc->worker_exited, portMAX_DELAY);
+        }
+    }
+    if (rpc->request_queue != NULL) {
+        // Invocations that never reached a handler are dropped without a result.
+        rpc_request_t *request;
+        while (xQueueReceive(rpc->request_queue, &request, 0) == pdPASS) {
+            free(request);
+        }
+        vQueueDelete(rpc->request_queue);
+    }
+    if (rpc->worker_exited != NULL) {
+        vSemaphoreDelete(rpc->worker_exited);
+    }
+#endif
+    if (rpc->timeout_timer != NULL) {
+        if (rpc->pending_lock != NULL) {
+            xSemaphoreTake(rpc->pending_lock, portMAX_DELAY);
+            rpc->is_closing = true;
+            xSemaphoreGive(rpc->pending_lock);
+        }
+        xTimerDelete(rpc->timeout_timer, portMAX_DELAY);
+        // Timer commands run in order on the timer task, so once this is given no
+        // tick is running and none will follow.
+        if (rpc->timer_drained != NULL &&
+            xTimerPendFunctionCall(on_timer_drained, rpc->timer_drained, 0, portMAX_DELAY) == pdPASS) {
+            xSemaphoreTake(rpc->timer_drained, portMAX_DELAY);
+        }
+    }
+    if (rpc->timer_drained != NULL) {
+        vSemaphoreDelete(rpc->timer_drained);
+    }
+    if (rpc->pending != NULL) {
+        // Invocations still pending are dropped without a result.
+        pending_call_t *call;
+        kh_foreach_value(rpc->pending, call, free(call));
+        kh_destroy(pending, rpc->pending);
+    }
+    if (rpc->pending_lock != NULL) {
+        vSemaphoreDelete(rpc->pending_lock);
+    }
+    if (rpc->handlers != NULL) {
+        rpc_method_t *method;
+        kh_foreach_value(rpc->handlers, method, {
+            free(method->name);
+            free(method);
+        });
+        kh_destroy(handlers, rpc->handlers);
+    }
+    if (rpc->handlers_lock != NULL) {
+        vSemaphoreDelete(rpc->handlers_lock);
+    }
     free(rpc);
     return RPC_MANAGER_ERR_NONE;
 }
 
-rpc_manager_err_t rpc_manager_register(rpc_manager_handle_t handle, const char* method, livekit_rpc_handler_t handler)
+rpc_manager_err_t rpc_manager_invoke(rpc_manager_handle_t handle, const livekit_rpc_invoke_options_t *options, char *out_id)
 {
-    if (handle == NULL || method == NULL || handler == NULL) {
+    if (handle == NULL ||
+        options == NULL ||
+        options->destination_identity == NULL ||
+        options->method == NULL) {
         return RPC_MANAGER_ERR_INVALID_ARG;
     }
     rpc_manager_t *manager = (rpc_manager_t *)handle;
 
-    int put_flag;
-    khiter_t key = kh_put(handlers, manager->handlers, method, &put_flag);
-    if (put_flag != 1) {
-        return RPC_MANAGER_ERR_INVALID_STATE;
+    if (options->payload != NULL && strlen(options->payload) >= LIVEKIT_RPC_MAX_PAYLOAD_BYTES) {
+        ESP_LOGE(TAG, "Payload too large");
+        return RPC_MANAGER_ERR_INVALID_ARG;
+    }
+    uint32_t response_timeout_ms = options->response_timeout_ms > 0 ?
+        options->response_timeout_ms : DEFAULT_RESPONSE_TIMEOUT_MS;
+    if (response_timeout_ms < ACK_TIMEOUT_MS + TIMEOUT_TICK_MS) {
+        response_timeout_ms = ACK_TIMEOUT_MS + TIMEOUT_TICK_MS;
     }
-    kh_value(manager->handlers, key) = handler;
 
+    pending_call_t *call = calloc(1, sizeof(pending_call_t));
+    if (call == NULL) {
+        return RPC_MANAGER_ERR_NO_MEM;
+    }
+    generate_uuid(call->id);
+
+    // Track the invocation before sending so an early response isn't missed.
+    xSemaphoreTake(manager->pending_lock, portMAX_DELAY);
+    int put_result;
+    khiter_t key = kh_put(pending, manager->pending, call->id, &put_result);
+    if (put_result <= 0) {
+        xSemaphoreGive(manager->pending_lock);
+        free(call);
+        return put_result < 0 ? RPC_MANAGER_ERR_NO_MEM : RPC_MANAGER_ERR_INVALID_STATE;
+    }
+    kh_value(manager->pending, key) = call;
+    call->response_deadline = manager->timeouts.current_tick + response_timeout_ms / TIMEOUT_TICK_MS;
+    timer_wheel_schedule(&manager->timeouts, &call->timeout, ACK_TIMEOUT_MS / TIMEOUT_TICK_MS);
+    if (!manager->is_ticking) {
+        if (xTimerStart(manager->timeout_timer, 0) != pdPASS) {
+            take_pending(manager, call->id);
+            xSemaphoreGive(manager->pending_lock);
+            ESP_LOGE(TAG, "Failed to start timeout timer");
+            free(call);
+            return RPC_MANAGER_ERR_INVALID_STATE;
+        }
+        manager->is_ticking = true;
+    }
+    xSemaphoreGive(manager->pending_lock);
+
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG,
+        .value.rpc_request = {
+            .method = options->method,
+            .payload = options->payload,
+            // Leave the recipient time to deliver the response before the caller gives up.
+            .response_timeout_ms = response_timeout_ms - ACK_TIMEOUT_MS,
+            .version = 1
+        },
+        .destination_identities_count = 1,
+        .destination_identities = (char **)&options->destination_identity
+    };
+    strncpy(packet.value.rpc_request.id, call->id, sizeof(packet.value.rpc_request.id));
+
+    if (out_id != NULL) {
+        strncpy(out_id, call->id, LIVEKIT_RPC_ID_SIZE);
+    }
+    ESP_LOGD(TAG, "Invoking: method=%s, id=%s", options->method, call->id);
+
+    if (!manager->options.send_packet(&packet, manager->options.ctx)) {
+        xSemaphoreTake(manager->pending_lock, portMAX_DELAY);
+        call = take_pending(manager, packet.value.rpc_request.id);
+        xSemaphoreGive(manager->pending_lock);
+        free(call);
+        return RPC_MANAGER_ERR_SEND_FAILED;
+    }
     return RPC_MANAGER_ERR_NONE;
 }
 
+rpc_manager_err_t rpc_manager_register(rpc_manager_handle_t handle, const char* method, livekit_rpc_handler_t handler, const livekit_rpc_handler_options_t *options)
+{
+    if (handle == NULL || method == NULL || handler == NULL) {
+        return RPC_MANAGER_ERR_INVALID_ARG;
+    }
+    rpc_manager_t *manager = (rpc_manager_t *)handle;
+
+    rpc_manager_err_t ret = RPC_MANAGER_ERR_NONE;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    do {
+        rpc_method_t *entry;
+        khiter_t key = kh_get(handlers, manager->handlers, method);
+        if (key != kh_end(manager->handlers)) {
+            entry = kh_value(manager->handlers, key);
+            if (entry->handler != NULL) {
+                ret = RPC_MANAGER_ERR_INVALID_STATE;
+                break;
+            }
+        } else {
+            entry = calloc(1, sizeof(rpc_method_t));
+            if (entry == NULL || (entry->name = strdup(method)) == NULL) {
+                free(entry);
+                ret = RPC_MANAGER_ERR_NO_MEM;
+                break;
+            }
+            int put_flag;
+            key = kh_put(handlers, manager->handlers, entry->name, &put_flag);
+            if (put_flag < 0) {
+                free(entry->name);
+                free(entry);
+                ret = RPC_MANAGER_ERR_NO_MEM;
+                break;
+            }
+            kh_value(manager->handlers, key) = entry;
+        }
+        entry->handler = handler;
+        entry->max_concurrent = options != NULL ? options->max_concurrent : 0;
+    } while (0);
+    xSemaphoreGive(manager->handlers_lock);
+    return ret;
+}
+
 rpc_manager_err_t rpc_manager_unregister(rpc_manager_handle_t handle, const char* method)
 {
     if (handle == NULL || method == NULL) {
@@ -223,13 +750,33 @@ rpc_manager_err_t rpc_manager_unregister(rpc_manager_handle_t handle, const char
     }
     rpc_manager_t *manager = (rpc_manager_t *)handle;
 
+    rpc_manager_err_t ret = RPC_MANAGER_ERR_INVALID_STATE;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
     khiter_t key = kh_get(handlers, manager->handlers, method);
-    if (key == kh_end(manager->handlers)) {
-        return RPC_MANAGER_ERR_INVALID_STATE;
+    if (key != kh_end(manager->handlers) && kh_value(manager->handlers, key)->handler != NULL) {
+        kh_value(manager->handlers, key)->handler = NULL;
+        ret = RPC_MANAGER_ERR_NONE;
     }
-    kh_del(handlers, manager->handlers, key);
+    xSemaphoreGive(manager->handlers_lock);
+    return ret;
+}
 
-    return RPC_MANAGER_ERR_NONE;
+rpc_manager_err_t rpc_manager_get_method_stats(rpc_manager_handle_t handle, const char* method, livekit_rpc_method_stats_t *out_stats)
+{
+    if (handle == NULL || method == NULL || out_stats == NULL) {
+        return RPC_MANAGER_ERR_INVALID_ARG;
+    }
+    rpc_manager_t *manager = (rpc_manager_t *)handle;
+
+    rpc_manager_err_t ret = RPC_MANAGER_ERR_INVALID_STATE;
+    xSemaphoreTake(manager->handlers_lock, portMAX_DELAY);
+    khiter_t key = kh_get(handlers, manager->handlers, method);
+    if (key != kh_end(manager->handlers)) {
+        *out_stats = kh_value(manager->handlers, key)->stats;
+        ret = RPC_MANAGER_ERR_NONE;
+    }
+    xSemaphoreGive(manager->handlers_lock);
+    return ret;
 }
 
 rpc_manager_err_t rpc_manager_handle_packet(rpc_manager_handle_t handle, const livekit_pb_data_packet_t* packet)
@@ -44,14 +44,32 @@ typedef struct {
 rpc_manager_err_t rpc_manager_create(rpc_manager_handle_t *handle, const rpc_manager_options_t *options);
 
 /// Destroys an RPC manager.
+///
+/// Waits for handlers and timeout checks in progress to return. Invocations still
+/// pending are dropped without a result.
+///
 rpc_manager_err_t rpc_manager_destroy(rpc_manager_handle_t handle);
 
 /// Registers a handler for an RPC method.
-rpc_manager_err_t rpc_manager_register(rpc_manager_handle_t handle, const char* method, livekit_rpc_handler_t handler);
+/// @param options[in] Handler options or NULL for defaults.
+rpc_manager_err_t rpc_manager_register(rpc_manager_handle_t handle, const char* method, livekit_rpc_handler_t handler, const livekit_rpc_handler_options_t *options);
 
 /// Unregisters a handler for an RPC method.
 rpc_manager_err_t rpc_manager_unregister(rpc_manager_handle_t handle, const char* method);
 
+/// Gets statistics for a method that has been registered.
+rpc_manager_err_t rpc_manager_get_method_stats(rpc_manager_handle_t handle, const char* method, livekit_rpc_method_stats_t *out_stats);
+
+/// Invokes an RPC method on a remote participant.
+///
+/// The result is delivered through `on_result`, including when the recipient fails to
+/// acknowledge or respond in time.
+///
+/// @param out_id[out] Buffer of at least `LIVEKIT_RPC_ID_SIZE` bytes to receive the
+///                    invocation ID, or NULL.
+///
+rpc_manager_err_t rpc_manager_invoke(rpc_manager_handle_t handle, const livekit_rpc_invoke_options_t *options, char *out_id);
+
 /// Handles an incoming RPC packet.
 rpc_manager_err_t rpc_manager_handle_packet(rpc_manager_handle_t handle, const livekit_pb_data_packet_t* packet);
 
@@ -15,8 +15,12 @@
  */
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "freertos/timers.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_netif.h"
 #ifdef CONFIG_MBEDTLS_CERTIFICATE_BUNDLE
 #include "esp_crt_bundle.h"
@@ -31,12 +35,40 @@
 
 static const char *TAG = "livekit_signaling";
 
-#define SIGNAL_WS_BUFFER_SIZE          20 * 1024
 #define SIGNAL_WS_RECONNECT_TIMEOUT_MS 1000
 #define SIGNAL_WS_NETWORK_TIMEOUT_MS   10000
 #define SIGNAL_WS_CLOSE_CODE           1000
 #define SIGNAL_WS_CLOSE_TIMEOUT_MS     250
 
+/// Time the writer task waits for the socket to accept a request.
+#define SIGNAL_WS_SEND_TIMEOUT_MS      5000
+
+/// Number of leave and ping requests that can wait ahead of others.
+#define SIGNAL_CONTROL_QUEUE_SIZE      4
+
+/// Time a caller waits for space in a full queue before giving up on the socket.
+///
+/// The writer finishes with a request within `SIGNAL_WS_SEND_TIMEOUT_MS`, so a
+/// slot frees up within this time unless the socket has stopped accepting data.
+///
+#define SIGNAL_QUEUE_WAIT_MS           (SIGNAL_WS_SEND_TIMEOUT_MS + 1000)
+
+/// Number of requests that can be queued at once, plus the one being sent.
+#define SIGNAL_MSG_POOL_SIZE           (SIGNAL_CONTROL_QUEUE_SIZE + CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE + 1)
+
+/// An encoded request waiting to be sent.
+///
+/// Requests are encoded straight into `slot`. Those that do not fit (e.g., most
+/// SDP offers and answers) are encoded into an allocation `data` points to instead.
+///
+typedef struct {
+    pb_size_t type;
+    int64_t queued_us;
+    size_t len;
+    uint8_t *data;
+    uint8_t slot[CONFIG_LK_SIGNAL_SEND_SLOT_SIZE];
+} signal_msg_t;
+
 typedef struct {
     esp_websocket_client_handle_t ws;
     signal_options_t options;
@@ -44,11 +76,44 @@ typedef struct {
     bool is_terminal_state;
     TimerHandle_t ping_interval_timer;
     TimerHandle_t ping_timeout_timer;
-    int64_t rtt;
+    /// Round-trip time measured by the last ping in milliseconds; read without locking.
+    uint32_t rtt;
 
-#if CONFIG_LK_BENCHMARK
-    uint64_t start_time;
-#endif
+    /// Requests waiting for the writer task; control requests (leave and ping)
+    /// are sent ahead of the bulk of requests.
+    QueueHandle_t control_queue;
+    QueueHandle_t bulk_queue;
+
+    /// Queue of pointers to unused requests in `msg_pool`.
+    QueueHandle_t free_msgs;
+
+    /// Storage for all requests that can be queued or sent at once.
+    signal_msg_t msg_pool[SIGNAL_MSG_POOL_SIZE];
+
+    /// Counts the requests queued and other wakeups of the writer task.
+    SemaphoreHandle_t pending;
+
+    TaskHandle_t writer_task;
+    bool is_running;
+    bool is_stop_requested;
+    SemaphoreHandle_t task_exited;
+
+    /// Number of requests queued or being sent, guarded by `stats_lock`.
+    uint32_t in_flight;
+
+    /// Given by the writer when `in_flight` drops to zero.
+    SemaphoreHandle_t drained;
+
+    signal_send_stats_t send_stats;
+    SemaphoreHandle_t stats_lock;
+
+    /// Reassembly of a message delivered over several data events; only
+    /// allocated while such a message is being received.
+    uint8_t *rx_buf;
+    size_t rx_size;
+    size_t rx_capacity;
+    bool is_rx_binary;
+    bool is_rx_discarding;
 } signal_t;
 
 static inline void change_state(signal_t *sg, signal_state_t state)
@@ -68,33 +133,207 @@ static inline signal_state_t failed_state_from_http_status(int status)
     }
 }
 
-static signal_err_t send_request(signal_t *sg, livekit_pb_signal_request_t *request)
+// MARK: - Send queue
+
+static inline bool is_control_request(pb_size_t type)
+{
+    return type == LIVEKIT_PB_SIGNAL_REQUEST_LEAVE_TAG ||
+           type == LIVEKIT_PB_SIGNAL_REQUEST_PING_REQ_TAG;
+}
+
+/// Returns whether a request can be dropped when the queue is full.
+///
+/// Losing a ping only costs an RTT sample, whereas losing an offer, answer or
+/// subscription change would leave negotiation stuck.
+///
+static inline bool is_droppable_request(pb_size_t type)
+{
+    return type == LIVEKIT_PB_SIGNAL_REQUEST_PING_REQ_TAG;
+}
+
+static inline uint32_t queue_depth(signal_t *sg)
 {
+    return uxQueueMessagesWaiting(sg->control_queue) + uxQueueMessagesWaiting(sg->bulk_queue);
+}
+
+/// Returns a request to the pool, freeing its allocation if it did not fit its slot.
+static void msg_release(signal_t *sg, signal_msg_t *msg)
+{
+    if (msg->data != msg->slot) {
+        free(msg->data);
+    }
+    msg->data = NULL;
+    xQueueSend(sg->free_msgs, &msg, 0);
+}
+
+/// Encodes a request into a message taken from the pool.
+static signal_err_t msg_encode(signal_msg_t *msg, const livekit_pb_signal_request_t *request)
+{
+    msg->len = protocol_signal_request_try_encode(request, msg->slot, sizeof(msg->slot));
+    if (msg->len > 0) {
+        msg->data = msg->slot;
+        return SIGNAL_ERR_NONE;
+    }
     size_t encoded_size = protocol_signal_request_encoded_size(request);
-    if (encoded_size == 0) {
+    if (encoded_size <= sizeof(msg->slot)) {
+        // Fits, so encoding failed for another reason.
+        ESP_LOGE(TAG, "Failed to encode signal req: type=%d", request->which_message);
         return SIGNAL_ERR_MESSAGE;
     }
-    uint8_t *enc_buf = (uint8_t *)malloc(encoded_size);
-    if (enc_buf == NULL) {
+    msg->data = malloc(encoded_size);
+    if (msg->data == NULL) {
         return SIGNAL_ERR_NO_MEM;
     }
-    int ret = SIGNAL_ERR_NONE;
-    do {
-        if (!protocol_signal_request_encode(request, enc_buf, encoded_size)) {
-            ret = SIGNAL_ERR_MESSAGE;
-            break;
+    if (!protocol_signal_request_encode(request, msg->data, encoded_size)) {
+        return SIGNAL_ERR_MESSAGE;
+    }
+    msg->len = encoded_size;
+    return SIGNAL_ERR_NONE;
+}
+
+static void record_sent(signal_t *sg, const signal_msg_t *msg, bool is_sent)
+{
+    uint32_t latency_us = (uint32_t)(esp_timer_get_time() - msg->queued_us);
+    xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+    if (is_sent) {
+        sg->send_stats.sent++;
+        sg->send_stats.latency_last_us = latency_us;
+        if (latency_us > sg->send_stats.latency_max_us) {
+            sg->send_stats.latency_max_us = latency_us;
         }
-        if (esp_websocket_client_send_bin(sg->ws,
-                (const char *)enc_buf,
-                encoded_size,
-                portMAX_DELAY) < 0) {
-            //ESP_LOGE(TAG, "Failed to send request");
-            ret = SIGNAL_ERR_MESSAGE;
-            break;
+        sg->send_stats.latency_total_us += latency_us;
+    } else {
+        sg->send_stats.failed++;
+    }
+    if (--sg->in_flight == 0) {
+        xSemaphoreGive(sg->drained);
+    }
+    xSemaphoreGive(sg->stats_lock);
+}
+
+/// Owns the socket: sends queued requests and stops the client on ping timeout,
+/// so that neither the callers nor the timer task wait on the network.
+static void writer_task(void *arg)
+{
+    signal_t *sg = (signal_t *)arg;
+    while (sg->is_running) {
+        if (!xSemaphoreTake(sg->pending, portMAX_DELAY)) {
+            continue;
         }
-    } while (0);
-    free(enc_buf);
-    return ret;
+        if (sg->is_stop_requested) {
+            sg->is_stop_requested = false;
+            esp_websocket_client_stop(sg->ws);
+        }
+        signal_msg_t *msg;
+        if (xQueueReceive(sg->control_queue, &msg, 0) != pdPASS &&
+            xQueueReceive(sg->bulk_queue, &msg, 0) != pdPASS) {
+            // Woken up to stop the client or exit.
+            continue;
+        }
+        bool is_sent = esp_websocket_client_send_bin(sg->ws,
+            (const char *)msg->data,
+            msg->len,
+            pdMS_TO_TICKS(SIGNAL_WS_SEND_TIMEOUT_MS)) >= 0;
+        if (!is_sent) {
+            ESP_LOGD(TAG, "Failed to send request: type=%d", msg->type);
+        }
+        record_sent(sg, msg, is_sent);
+        msg_release(sg, msg);
+    }
+    xSemaphoreGive(sg->task_exited);
+    vTaskDelete(NULL);
+}
+
+/// Returns requests that have not been taken by the writer to the pool.
+static void discard_queued(signal_t *sg)
+{
+    QueueHandle_t queues[] = { sg->control_queue, sg->bulk_queue };
+    for (int i = 0; i < 2; i++) {
+        if (queues[i] == NULL) {
+            continue;
+        }
+        signal_msg_t *msg;
+        while (xQueueReceive(queues[i], &msg, 0) == pdPASS) {
+            msg_release(sg, msg);
+            xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+            sg->in_flight--;
+            xSemaphoreGive(sg->stats_lock);
+        }
+    }
+}
+
+/// Waits for queued requests to be sent.
+static bool wait_drained(signal_t *sg, TickType_t timeout)
+{
+    xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+    bool is_drained = sg->in_flight == 0;
+    if (!is_drained) {
+        // Clear a stale signal from an earlier drain.
+        xSemaphoreTake(sg->drained, 0);
+    }
+    xSemaphoreGive(sg->stats_lock);
+    return is_drained || xSemaphoreTake(sg->drained, timeout) == pdTRUE;
+}
+
+static signal_err_t send_request(signal_t *sg, livekit_pb_signal_request_t *request)
+{
+    pb_size_t type = request->which_message;
+    bool is_droppable = is_droppable_request(type);
+    TickType_t wait = is_droppable ? 0 : pdMS_TO_TICKS(SIGNAL_QUEUE_WAIT_MS);
+
+    // The pool holds a request for each queue slot and one for the writer, so it
+    // only runs out while other callers wait for space in a full queue.
+    signal_msg_t *msg = NULL;
+    bool is_queued = false;
+    if (xQueueReceive(sg->free_msgs, &msg, wait) == pdPASS) {
+        signal_err_t err = msg_encode(msg, request);
+        if (err != SIGNAL_ERR_NONE) {
+            msg_release(sg, msg);
+            return err;
+        }
+        msg->type = type;
+        msg->queued_us = esp_timer_get_time();
+
+        // Counted before queueing, since the writer may send the request right away.
+        xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+        sg->in_flight++;
+        xSemaphoreGive(sg->stats_lock);
+
+        QueueHandle_t queue = is_control_request(type) ? sg->control_queue : sg->bulk_queue;
+        is_queued = xQueueSend(queue, &msg, wait) == pdPASS;
+    }
+
+    xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+    if (is_queued) {
+        uint32_t depth = queue_depth(sg);
+        if (depth > sg->send_stats.max_queue_depth) {
+            sg->send_stats.max_queue_depth = depth;
+        }
+    } else {
+        sg->send_stats.dropped++;
+        if (msg != NULL && --sg->in_flight == 0) {
+            xSemaphoreGive(sg->drained);
+        }
+    }
+    xSemaphoreGive(sg->stats_lock);
+
+    if (!is_queued) {
+        if (msg != NULL) {
+            msg_release(sg, msg);
+        }
+        if (is_droppable) {
+            ESP_LOGW(TAG, "Send queue full, dropped request: type=%d", type);
+        } else {
+            // The socket has stopped accepting data; stopping the client reports
+            // the connection as lost so the room is rejoined.
+            ESP_LOGE(TAG, "Send queue stalled, dropped request: type=%d", type);
+            sg->is_stop_requested = true;
+            xSemaphoreGive(sg->pending);
+        }
+        return SIGNAL_ERR_QUEUE_FULL;
+    }
+    xSemaphoreGive(sg->pending);
+    return SIGNAL_ERR_NONE;
 }
 
 static void on_ping_interval_expired(TimerHandle_t handle)
@@ -112,7 +351,33 @@ static void on_ping_interval_expired(TimerHandle_t handle)
 static void on_ping_timeout_expired(TimerHandle_t handle)
 {
     signal_t *sg = (signal_t *)pvTimerGetTimerID(handle);
-    esp_websocket_client_stop(sg->ws);
+    // Stopping waits for the client's task, so it is left to the writer.
+    sg->is_stop_requested = true;
+    xSemaphoreGive(sg->pending);
+}
+
+/// Returns whether responses of a type are used by the middleware or the receiver.
+///
+/// Responses of other types are skipped without being decoded.
+///
+static inline bool is_res_consumed(pb_size_t type)
+{
+    switch (type) {
+        case LIVEKIT_PB_SIGNAL_RESPONSE_JOIN_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_ANSWER_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_OFFER_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_TRICKLE_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_UPDATE_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_TRACK_PUBLISHED_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_LEAVE_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_SPEAKERS_CHANGED_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_SUBSCRIBED_QUALITY_UPDATE_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_ROOM_UPDATE_TAG:
+        case LIVEKIT_PB_SIGNAL_RESPONSE_PONG_RESP_TAG:
+            return true;
+        default:
+            return false;
+    }
 }
 
 /// Processes responses before forwarding them to the receiver.
@@ -136,7 +401,8 @@ static inline bool res_middleware(signal_t *sg, livekit_pb_signal_response_t *re
         case LIVEKIT_PB_SIGNAL_RESPONSE_PONG_RESP_TAG:
             livekit_pb_pong_t *pong = &res->message.pong_resp;
             // Calculate round trip time (RTT) and restart ping timeout timer.
-            sg->rtt = get_unix_time_ms() - pong->last_ping_timestamp;
+            int64_t rtt = get_unix_time_ms() - pong->last_ping_timestamp;
+            sg->rtt = rtt > 0 ? (uint32_t)rtt : 0;
             xTimerReset(sg->ping_timeout_timer, 0);
             return false;
         default:
@@ -144,6 +410,114 @@ static inline bool res_middleware(signal_t *sg, livekit_pb_signal_response_t *re
     }
 }
 
+static void handle_message(signal_t *sg, const uint8_t *buf, size_t len)
+{
+    pb_size_t type = protocol_signal_response_peek_type(buf, len);
+    if (!is_res_consumed(type)) {
+        ESP_LOGD(TAG, "Skipping signal response: type=%d", type);
+        return;
+    }
+    livekit_pb_signal_response_t *res = NULL;
+    if (!protocol_signal_response_decode(buf, len, &res)) {
+        return;
+    }
+    bool is_taken = false;
+    do {
+        if (res->which_message == 0) {
+            // Response type is not supported yet.
+            break;
+        }
+        if (!res_middleware(sg, res)) {
+            // Don't forward.
+            break;
+        }
+        is_taken = sg->options.on_res(res, sg->options.ctx);
+    } while (0);
+
+    if (!is_taken) {
+        protocol_signal_response_free(res);
+    }
+}
+
+static void reset_rx(signal_t *sg)
+{
+    free(sg->rx_buf);
+    sg->rx_buf = NULL;
+    sg->rx_size = 0;
+    sg->rx_capacity = 0;
+    sg->is_rx_binary = false;
+    sg->is_rx_discarding = false;
+}
+
+/// Appends part of a frame to the reassembly buffer, reserving space for the
+/// rest of the frame on its first part.
+static bool append_rx(signal_t *sg, const esp_websocket_event_data_t *data)
+{
+    size_t required = sg->rx_size + (size_t)(data->payload_len - data->payload_offset);
+    if (required > CONFIG_LK_SIGNAL_MAX_MESSAGE_SIZE) {
+        ESP_LOGE(TAG, "Signal message exceeds %d bytes, discarding", CONFIG_LK_SIGNAL_MAX_MESSAGE_SIZE);
+        return false;
+    }
+    if (required > sg->rx_capacity) {
+        uint8_t *buf = realloc(sg->rx_buf, required);
+        if (buf == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate %zu bytes for signal message", required);
+            return false;
+        }
+        sg->rx_buf = buf;
+        sg->rx_capacity = required;
+    }
+    memcpy(sg->rx_buf + sg->rx_size, data->data_ptr, data->data_len);
+    sg->rx_size += data->data_len;
+    return true;
+}
+
+/// Handles one data event.
+///
+/// A frame larger than the WebSocket buffer is delivered over several events
+/// (`payload_offset` advancing to `payload_len`), and a message may span several
+/// frames (continuation frames until `fin`). Messages that arrive whole are
+/// decoded in place; others are reassembled first.
+///
+static void handle_data(signal_t *sg, const esp_websocket_event_data_t *data)
+{
+    bool is_frame_start = data->payload_offset == 0;
+    bool is_frame_end = data->payload_offset + data->data_len >= data->payload_len;
+
+    if (data->op_code >= WS_TRANSPORT_OPCODES_CLOSE) {
+        // Control frames (e.g., ping) may be interleaved with a fragmented message.
+        return;
+    }
+    if (data->op_code != WS_TRANSPORT_OPCODES_CONT && is_frame_start) {
+        // First part of a new message.
+        if (sg->rx_buf != NULL || sg->is_rx_discarding) {
+            ESP_LOGW(TAG, "Incomplete signal message discarded");
+            reset_rx(sg);
+        }
+        sg->is_rx_binary = data->op_code == WS_TRANSPORT_OPCODES_BINARY;
+        if (sg->is_rx_binary && is_frame_end && data->fin) {
+            if (data->data_len > 0) {
+                handle_message(sg, (const uint8_t *)data->data_ptr, data->data_len);
+            }
+            sg->is_rx_binary = false;
+            return;
+        }
+    }
+    if (!sg->is_rx_binary) {
+        return;
+    }
+    if (!sg->is_rx_discarding && data->data_len > 0 && !append_rx(sg, data)) {
+        sg->is_rx_discarding = true;
+    }
+    if (!is_frame_end || !data->fin) {
+        return;
+    }
+    if (!sg->is_rx_discarding && sg->rx_size > 0) {
+        handle_message(sg, sg->rx_buf, sg->rx_size);
+    }
+    reset_rx(sg);
+}
+
 static void on_ws_event(void *ctx, esp_event_base_t base, int32_t event_id, void *event_data)
 {
     signal_t *sg = (signal_t *)ctx;
@@ -151,10 +525,8 @@ static void on_ws_event(void *ctx, esp_event_base_t base, int32_t event_id, void
 
     switch (event_id) {
         case WEBSOCKET_EVENT_BEFORE_CONNECT:
-#if CONFIG_LK_BENCHMARK
-            sg->start_time = get_unix_time_ms();
-#endif
             sg->is_terminal_state = false;
+            reset_rx(sg);
             change_state(sg, SIGNAL_STATE_CONNECTING);
             break;
         case WEBSOCKET_EVENT_CLOSED:
@@ -183,35 +555,10 @@ static void on_ws_event(void *ctx, esp_event_base_t base, int32_t event_id, void
             change_state(sg, state);
             break;
         case WEBSOCKET_EVENT_CONNECTED:
-#if CONFIG_LK_BENCHMARK
-            ESP_LOGI(TAG, "[BENCH] Connected in %" PRIu64 "ms",
-                get_unix_time_ms() - sg->start_time);
-#endif
             change_state(sg, SIGNAL_STATE_CONNECTED);
             break;
         case WEBSOCKET_EVENT_DATA:
-            if (data->op_code != WS_TRANSPORT_OPCODES_BINARY) {
-                break;
-            }
-            if (data->data_len < 1) break;
-            livekit_pb_signal_response_t res = {};
-            if (!protocol_signal_response_decode((const uint8_t *)data->data_ptr, data->data_len, &res)) {
-                break;
-            }
-            if (res.which_message == 0) {
-                // Response type is not supported yet.
-                protocol_signal_response_free(&res);
-                break;
-            }
-            if (!res_middleware(sg, &res)) {
-                // Don't forward.
-                protocol_signal_response_free(&res);
-                break;
-            }
-            if (!sg->options.on_res(&res, sg->options.ctx)) {
-                // Ownership was not taken.
-                protocol_signal_response_free(&res);
-            }
+            handle_data(sg, data);
             break;
         default:
             break;
@@ -231,6 +578,30 @@ signal_handle_t signal_init(const signal_options_t *options)
     }
     sg->options = *options;
 
+    sg->control_queue = xQueueCreate(SIGNAL_CONTROL_QUEUE_SIZE, sizeof(signal_msg_t *));
+    sg->bulk_queue = xQueueCreate(CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE, sizeof(signal_msg_t *));
+    sg->free_msgs = xQueueCreate(SIGNAL_MSG_POOL_SIZE, sizeof(signal_msg_t *));
+    // One count per queued request, plus room for stop and exit wakeups.
+    sg->pending = xSemaphoreCreateCounting(
+        SIGNAL_CONTROL_QUEUE_SIZE + CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE + 2,
+        0
+    );
+    sg->drained = xSemaphoreCreateBinary();
+    sg->stats_lock = xSemaphoreCreateMutex();
+    sg->task_exited = xSemaphoreCreateBinary();
+    if (sg->control_queue == NULL ||
+        sg->bulk_queue    == NULL ||
+        sg->free_msgs     == NULL ||
+        sg->pending       == NULL ||
+        sg->drained       == NULL ||
+        sg->stats_lock    == NULL ||
+        sg->task_exited   == NULL) {
+        goto _init_failed;
+    }
+    for (int i = 0; i < SIGNAL_MSG_POOL_SIZE; i++) {
+        msg_release(sg, &sg->msg_pool[i]);
+    }
+
     sg->ping_interval_timer = xTimerCreate(
         "ping_interval",
         pdMS_TO_TICKS(1000), // Will be overwritten before start
@@ -253,7 +624,7 @@ signal_handle_t signal_init(const signal_options_t *options)
     }
     // URL will be set on connect
     static esp_websocket_client_config_t ws_config = {
-        .buffer_size = SIGNAL_WS_BUFFER_SIZE,
+        .buffer_size = CONFIG_LK_SIGNAL_WS_BUFFER_SIZE,
         .disable_pingpong_discon = true,
         .network_timeout_ms = SIGNAL_WS_NETWORK_TIMEOUT_MS,
         .disable_auto_reconnect = true,
@@ -273,6 +644,18 @@ signal_handle_t signal_init(const signal_options_t *options)
     ) != ESP_OK) {
         goto _init_failed;
     }
+    sg->is_running = true;
+    if (xTaskCreate(
+        writer_task,
+        "lk_signal_task",
+        CONFIG_LK_SIGNAL_TASK_STACK_SIZE,
+        (void *)sg,
+        CONFIG_LK_SIGNAL_TASK_PRIORITY,
+        &sg->writer_task
+    ) != pdPASS) {
+        sg->is_running = false;
+        goto _init_failed;
+    }
     return sg;
 _init_failed:
     signal_destroy(sg);
@@ -291,9 +674,39 @@ signal_err_t signal_destroy(signal_handle_t handle)
     if (sg->ping_timeout_timer != NULL) {
         xTimerDelete(sg->ping_timeout_timer, portMAX_DELAY);
     }
+    if (sg->is_running) {
+        sg->is_running = false;
+        xSemaphoreGive(sg->pending);
+        xSemaphoreTake(sg->task_exited, portMAX_DELAY);
+    }
     if (sg->ws != NULL) {
         esp_websocket_client_destroy(sg->ws);
     }
+    if (sg->stats_lock != NULL) {
+        discard_queued(sg);
+    }
+    if (sg->control_queue != NULL) {
+        vQueueDelete(sg->control_queue);
+    }
+    if (sg->bulk_queue != NULL) {
+        vQueueDelete(sg->bulk_queue);
+    }
+    if (sg->free_msgs != NULL) {
+        vQueueDelete(sg->free_msgs);
+    }
+    if (sg->pending != NULL) {
+        vSemaphoreDelete(sg->pending);
+    }
+    if (sg->drained != NULL) {
+        vSemaphoreDelete(sg->drained);
+    }
+    if (sg->stats_lock != NULL) {
+        vSemaphoreDelete(sg->stats_lock);
+    }
+    if (sg->task_exited != NULL) {
+        vSemaphoreDelete(sg->task_exited);
+    }
+    free(sg->rx_buf);
     free(sg);
     return SIGNAL_ERR_NONE;
 }
@@ -329,6 +742,19 @@ signal_err_t signal_close(signal_handle_t handle)
         return SIGNAL_ERR_INVALID_ARG;
     }
     signal_t *sg = (signal_t *)handle;
+
+    // Closing is intentional; don't report it as a disconnect or ping timeout.
+    sg->is_terminal_state = true;
+    xTimerStop(sg->ping_timeout_timer, 0);
+    xTimerStop(sg->ping_interval_timer, 0);
+    sg->state = SIGNAL_STATE_DISCONNECTED;
+    sg->is_stop_requested = false;
+
+    if (!wait_drained(sg, pdMS_TO_TICKS(SIGNAL_WS_CLOSE_TIMEOUT_MS))) {
+        ESP_LOGW(TAG, "Discarding requests not sent before closing");
+    }
+    discard_queued(sg);
+
     if (esp_websocket_client_is_connected(sg->ws) &&
         esp_websocket_client_close(sg->ws, pdMS_TO_TICKS(SIGNAL_WS_CLOSE_TIMEOUT_MS)) != ESP_OK) {
         return SIGNAL_ERR_WEBSOCKET;
@@ -415,4 +841,41 @@ signal_err_t signal_send_update_subscription(signal_handle_t handle, const char
     req.which_message = LIVEKIT_PB_SIGNAL_REQUEST_SUBSCRIPTION_TAG;
     req.message.subscription = subscription;
     return send_request(sg, &req);
+}
+
+signal_err_t signal_send_mute_track(signal_handle_t handle, const char *sid, bool muted)
+{
+    if (sid == NULL || handle == NULL) {
+        return SIGNAL_ERR_INVALID_ARG;
+    }
+    signal_t *sg = (signal_t *)handle;
+    livekit_pb_signal_request_t req = LIVEKIT_PB_SIGNAL_REQUEST_INIT_ZERO;
+    req.which_message = LIVEKIT_PB_SIGNAL_REQUEST_MUTE_TAG;
+    req.message.mute = (livekit_pb_mute_track_request_t){
+        .sid = (char *)sid,
+        .muted = muted
+    };
+    return send_request(sg, &req);
+}
+
+signal_err_t signal_get_send_stats(signal_handle_t handle, signal_send_stats_t *out_stats)
+{
+    if (handle == NULL || out_stats == NULL) {
+        return SIGNAL_ERR_INVALID_ARG;
+    }
+    signal_t *sg = (signal_t *)handle;
+    xSemaphoreTake(sg->stats_lock, portMAX_DELAY);
+    *out_stats = sg->send_stats;
+    out_stats->queue_depth = queue_depth(sg);
+    xSemaphoreGive(sg->stats_lock);
+    return SIGNAL_ERR_NONE;
+}
+
+uint32_t signal_get_rtt(signal_handle_t handle)
+{
+    if (handle == NULL) {
+        return 0;
+    }
+    signal_t *sg = (signal_t *)handle;
+    return sg->rtt;
 }
\ No newline at end of file
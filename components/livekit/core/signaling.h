@@ -32,6 +32,7 @@ typedef enum {
     SIGNAL_ERR_INVALID_URL = -4,
     SIGNAL_ERR_MESSAGE     = -5,
     SIGNAL_ERR_OTHER       = -6,
+    SIGNAL_ERR_QUEUE_FULL  = -7,
     // TODO: Add more error cases as needed
 } signal_err_t;
 
@@ -84,13 +85,34 @@ typedef struct {
 
     /// Invoked when a signal response is received.
     ///
-    /// The receiver returns true to take ownership of the response. If
-    /// ownership is not taken (false), the response will be freed with
-    /// `protocol_signal_response_free` internally.
+    /// The response is heap allocated. The receiver returns true to take ownership
+    /// of it, in which case it must later be released with `protocol_signal_response_free`.
+    /// If ownership is not taken (false), the response will be freed internally.
     ///
     bool (*on_res)(livekit_pb_signal_response_t *res, void *ctx);
 } signal_options_t;
 
+/// Outgoing signal request metrics.
+typedef struct {
+    /// Number of requests waiting to be sent.
+    uint32_t queue_depth;
+    /// Highest number of requests waiting at once.
+    uint32_t max_queue_depth;
+    /// Number of requests sent.
+    uint32_t sent;
+    /// Number of requests dropped because the queue was full: pings, or other
+    /// requests after the queue stayed full for the wait time.
+    uint32_t dropped;
+    /// Number of requests the WebSocket failed to send (e.g., while disconnected).
+    uint32_t failed;
+    /// Time from queueing to sent for the most recent request in microseconds.
+    uint32_t latency_last_us;
+    /// Longest time from queueing to sent in microseconds.
+    uint32_t latency_max_us;
+    /// Total time from queueing to sent in microseconds, for computing the mean.
+    uint64_t latency_total_us;
+} signal_send_stats_t;
+
 signal_handle_t signal_init(const signal_options_t *options);
 signal_err_t signal_destroy(signal_handle_t handle);
 
@@ -99,8 +121,21 @@ signal_err_t signal_destroy(signal_handle_t handle);
 signal_err_t signal_connect(signal_handle_t handle, const char* server_url, const char* token);
 
 /// Closes the WebSocket connection
+///
+/// Requests already queued are given a short time to be sent (e.g., a leave
+/// request sent just before), after which the rest are discarded. Closing is
+/// not reported as a state change.
+///
 signal_err_t signal_close(signal_handle_t handle);
 
+// Requests are encoded by the caller into preallocated slots of
+// `CONFIG_LK_SIGNAL_SEND_SLOT_SIZE` bytes (larger ones are allocated) and queued
+// for the writer task, which owns the socket; leave and ping requests are sent ahead of others. Pings are
+// dropped if the queue is full. Other requests wait for space, and if the queue
+// stays full the connection is stopped and reported as lost. A result of
+// `SIGNAL_ERR_NONE` means the request was queued, and `SIGNAL_ERR_QUEUE_FULL`
+// that it was dropped.
+
 /// Sends a leave request.
 signal_err_t signal_send_leave(signal_handle_t handle);
 signal_err_t signal_send_offer(signal_handle_t handle, const char *sdp);
@@ -109,6 +144,16 @@ signal_err_t signal_send_answer(signal_handle_t handle, const char *sdp);
 signal_err_t signal_send_add_track(signal_handle_t handle, livekit_pb_add_track_request_t *req);
 signal_err_t signal_send_update_subscription(signal_handle_t handle, const char *sid, bool subscribe);
 
+/// Sends a request to mute or unmute a published track.
+signal_err_t signal_send_mute_track(signal_handle_t handle, const char *sid, bool muted);
+
+/// Gets metrics for outgoing requests.
+signal_err_t signal_get_send_stats(signal_handle_t handle, signal_send_stats_t *out_stats);
+
+/// Returns the round-trip time measured by the last ping in milliseconds, or 0 if
+/// none has been measured.
+uint32_t signal_get_rtt(signal_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "timer_wheel.h"
+
+void timer_wheel_init(timer_wheel_t *wheel)
+{
+    memset(wheel, 0, sizeof(*wheel));
+}
+
+void timer_wheel_schedule(timer_wheel_t *wheel, timer_wheel_node_t *node, uint32_t ticks)
+{
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    node->expiry_tick = wheel->current_tick + ticks;
+    timer_wheel_node_t **slot = &wheel->slots[node->expiry_tick % TIMER_WHEEL_SLOTS];
+    node->next = *slot;
+    if (node->next != NULL) {
+        node->next->pprev = &node->next;
+    }
+    node->pprev = slot;
+    *slot = node;
+    wheel->count++;
+}
+
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_node_t *node)
+{
+    if (node->pprev == NULL) {
+        return;
+    }
+    *node->pprev = node->next;
+    if (node->next != NULL) {
+        node->next->pprev = node->pprev;
+    }
+    node->next = NULL;
+    node->pprev = NULL;
+    wheel->count--;
+}
+
+timer_wheel_node_t *timer_wheel_advance(timer_wheel_t *wheel)
+{
+    wheel->current_tick++;
+    timer_wheel_node_t *expired = NULL;
+    timer_wheel_node_t *node = wheel->slots[wheel->current_tick % TIMER_WHEEL_SLOTS];
+    while (node != NULL) {
+        timer_wheel_node_t *next = node->next;
+        // Nodes more than one revolution out share the slot; compare using serial
+        // number arithmetic to allow the tick counter to wrap.
+        if ((int32_t)(node->expiry_tick - wheel->current_tick) <= 0) {
+            timer_wheel_cancel(wheel, node);
+            node->next = expired;
+            expired = node;
+        }
+        node = next;
+    }
+    return expired;
+}
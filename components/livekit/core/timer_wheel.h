@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of slots in a timer wheel; deadlines further out wrap around.
+#define TIMER_WHEEL_SLOTS 64
+
+/// A deadline tracked by a timer wheel, embedded in the owner's structure.
+///
+/// Must be zero-initialized before first use.
+///
+typedef struct timer_wheel_node {
+    struct timer_wheel_node *next;
+    struct timer_wheel_node **pprev;
+    uint32_t expiry_tick;
+} timer_wheel_node_t;
+
+/// Hashed timer wheel for tracking many deadlines with a single periodic tick.
+///
+/// Scheduling and canceling are O(1); each tick only visits the nodes in one slot.
+/// Deadlines have the resolution of the tick period chosen by the caller.
+///
+/// @note Not thread-safe; callers must synchronize access.
+///
+typedef struct {
+    timer_wheel_node_t *slots[TIMER_WHEEL_SLOTS];
+    uint32_t current_tick;
+    size_t count;
+} timer_wheel_t;
+
+/// Initializes an empty wheel.
+void timer_wheel_init(timer_wheel_t *wheel);
+
+/// Schedules a node to expire after the given number of ticks (at least one).
+///
+/// The node must not already be scheduled.
+///
+void timer_wheel_schedule(timer_wheel_t *wheel, timer_wheel_node_t *node, uint32_t ticks);
+
+/// Cancels a node if it is scheduled.
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_node_t *node);
+
+/// Advances the wheel by one tick.
+///
+/// @returns Linked list (through `next`) of nodes that expired, which are
+///          no longer scheduled.
+///
+timer_wheel_node_t *timer_wheel_advance(timer_wheel_t *wheel);
+
+/// Whether any nodes are scheduled.
+static inline bool timer_wheel_is_empty(const timer_wheel_t *wheel)
+{
+    return wheel->count == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
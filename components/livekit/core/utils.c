@@ -16,6 +16,8 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 #include "esp_random.h"
 
 #include "utils.h"
@@ -36,4 +38,19 @@ uint16_t backoff_ms_for_attempt(uint16_t attempt)
     uint16_t rand = (uint16_t)(esp_random() % 1001); // range [0, 1000]
     uint16_t total = base + rand;
     return total > MAX_BACKOFF_MS ? MAX_BACKOFF_MS : total;
+}
+
+void generate_uuid(char out[UUID_STRING_SIZE])
+{
+    uint8_t bytes[16];
+    for (int i = 0; i < sizeof(bytes); i += 4) {
+        uint32_t value = esp_random();
+        memcpy(&bytes[i], &value, sizeof(value));
+    }
+    bytes[6] = (bytes[6] & 0x0F) | 0x40;
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+    snprintf(out, UUID_STRING_SIZE,
+        "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+        bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6], bytes[7],
+        bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
 }
\ No newline at end of file
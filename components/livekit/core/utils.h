@@ -33,6 +33,12 @@ int64_t get_unix_time_ms(void);
 ///
 uint16_t backoff_ms_for_attempt(uint16_t attempt);
 
+/// Size of a UUID string, including the NULL terminator.
+#define UUID_STRING_SIZE 37
+
+/// Generates a random (version 4) UUID string.
+void generate_uuid(char out[UUID_STRING_SIZE]);
+
 #ifdef __cplusplus
 }
 #endif
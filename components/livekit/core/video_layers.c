@@ -0,0 +1,161 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "esp_log.h"
+
+#include "video_layers.h"
+
+static const char *TAG = "livekit_video_layers";
+
+typedef struct {
+    video_layers_options_t options;
+
+    /// Whether subscribers requested any quality.
+    bool is_requested;
+    bool is_muted;
+
+    /// Whether video is paused. Written on the engine task and read on the media
+    /// streaming task.
+    _Atomic bool is_paused;
+    _Atomic bool is_base_path_shared;
+} video_layers_t;
+
+static inline void set_path_enabled(video_layers_t *layers, bool enabled)
+{
+    if (!enabled && atomic_load(&layers->is_base_path_shared)) {
+        // Audio is still captured on the path.
+        return;
+    }
+    if (esp_capture_sink_enable(
+        layers->options.base_path,
+        enabled ? ESP_CAPTURE_RUN_MODE_ALWAYS : ESP_CAPTURE_RUN_MODE_DISABLE
+    ) != ESP_CAPTURE_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to %s video capture", enabled ? "enable" : "disable");
+    }
+}
+
+/// Sends video, or pauses it if no quality is requested or video is muted.
+static void apply_state(video_layers_t *layers)
+{
+    bool is_paused = !layers->is_requested || layers->is_muted;
+    if (is_paused == atomic_load(&layers->is_paused)) {
+        return;
+    }
+    if (is_paused) {
+        atomic_store(&layers->is_paused, true);
+        set_path_enabled(layers, false);
+        ESP_LOGI(TAG, "Video paused: muted=%d", layers->is_muted);
+    } else {
+        set_path_enabled(layers, true);
+        atomic_store(&layers->is_paused, false);
+        ESP_LOGI(TAG, "Video resumed");
+    }
+}
+
+video_layers_err_t video_layers_create(video_layers_handle_t *handle, const video_layers_options_t *options)
+{
+    if (handle == NULL || options == NULL || options->base_path == NULL) {
+        return VIDEO_LAYERS_ERR_INVALID_ARG;
+    }
+    video_layers_t *layers = calloc(1, sizeof(video_layers_t));
+    if (layers == NULL) {
+        return VIDEO_LAYERS_ERR_NO_MEM;
+    }
+    layers->options = *options;
+    layers->is_requested = true;
+    atomic_store(&layers->is_base_path_shared, options->is_base_path_shared);
+    *handle = layers;
+    return VIDEO_LAYERS_ERR_NONE;
+}
+
+video_layers_err_t video_layers_destroy(video_layers_handle_t handle)
+{
+    if (handle == NULL) {
+        return VIDEO_LAYERS_ERR_INVALID_ARG;
+    }
+    free(handle);
+    return VIDEO_LAYERS_ERR_NONE;
+}
+
+esp_capture_sink_handle_t video_layers_get_path(video_layers_handle_t handle, bool *out_send)
+{
+    video_layers_t *layers = (video_layers_t *)handle;
+    bool is_paused = atomic_load_explicit(&layers->is_paused, memory_order_relaxed);
+    *out_send = !is_paused;
+    if (is_paused && !atomic_load_explicit(&layers->is_base_path_shared, memory_order_relaxed)) {
+        return NULL;
+    }
+    // A paused path that also captures audio is still drained, so that capture
+    // does not stall, but its frames are not sent.
+    return layers->options.base_path;
+}
+
+void video_layers_handle_update(video_layers_handle_t handle, const livekit_pb_subscribed_quality_update_t *update)
+{
+    video_layers_t *layers = (video_layers_t *)handle;
+    if (layers == NULL || update == NULL) {
+        return;
+    }
+    // Only one video track is published, so the update is for it. Only one codec
+    // is published too, so the qualities of all codecs are combined.
+    bool any_enabled = false;
+    for (pb_size_t i = 0; i < update->subscribed_codecs_count; i++) {
+        const livekit_pb_subscribed_codec_t *codec = &update->subscribed_codecs[i];
+        for (pb_size_t j = 0; j < codec->qualities_count; j++) {
+            const livekit_pb_subscribed_quality_t *quality = &codec->qualities[j];
+            if (quality->enabled && quality->quality != LIVEKIT_PB_VIDEO_QUALITY_OFF) {
+                any_enabled = true;
+            }
+        }
+    }
+    layers->is_requested = any_enabled;
+    apply_state(layers);
+}
+
+void video_layers_reset(video_layers_handle_t handle)
+{
+    video_layers_t *layers = (video_layers_t *)handle;
+    if (layers == NULL) {
+        return;
+    }
+    layers->is_requested = true;
+    apply_state(layers);
+}
+
+void video_layers_set_muted(video_layers_handle_t handle, bool muted)
+{
+    video_layers_t *layers = (video_layers_t *)handle;
+    if (layers == NULL) {
+        return;
+    }
+    layers->is_muted = muted;
+    apply_state(layers);
+}
+
+void video_layers_set_base_path_shared(video_layers_handle_t handle, bool shared)
+{
+    video_layers_t *layers = (video_layers_t *)handle;
+    if (layers == NULL) {
+        return;
+    }
+    atomic_store(&layers->is_base_path_shared, shared);
+    if (atomic_load(&layers->is_paused)) {
+        // Capture for audio only while it is needed.
+        set_path_enabled(layers, shared);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "esp_capture_sink.h"
+#include "protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *video_layers_handle_t;
+
+typedef enum {
+    VIDEO_LAYERS_ERR_NONE        =  0,
+    VIDEO_LAYERS_ERR_INVALID_ARG = -1,
+    VIDEO_LAYERS_ERR_NO_MEM      = -2
+} video_layers_err_t;
+
+typedef struct {
+    /// Capture path 0, which captures the published video layer.
+    esp_capture_sink_handle_t base_path;
+
+    /// Whether `base_path` also captures audio, in which case it is never disabled.
+    bool is_base_path_shared;
+} video_layers_options_t;
+
+/// Creates the layers for video captured on `base_path`, sending it initially.
+video_layers_err_t video_layers_create(video_layers_handle_t *handle, const video_layers_options_t *options);
+
+/// Destroys the layers.
+video_layers_err_t video_layers_destroy(video_layers_handle_t handle);
+
+/// Gets the path to take video frames from.
+///
+/// @param[out] out_send Whether frames taken from the path should be sent; false while
+///                      video is paused but its path also captures audio.
+/// @returns The path, or NULL if no video is being captured.
+///
+esp_capture_sink_handle_t video_layers_get_path(video_layers_handle_t handle, bool *out_send);
+
+/// Applies the qualities subscribers requested.
+///
+/// A single layer is published, so any quality requested is served by it. If no
+/// quality is requested, video is paused.
+///
+void video_layers_handle_update(video_layers_handle_t handle, const livekit_pb_subscribed_quality_update_t *update);
+
+/// Resumes video after a new session starts.
+///
+/// Video stays paused if muted.
+///
+void video_layers_reset(video_layers_handle_t handle);
+
+/// Mutes or unmutes video. While muted, video is paused regardless of the
+/// qualities requested.
+void video_layers_set_muted(video_layers_handle_t handle, bool muted);
+
+/// Sets whether `base_path` also captures audio (e.g., false while audio is muted).
+///
+/// While video is paused, the base path is only kept running if it is shared.
+///
+void video_layers_set_base_path_shared(video_layers_handle_t handle, bool shared);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include <malloc.h>
+
+#include "host_time.h"
+#include "bench.h"
+
+// MARK: - Allocation interposer
+//
+// malloc and friends are replaced process-wide so that every allocation,
+// including those made by nanopb's pb_realloc and strdup inside libc, is
+// counted. The glibc entry points do the real work.
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static atomic_uint_fast64_t alloc_count;
+static atomic_uint_fast64_t alloc_bytes;
+static atomic_int_fast64_t live_count;
+static atomic_int_fast64_t live_bytes;
+
+static inline void count_alloc(size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&alloc_bytes, size, memory_order_relaxed);
+}
+
+/// Tracks blocks held by the process, by their usable size as the allocator
+/// rounds it.
+static inline void count_live(void *ptr, int sign)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    atomic_fetch_add_explicit(&live_count, sign, memory_order_relaxed);
+    atomic_fetch_add_explicit(&live_bytes, sign * (int64_t)malloc_usable_size(ptr), memory_order_relaxed);
+}
+
+void *malloc(size_t size)
+{
+    count_alloc(size);
+    void *ptr = __libc_malloc(size);
+    count_live(ptr, 1);
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size)
+{
+    count_alloc(count * size);
+    void *ptr = __libc_calloc(count, size);
+    count_live(ptr, 1);
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    // Growing an existing block is counted as an allocation of the new size,
+    // which matches the cost model of the allocator on target.
+    count_alloc(size);
+    count_live(ptr, -1);
+    void *new_ptr = __libc_realloc(ptr, size);
+    count_live(new_ptr != NULL || size == 0 ? new_ptr : ptr, 1);
+    return new_ptr;
+}
+
+void free(void *ptr)
+{
+    count_live(ptr, -1);
+    __libc_free(ptr);
+}
+
+void bench_alloc_snapshot(bench_alloc_stats_t *out)
+{
+    out->allocs = atomic_load_explicit(&alloc_count, memory_order_relaxed);
+    out->bytes = atomic_load_explicit(&alloc_bytes, memory_order_relaxed);
+    out->live_allocs = atomic_load_explicit(&live_count, memory_order_relaxed);
+    out->live_bytes = atomic_load_explicit(&live_bytes, memory_order_relaxed);
+}
+
+// MARK: - Runner
+
+bool bench_is_selected(const bench_config_t *config, const char *name)
+{
+    return config->filter == NULL || strstr(name, config->filter) != NULL;
+}
+
+void bench_print_header(const bench_config_t *config)
+{
+    if (config->csv) {
+        printf("name,iterations,ns_per_op,allocs_per_op,bytes_per_op\n");
+    } else {
+        printf("%-48s %10s %12s %10s %10s\n", "benchmark", "iters", "ns/op", "allocs/op", "bytes/op");
+    }
+}
+
+void bench_run(const bench_config_t *config, const char *name, bench_fn_t fn, void *ctx)
+{
+    if (!bench_is_selected(config, name)) {
+        return;
+    }
+    const uint64_t min_time_ns = (uint64_t)config->min_time_ms * 1000000ULL;
+
+    // Warm up caches and any lazily initialized state.
+    fn(ctx);
+
+    uint64_t iterations = 1;
+    uint64_t elapsed_ns = 0;
+    bench_alloc_stats_t before, after;
+    for (;;) {
+        bench_alloc_snapshot(&before);
+        uint64_t start = host_time_now_ns();
+        for (uint64_t i = 0; i < iterations; i++) {
+            fn(ctx);
+        }
+        elapsed_ns = host_time_now_ns() - start;
+        bench_alloc_snapshot(&after);
+        if (elapsed_ns >= min_time_ns || iterations >= (1ULL << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    double ns_per_op = (double)elapsed_ns / (double)iterations;
+    double allocs_per_op = (double)(after.allocs - before.allocs) / (double)iterations;
+    double bytes_per_op = (double)(after.bytes - before.bytes) / (double)iterations;
+    if (config->csv) {
+        printf("%s,%" PRIu64 ",%.1f,%.2f,%.1f\n", name, iterations, ns_per_op, allocs_per_op, bytes_per_op);
+    } else {
+        printf("%-48s %10" PRIu64 " %12.1f %10.2f %10.1f\n", name, iterations, ns_per_op, allocs_per_op, bytes_per_op);
+    }
+    fflush(stdout);
+}
+
+void bench_print_metric(const bench_config_t *config, const char *name, double value)
+{
+    if (config->csv) {
+        printf("%s,,%.1f,,\n", name, value);
+    } else {
+        printf("%-48s %10s %12.1f\n", name, "-", value);
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Options shared by all benchmarks in a run.
+typedef struct {
+    /// Only benchmarks whose name contains this substring are run (NULL runs all).
+    const char *filter;
+
+    /// Minimum measured wall time per benchmark.
+    uint32_t min_time_ms;
+
+    /// Print results as CSV instead of an aligned table.
+    bool csv;
+} bench_config_t;
+
+/// Heap activity observed by the allocation interposer.
+typedef struct {
+    uint64_t allocs;
+    uint64_t bytes;
+    /// Blocks not yet freed.
+    int64_t live_allocs;
+    /// Usable size of the blocks not yet freed, including rounding by the allocator.
+    int64_t live_bytes;
+} bench_alloc_stats_t;
+
+typedef void (*bench_fn_t)(void *ctx);
+
+/// Prints the column header for the selected output format.
+void bench_print_header(const bench_config_t *config);
+
+/// Runs `fn` until `min_time_ms` has elapsed and prints ns/op, allocations/op
+/// and bytes allocated/op.
+///
+/// The iteration count doubles until the time budget is met; only the final
+/// batch is reported, so one-time warm-up costs are excluded.
+///
+void bench_run(const bench_config_t *config, const char *name, bench_fn_t fn, void *ctx);
+
+/// Prints a single measured value for benchmarks that do not fit `bench_run`.
+///
+/// The unit should be part of the name (e.g., "peer_loop/idle_wakeups_per_s").
+///
+void bench_print_metric(const bench_config_t *config, const char *name, double value);
+
+/// Returns whether a benchmark with the given name is selected by the filter.
+bool bench_is_selected(const bench_config_t *config, const char *name);
+
+/// Reads the process-wide allocation counters.
+void bench_alloc_snapshot(bench_alloc_stats_t *out);
+
+/// Prevents the compiler from discarding a computed value.
+static inline void bench_keep(const void *value)
+{
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "esp_random.h"
+#include "audio_vad.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Measures voice activity detection on one 20 ms frame of 16 kHz mono PCM:
+// the integer energy kernel, the same measure computed in floating point with
+// a square root as an RMS level meter would, and the full detector. Before
+// measuring, the energy is checked against an exact reference and the detector
+// against a synthetic pause between two bursts of speech.
+
+#define FRAME_MS         20
+#define RATE_HZ          16000
+#define FRAME_LEN        (RATE_HZ * FRAME_MS / 1000)
+#define THRESHOLD_DBFS   -50
+#define HANGOVER_MS      200
+#define NOISE_AMPLITUDE  16      // About -66 dBFS
+#define VOICE_AMPLITUDE  8000    // About -12 dBFS
+
+static int16_t noise[FRAME_LEN];
+static int16_t voice[FRAME_LEN];
+
+static void bench_energy(void *ctx)
+{
+    uint32_t energy = audio_vad_energy(ctx, FRAME_LEN);
+    bench_keep(&energy);
+}
+
+static void bench_rms_double(void *ctx)
+{
+    const int16_t *samples = ctx;
+    double sum = 0;
+    for (size_t i = 0; i < FRAME_LEN; i++) {
+        sum += (double)samples[i] * samples[i];
+    }
+    double rms = sqrt(sum / FRAME_LEN);
+    bench_keep(&rms);
+}
+
+static void bench_process(void *ctx)
+{
+    static audio_vad_t vad;
+    static bool is_initialized;
+    if (!is_initialized) {
+        audio_vad_init(&vad, THRESHOLD_DBFS, HANGOVER_MS);
+        is_initialized = true;
+    }
+    bool is_speaking = audio_vad_process(&vad, ctx, FRAME_LEN, FRAME_MS);
+    bench_keep(&is_speaking);
+}
+
+static void check_energy(const int16_t *samples, size_t count)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (uint64_t)((int32_t)samples[i] * samples[i]);
+    }
+    uint32_t expected = count > 0 ? (uint32_t)(sum / count) : 0;
+    uint32_t energy = audio_vad_energy(samples, count);
+    if (energy != expected) {
+        fprintf(stderr, "audio_vad: energy of %zu samples is %u, expected %u\n",
+            count, energy, expected);
+        abort();
+    }
+}
+
+static void check_detector(void)
+{
+    // Noise, speech, a pause longer than the hangover, then speech again.
+    static const struct {
+        const int16_t *frame;
+        int count;
+        bool is_speaking;
+    } steps[] = {
+        { noise, 25, false },
+        { voice, 10, true },
+        { noise, HANGOVER_MS / FRAME_MS - 1, true },
+        { noise, 1, false },
+        { noise, 5, false },
+        { voice, 1, true },
+    };
+    audio_vad_t vad;
+    audio_vad_init(&vad, THRESHOLD_DBFS, HANGOVER_MS);
+    for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        for (int i = 0; i < steps[s].count; i++) {
+            if (audio_vad_process(&vad, steps[s].frame, FRAME_LEN, FRAME_MS) != steps[s].is_speaking) {
+                fprintf(stderr, "audio_vad: step %zu frame %d should be %s\n",
+                    s, i, steps[s].is_speaking ? "speaking" : "silent");
+                abort();
+            }
+        }
+    }
+}
+
+void bench_audio_vad(const bench_config_t *config)
+{
+    if (!bench_is_selected(config, "audio_vad")) {
+        return;
+    }
+    for (size_t i = 0; i < FRAME_LEN; i++) {
+        noise[i] = (int16_t)((int32_t)(esp_random() % (2 * NOISE_AMPLITUDE + 1)) - NOISE_AMPLITUDE);
+        // A 250 Hz tone with noise on top.
+        voice[i] = (int16_t)(VOICE_AMPLITUDE * sin(2 * M_PI * 250 * i / RATE_HZ)) + noise[i];
+    }
+    static int16_t full_scale[FRAME_LEN + 7];
+    for (size_t i = 0; i < sizeof(full_scale) / sizeof(full_scale[0]); i++) {
+        full_scale[i] = (i & 1) ? INT16_MIN : INT16_MAX;
+    }
+    for (size_t count = 0; count <= FRAME_LEN + 7; count += 13) {
+        check_energy(full_scale, count);
+        check_energy(voice, count < FRAME_LEN ? count : FRAME_LEN);
+    }
+    check_detector();
+
+    bench_run(config, "audio_vad[16k]/energy", bench_energy, voice);
+    bench_run(config, "audio_vad[16k]/rms_double", bench_rms_double, voice);
+    bench_run(config, "audio_vad[16k]/process", bench_process, voice);
+}
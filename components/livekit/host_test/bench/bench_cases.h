@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "bench.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Encode/decode cost of every function in core/protocol.h.
+void bench_protocol(const bench_config_t *config);
+
+/// Peer connection loop wakeups and data packet turnaround over a loopback.
+void bench_peer_loop(const bench_config_t *config);
+
+/// Receive path cost of queuing data packets for the dispatch task.
+void bench_data_dispatch(const bench_config_t *config);
+
+/// Send and receive cost of a large data stream over an encode/decode loopback.
+void bench_data_stream(const bench_config_t *config);
+
+/// Caller and timer task stalls caused by a slow signaling socket.
+void bench_signal_send(const bench_config_t *config);
+
+/// Cost of detecting voice activity in a 16 kHz PCM frame.
+void bench_audio_vad(const bench_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host_time.h"
+#include "data_dispatch.h"
+#include "fixtures.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Measures the time the receiving thread (the peer connection loop) spends per
+// data packet when handlers are invoked inline, as before the dispatch task was
+// added, and when packets are queued for the dispatch task.
+
+#define NAME_MAX_LEN     96
+#define SLOW_HANDLER_US  2000
+#define BURST_PACKETS    8
+#define DRAIN_TIMEOUT_MS 1000
+
+static void on_packet_fast(livekit_pb_data_packet_t *packet, void *ctx)
+{
+    bench_keep(packet);
+}
+
+static void on_packet_slow(livekit_pb_data_packet_t *packet, void *ctx)
+{
+    uint64_t until_ns = host_time_now_ns() + SLOW_HANDLER_US * 1000ULL;
+    while (host_time_now_ns() < until_ns) {}
+}
+
+static livekit_pb_data_packet_t *decode_user_packet(void)
+{
+    const fixture_buf_t *encoded = fixture_packet_encoded(FIXTURE_PACKET_USER);
+    livekit_pb_data_packet_t *packet = NULL;
+    if (!protocol_data_packet_decode(encoded->data, encoded->len, &packet)) {
+        fprintf(stderr, "data_dispatch: failed to decode fixture\n");
+        abort();
+    }
+    return packet;
+}
+
+static void bench_decode_enqueue(void *ctx)
+{
+    livekit_pb_data_packet_t *packet = decode_user_packet();
+    if (!data_dispatch_enqueue((data_dispatch_handle_t)ctx, packet, true)) {
+        protocol_data_packet_free(packet);
+    }
+}
+
+static void wait_for_drain(data_dispatch_handle_t dispatch, uint32_t expected)
+{
+    data_dispatch_stats_t stats = {};
+    for (int waited = 0; waited < DRAIN_TIMEOUT_MS; waited++) {
+        data_dispatch_get_stats(dispatch, &stats);
+        if (stats.dispatched >= expected) {
+            return;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    fprintf(stderr, "data_dispatch: packets were not dispatched\n");
+    abort();
+}
+
+static void print(const bench_config_t *config, const char *metric, double value)
+{
+    char name[NAME_MAX_LEN];
+    snprintf(name, sizeof(name), "data_dispatch/%s", metric);
+    bench_print_metric(config, name, value);
+}
+
+void bench_data_dispatch(const bench_config_t *config)
+{
+    if (!bench_is_selected(config, "data_dispatch")) {
+        return;
+    }
+    data_dispatch_handle_t dispatch = NULL;
+
+    // 1. Receive path cost with a handler that returns immediately
+    if (data_dispatch_create(&dispatch, &(data_dispatch_options_t){ .on_packet = on_packet_fast }) != DATA_DISPATCH_ERR_NONE) {
+        fprintf(stderr, "data_dispatch: failed to create dispatcher\n");
+        abort();
+    }
+    bench_run(config, "data_dispatch/decode_enqueue/user", bench_decode_enqueue, dispatch);
+    data_dispatch_destroy(dispatch);
+
+    // 2. Time the receiving thread is blocked by a burst of packets with a slow handler
+    livekit_pb_data_packet_t *packet;
+    uint64_t start_ns = host_time_now_ns();
+    for (int i = 0; i < BURST_PACKETS; i++) {
+        packet = decode_user_packet();
+        on_packet_slow(packet, NULL);
+        protocol_data_packet_free(packet);
+    }
+    print(config, "slow_handler/inline_stall_us", (host_time_now_ns() - start_ns) / 1e3 / BURST_PACKETS);
+
+    if (data_dispatch_create(&dispatch, &(data_dispatch_options_t){ .on_packet = on_packet_slow }) != DATA_DISPATCH_ERR_NONE) {
+        fprintf(stderr, "data_dispatch: failed to create dispatcher\n");
+        abort();
+    }
+    start_ns = host_time_now_ns();
+    for (int i = 0; i < BURST_PACKETS; i++) {
+        packet = decode_user_packet();
+        if (!data_dispatch_enqueue(dispatch, packet, true)) {
+            protocol_data_packet_free(packet);
+        }
+    }
+    print(config, "slow_handler/queued_stall_us", (host_time_now_ns() - start_ns) / 1e3 / BURST_PACKETS);
+    wait_for_drain(dispatch, BURST_PACKETS);
+
+    // 3. Lossy packets dropped when a burst exceeds the queue
+    for (int i = 0; i < CONFIG_LK_DATA_QUEUE_SIZE * 2; i++) {
+        packet = decode_user_packet();
+        if (!data_dispatch_enqueue(dispatch, packet, false)) {
+            protocol_data_packet_free(packet);
+        }
+    }
+    data_dispatch_stats_t stats = {};
+    data_dispatch_get_stats(dispatch, &stats);
+    print(config, "slow_handler/reliable_burst_dropped", stats.dropped_reliable);
+    print(config, "slow_handler/lossy_burst_dropped", stats.dropped_lossy);
+    print(config, "slow_handler/max_queue_depth", stats.max_queue_depth);
+    print(config, "slow_handler/handler_mean_us", (double)stats.handler_total_us / stats.dispatched);
+    wait_for_drain(dispatch, stats.dispatched + stats.queue_depth);
+
+    // 4. Reliable packets held without holding back the receiving thread when they overflow the queue
+    uint32_t dispatched = stats.dispatched;
+    uint32_t queued = 0;
+    start_ns = host_time_now_ns();
+    for (int i = 0; i < CONFIG_LK_DATA_QUEUE_SIZE * 2; i++) {
+        packet = decode_user_packet();
+        if (data_dispatch_enqueue(dispatch, packet, true)) {
+            queued++;
+        } else {
+            protocol_data_packet_free(packet);
+        }
+    }
+    print(config, "slow_handler/overflow_enqueue_us", (host_time_now_ns() - start_ns) / 1e3 / (CONFIG_LK_DATA_QUEUE_SIZE * 2));
+    wait_for_drain(dispatch, dispatched + queued);
+    data_dispatch_get_stats(dispatch, &stats);
+    print(config, "slow_handler/overflow_dropped", stats.dropped_reliable);
+    print(config, "slow_handler/overflow_max_held", stats.max_overflow_depth);
+    data_dispatch_destroy(dispatch);
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "data_stream.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Measures sending and receiving a large data stream. Packets from the writer are
+// encoded, decoded, and handed straight to the receiving side, as they would be
+// after crossing the data channel, so the allocations reported per stream are
+// those of the full round trip.
+
+#define NAME_MAX_LEN    96
+#define STREAM_SIZE     (256 * 1024)
+#define WRITE_SIZE      700
+#define ENC_BUFFER_SIZE 512
+
+typedef struct {
+    data_stream_manager_handle_t sender;
+    data_stream_manager_handle_t receiver;
+    protocol_enc_buf_t enc_buf;
+    livekit_data_stream_kind_t kind;
+    uint8_t *content;
+    uint64_t received_bytes;
+    uint32_t chunks;
+    livekit_data_stream_close_reason_t close_reason;
+} stream_ctx_t;
+
+static bool loopback_packet(const livekit_pb_data_packet_t *packet, void *ctx)
+{
+    stream_ctx_t *stream = ctx;
+    size_t encoded_size = protocol_data_packet_encode_into(packet, &stream->enc_buf);
+    livekit_pb_data_packet_t *decoded = NULL;
+    if (encoded_size == 0 ||
+        !protocol_data_packet_decode(stream->enc_buf.data, encoded_size, &decoded)) {
+        fprintf(stderr, "data_stream: failed to encode or decode packet\n");
+        abort();
+    }
+    data_stream_manager_handle_packet(stream->receiver, decoded);
+    protocol_data_packet_free(decoded);
+    return true;
+}
+
+static size_t get_buffered_amount(void *ctx)
+{
+    return 0;
+}
+
+static bool on_open(const livekit_data_stream_info_t *info, void **stream_ctx, void *ctx)
+{
+    stream_ctx_t *stream = ctx;
+    stream->received_bytes = 0;
+    stream->chunks = 0;
+    *stream_ctx = stream;
+    return true;
+}
+
+static bool on_chunk(const uint8_t *data, size_t size, void *stream_ctx)
+{
+    stream_ctx_t *stream = stream_ctx;
+    if (stream->received_bytes + size > STREAM_SIZE ||
+        memcmp(data, stream->content + stream->received_bytes, size) != 0) {
+        fprintf(stderr, "data_stream: received content does not match\n");
+        abort();
+    }
+    // Text chunks must not end in the middle of a character.
+    if (stream->kind == LIVEKIT_DATA_STREAM_KIND_TEXT &&
+        stream->received_bytes + size < STREAM_SIZE &&
+        (stream->content[stream->received_bytes + size] & 0xC0) == 0x80) {
+        fprintf(stderr, "data_stream: text chunk split a character\n");
+        abort();
+    }
+    stream->received_bytes += size;
+    stream->chunks++;
+    return true;
+}
+
+static void on_close(livekit_data_stream_close_reason_t reason, void *stream_ctx)
+{
+    ((stream_ctx_t *)stream_ctx)->close_reason = reason;
+}
+
+static void bench_send_stream(void *ctx)
+{
+    stream_ctx_t *stream = ctx;
+    livekit_data_stream_options_t stream_options = {
+        .topic = "bench",
+        .kind = stream->kind,
+        .total_length = STREAM_SIZE
+    };
+    livekit_data_stream_writer_handle_t writer;
+    if (data_stream_writer_open(stream->sender, &stream_options, &writer) != DATA_STREAM_ERR_NONE) {
+        abort();
+    }
+    for (size_t offset = 0; offset < STREAM_SIZE; offset += WRITE_SIZE) {
+        size_t size = STREAM_SIZE - offset < WRITE_SIZE ? STREAM_SIZE - offset : WRITE_SIZE;
+        data_stream_writer_write(writer, stream->content + offset, size);
+    }
+    stream->close_reason = LIVEKIT_DATA_STREAM_CLOSE_REASON_INTERRUPTED;
+    data_stream_writer_close(writer, NULL);
+    if (stream->close_reason != LIVEKIT_DATA_STREAM_CLOSE_REASON_COMPLETE ||
+        stream->received_bytes != STREAM_SIZE) {
+        fprintf(stderr, "data_stream: stream did not complete\n");
+        abort();
+    }
+}
+
+static void fill_content(uint8_t *content, livekit_data_stream_kind_t kind)
+{
+    if (kind == LIVEKIT_DATA_STREAM_KIND_BYTE) {
+        for (size_t i = 0; i < STREAM_SIZE; i++) {
+            content[i] = (uint8_t)(i * 31 + 7);
+        }
+        return;
+    }
+    // Mix of one to four byte characters ("a", "é", "€", "😀").
+    static const char *characters[] = { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    size_t offset = 0;
+    for (int i = 0; offset < STREAM_SIZE; i++) {
+        const char *character = characters[i % 4];
+        size_t length = strlen(character);
+        if (offset + length > STREAM_SIZE) {
+            character = "a";
+            length = 1;
+        }
+        memcpy(content + offset, character, length);
+        offset += length;
+    }
+}
+
+static void run_case(const bench_config_t *config, livekit_data_stream_kind_t kind, const char *kind_name)
+{
+    stream_ctx_t stream = { .kind = kind, .content = malloc(STREAM_SIZE) };
+    if (stream.content == NULL || !protocol_enc_buf_init(&stream.enc_buf, ENC_BUFFER_SIZE)) {
+        abort();
+    }
+    fill_content(stream.content, kind);
+
+    data_stream_manager_options_t options = {
+        .send_packet = loopback_packet,
+        .get_buffered_amount = get_buffered_amount,
+        .window_size = CONFIG_LK_DATA_STREAM_WINDOW_SIZE,
+        .ctx = &stream
+    };
+    livekit_data_stream_handler_t handler = {
+        .on_open = on_open,
+        .on_chunk = on_chunk,
+        .on_close = on_close,
+        .ctx = &stream
+    };
+    if (data_stream_manager_create(&stream.sender, &options) != DATA_STREAM_ERR_NONE ||
+        data_stream_manager_create(&stream.receiver, &options) != DATA_STREAM_ERR_NONE ||
+        data_stream_manager_register(stream.receiver, "bench", &handler) != DATA_STREAM_ERR_NONE) {
+        abort();
+    }
+
+    char name[NAME_MAX_LEN];
+    snprintf(name, sizeof(name), "data_stream/%s_256KiB", kind_name);
+    bench_run(config, name, bench_send_stream, &stream);
+    snprintf(name, sizeof(name), "data_stream/%s_chunks_per_stream", kind_name);
+    bench_print_metric(config, name, stream.chunks);
+
+    data_stream_manager_destroy(stream.sender);
+    data_stream_manager_destroy(stream.receiver);
+    protocol_enc_buf_free(&stream.enc_buf);
+    free(stream.content);
+}
+
+void bench_data_stream(const bench_config_t *config)
+{
+    if (!bench_is_selected(config, "data_stream")) {
+        return;
+    }
+    run_case(config, LIVEKIT_DATA_STREAM_KIND_BYTE, "byte");
+    run_case(config, LIVEKIT_DATA_STREAM_KIND_TEXT, "text");
+}
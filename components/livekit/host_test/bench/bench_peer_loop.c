@@ -0,0 +1,182 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_random.h"
+#include "esp_peer_fake.h"
+#include "host_time.h"
+#include "peer.h"
+#include "fixtures.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Measures how often the peer connection loop wakes up and how long a data
+// packet takes to make it through the loop. The esp_peer stand-in is put in
+// loopback mode, so a packet sent on the publisher is delivered back to it on
+// the next loop iteration. Inbound frames are also injected from outside the
+// loop, as if the remote peer had sent them unprompted while the loop was idle.
+//
+// Build with -DCONFIG_LK_PEER_LOOP_ADAPTIVE=1 to measure the adaptive loop.
+
+#define NAME_MAX_LEN        96
+#define CONNECT_TIMEOUT_MS  2000
+#define SETTLE_MS           300
+#define TURNAROUND_SAMPLES  200
+#define MAX_SEND_GAP_MS     25
+#define INBOUND_SAMPLES     30
+#define INBOUND_IDLE_MS     60
+
+#if CONFIG_LK_PEER_LOOP_ADAPTIVE
+#define LOOP_MODE "adaptive"
+#else
+#define LOOP_MODE "polling"
+#endif
+
+typedef struct {
+    volatile connection_state_t state;
+    SemaphoreHandle_t received;
+    volatile uint64_t received_ns;
+} loop_ctx_t;
+
+static void on_state_changed(connection_state_t state, peer_role_t role, void *ctx)
+{
+    ((loop_ctx_t *)ctx)->state = state;
+}
+
+static void on_sdp(const char *sdp, peer_role_t role, void *ctx) {}
+
+static bool on_data_packet(livekit_pb_data_packet_t *packet, bool reliable, void *ctx)
+{
+    loop_ctx_t *loop = ctx;
+    loop->received_ns = host_time_now_ns();
+    xSemaphoreGive(loop->received);
+    return false;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print(const bench_config_t *config, const char *metric, double value)
+{
+    char name[NAME_MAX_LEN];
+    snprintf(name, sizeof(name), "peer_loop[%s]/%s", LOOP_MODE, metric);
+    bench_print_metric(config, name, value);
+}
+
+void bench_peer_loop(const bench_config_t *config)
+{
+    if (!bench_is_selected(config, "peer_loop")) {
+        return;
+    }
+    esp_peer_fake_configure(&(esp_peer_fake_cfg_t){ .auto_connect = true, .loopback = true });
+
+    loop_ctx_t loop = { .received = xSemaphoreCreateBinary() };
+    engine_media_options_t media = {};
+    peer_options_t options = {
+        .role = PEER_ROLE_PUBLISHER,
+        .media = &media,
+        .on_state_changed = on_state_changed,
+        .on_sdp = on_sdp,
+        .on_data_packet = on_data_packet,
+        .ctx = &loop
+    };
+    peer_handle_t peer = NULL;
+    if (loop.received == NULL ||
+        peer_create(&peer, &options) != PEER_ERR_NONE ||
+        peer_connect(peer) != PEER_ERR_NONE) {
+        fprintf(stderr, "peer_loop: failed to start peer\n");
+        abort();
+    }
+    for (int waited = 0; loop.state != CONNECTION_STATE_CONNECTED; waited++) {
+        if (waited > CONNECT_TIMEOUT_MS) {
+            fprintf(stderr, "peer_loop: peer did not connect\n");
+            abort();
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+
+    // 1. Idle wakeups
+    vTaskDelay(pdMS_TO_TICKS(SETTLE_MS));
+    uint32_t idle_ms = config->min_time_ms < 1000 ? 1000 : config->min_time_ms;
+    uint64_t loops_before = esp_peer_fake_main_loop_count();
+    vTaskDelay(pdMS_TO_TICKS(idle_ms));
+    uint64_t idle_loops = esp_peer_fake_main_loop_count() - loops_before;
+    print(config, "idle_wakeups_per_s", idle_loops * 1000.0 / idle_ms);
+
+    // 2. Turnaround of packets sent at random points relative to the loop.
+    const livekit_pb_data_packet_t *packet = fixture_packet(FIXTURE_PACKET_USER, NULL);
+    uint64_t samples[TURNAROUND_SAMPLES];
+    uint64_t start_ns = host_time_now_ns();
+    loops_before = esp_peer_fake_main_loop_count();
+    for (int i = 0; i < TURNAROUND_SAMPLES; i++) {
+        vTaskDelay(pdMS_TO_TICKS(esp_random() % MAX_SEND_GAP_MS));
+        uint64_t sent_ns = host_time_now_ns();
+        if (peer_send_data_packet(peer, packet, true) != PEER_ERR_NONE ||
+            xSemaphoreTake(loop.received, pdMS_TO_TICKS(1000)) != pdTRUE) {
+            fprintf(stderr, "peer_loop: packet was not looped back\n");
+            abort();
+        }
+        samples[i] = loop.received_ns - sent_ns;
+    }
+    uint64_t active_ns = host_time_now_ns() - start_ns;
+    uint64_t active_loops = esp_peer_fake_main_loop_count() - loops_before;
+
+    qsort(samples, TURNAROUND_SAMPLES, sizeof(samples[0]), compare_u64);
+    uint64_t total_ns = 0;
+    for (int i = 0; i < TURNAROUND_SAMPLES; i++) {
+        total_ns += samples[i];
+    }
+    print(config, "active_wakeups_per_s", active_loops * 1e9 / active_ns);
+    print(config, "turnaround_mean_us", total_ns / 1e3 / TURNAROUND_SAMPLES);
+    print(config, "turnaround_p50_us", samples[TURNAROUND_SAMPLES / 2] / 1e3);
+    print(config, "turnaround_p99_us", samples[TURNAROUND_SAMPLES * 99 / 100] / 1e3);
+    print(config, "turnaround_max_us", samples[TURNAROUND_SAMPLES - 1] / 1e3);
+
+    // 3. Latency of inbound frames arriving after the loop has been idle.
+    const fixture_buf_t *inbound = fixture_packet_encoded(FIXTURE_PACKET_USER);
+    uint64_t inbound_samples[INBOUND_SAMPLES];
+    for (int i = 0; i < INBOUND_SAMPLES; i++) {
+        vTaskDelay(pdMS_TO_TICKS(INBOUND_IDLE_MS + esp_random() % MAX_SEND_GAP_MS));
+        uint64_t injected_ns = host_time_now_ns();
+        if (!esp_peer_fake_inject_data(inbound->data, inbound->len) ||
+            xSemaphoreTake(loop.received, pdMS_TO_TICKS(1000)) != pdTRUE) {
+            fprintf(stderr, "peer_loop: inbound packet was not delivered\n");
+            abort();
+        }
+        inbound_samples[i] = loop.received_ns - injected_ns;
+    }
+    qsort(inbound_samples, INBOUND_SAMPLES, sizeof(inbound_samples[0]), compare_u64);
+    total_ns = 0;
+    for (int i = 0; i < INBOUND_SAMPLES; i++) {
+        total_ns += inbound_samples[i];
+    }
+    print(config, "inbound_mean_us", total_ns / 1e3 / INBOUND_SAMPLES);
+    print(config, "inbound_p99_us", inbound_samples[INBOUND_SAMPLES * 99 / 100] / 1e3);
+    print(config, "inbound_max_us", inbound_samples[INBOUND_SAMPLES - 1] / 1e3);
+
+    peer_disconnect(peer);
+    peer_destroy(peer);
+    vSemaphoreDelete(loop.received);
+    esp_peer_fake_configure(&(esp_peer_fake_cfg_t){});
+}
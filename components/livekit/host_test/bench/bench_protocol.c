@@ -0,0 +1,436 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "cJSON.h"
+#include "pb_encode.h"
+#include "protocol.h"
+#include "fixtures.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Benchmarks for every function in core/protocol.h. Encode cases report the
+// individual steps, a size/allocate/encode/free sequence, and single-pass
+// encoding into a warm reusable buffer as done by signaling and peer.
+//
+// The session cases decode the messages of a short room session and hold them
+// until all are decoded, as queues do under load, to show the heap blocks
+// taken per message. Build with -DCONFIG_LK_PROTOCOL_ARENA=0 to compare with
+// allocating each field separately.
+//
+// The trickle cases compare the candidate scanner with building a cJSON tree
+// and copying the candidate out of it, as was done before the scanner.
+
+#define NAME_MAX_LEN 96
+
+/// Tag of `SignalResponse.speakers_changed`, which the bindings do not include.
+#define SPEAKERS_CHANGED_TAG 10
+
+#if CONFIG_LK_PROTOCOL_ARENA
+#define DECODE_MODE "arena"
+#else
+#define DECODE_MODE "heap"
+#endif
+
+typedef struct {
+    const fixture_buf_t *encoded;
+} decode_ctx_t;
+
+typedef struct {
+    const void *msg;
+    uint8_t *dest;
+    size_t encoded_size;
+    protocol_enc_buf_t enc_buf;
+} encode_ctx_t;
+
+// MARK: - Signal response
+
+static void signal_response_decode_free(void *arg)
+{
+    decode_ctx_t *ctx = arg;
+    livekit_pb_signal_response_t *res = NULL;
+    if (!protocol_signal_response_decode(ctx->encoded->data, ctx->encoded->len, &res)) {
+        abort();
+    }
+    bench_keep(res);
+    protocol_signal_response_free(res);
+}
+
+static void signal_response_peek_type(void *arg)
+{
+    decode_ctx_t *ctx = arg;
+    pb_size_t type = protocol_signal_response_peek_type(ctx->encoded->data, ctx->encoded->len);
+    bench_keep(&type);
+}
+
+/// Encodes a speakers changed response, one of the types the bindings leave
+/// out, as sent several times a second in a busy room.
+static bool encode_speakers_changed(fixture_buf_t *out, int speakers)
+{
+    uint8_t speaker[64];
+    pb_ostream_t stream = pb_ostream_from_buffer(speaker, sizeof(speaker));
+    const char *sid = "PA_8bKQ3nWxY2fD";
+    float level = 0.42f;
+    if (!pb_encode_tag(&stream, PB_WT_STRING, 1) ||
+        !pb_encode_string(&stream, (const pb_byte_t *)sid, strlen(sid)) ||
+        !pb_encode_tag(&stream, PB_WT_32BIT, 2) ||
+        !pb_encode_fixed32(&stream, &level) ||
+        !pb_encode_tag(&stream, PB_WT_VARINT, 3) ||
+        !pb_encode_varint(&stream, 1)) {
+        return false;
+    }
+    size_t speaker_len = stream.bytes_written;
+
+    uint8_t changed[512];
+    stream = pb_ostream_from_buffer(changed, sizeof(changed));
+    for (int i = 0; i < speakers; i++) {
+        if (!pb_encode_tag(&stream, PB_WT_STRING, 1) ||
+            !pb_encode_string(&stream, speaker, speaker_len)) {
+            return false;
+        }
+    }
+    size_t changed_len = stream.bytes_written;
+
+    static uint8_t encoded[sizeof(changed) + 8];
+    stream = pb_ostream_from_buffer(encoded, sizeof(encoded));
+    if (!pb_encode_tag(&stream, PB_WT_STRING, SPEAKERS_CHANGED_TAG) ||
+        !pb_encode_string(&stream, changed, changed_len)) {
+        return false;
+    }
+    out->name = "speakers_changed";
+    out->data = encoded;
+    out->len = stream.bytes_written;
+    return true;
+}
+
+static void signal_trickle_get_candidate(void *arg)
+{
+    const livekit_pb_trickle_request_t *trickle = arg;
+    protocol_ice_candidate_t ice;
+    if (!protocol_signal_trickle_get_candidate(trickle, &ice)) {
+        abort();
+    }
+    // Copied rather than unescaped in place as the engine does, so that the
+    // fixture is left intact for the next iteration.
+    char candidate[256];
+    if (!protocol_json_string_copy(ice.candidate, ice.candidate_len, candidate, sizeof(candidate))) {
+        abort();
+    }
+    bench_keep(candidate);
+    bench_keep(&ice);
+}
+
+static void signal_trickle_get_candidate_cjson(void *arg)
+{
+    const livekit_pb_trickle_request_t *trickle = arg;
+    cJSON *candidate_init = cJSON_Parse(trickle->candidate_init);
+    cJSON *candidate = cJSON_GetObjectItemCaseSensitive(candidate_init, "candidate");
+    cJSON *sdp_mid = cJSON_GetObjectItemCaseSensitive(candidate_init, "sdpMid");
+    cJSON *sdp_mline_index = cJSON_GetObjectItemCaseSensitive(candidate_init, "sdpMLineIndex");
+    if (!cJSON_IsString(candidate) || !cJSON_IsString(sdp_mid) || !cJSON_IsNumber(sdp_mline_index)) {
+        abort();
+    }
+    char *copy = strdup(candidate->valuestring);
+    if (copy == NULL) {
+        abort();
+    }
+    bench_keep(copy);
+    free(copy);
+    cJSON_Delete(candidate_init);
+}
+
+// MARK: - Signal request
+
+static void signal_request_encoded_size(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    size_t size = protocol_signal_request_encoded_size(ctx->msg);
+    bench_keep(&size);
+}
+
+static void signal_request_encode(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    if (!protocol_signal_request_encode(ctx->msg, ctx->dest, ctx->encoded_size)) {
+        abort();
+    }
+    bench_keep(ctx->dest);
+}
+
+static void signal_request_encode_into(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    if (protocol_signal_request_encode_into(ctx->msg, &ctx->enc_buf) == 0) {
+        abort();
+    }
+    bench_keep(ctx->enc_buf.data);
+}
+
+static void signal_request_send_path(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    size_t size = protocol_signal_request_encoded_size(ctx->msg);
+    uint8_t *dest = malloc(size);
+    if (dest == NULL || !protocol_signal_request_encode(ctx->msg, dest, size)) {
+        abort();
+    }
+    bench_keep(dest);
+    free(dest);
+}
+
+// MARK: - Data packet
+
+static void data_packet_decode_free(void *arg)
+{
+    decode_ctx_t *ctx = arg;
+    livekit_pb_data_packet_t *packet = NULL;
+    if (!protocol_data_packet_decode(ctx->encoded->data, ctx->encoded->len, &packet)) {
+        abort();
+    }
+    bench_keep(packet);
+    protocol_data_packet_free(packet);
+}
+
+static void data_packet_encoded_size(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    size_t size = protocol_data_packet_encoded_size(ctx->msg);
+    bench_keep(&size);
+}
+
+static void data_packet_encode(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    if (!protocol_data_packet_encode(ctx->msg, ctx->dest, ctx->encoded_size)) {
+        abort();
+    }
+    bench_keep(ctx->dest);
+}
+
+static void data_packet_encode_into(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    if (protocol_data_packet_encode_into(ctx->msg, &ctx->enc_buf) == 0) {
+        abort();
+    }
+    bench_keep(ctx->enc_buf.data);
+}
+
+static void data_packet_send_path(void *arg)
+{
+    encode_ctx_t *ctx = arg;
+    size_t size = protocol_data_packet_encoded_size(ctx->msg);
+    uint8_t *dest = malloc(size);
+    if (dest == NULL || !protocol_data_packet_encode(ctx->msg, dest, size)) {
+        abort();
+    }
+    bench_keep(dest);
+    free(dest);
+}
+
+// MARK: - Session
+
+/// Messages received in a short session: joining, negotiating, a few
+/// participant updates and pings, and some user and RPC data.
+static const struct {
+    bool is_packet;
+    int id;
+    int count;
+} session[] = {
+    { false, FIXTURE_RES_JOIN,           1 },
+    { false, FIXTURE_RES_OFFER,          1 },
+    { false, FIXTURE_RES_TRICKLE,        8 },
+    { false, FIXTURE_RES_UPDATE,         4 },
+    { false, FIXTURE_RES_PONG,          10 },
+    { true,  FIXTURE_PACKET_USER,       10 },
+    { true,  FIXTURE_PACKET_RPC_REQUEST, 3 },
+    { true,  FIXTURE_PACKET_RPC_ACK,     3 },
+    { true,  FIXTURE_PACKET_RPC_RESPONSE, 3 },
+};
+
+#define SESSION_MAX_MESSAGES 64
+
+typedef struct {
+    void *messages[SESSION_MAX_MESSAGES];
+    int count;
+} session_ctx_t;
+
+static void session_decode(session_ctx_t *ctx)
+{
+    ctx->count = 0;
+    for (size_t i = 0; i < sizeof(session) / sizeof(session[0]); i++) {
+        const fixture_buf_t *encoded = session[i].is_packet ?
+            fixture_packet_encoded(session[i].id) :
+            fixture_res_encoded(session[i].id);
+        for (int j = 0; j < session[i].count; j++) {
+            void **out = &ctx->messages[ctx->count++];
+            bool decoded = session[i].is_packet ?
+                protocol_data_packet_decode(encoded->data, encoded->len, (livekit_pb_data_packet_t **)out) :
+                protocol_signal_response_decode(encoded->data, encoded->len, (livekit_pb_signal_response_t **)out);
+            if (!decoded) {
+                abort();
+            }
+        }
+    }
+}
+
+static void session_free(session_ctx_t *ctx)
+{
+    int index = 0;
+    for (size_t i = 0; i < sizeof(session) / sizeof(session[0]); i++) {
+        for (int j = 0; j < session[i].count; j++, index++) {
+            if (session[i].is_packet) {
+                protocol_data_packet_free(ctx->messages[index]);
+            } else {
+                protocol_signal_response_free(ctx->messages[index]);
+            }
+        }
+    }
+    ctx->count = 0;
+}
+
+static void session_decode_free(void *arg)
+{
+    session_ctx_t *ctx = arg;
+    session_decode(ctx);
+    session_free(ctx);
+}
+
+static void run_session_cases(const bench_config_t *config)
+{
+    char name[NAME_MAX_LEN];
+    session_ctx_t ctx = {};
+    snprintf(name, sizeof(name), "protocol_session[%s]/decode_free", DECODE_MODE);
+    bench_run(config, name, session_decode_free, &ctx);
+
+    snprintf(name, sizeof(name), "protocol_session[%s]/held", DECODE_MODE);
+    if (!bench_is_selected(config, name)) {
+        return;
+    }
+    bench_alloc_stats_t before, after;
+    bench_alloc_snapshot(&before);
+    session_decode(&ctx);
+    bench_alloc_snapshot(&after);
+    int messages = ctx.count;
+    session_free(&ctx);
+
+    snprintf(name, sizeof(name), "protocol_session[%s]/held_blocks_per_msg", DECODE_MODE);
+    bench_print_metric(config, name, (double)(after.live_allocs - before.live_allocs) / messages);
+    snprintf(name, sizeof(name), "protocol_session[%s]/held_bytes_per_msg", DECODE_MODE);
+    bench_print_metric(config, name, (double)(after.live_bytes - before.live_bytes) / messages);
+}
+
+// MARK: - Registration
+
+static void run_encode_cases(
+    const bench_config_t *config,
+    const char *prefix,
+    const char *msg_name,
+    const void *msg,
+    size_t encoded_size,
+    bench_fn_t size_fn,
+    bench_fn_t encode_fn,
+    bench_fn_t send_path_fn,
+    bench_fn_t encode_into_fn)
+{
+    char name[NAME_MAX_LEN];
+    encode_ctx_t ctx = {
+        .msg = msg,
+        .dest = malloc(encoded_size),
+        .encoded_size = encoded_size
+    };
+    // Starts small so the first (warm-up) call exercises the grow path.
+    if (ctx.dest == NULL || !protocol_enc_buf_init(&ctx.enc_buf, 16)) {
+        abort();
+    }
+    snprintf(name, sizeof(name), "%s_encoded_size/%s", prefix, msg_name);
+    bench_run(config, name, size_fn, &ctx);
+    snprintf(name, sizeof(name), "%s_encode/%s", prefix, msg_name);
+    bench_run(config, name, encode_fn, &ctx);
+    snprintf(name, sizeof(name), "%s_send_path/%s", prefix, msg_name);
+    bench_run(config, name, send_path_fn, &ctx);
+    snprintf(name, sizeof(name), "%s_encode_into/%s", prefix, msg_name);
+    bench_run(config, name, encode_into_fn, &ctx);
+    protocol_enc_buf_free(&ctx.enc_buf);
+    free(ctx.dest);
+}
+
+void bench_protocol(const bench_config_t *config)
+{
+    char name[NAME_MAX_LEN];
+
+    for (int i = 0; i < FIXTURE_RES_MAX; i++) {
+        decode_ctx_t ctx = { .encoded = fixture_res_encoded(i) };
+        snprintf(name, sizeof(name), "signal_response_decode_free/%s (%zu B)",
+            ctx.encoded->name, ctx.encoded->len);
+        bench_run(config, name, signal_response_decode_free, &ctx);
+    }
+
+    // A response the engine does not use: decoding it versus peeking its type,
+    // as signaling does before skipping it.
+    static fixture_buf_t speakers_changed;
+    if (!encode_speakers_changed(&speakers_changed, 3)) {
+        abort();
+    }
+    decode_ctx_t skip_ctx = { .encoded = &speakers_changed };
+    snprintf(name, sizeof(name), "signal_response_decode_free/%s (%zu B)",
+        speakers_changed.name, speakers_changed.len);
+    bench_run(config, name, signal_response_decode_free, &skip_ctx);
+    snprintf(name, sizeof(name), "signal_response_peek_type/%s (%zu B)",
+        speakers_changed.name, speakers_changed.len);
+    bench_run(config, name, signal_response_peek_type, &skip_ctx);
+
+    const livekit_pb_signal_request_t *trickle_req = fixture_req(FIXTURE_REQ_TRICKLE, NULL);
+    bench_run(config, "signal_trickle_get_candidate/scan",
+        signal_trickle_get_candidate, (void *)&trickle_req->message.trickle);
+    bench_run(config, "signal_trickle_get_candidate/cjson",
+        signal_trickle_get_candidate_cjson, (void *)&trickle_req->message.trickle);
+
+    for (int i = 0; i < FIXTURE_REQ_MAX; i++) {
+        const char *req_name;
+        const livekit_pb_signal_request_t *req = fixture_req(i, &req_name);
+        run_encode_cases(config, "signal_request", req_name, req,
+            protocol_signal_request_encoded_size(req),
+            signal_request_encoded_size,
+            signal_request_encode,
+            signal_request_send_path,
+            signal_request_encode_into);
+    }
+
+    for (int i = 0; i < FIXTURE_PACKET_MAX; i++) {
+        decode_ctx_t ctx = { .encoded = fixture_packet_encoded(i) };
+        snprintf(name, sizeof(name), "data_packet_decode_free/%s (%zu B)",
+            ctx.encoded->name, ctx.encoded->len);
+        bench_run(config, name, data_packet_decode_free, &ctx);
+    }
+
+    for (int i = 0; i < FIXTURE_PACKET_MAX; i++) {
+        const char *packet_name;
+        const livekit_pb_data_packet_t *packet = fixture_packet(i, &packet_name);
+        run_encode_cases(config, "data_packet", packet_name, packet,
+            protocol_data_packet_encoded_size(packet),
+            data_packet_encoded_size,
+            data_packet_encode,
+            data_packet_send_path,
+            data_packet_encode_into);
+    }
+
+    run_session_cases(config);
+}
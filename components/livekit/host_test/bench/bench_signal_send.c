@@ -0,0 +1,217 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "esp_websocket_client.h"
+#include "esp_websocket_client_fake.h"
+#include "host_time.h"
+#include "signaling.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+// Measures what a stalled signaling socket costs the rest of the system. The
+// WebSocket stand-in blocks each send for STALL_MS, as a socket with a full TCP
+// send buffer would.
+//
+// Pings are sent from a software timer, so a send that blocks there delays
+// every other timer. The timer cases send from a timer callback, directly on
+// the socket as before the writer task was added and through the send queue,
+// while a probe timer measures how late it fires.
+
+#define NAME_MAX_LEN      96
+#define STALL_MS          100
+#define BURST_REQUESTS    8
+#define OVERFLOW_REQUESTS (CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE + BURST_REQUESTS)
+#define LATENCY_REQUESTS  1000
+#define PROBE_PERIOD_MS   10
+#define PROBE_RUN_MS      (STALL_MS * 3)
+#define DRAIN_TIMEOUT_MS  5000
+
+typedef struct {
+    signal_handle_t signal;
+    esp_websocket_client_handle_t ws;
+    bool is_direct;
+
+    TimerHandle_t probe;
+    uint64_t probe_expected_ns;
+    uint64_t probe_max_late_ns;
+} timer_ctx_t;
+
+static void on_state_changed(signal_state_t state, void *ctx) {}
+
+static bool on_res(livekit_pb_signal_response_t *res, void *ctx)
+{
+    return false;
+}
+
+static signal_handle_t create_signal(void)
+{
+    signal_options_t options = {
+        .on_state_changed = on_state_changed,
+        .on_res = on_res
+    };
+    signal_handle_t signal = signal_init(&options);
+    if (signal == NULL) {
+        fprintf(stderr, "signal_send: failed to create signal client\n");
+        abort();
+    }
+    return signal;
+}
+
+static void wait_for_drain(signal_handle_t signal, uint32_t expected)
+{
+    signal_send_stats_t stats = {};
+    for (int waited = 0; waited < DRAIN_TIMEOUT_MS; waited++) {
+        signal_get_send_stats(signal, &stats);
+        if (stats.sent + stats.failed >= expected) {
+            return;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    fprintf(stderr, "signal_send: requests were not sent\n");
+    abort();
+}
+
+static void on_probe(TimerHandle_t timer)
+{
+    timer_ctx_t *ctx = pvTimerGetTimerID(timer);
+    uint64_t now_ns = host_time_now_ns();
+    if (now_ns > ctx->probe_expected_ns &&
+        now_ns - ctx->probe_expected_ns > ctx->probe_max_late_ns) {
+        ctx->probe_max_late_ns = now_ns - ctx->probe_expected_ns;
+    }
+    ctx->probe_expected_ns = now_ns + PROBE_PERIOD_MS * 1000000ULL;
+}
+
+static void on_ping(TimerHandle_t timer)
+{
+    timer_ctx_t *ctx = pvTimerGetTimerID(timer);
+    if (ctx->is_direct) {
+        static const char ping[16] = {};
+        esp_websocket_client_send_bin(ctx->ws, ping, sizeof(ping), portMAX_DELAY);
+    } else {
+        signal_send_leave(ctx->signal);
+    }
+}
+
+/// Returns how late the probe timer fired at worst while a ping is sent.
+static double probe_max_late_ms(signal_handle_t signal, bool is_direct)
+{
+    static esp_websocket_client_config_t ws_config = {};
+    timer_ctx_t ctx = {
+        .signal = signal,
+        .ws = esp_websocket_client_init(&ws_config),
+        .is_direct = is_direct
+    };
+    ctx.probe = xTimerCreate("probe", pdMS_TO_TICKS(PROBE_PERIOD_MS), pdTRUE, &ctx, on_probe);
+    TimerHandle_t ping = xTimerCreate("ping", pdMS_TO_TICKS(PROBE_PERIOD_MS * 3), pdFALSE, &ctx, on_ping);
+    if (ctx.ws == NULL || ctx.probe == NULL || ping == NULL) {
+        fprintf(stderr, "signal_send: failed to create timers\n");
+        abort();
+    }
+    ctx.probe_expected_ns = host_time_now_ns() + PROBE_PERIOD_MS * 1000000ULL;
+    xTimerStart(ctx.probe, 0);
+    xTimerStart(ping, 0);
+    vTaskDelay(pdMS_TO_TICKS(PROBE_RUN_MS));
+    xTimerDelete(ping, portMAX_DELAY);
+    xTimerDelete(ctx.probe, portMAX_DELAY);
+    esp_websocket_client_destroy(ctx.ws);
+    return ctx.probe_max_late_ns / 1e6;
+}
+
+static void bench_queue_request(void *ctx)
+{
+    static const char sdp[] = "v=0\r\no=- 0 0 IN IP4 127.0.0.1\r\ns=-\r\nt=0 0\r\n";
+    signal_send_offer((signal_handle_t)ctx, sdp);
+}
+
+static void print(const bench_config_t *config, const char *metric, double value)
+{
+    char name[NAME_MAX_LEN];
+    snprintf(name, sizeof(name), "signal_send/%s", metric);
+    bench_print_metric(config, name, value);
+}
+
+void bench_signal_send(const bench_config_t *config)
+{
+    if (!bench_is_selected(config, "signal_send")) {
+        return;
+    }
+    signal_handle_t signal = create_signal();
+    static const char sdp[] = "v=0\r\no=- 0 0 IN IP4 127.0.0.1\r\ns=-\r\nt=0 0\r\n";
+
+    // 1. Time from queueing to sent on a socket that keeps up
+    for (int i = 0; i < LATENCY_REQUESTS; i += BURST_REQUESTS) {
+        for (int j = 0; j < BURST_REQUESTS; j++) {
+            signal_send_offer(signal, sdp);
+        }
+        wait_for_drain(signal, i + BURST_REQUESTS);
+    }
+    signal_send_stats_t stats = {};
+    signal_get_send_stats(signal, &stats);
+    print(config, "latency_mean_us", (double)stats.latency_total_us / stats.sent);
+    print(config, "latency_max_us", stats.latency_max_us);
+    print(config, "max_queue_depth", stats.max_queue_depth);
+
+    // 2. Time callers spend per request while the socket is stalled
+    esp_websocket_client_fake_configure(&(esp_websocket_client_fake_cfg_t){ .send_delay_ms = STALL_MS });
+    uint64_t max_call_ns = 0;
+    uint64_t start_ns = host_time_now_ns();
+    for (int i = 0; i < BURST_REQUESTS; i++) {
+        uint64_t call_ns = host_time_now_ns();
+        signal_send_offer(signal, sdp);
+        call_ns = host_time_now_ns() - call_ns;
+        if (call_ns > max_call_ns) {
+            max_call_ns = call_ns;
+        }
+    }
+    print(config, "stalled/caller_mean_us", (host_time_now_ns() - start_ns) / 1e3 / BURST_REQUESTS);
+    print(config, "stalled/caller_max_us", max_call_ns / 1e3);
+    wait_for_drain(signal, stats.sent + stats.failed + BURST_REQUESTS);
+
+    // 3. Requests dropped and caller wait when a burst overflows the queue
+    signal_get_send_stats(signal, &stats);
+    uint32_t dropped = stats.dropped;
+    uint32_t expected = stats.sent + stats.failed + OVERFLOW_REQUESTS;
+    max_call_ns = 0;
+    for (int i = 0; i < OVERFLOW_REQUESTS; i++) {
+        uint64_t call_ns = host_time_now_ns();
+        signal_send_offer(signal, sdp);
+        call_ns = host_time_now_ns() - call_ns;
+        if (call_ns > max_call_ns) {
+            max_call_ns = call_ns;
+        }
+    }
+    wait_for_drain(signal, expected);
+    signal_get_send_stats(signal, &stats);
+    print(config, "stalled/overflow_dropped", stats.dropped - dropped);
+    print(config, "stalled/overflow_caller_max_ms", max_call_ns / 1e6);
+
+    // 4. Lateness of other timers while a ping is sent from the timer task
+    print(config, "stalled/timer_late_ms/direct", probe_max_late_ms(signal, true));
+    print(config, "stalled/timer_late_ms/queued", probe_max_late_ms(signal, false));
+    esp_websocket_client_fake_configure(&(esp_websocket_client_fake_cfg_t){});
+
+    // 5. Caller cost of queueing a request that fits a pooled slot
+    bench_run(config, "signal_send/queue_request", bench_queue_request, signal);
+
+    signal_destroy(signal);
+}
@@ -0,0 +1,457 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include "pb_encode.h"
+#include "fixtures.h"
+
+// Message contents approximate what a LiveKit server sends to an ESP32
+// participant joining a room with an agent and one other user.
+
+// MARK: - Shared contents
+
+static const char OFFER_SDP[] =
+    "v=0\r\n"
+    "o=- 4611731400430051336 2 IN IP4 127.0.0.1\r\n"
+    "s=-\r\n"
+    "t=0 0\r\n"
+    "a=group:BUNDLE 0 1\r\n"
+    "a=extmap-allow-mixed\r\n"
+    "a=msid-semantic: WMS\r\n"
+    "m=audio 9 UDP/TLS/RTP/SAVPF 111 0 8\r\n"
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+    "a=ice-ufrag:WpjsPnMoHCwvWHcK\r\n"
+    "a=ice-pwd:XqYbdbmNaqhdOVwQBWLeIkZAKjmeRqgQ\r\n"
+    "a=ice-options:trickle\r\n"
+    "a=fingerprint:sha-256 5B:A4:CE:08:9E:4F:3D:0A:62:8E:1C:6C:9B:5D:B1:7A:"
+    "F1:30:C4:12:88:7D:3E:FB:2A:06:58:9C:E3:D1:47:BE\r\n"
+    "a=setup:actpass\r\n"
+    "a=mid:0\r\n"
+    "a=extmap:1 urn:ietf:params:rtp-hdrext:ssrc-audio-level\r\n"
+    "a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+    "a=sendonly\r\n"
+    "a=msid:PA_mPzNXQkfH3Hd TR_AMbR8dw6Ykr4fK\r\n"
+    "a=rtcp-mux\r\n"
+    "a=rtpmap:111 opus/48000/2\r\n"
+    "a=rtcp-fb:111 transport-cc\r\n"
+    "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+    "a=rtpmap:0 PCMU/8000\r\n"
+    "a=rtpmap:8 PCMA/8000\r\n"
+    "a=ssrc:3051201433 cname:Xo3X6bQ4zBfK0c2L\r\n"
+    "a=ssrc:3051201433 msid:PA_mPzNXQkfH3Hd TR_AMbR8dw6Ykr4fK\r\n"
+    "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=ice-ufrag:WpjsPnMoHCwvWHcK\r\n"
+    "a=ice-pwd:XqYbdbmNaqhdOVwQBWLeIkZAKjmeRqgQ\r\n"
+    "a=ice-options:trickle\r\n"
+    "a=fingerprint:sha-256 5B:A4:CE:08:9E:4F:3D:0A:62:8E:1C:6C:9B:5D:B1:7A:"
+    "F1:30:C4:12:88:7D:3E:FB:2A:06:58:9C:E3:D1:47:BE\r\n"
+    "a=setup:actpass\r\n"
+    "a=mid:1\r\n"
+    "a=sctp-port:5000\r\n"
+    "a=max-message-size:262144\r\n";
+
+static const char ANSWER_SDP[] =
+    "v=0\r\n"
+    "o=- 1740155209 1740155209 IN IP4 0.0.0.0\r\n"
+    "s=-\r\n"
+    "t=0 0\r\n"
+    "a=group:BUNDLE 0 1\r\n"
+    "m=audio 9 UDP/TLS/RTP/SAVPF 0\r\n"
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=ice-ufrag:esp3\r\n"
+    "a=ice-pwd:2b6a9f4e1c3d5a7b9e0f1a2b\r\n"
+    "a=fingerprint:sha-256 0F:3C:77:A2:91:5E:D4:6B:28:AC:E1:40:9B:52:C7:1D:"
+    "86:F3:0A:6E:B5:24:9C:DF:13:78:E0:4A:B6:2D:95:C1\r\n"
+    "a=setup:active\r\n"
+    "a=mid:0\r\n"
+    "a=recvonly\r\n"
+    "a=rtcp-mux\r\n"
+    "a=rtpmap:0 PCMU/8000\r\n"
+    "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\r\n"
+    "c=IN IP4 0.0.0.0\r\n"
+    "a=ice-ufrag:esp3\r\n"
+    "a=ice-pwd:2b6a9f4e1c3d5a7b9e0f1a2b\r\n"
+    "a=fingerprint:sha-256 0F:3C:77:A2:91:5E:D4:6B:28:AC:E1:40:9B:52:C7:1D:"
+    "86:F3:0A:6E:B5:24:9C:DF:13:78:E0:4A:B6:2D:95:C1\r\n"
+    "a=setup:active\r\n"
+    "a=mid:1\r\n"
+    "a=sctp-port:5000\r\n";
+
+static const char REMOTE_CANDIDATE_INIT[] =
+    "{\"candidate\":\"candidate:1617435936 1 udp 2130706431 203.0.113.24 50018 typ host generation 0\","
+    "\"sdpMid\":\"0\",\"sdpMLineIndex\":0,\"usernameFragment\":\"WpjsPnMoHCwvWHcK\"}";
+
+static const char LOCAL_CANDIDATE_INIT[] =
+    "{\"candidate\":\"candidate:2 1 UDP 1694498815 198.51.100.7 61523 typ srflx raddr 192.168.1.42 rport 61523\","
+    "\"sdpMid\":\"0\",\"sdpMLineIndex\":0}";
+
+static livekit_pb_track_info_t agent_tracks[] = {
+    {
+        .sid = "TR_AMbR8dw6Ykr4fK",
+        .type = LIVEKIT_PB_TRACK_TYPE_AUDIO,
+        .mime_type = "audio/opus",
+        .audio_features_count = 2,
+        .audio_features = {
+            LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_ECHO_CANCELLATION,
+            LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_NOISE_SUPPRESSION
+        }
+    }
+};
+
+static livekit_pb_track_info_t user_tracks[] = {
+    {
+        .sid = "TR_VCk3Jp9QeN2rTx",
+        .type = LIVEKIT_PB_TRACK_TYPE_VIDEO,
+        .mime_type = "video/H264"
+    },
+    {
+        .sid = "TR_AUq7Lm2XzW8sDe",
+        .type = LIVEKIT_PB_TRACK_TYPE_AUDIO,
+        .mime_type = "audio/opus",
+        .stereo = true,
+        .audio_features_count = 1,
+        .audio_features = { LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_STEREO }
+    }
+};
+
+static livekit_pb_participant_info_t remote_participants[] = {
+    {
+        .sid = "PA_mPzNXQkfH3Hd",
+        .identity = "agent-AJ_5sYxQnUu7vRm",
+        .state = LIVEKIT_PB_PARTICIPANT_INFO_STATE_ACTIVE,
+        .tracks_count = 1,
+        .tracks = agent_tracks,
+        .metadata = "",
+        .name = "Voice Agent",
+        .permission = { .can_subscribe = true, .can_publish = true, .can_publish_data = true },
+        .kind = LIVEKIT_PB_PARTICIPANT_INFO_KIND_AGENT
+    },
+    {
+        .sid = "PA_7hWqLz2Rt9Ks",
+        .identity = "web-user-4821",
+        .state = LIVEKIT_PB_PARTICIPANT_INFO_STATE_ACTIVE,
+        .tracks_count = 2,
+        .tracks = user_tracks,
+        .metadata = "{\"role\":\"viewer\",\"locale\":\"en-US\"}",
+        .name = "Browser",
+        .permission = { .can_subscribe = true, .can_publish = true, .can_publish_data = true },
+        .kind = LIVEKIT_PB_PARTICIPANT_INFO_KIND_STANDARD
+    }
+};
+
+static char *turn_urls[] = {
+    "turn:turn.example.livekit.cloud:443?transport=udp",
+    "turns:turn.example.livekit.cloud:443?transport=tcp"
+};
+
+static char *stun_urls[] = {
+    "stun:global.stun.twilio.com:3478"
+};
+
+// MARK: - Signal responses
+
+static livekit_pb_signal_response_t make_join(void)
+{
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_JOIN_TAG,
+        .message.join = {
+            .has_room = true,
+            .room = {
+                .sid = "RM_kT4Hs8YpQbVz",
+                .name = "esp32-demo",
+                .metadata = "",
+                .num_participants = 3
+            },
+            .participant = {
+                .sid = "PA_Zq9Xc3Vb7Nm2",
+                .identity = "esp32-device-01",
+                .state = LIVEKIT_PB_PARTICIPANT_INFO_STATE_JOINED,
+                .metadata = "",
+                .name = "ESP32",
+                .permission = { .can_subscribe = true, .can_publish = true, .can_publish_data = true },
+                .kind = LIVEKIT_PB_PARTICIPANT_INFO_KIND_STANDARD
+            },
+            .other_participants_count = 2,
+            .other_participants = remote_participants,
+            .ice_servers_count = 2,
+            .ice_servers = {
+                {
+                    .urls_count = 2,
+                    .urls = turn_urls,
+                    .username = "1740155209:PA_Zq9Xc3Vb7Nm2",
+                    .credential = "e2xAeP7mZ1S6f4qG+dH3vB0nK8o="
+                },
+                {
+                    .urls_count = 1,
+                    .urls = stun_urls,
+                    .username = "",
+                    .credential = ""
+                }
+            },
+            .subscriber_primary = true,
+            .has_client_configuration = true,
+            .ping_timeout = 15,
+            .ping_interval = 5
+        }
+    };
+    return res;
+}
+
+static livekit_pb_signal_response_t make_offer(void)
+{
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_OFFER_TAG,
+        .message.offer = { .type = "offer", .sdp = (char *)OFFER_SDP, .id = 1 }
+    };
+    return res;
+}
+
+static livekit_pb_signal_response_t make_trickle(void)
+{
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_TRICKLE_TAG,
+        .message.trickle = {
+            .candidate_init = (char *)REMOTE_CANDIDATE_INIT,
+            .target = LIVEKIT_PB_SIGNAL_TARGET_SUBSCRIBER
+        }
+    };
+    return res;
+}
+
+static livekit_pb_signal_response_t make_update(void)
+{
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_UPDATE_TAG,
+        .message.update = {
+            .participants_count = 2,
+            .participants = remote_participants
+        }
+    };
+    return res;
+}
+
+static livekit_pb_signal_response_t make_pong(void)
+{
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_PONG_RESP_TAG,
+        .message.pong_resp = {
+            .last_ping_timestamp = 1740155209123,
+            .timestamp = 1740155209187
+        }
+    };
+    return res;
+}
+
+// MARK: - Signal requests
+
+static char *subscription_sids[] = { "TR_AMbR8dw6Ykr4fK" };
+
+static livekit_pb_signal_request_t requests[FIXTURE_REQ_MAX];
+static const char *request_names[FIXTURE_REQ_MAX] = {
+    [FIXTURE_REQ_ANSWER] = "answer",
+    [FIXTURE_REQ_TRICKLE] = "trickle",
+    [FIXTURE_REQ_ADD_TRACK] = "add_track",
+    [FIXTURE_REQ_SUBSCRIPTION] = "subscription",
+    [FIXTURE_REQ_PING] = "ping",
+};
+
+static void init_requests(void)
+{
+    requests[FIXTURE_REQ_ANSWER] = (livekit_pb_signal_request_t){
+        .which_message = LIVEKIT_PB_SIGNAL_REQUEST_ANSWER_TAG,
+        .message.answer = { .type = "answer", .sdp = (char *)ANSWER_SDP, .id = 1 }
+    };
+    requests[FIXTURE_REQ_TRICKLE] = (livekit_pb_signal_request_t){
+        .which_message = LIVEKIT_PB_SIGNAL_REQUEST_TRICKLE_TAG,
+        .message.trickle = {
+            .candidate_init = (char *)LOCAL_CANDIDATE_INIT,
+            .target = LIVEKIT_PB_SIGNAL_TARGET_PUBLISHER
+        }
+    };
+    requests[FIXTURE_REQ_ADD_TRACK] = (livekit_pb_signal_request_t){
+        .which_message = LIVEKIT_PB_SIGNAL_REQUEST_ADD_TRACK_TAG,
+        .message.add_track = {
+            .cid = "TR_esp32_audio",
+            .name = "Audio",
+            .type = LIVEKIT_PB_TRACK_TYPE_AUDIO,
+            .source = LIVEKIT_PB_TRACK_SOURCE_MICROPHONE,
+            .audio_features_count = 1,
+            .audio_features = { LIVEKIT_PB_AUDIO_TRACK_FEATURE_TF_ECHO_CANCELLATION }
+        }
+    };
+    requests[FIXTURE_REQ_SUBSCRIPTION] = (livekit_pb_signal_request_t){
+        .which_message = LIVEKIT_PB_SIGNAL_REQUEST_SUBSCRIPTION_TAG,
+        .message.subscription = {
+            .track_sids_count = 1,
+            .track_sids = subscription_sids,
+            .subscribe = true
+        }
+    };
+    requests[FIXTURE_REQ_PING] = (livekit_pb_signal_request_t){
+        .which_message = LIVEKIT_PB_SIGNAL_REQUEST_PING_REQ_TAG,
+        .message.ping_req = { .timestamp = 1740155209123, .rtt = 64 }
+    };
+}
+
+// MARK: - Data packets
+
+static uint8_t user_payload_storage[sizeof(pb_bytes_array_t) + 256];
+
+static livekit_pb_data_packet_t packets[FIXTURE_PACKET_MAX];
+static const char *packet_names[FIXTURE_PACKET_MAX] = {
+    [FIXTURE_PACKET_USER] = "user",
+    [FIXTURE_PACKET_RPC_REQUEST] = "rpc_request",
+    [FIXTURE_PACKET_RPC_RESPONSE] = "rpc_response",
+    [FIXTURE_PACKET_RPC_ACK] = "rpc_ack",
+};
+
+static void init_packets(void)
+{
+    pb_bytes_array_t *user_payload = (pb_bytes_array_t *)user_payload_storage;
+    user_payload->size = 256;
+    for (size_t i = 0; i < 256; i++) {
+        user_payload->bytes[i] = (pb_byte_t)(i * 31 + 7);
+    }
+
+    packets[FIXTURE_PACKET_USER] = (livekit_pb_data_packet_t){
+        .which_value = LIVEKIT_PB_DATA_PACKET_USER_TAG,
+        .value.user = { .payload = user_payload, .topic = "sensor-readings" },
+        .participant_identity = "web-user-4821",
+        .participant_sid = "PA_7hWqLz2Rt9Ks"
+    };
+    packets[FIXTURE_PACKET_RPC_REQUEST] = (livekit_pb_data_packet_t){
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG,
+        .value.rpc_request = {
+            .id = "6f1c2d3e-4a5b-4c6d-8e7f-90a1b2c3d4e5",
+            .method = "set_led_state",
+            .payload = "{\"led\":\"status\",\"on\":true,\"color\":[255,128,0]}",
+            .response_timeout_ms = 10000,
+            .version = 1
+        },
+        .participant_identity = "agent-AJ_5sYxQnUu7vRm",
+        .participant_sid = "PA_mPzNXQkfH3Hd"
+    };
+    packets[FIXTURE_PACKET_RPC_RESPONSE] = (livekit_pb_data_packet_t){
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG,
+        .value.rpc_response = {
+            .request_id = "6f1c2d3e-4a5b-4c6d-8e7f-90a1b2c3d4e5",
+            .which_value = LIVEKIT_PB_RPC_RESPONSE_PAYLOAD_TAG,
+            .value.payload = "{\"ok\":true}"
+        },
+        .participant_identity = "esp32-device-01"
+    };
+    packets[FIXTURE_PACKET_RPC_ACK] = (livekit_pb_data_packet_t){
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG,
+        .value.rpc_ack = { .request_id = "6f1c2d3e-4a5b-4c6d-8e7f-90a1b2c3d4e5" },
+        .participant_identity = "esp32-device-01"
+    };
+}
+
+// MARK: - Encoding
+
+static fixture_buf_t res_encoded[FIXTURE_RES_MAX];
+static fixture_buf_t packet_encoded[FIXTURE_PACKET_MAX];
+
+static bool encode(const pb_msgdesc_t *fields, const void *msg, const char *name, fixture_buf_t *out)
+{
+    size_t size = 0;
+    if (!pb_get_encoded_size(&size, fields, msg)) {
+        return false;
+    }
+    uint8_t *data = malloc(size);
+    if (data == NULL) {
+        return false;
+    }
+    pb_ostream_t stream = pb_ostream_from_buffer(data, size);
+    if (!pb_encode(&stream, fields, msg)) {
+        free(data);
+        return false;
+    }
+    out->name = name;
+    out->data = data;
+    out->len = stream.bytes_written;
+    return true;
+}
+
+bool fixtures_init(void)
+{
+    init_requests();
+    init_packets();
+
+    const struct {
+        const char *name;
+        livekit_pb_signal_response_t res;
+    } responses[FIXTURE_RES_MAX] = {
+        [FIXTURE_RES_JOIN] = { "join", make_join() },
+        [FIXTURE_RES_OFFER] = { "offer", make_offer() },
+        [FIXTURE_RES_TRICKLE] = { "trickle", make_trickle() },
+        [FIXTURE_RES_UPDATE] = { "update", make_update() },
+        [FIXTURE_RES_PONG] = { "pong", make_pong() },
+    };
+    for (int i = 0; i < FIXTURE_RES_MAX; i++) {
+        if (!encode(LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, &responses[i].res,
+                    responses[i].name, &res_encoded[i])) {
+            return false;
+        }
+    }
+    for (int i = 0; i < FIXTURE_PACKET_MAX; i++) {
+        if (!encode(LIVEKIT_PB_DATA_PACKET_FIELDS, &packets[i],
+                    packet_names[i], &packet_encoded[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void fixtures_deinit(void)
+{
+    for (int i = 0; i < FIXTURE_RES_MAX; i++) {
+        free(res_encoded[i].data);
+        res_encoded[i] = (fixture_buf_t){ 0 };
+    }
+    for (int i = 0; i < FIXTURE_PACKET_MAX; i++) {
+        free(packet_encoded[i].data);
+        packet_encoded[i] = (fixture_buf_t){ 0 };
+    }
+}
+
+const fixture_buf_t *fixture_res_encoded(fixture_res_t id)
+{
+    return &res_encoded[id];
+}
+
+const livekit_pb_signal_request_t *fixture_req(fixture_req_t id, const char **name)
+{
+    if (name != NULL) {
+        *name = request_names[id];
+    }
+    return &requests[id];
+}
+
+const livekit_pb_data_packet_t *fixture_packet(fixture_packet_t id, const char **name)
+{
+    if (name != NULL) {
+        *name = packet_names[id];
+    }
+    return &packets[id];
+}
+
+const fixture_buf_t *fixture_packet_encoded(fixture_packet_t id)
+{
+    return &packet_encoded[id];
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Signal responses representative of a typical session, in the order
+/// they are normally received.
+typedef enum {
+    FIXTURE_RES_JOIN,
+    FIXTURE_RES_OFFER,
+    FIXTURE_RES_TRICKLE,
+    FIXTURE_RES_UPDATE,
+    FIXTURE_RES_PONG,
+    FIXTURE_RES_MAX
+} fixture_res_t;
+
+/// Signal requests sent by the client.
+typedef enum {
+    FIXTURE_REQ_ANSWER,
+    FIXTURE_REQ_TRICKLE,
+    FIXTURE_REQ_ADD_TRACK,
+    FIXTURE_REQ_SUBSCRIPTION,
+    FIXTURE_REQ_PING,
+    FIXTURE_REQ_MAX
+} fixture_req_t;
+
+/// Data packets exchanged over the data channels.
+typedef enum {
+    FIXTURE_PACKET_USER,
+    FIXTURE_PACKET_RPC_REQUEST,
+    FIXTURE_PACKET_RPC_RESPONSE,
+    FIXTURE_PACKET_RPC_ACK,
+    FIXTURE_PACKET_MAX
+} fixture_packet_t;
+
+/// An encoded message.
+typedef struct {
+    const char *name;
+    uint8_t *data;
+    size_t len;
+} fixture_buf_t;
+
+/// Encodes all fixtures; must be called once before any accessor.
+bool fixtures_init(void);
+
+/// Frees the encoded fixtures.
+void fixtures_deinit(void);
+
+/// Returns the wire encoding of a signal response.
+const fixture_buf_t *fixture_res_encoded(fixture_res_t id);
+
+/// Returns a signal request ready to be encoded.
+const livekit_pb_signal_request_t *fixture_req(fixture_req_t id, const char **name);
+
+/// Returns a data packet ready to be encoded.
+const livekit_pb_data_packet_t *fixture_packet(fixture_packet_t id, const char **name);
+
+/// Returns the wire encoding of a data packet.
+const fixture_buf_t *fixture_packet_encoded(fixture_packet_t id);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "fixtures.h"
+#include "bench.h"
+#include "bench_cases.h"
+
+static void print_usage(const char *argv0)
+{
+    fprintf(stderr,
+        "Usage: %s [--filter SUBSTRING] [--min-time-ms N] [--csv]\n"
+        "  --filter       Only run benchmarks whose name contains SUBSTRING\n"
+        "  --min-time-ms  Minimum measured time per benchmark (default 200)\n"
+        "  --csv          Print results as CSV\n",
+        argv0);
+}
+
+int main(int argc, char **argv)
+{
+    bench_config_t config = {
+        .filter = NULL,
+        .min_time_ms = 200,
+        .csv = false
+    };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            config.min_time_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            config.csv = true;
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    // Logging would dominate the measurements of the error paths.
+    esp_log_level_set("*", ESP_LOG_NONE);
+
+    if (!fixtures_init()) {
+        fprintf(stderr, "Failed to encode fixtures\n");
+        return EXIT_FAILURE;
+    }
+    bench_print_header(&config);
+    bench_protocol(&config);
+    bench_peer_loop(&config);
+    bench_data_dispatch(&config);
+    bench_data_stream(&config);
+    bench_signal_send(&config);
+    bench_audio_vad(&config);
+    fixtures_deinit();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+#include "protocol.h"
+
+// Differential target for protocol_ice_candidate_parse. The scanner is stricter
+// than cJSON (it rejects e.g. leading zeros, control characters in strings and
+// deep nesting), so only inputs it accepts are checked: cJSON must accept them
+// too and agree on every value. Resolving escapes in place must give the same
+// result as copying.
+
+static void fail(const char *what, const uint8_t *data, size_t size)
+{
+    fprintf(stderr, "fuzz_candidate: %s: %.*s\n", what, (int)size, (const char *)data);
+    abort();
+}
+
+/// Resolves escapes in a slice both into a separate buffer and in place.
+static char *unescape(const char *str, size_t len, const uint8_t *data, size_t size)
+{
+    char *copy = malloc(len + 1);
+    char *in_place = malloc(len + 1);
+    if (copy == NULL || in_place == NULL) {
+        abort();
+    }
+    memcpy(in_place, str, len);
+    bool copied = protocol_json_string_copy(str, len, copy, len + 1);
+    bool resolved = protocol_json_string_copy(in_place, len, in_place, len + 1);
+    if (!copied || !resolved || strcmp(copy, in_place) != 0) {
+        fail("escapes not resolved", data, size);
+    }
+    free(in_place);
+    return copy;
+}
+
+static void check_string(const cJSON *item, const char *str, size_t len, const uint8_t *data, size_t size)
+{
+    if (str == NULL) {
+        if (item != NULL && !cJSON_IsNull(item)) {
+            fail("string missed", data, size);
+        }
+        return;
+    }
+    char *value = unescape(str, len, data, size);
+    if (!cJSON_IsString(item) || strcmp(item->valuestring, value) != 0) {
+        fail("string differs", data, size);
+    }
+    free(value);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    protocol_ice_candidate_t ice;
+    if (!protocol_ice_candidate_parse((const char *)data, size, &ice)) {
+        return 0;
+    }
+    char *json = malloc(size + 1);
+    if (json == NULL) {
+        abort();
+    }
+    memcpy(json, data, size);
+    json[size] = '\0';
+
+    // cJSON truncates strings at an escaped NUL, which the scanner rejects when
+    // resolving escapes instead.
+    if (strstr(json, "\\u0000") != NULL) {
+        free(json);
+        return 0;
+    }
+    cJSON *root = cJSON_Parse(json);
+    if (root == NULL) {
+        fail("rejected by cJSON", data, size);
+    }
+    check_string(cJSON_GetObjectItemCaseSensitive(root, "candidate"),
+        ice.candidate, ice.candidate_len, data, size);
+    check_string(cJSON_GetObjectItemCaseSensitive(root, "sdpMid"),
+        ice.sdp_mid, ice.sdp_mid_len, data, size);
+
+    const cJSON *index = cJSON_GetObjectItemCaseSensitive(root, "sdpMLineIndex");
+    if (ice.sdp_mline_index < 0 ?
+            index != NULL && !cJSON_IsNull(index) :
+            !cJSON_IsNumber(index) || index->valuedouble != ice.sdp_mline_index) {
+        fail("sdpMLineIndex differs", data, size);
+    }
+    cJSON_Delete(root);
+    free(json);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Replays fuzz inputs when not building with libFuzzer. Each argument is a
+// file or a directory of files, such as ../corpus/<target>.
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static int replay_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "replay: cannot open %s\n", path);
+        return -1;
+    }
+    uint8_t *data = NULL;
+    size_t size = 0, capacity = 0;
+    for (;;) {
+        if (size == capacity) {
+            capacity = capacity ? capacity * 2 : 4096;
+            uint8_t *grown = realloc(data, capacity);
+            if (grown == NULL) {
+                free(data);
+                fclose(file);
+                return -1;
+            }
+            data = grown;
+        }
+        size_t read = fread(data + size, 1, capacity - size, file);
+        if (read == 0) {
+            break;
+        }
+        size += read;
+    }
+    fclose(file);
+    LLVMFuzzerTestOneInput(data, size);
+    free(data);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int count = 0;
+    for (int i = 1; i < argc; i++) {
+        struct stat st;
+        if (stat(argv[i], &st) != 0) {
+            fprintf(stderr, "replay: cannot open %s\n", argv[i]);
+            return 1;
+        }
+        if (!S_ISDIR(st.st_mode)) {
+            if (replay_file(argv[i]) != 0) {
+                return 1;
+            }
+            count++;
+            continue;
+        }
+        DIR *dir = opendir(argv[i]);
+        if (dir == NULL) {
+            fprintf(stderr, "replay: cannot open %s\n", argv[i]);
+            return 1;
+        }
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            char path[4096];
+            snprintf(path, sizeof(path), "%s/%s", argv[i], entry->d_name);
+            if (replay_file(path) != 0) {
+                closedir(dir);
+                return 1;
+            }
+            count++;
+        }
+        closedir(dir);
+    }
+    printf("Replayed %d inputs\n", count);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the subset of av_render used by the LiveKit core.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_MEDIA_ERR_OK 0
+
+typedef enum {
+    AV_RENDER_AUDIO_CODEC_NONE,
+    AV_RENDER_AUDIO_CODEC_AAC,
+    AV_RENDER_AUDIO_CODEC_MP3,
+    AV_RENDER_AUDIO_CODEC_PCM,
+    AV_RENDER_AUDIO_CODEC_G711A,
+    AV_RENDER_AUDIO_CODEC_G711U,
+    AV_RENDER_AUDIO_CODEC_OPUS
+} av_render_audio_codec_t;
+
+typedef struct {
+    av_render_audio_codec_t codec;
+    uint8_t channel;
+    uint8_t bits_per_sample;
+    uint32_t sample_rate;
+} av_render_audio_info_t;
+
+typedef struct {
+    uint32_t pts;
+    uint8_t *data;
+    uint32_t size;
+    bool eos;
+} av_render_audio_data_t;
+
+typedef struct host_render *av_render_handle_t;
+
+int av_render_add_audio_stream(av_render_handle_t render, av_render_audio_info_t *audio_info);
+int av_render_add_audio_data(av_render_handle_t render, av_render_audio_data_t *audio_data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the subset of esp_capture used by the LiveKit core.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ESP_CAPTURE_ERR_OK            = 0,
+    ESP_CAPTURE_ERR_NO_MEM        = -1,
+    ESP_CAPTURE_ERR_INVALID_ARG   = -2,
+    ESP_CAPTURE_ERR_NOT_SUPPORTED = -3,
+    ESP_CAPTURE_ERR_NOT_FOUND     = -4,
+    ESP_CAPTURE_ERR_NOT_ENOUGH    = -5,
+    ESP_CAPTURE_ERR_TIMEOUT       = -6,
+    ESP_CAPTURE_ERR_INVALID_STATE = -7,
+    ESP_CAPTURE_ERR_INTERNAL      = -8
+} esp_capture_err_t;
+
+typedef enum {
+    ESP_CAPTURE_FMT_ID_NONE,
+    ESP_CAPTURE_FMT_ID_PCM,
+    ESP_CAPTURE_FMT_ID_G711A,
+    ESP_CAPTURE_FMT_ID_G711U,
+    ESP_CAPTURE_FMT_ID_OPUS,
+    ESP_CAPTURE_FMT_ID_AAC,
+    ESP_CAPTURE_FMT_ID_H264,
+    ESP_CAPTURE_FMT_ID_MJPEG
+} esp_capture_format_id_t;
+
+typedef enum {
+    ESP_CAPTURE_STREAM_TYPE_NONE,
+    ESP_CAPTURE_STREAM_TYPE_AUDIO,
+    ESP_CAPTURE_STREAM_TYPE_VIDEO,
+    ESP_CAPTURE_STREAM_TYPE_MUXER
+} esp_capture_stream_type_t;
+
+typedef enum {
+    ESP_CAPTURE_RUN_MODE_DISABLE,
+    ESP_CAPTURE_RUN_MODE_ALWAYS,
+    ESP_CAPTURE_RUN_MODE_ONESHOT
+} esp_capture_run_mode_t;
+
+typedef struct {
+    esp_capture_format_id_t format_id;
+    uint32_t sample_rate;
+    uint8_t channel;
+    uint8_t bits_per_sample;
+} esp_capture_audio_info_t;
+
+typedef struct {
+    esp_capture_format_id_t format_id;
+    uint16_t width;
+    uint16_t height;
+    uint8_t fps;
+} esp_capture_video_info_t;
+
+typedef struct {
+    esp_capture_stream_type_t stream_type;
+    uint32_t pts;
+    uint8_t *data;
+    int size;
+} esp_capture_stream_frame_t;
+
+typedef struct {
+    esp_capture_audio_info_t audio_info;
+    esp_capture_video_info_t video_info;
+} esp_capture_sink_cfg_t;
+
+typedef struct {
+    uint32_t stack_size;
+    uint8_t priority;
+    uint8_t core_id;
+    bool stack_in_ext;
+} esp_capture_thread_schedule_cfg_t;
+
+typedef void (*esp_capture_thread_scheduler_cb_t)(const char *name, esp_capture_thread_schedule_cfg_t *cfg);
+
+typedef struct host_capture *esp_capture_handle_t;
+typedef struct host_capture_sink *esp_capture_sink_handle_t;
+
+esp_capture_err_t esp_capture_set_thread_scheduler(esp_capture_thread_scheduler_cb_t scheduler);
+esp_capture_err_t esp_capture_start(esp_capture_handle_t capture);
+esp_capture_err_t esp_capture_stop(esp_capture_handle_t capture);
+
+#ifdef __cplusplus
+}
+#endif
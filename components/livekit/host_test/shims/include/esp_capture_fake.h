@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host-only controls for the esp_capture stand-in, used by tests to observe which
+// capture paths are running.
+
+#include <stdint.h>
+#include "esp_capture.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Highest path index tracked by the stand-in.
+#define ESP_CAPTURE_FAKE_MAX_PATHS 4
+
+/// Returns the run mode of the sink most recently set up on a path, or
+/// `ESP_CAPTURE_RUN_MODE_DISABLE` if none has been.
+esp_capture_run_mode_t esp_capture_fake_path_run_mode(uint8_t path);
+
+/// Forgets all sinks set up so far.
+void esp_capture_fake_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
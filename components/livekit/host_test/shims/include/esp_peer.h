@@ -0,0 +1,130 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the subset of esp_peer used by the LiveKit core. The
+// default implementation on host is a fake controlled through esp_peer_fake.h.
+
+#include "esp_peer_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *esp_peer_handle_t;
+
+typedef enum {
+    ESP_PEER_STATE_CLOSED,
+    ESP_PEER_STATE_DISCONNECTED,
+    ESP_PEER_STATE_NEW_CONNECTION,
+    ESP_PEER_STATE_PAIRING,
+    ESP_PEER_STATE_PAIRED,
+    ESP_PEER_STATE_CONNECTING,
+    ESP_PEER_STATE_CONNECTED,
+    ESP_PEER_STATE_CONNECT_FAILED,
+    ESP_PEER_STATE_DATA_CHANNEL_CONNECTED,
+    ESP_PEER_STATE_DATA_CHANNEL_OPENED,
+    ESP_PEER_STATE_DATA_CHANNEL_CLOSED,
+    ESP_PEER_STATE_DATA_CHANNEL_DISCONNECTED
+} esp_peer_state_t;
+
+typedef enum {
+    ESP_PEER_MSG_TYPE_NONE,
+    ESP_PEER_MSG_TYPE_SDP,
+    ESP_PEER_MSG_TYPE_CANDIDATE
+} esp_peer_msg_type_t;
+
+typedef struct {
+    esp_peer_msg_type_t type;
+    void *data;
+    int size;
+} esp_peer_msg_t;
+
+typedef enum {
+    ESP_PEER_DATA_CHANNEL_NONE,
+    ESP_PEER_DATA_CHANNEL_DATA,
+    ESP_PEER_DATA_CHANNEL_STRING
+} esp_peer_data_frame_type_t;
+
+typedef enum {
+    ESP_PEER_DATA_CHANNEL_RELIABLE,
+    ESP_PEER_DATA_CHANNEL_PARTIAL_RELIABLE_TIMEOUT,
+    ESP_PEER_DATA_CHANNEL_PARTIAL_RELIABLE_RETX
+} esp_peer_data_channel_type_t;
+
+typedef struct {
+    esp_peer_data_frame_type_t type;
+    uint16_t stream_id;
+    uint8_t *data;
+    int size;
+} esp_peer_data_frame_t;
+
+typedef struct {
+    esp_peer_data_channel_type_t type;
+    bool ordered;
+    const char *label;
+    uint16_t max_retransmit_count;
+    uint16_t max_packet_life_time;
+} esp_peer_data_channel_cfg_t;
+
+typedef struct {
+    const char *label;
+    uint16_t stream_id;
+} esp_peer_data_channel_info_t;
+
+typedef struct {
+    esp_peer_ice_server_cfg_t *server_lists;
+    uint8_t server_num;
+    esp_peer_role_t role;
+    esp_peer_ice_trans_policy_t ice_trans_policy;
+    esp_peer_audio_stream_info_t audio_info;
+    esp_peer_video_stream_info_t video_info;
+    esp_peer_media_dir_t audio_dir;
+    esp_peer_media_dir_t video_dir;
+    bool no_auto_reconnect;
+    bool enable_data_channel;
+    bool manual_ch_create;
+    void *extra_cfg;
+    int extra_size;
+    int (*on_state)(esp_peer_state_t state, void *ctx);
+    int (*on_msg)(esp_peer_msg_t *info, void *ctx);
+    int (*on_video_info)(esp_peer_video_stream_info_t *info, void *ctx);
+    int (*on_audio_info)(esp_peer_audio_stream_info_t *info, void *ctx);
+    int (*on_video_data)(esp_peer_video_frame_t *frame, void *ctx);
+    int (*on_audio_data)(esp_peer_audio_frame_t *frame, void *ctx);
+    int (*on_channel_open)(esp_peer_data_channel_info_t *ch, void *ctx);
+    int (*on_channel_close)(esp_peer_data_channel_info_t *ch, void *ctx);
+    int (*on_data)(esp_peer_data_frame_t *frame, void *ctx);
+    void *ctx;
+} esp_peer_cfg_t;
+
+typedef struct esp_peer_ops esp_peer_ops_t;
+
+int esp_peer_open(esp_peer_cfg_t *cfg, const esp_peer_ops_t *ops, esp_peer_handle_t *peer);
+int esp_peer_new_connection(esp_peer_handle_t peer);
+int esp_peer_create_data_channel(esp_peer_handle_t peer, esp_peer_data_channel_cfg_t *ch_cfg);
+int esp_peer_send_msg(esp_peer_handle_t peer, esp_peer_msg_t *msg);
+int esp_peer_send_video(esp_peer_handle_t peer, esp_peer_video_frame_t *info);
+int esp_peer_send_audio(esp_peer_handle_t peer, esp_peer_audio_frame_t *info);
+int esp_peer_send_data(esp_peer_handle_t peer, esp_peer_data_frame_t *frame);
+int esp_peer_main_loop(esp_peer_handle_t peer);
+int esp_peer_disconnect(esp_peer_handle_t peer);
+int esp_peer_close(esp_peer_handle_t peer);
+
+#ifdef __cplusplus
+}
+#endif
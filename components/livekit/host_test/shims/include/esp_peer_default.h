@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "esp_peer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t cache_timeout;
+    uint32_t send_cache_size;
+    uint32_t recv_cache_size;
+} esp_peer_default_data_ch_cfg_t;
+
+typedef struct {
+    uint16_t agent_recv_timeout;
+    esp_peer_default_data_ch_cfg_t data_ch_cfg;
+} esp_peer_default_cfg_t;
+
+const esp_peer_ops_t *esp_peer_get_default_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host-only controls for the esp_peer stand-in, used by tests and benchmarks to
+// drive peers without a network.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Behavior of the esp_peer stand-in, shared by all peers.
+typedef struct {
+    /// Reports the connection as established and opens any data channels created
+    /// by the peer on the main loop iterations following `esp_peer_new_connection`.
+    /// Data frames can only be sent on open channels.
+    bool auto_connect;
+
+    /// Delivers data frames sent on a peer back to the same peer through `on_data`
+    /// during its next main loop iteration.
+    bool loopback;
+} esp_peer_fake_cfg_t;
+
+/// Sets the behavior for peers opened after this call.
+void esp_peer_fake_configure(const esp_peer_fake_cfg_t *cfg);
+
+/// Returns the total number of `esp_peer_main_loop` calls across all peers.
+uint64_t esp_peer_fake_main_loop_count(void);
+
+/// Makes `esp_peer_send_data` fail with `ESP_PEER_ERR_WOULD_BLOCK` on all peers
+/// until cleared, as when the SCTP send buffer is full.
+void esp_peer_fake_set_send_rejected(bool rejected);
+
+/// Queues a data frame as if the remote peer had sent it on the first open data
+/// channel of the most recently opened peer.
+///
+/// As with a frame arriving on a socket, nothing wakes the peer's loop; the frame
+/// is delivered through `on_data` during the next main loop iteration.
+///
+/// @returns Whether the frame was queued.
+///
+bool esp_peer_fake_inject_data(const uint8_t *data, int size);
+
+#ifdef __cplusplus
+}
+#endif
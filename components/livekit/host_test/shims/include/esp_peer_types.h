@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ESP_PEER_ERR_NONE         = 0,
+    ESP_PEER_ERR_INVALID_ARG  = -1,
+    ESP_PEER_ERR_NO_MEM       = -2,
+    ESP_PEER_ERR_WRONG_STATE  = -3,
+    ESP_PEER_ERR_NOT_SUPPORT  = -4,
+    ESP_PEER_ERR_NOT_EXISTS   = -5,
+    ESP_PEER_ERR_FAIL         = -6,
+    ESP_PEER_ERR_OVER_LIMITED = -7,
+    ESP_PEER_ERR_BAD_DATA     = -8,
+    ESP_PEER_ERR_WOULD_BLOCK  = -9
+} esp_peer_err_t;
+
+typedef enum {
+    ESP_PEER_AUDIO_CODEC_NONE,
+    ESP_PEER_AUDIO_CODEC_G711A,
+    ESP_PEER_AUDIO_CODEC_G711U,
+    ESP_PEER_AUDIO_CODEC_OPUS
+} esp_peer_audio_codec_t;
+
+typedef enum {
+    ESP_PEER_VIDEO_CODEC_NONE,
+    ESP_PEER_VIDEO_CODEC_H264,
+    ESP_PEER_VIDEO_CODEC_MJPEG
+} esp_peer_video_codec_t;
+
+typedef enum {
+    ESP_PEER_MEDIA_DIR_NONE      = 0,
+    ESP_PEER_MEDIA_DIR_SEND_ONLY = (1 << 0),
+    ESP_PEER_MEDIA_DIR_RECV_ONLY = (1 << 1),
+    ESP_PEER_MEDIA_DIR_SEND_RECV = ESP_PEER_MEDIA_DIR_SEND_ONLY | ESP_PEER_MEDIA_DIR_RECV_ONLY
+} esp_peer_media_dir_t;
+
+typedef enum {
+    ESP_PEER_ICE_TRANS_POLICY_ALL,
+    ESP_PEER_ICE_TRANS_POLICY_RELAY
+} esp_peer_ice_trans_policy_t;
+
+typedef enum {
+    ESP_PEER_ROLE_CONTROLLING,
+    ESP_PEER_ROLE_CONTROLLED
+} esp_peer_role_t;
+
+typedef struct {
+    char *stun_url;
+    char *user;
+    char *psw;
+} esp_peer_ice_server_cfg_t;
+
+typedef struct {
+    esp_peer_audio_codec_t codec;
+    uint32_t sample_rate;
+    uint8_t channel;
+} esp_peer_audio_stream_info_t;
+
+typedef struct {
+    esp_peer_video_codec_t codec;
+    int width;
+    int height;
+    int fps;
+} esp_peer_video_stream_info_t;
+
+typedef struct {
+    uint32_t pts;
+    uint8_t *data;
+    int size;
+} esp_peer_audio_frame_t;
+
+typedef struct {
+    uint32_t pts;
+    uint8_t *data;
+    int size;
+} esp_peer_video_frame_t;
+
+#ifdef __cplusplus
+}
+#endif
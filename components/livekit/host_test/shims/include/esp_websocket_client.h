@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the subset of esp_websocket_client used by the LiveKit core.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct host_websocket *esp_websocket_client_handle_t;
+
+typedef enum {
+    WEBSOCKET_EVENT_ANY = -1,
+    WEBSOCKET_EVENT_ERROR = 0,
+    WEBSOCKET_EVENT_CONNECTED,
+    WEBSOCKET_EVENT_DISCONNECTED,
+    WEBSOCKET_EVENT_DATA,
+    WEBSOCKET_EVENT_CLOSED,
+    WEBSOCKET_EVENT_BEFORE_CONNECT,
+    WEBSOCKET_EVENT_BEGIN,
+    WEBSOCKET_EVENT_FINISH,
+    WEBSOCKET_EVENT_MAX
+} esp_websocket_event_id_t;
+
+typedef enum {
+    WS_TRANSPORT_OPCODES_CONT   = 0x00,
+    WS_TRANSPORT_OPCODES_TEXT   = 0x01,
+    WS_TRANSPORT_OPCODES_BINARY = 0x02,
+    WS_TRANSPORT_OPCODES_CLOSE  = 0x08,
+    WS_TRANSPORT_OPCODES_PING   = 0x09,
+    WS_TRANSPORT_OPCODES_PONG   = 0x0a,
+    WS_TRANSPORT_OPCODES_FIN    = 0x80
+} ws_transport_opcodes_t;
+
+typedef struct {
+    int esp_ws_handshake_status_code;
+} esp_websocket_error_codes_t;
+
+typedef struct {
+    const char *data_ptr;
+    int data_len;
+    bool fin;
+    uint8_t op_code;
+    esp_websocket_client_handle_t client;
+    void *user_context;
+    int payload_len;
+    int payload_offset;
+    esp_websocket_error_codes_t error_handle;
+} esp_websocket_event_data_t;
+
+typedef struct {
+    const char *uri;
+    int buffer_size;
+    bool disable_pingpong_discon;
+    int network_timeout_ms;
+    bool disable_auto_reconnect;
+    esp_err_t (*crt_bundle_attach)(void *conf);
+} esp_websocket_client_config_t;
+
+esp_websocket_client_handle_t esp_websocket_client_init(const esp_websocket_client_config_t *config);
+esp_err_t esp_websocket_client_destroy(esp_websocket_client_handle_t client);
+esp_err_t esp_websocket_client_set_uri(esp_websocket_client_handle_t client, const char *uri);
+esp_err_t esp_websocket_client_start(esp_websocket_client_handle_t client);
+esp_err_t esp_websocket_client_stop(esp_websocket_client_handle_t client);
+esp_err_t esp_websocket_client_close(esp_websocket_client_handle_t client, TickType_t timeout);
+bool esp_websocket_client_is_connected(esp_websocket_client_handle_t client);
+int esp_websocket_client_send_bin(esp_websocket_client_handle_t client, const char *data, int len, TickType_t timeout);
+esp_err_t esp_websocket_register_events(
+    esp_websocket_client_handle_t client,
+    esp_websocket_event_id_t event,
+    esp_event_handler_t event_handler,
+    void *event_handler_arg
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host-only controls for the esp_websocket_client stand-in, used by benchmarks
+// to simulate a slow socket and by tests to play the server.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_websocket_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Behavior of the esp_websocket_client stand-in, shared by all clients.
+typedef struct {
+    /// Time each send blocks before it succeeds, as with a stalled TCP socket.
+    uint32_t send_delay_ms;
+
+    /// Invoked with each message sent, after the delay. Optional.
+    void (*on_send)(const uint8_t *data, int len, void *ctx);
+    void *ctx;
+} esp_websocket_client_fake_cfg_t;
+
+/// Sets the behavior of all clients.
+void esp_websocket_client_fake_configure(const esp_websocket_client_fake_cfg_t *cfg);
+
+/// Returns the total number of messages sent across all clients.
+uint64_t esp_websocket_client_fake_sent_count(void);
+
+/// Returns the number of times a client has been started.
+uint32_t esp_websocket_client_fake_start_count(void);
+
+/// Copies the URI of the most recently started client.
+///
+/// @returns Whether a client has been started.
+///
+bool esp_websocket_client_fake_last_uri(char *buf, size_t size);
+
+/// Delivers an event to the most recently started client, as its event task would.
+///
+/// `data` is delivered as a single binary frame with `WEBSOCKET_EVENT_DATA`.
+///
+void esp_websocket_client_fake_emit(esp_websocket_event_id_t event, const uint8_t *data, int len);
+
+#ifdef __cplusplus
+}
+#endif
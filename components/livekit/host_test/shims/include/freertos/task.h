@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*TaskFunction_t)(void *arg);
+typedef struct host_task *TaskHandle_t;
+
+BaseType_t xTaskCreate(
+    TaskFunction_t fn,
+    const char *name,
+    uint32_t stack_depth,
+    void *arg,
+    UBaseType_t priority,
+    TaskHandle_t *out_handle
+);
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t fn,
+    const char *name,
+    uint32_t stack_depth,
+    void *arg,
+    UBaseType_t priority,
+    TaskHandle_t *out_handle,
+    BaseType_t core_id
+);
+
+/// Deletes a task; passing NULL exits the calling task.
+void vTaskDelete(TaskHandle_t handle);
+
+void vTaskDelay(TickType_t ticks);
+
+TickType_t xTaskGetTickCount(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle);
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the subset of media_lib_sal's OS abstraction used by the
+// LiveKit core. Semantics follow the FreeRTOS adapter shipped with media_lib_sal.
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEDIA_LIB_MAX_LOCK_TIME 0xFFFFFFFF
+
+typedef void *media_lib_thread_handle_t;
+typedef void *media_lib_mutex_handle_t;
+typedef void *media_lib_sema_handle_t;
+typedef void *media_lib_event_grp_handle_t;
+
+typedef struct {
+    uint32_t stack_size;
+    uint8_t priority;
+    uint8_t core_id;
+} media_lib_thread_cfg_t;
+
+typedef void (*media_lib_thread_schedule_cb)(const char *thread_name, media_lib_thread_cfg_t *thread_cfg);
+
+int media_lib_thread_create_from_scheduler(
+    media_lib_thread_handle_t *handle,
+    const char *name,
+    void (*body)(void *arg),
+    void *arg
+);
+
+/// Exits the calling thread when `handle` is NULL.
+void media_lib_thread_destroy(media_lib_thread_handle_t handle);
+void media_lib_thread_sleep(int ms);
+int media_lib_thread_set_schedule_cb(media_lib_thread_schedule_cb cb);
+
+int media_lib_mutex_create(media_lib_mutex_handle_t *mutex);
+int media_lib_mutex_lock(media_lib_mutex_handle_t mutex, uint32_t timeout);
+int media_lib_mutex_unlock(media_lib_mutex_handle_t mutex);
+int media_lib_mutex_destroy(media_lib_mutex_handle_t mutex);
+
+int media_lib_sema_create(media_lib_sema_handle_t *sema);
+int media_lib_sema_lock(media_lib_sema_handle_t sema, uint32_t timeout);
+int media_lib_sema_unlock(media_lib_sema_handle_t sema);
+int media_lib_sema_destroy(media_lib_sema_handle_t sema);
+
+int media_lib_event_group_create(media_lib_event_grp_handle_t *event_handle);
+
+/// Sets bits and wakes waiters; returns the resulting bits.
+uint32_t media_lib_event_group_set_bits(media_lib_event_grp_handle_t event_group, uint32_t bits);
+
+/// Clears bits; returns the bits before clearing.
+uint32_t media_lib_event_group_clr_bits(media_lib_event_grp_handle_t event_group, uint32_t bits);
+
+/// Waits until all of `bits` are set (bits are not cleared on exit).
+uint32_t media_lib_event_group_wait_bits(media_lib_event_grp_handle_t event_group, uint32_t bits, uint32_t timeout);
+int media_lib_event_group_destroy(media_lib_event_grp_handle_t event_group);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// Host stand-in for the generated sdkconfig.h. Values mirror the defaults
+// in components/livekit/Kconfig; any of them can be overridden on the
+// command line (e.g. -DCONFIG_LK_ENGINE_QUEUE_SIZE=64).
+
+#ifndef CONFIG_LK_MAX_RETRIES
+#define CONFIG_LK_MAX_RETRIES 7
+#endif
+
+#ifndef CONFIG_LK_MAX_ICE_SERVERS
+#define CONFIG_LK_MAX_ICE_SERVERS 3
+#endif
+
+
+#ifndef CONFIG_LK_MAX_REMOTE_AUDIO_TRACKS
+#define CONFIG_LK_MAX_REMOTE_AUDIO_TRACKS 8
+#endif
+
+#ifndef CONFIG_LK_SPEAKER_HOLD_MS
+#define CONFIG_LK_SPEAKER_HOLD_MS 2000
+#endif
+
+#ifndef CONFIG_LK_VAD_THRESHOLD_DBFS
+#define CONFIG_LK_VAD_THRESHOLD_DBFS -50
+#endif
+
+#ifndef CONFIG_LK_VAD_HANGOVER_MS
+#define CONFIG_LK_VAD_HANGOVER_MS 400
+#endif
+
+#ifndef CONFIG_LK_PRE_CONNECT_BUFFER_MS
+#define CONFIG_LK_PRE_CONNECT_BUFFER_MS 2000
+#endif
+
+#ifndef CONFIG_LK_PRE_CONNECT_BUFFER_SIZE
+#define CONFIG_LK_PRE_CONNECT_BUFFER_SIZE 65536
+#endif
+
+#ifndef CONFIG_LK_PRE_CONNECT_TIMEOUT_MS
+#define CONFIG_LK_PRE_CONNECT_TIMEOUT_MS 10000
+#endif
+
+#ifndef CONFIG_LK_ENGINE_QUEUE_SIZE
+#define CONFIG_LK_ENGINE_QUEUE_SIZE 32
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_WS_BUFFER_SIZE
+#define CONFIG_LK_SIGNAL_WS_BUFFER_SIZE 4096
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_MAX_MESSAGE_SIZE
+#define CONFIG_LK_SIGNAL_MAX_MESSAGE_SIZE 65536
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE
+#define CONFIG_LK_SIGNAL_SEND_QUEUE_SIZE 16
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_SEND_SLOT_SIZE
+#define CONFIG_LK_SIGNAL_SEND_SLOT_SIZE 512
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_TASK_STACK_SIZE
+#define CONFIG_LK_SIGNAL_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CONFIG_LK_SIGNAL_TASK_PRIORITY
+#define CONFIG_LK_SIGNAL_TASK_PRIORITY 5
+#endif
+
+#ifndef CONFIG_LK_PROTOCOL_ARENA
+#define CONFIG_LK_PROTOCOL_ARENA 1
+#endif
+
+#ifndef CONFIG_LK_RELIABLE_BUFFER_SIZE
+#define CONFIG_LK_RELIABLE_BUFFER_SIZE 4096
+#endif
+
+#ifndef CONFIG_LK_DATA_QUEUE_SIZE
+#define CONFIG_LK_DATA_QUEUE_SIZE 16
+#endif
+
+#ifndef CONFIG_LK_DATA_TASK_STACK_SIZE
+#define CONFIG_LK_DATA_TASK_STACK_SIZE 4096
+#endif
+
+#ifndef CONFIG_LK_DATA_TASK_PRIORITY
+#define CONFIG_LK_DATA_TASK_PRIORITY 4
+#endif
+
+#ifndef CONFIG_LK_DATA_STREAM_CHUNK_SIZE
+#define CONFIG_LK_DATA_STREAM_CHUNK_SIZE 1024
+#endif
+
+#ifndef CONFIG_LK_DATA_STREAM_WINDOW_SIZE
+#define CONFIG_LK_DATA_STREAM_WINDOW_SIZE 2048
+#endif
+
+#ifndef CONFIG_LK_DATA_STREAM_MAX_INCOMING
+#define CONFIG_LK_DATA_STREAM_MAX_INCOMING 4
+#endif
+
+#ifndef CONFIG_LK_RPC_WORKER_COUNT
+#define CONFIG_LK_RPC_WORKER_COUNT 0
+#endif
+
+#ifndef CONFIG_LK_RPC_QUEUE_SIZE
+#define CONFIG_LK_RPC_QUEUE_SIZE 8
+#endif
+
+#ifndef CONFIG_LK_RPC_WORKER_STACK_SIZE
+#define CONFIG_LK_RPC_WORKER_STACK_SIZE 4096
+#endif
+
+#ifndef CONFIG_LK_RPC_WORKER_PRIORITY
+#define CONFIG_LK_RPC_WORKER_PRIORITY 3
+#endif
+
+// Bool options are left undefined when disabled, as in the generated header:
+// CONFIG_LK_PUB_EVENT_DRIVEN, CONFIG_LK_PEER_LOOP_ADAPTIVE
+
+#ifndef CONFIG_LK_PUB_INTERVAL_MS
+#define CONFIG_LK_PUB_INTERVAL_MS 20
+#endif
+
+#ifndef CONFIG_LK_PUB_AUDIO_TRACK_NAME
+#define CONFIG_LK_PUB_AUDIO_TRACK_NAME "Audio"
+#endif
+
+#ifndef CONFIG_LK_PUB_VIDEO_TRACK_NAME
+#define CONFIG_LK_PUB_VIDEO_TRACK_NAME "Video"
+#endif
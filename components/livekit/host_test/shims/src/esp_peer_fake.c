@@ -0,0 +1,275 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "esp_peer.h"
+#include "esp_peer_default.h"
+#include "esp_peer_fake.h"
+
+// Stand-in for esp_peer. By default it is inert: connections are accepted and
+// every send succeeds, but no state changes or media are ever reported back.
+// esp_peer_fake_configure enables a simulated connection and data loopback.
+// As with esp_peer, disconnecting closes the data channels; channels created for
+// the next connection are given new stream IDs.
+
+#define MAX_CHANNELS 4
+
+struct esp_peer_ops {
+    int unused;
+};
+
+typedef struct loopback_frame {
+    struct loopback_frame *next;
+    esp_peer_data_frame_t frame;
+} loopback_frame_t;
+
+typedef struct {
+    esp_peer_cfg_t cfg;
+    esp_peer_fake_cfg_t fake_cfg;
+
+    bool connect_pending;
+    bool channels_pending;
+    bool channels_open;
+    int channel_count;
+    uint16_t next_stream_id;
+    esp_peer_data_channel_info_t channels[MAX_CHANNELS];
+
+    pthread_mutex_t lock;
+    loopback_frame_t *head;
+    loopback_frame_t *tail;
+} host_peer_t;
+
+static const esp_peer_ops_t default_impl = {};
+static esp_peer_fake_cfg_t fake_cfg;
+static atomic_uint_fast64_t main_loop_count;
+static atomic_bool is_send_rejected;
+
+/// Most recently opened peer, for injecting data.
+static pthread_mutex_t last_peer_lock = PTHREAD_MUTEX_INITIALIZER;
+static host_peer_t *last_peer;
+
+void esp_peer_fake_configure(const esp_peer_fake_cfg_t *cfg)
+{
+    fake_cfg = *cfg;
+}
+
+void esp_peer_fake_set_send_rejected(bool rejected)
+{
+    atomic_store(&is_send_rejected, rejected);
+}
+
+uint64_t esp_peer_fake_main_loop_count(void)
+{
+    return atomic_load(&main_loop_count);
+}
+
+const esp_peer_ops_t *esp_peer_get_default_impl(void)
+{
+    return &default_impl;
+}
+
+int esp_peer_open(esp_peer_cfg_t *cfg, const esp_peer_ops_t *ops, esp_peer_handle_t *peer)
+{
+    if (cfg == NULL || ops == NULL || peer == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = calloc(1, sizeof(host_peer_t));
+    if (p == NULL) {
+        return ESP_PEER_ERR_NO_MEM;
+    }
+    p->cfg = *cfg;
+    p->fake_cfg = fake_cfg;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_mutex_lock(&last_peer_lock);
+    last_peer = p;
+    pthread_mutex_unlock(&last_peer_lock);
+    *peer = p;
+    return ESP_PEER_ERR_NONE;
+}
+
+int esp_peer_new_connection(esp_peer_handle_t peer)
+{
+    if (peer == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    p->connect_pending = p->fake_cfg.auto_connect;
+    return ESP_PEER_ERR_NONE;
+}
+
+int esp_peer_create_data_channel(esp_peer_handle_t peer, esp_peer_data_channel_cfg_t *ch_cfg)
+{
+    if (peer == NULL || ch_cfg == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    if (p->channel_count >= MAX_CHANNELS) {
+        return ESP_PEER_ERR_NO_MEM;
+    }
+    p->channels[p->channel_count] = (esp_peer_data_channel_info_t){
+        .label = ch_cfg->label,
+        .stream_id = ++p->next_stream_id
+    };
+    p->channel_count++;
+    p->channels_pending = p->fake_cfg.auto_connect;
+    return ESP_PEER_ERR_NONE;
+}
+
+int esp_peer_send_msg(esp_peer_handle_t peer, esp_peer_msg_t *msg)
+{
+    return peer && msg ? ESP_PEER_ERR_NONE : ESP_PEER_ERR_INVALID_ARG;
+}
+
+int esp_peer_send_video(esp_peer_handle_t peer, esp_peer_video_frame_t *info)
+{
+    return peer && info ? ESP_PEER_ERR_NONE : ESP_PEER_ERR_INVALID_ARG;
+}
+
+int esp_peer_send_audio(esp_peer_handle_t peer, esp_peer_audio_frame_t *info)
+{
+    return peer && info ? ESP_PEER_ERR_NONE : ESP_PEER_ERR_INVALID_ARG;
+}
+
+/// Queues a copy of a frame to be delivered on the peer's next main loop iteration.
+static int queue_received(host_peer_t *p, const esp_peer_data_frame_t *frame)
+{
+    loopback_frame_t *item = malloc(sizeof(loopback_frame_t) + frame->size);
+    if (item == NULL) {
+        return ESP_PEER_ERR_NO_MEM;
+    }
+    item->next = NULL;
+    item->frame = *frame;
+    item->frame.data = (uint8_t *)(item + 1);
+    memcpy(item->frame.data, frame->data, frame->size);
+
+    pthread_mutex_lock(&p->lock);
+    if (p->tail != NULL) {
+        p->tail->next = item;
+    } else {
+        p->head = item;
+    }
+    p->tail = item;
+    pthread_mutex_unlock(&p->lock);
+    return ESP_PEER_ERR_NONE;
+}
+
+bool esp_peer_fake_inject_data(const uint8_t *data, int size)
+{
+    pthread_mutex_lock(&last_peer_lock);
+    host_peer_t *p = last_peer;
+    bool is_queued = p != NULL && p->channels_open && p->channel_count > 0 &&
+        queue_received(p, &(esp_peer_data_frame_t){
+            .type = ESP_PEER_DATA_CHANNEL_DATA,
+            .stream_id = p->channels[0].stream_id,
+            .data = (uint8_t *)data,
+            .size = size
+        }) == ESP_PEER_ERR_NONE;
+    pthread_mutex_unlock(&last_peer_lock);
+    return is_queued;
+}
+
+int esp_peer_send_data(esp_peer_handle_t peer, esp_peer_data_frame_t *frame)
+{
+    if (peer == NULL || frame == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    bool is_open = false;
+    for (int i = 0; p->channels_open && i < p->channel_count; i++) {
+        is_open |= p->channels[i].stream_id == frame->stream_id;
+    }
+    if (!is_open) {
+        return ESP_PEER_ERR_WRONG_STATE;
+    }
+    if (atomic_load(&is_send_rejected)) {
+        return ESP_PEER_ERR_WOULD_BLOCK;
+    }
+    if (!p->fake_cfg.loopback) {
+        return ESP_PEER_ERR_NONE;
+    }
+    return queue_received(p, frame);
+}
+
+int esp_peer_main_loop(esp_peer_handle_t peer)
+{
+    if (peer == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    atomic_fetch_add(&main_loop_count, 1);
+
+    if (p->connect_pending) {
+        p->connect_pending = false;
+        p->cfg.on_state(ESP_PEER_STATE_CONNECTED, p->cfg.ctx);
+    } else if (p->channels_pending) {
+        p->channels_pending = false;
+        p->channels_open = true;
+        for (int i = 0; i < p->channel_count; i++) {
+            p->cfg.on_channel_open(&p->channels[i], p->cfg.ctx);
+        }
+        p->cfg.on_state(ESP_PEER_STATE_DATA_CHANNEL_OPENED, p->cfg.ctx);
+    }
+
+    pthread_mutex_lock(&p->lock);
+    loopback_frame_t *item = p->head;
+    p->head = p->tail = NULL;
+    pthread_mutex_unlock(&p->lock);
+    while (item != NULL) {
+        loopback_frame_t *next = item->next;
+        p->cfg.on_data(&item->frame, p->cfg.ctx);
+        free(item);
+        item = next;
+    }
+    return ESP_PEER_ERR_NONE;
+}
+
+int esp_peer_disconnect(esp_peer_handle_t peer)
+{
+    if (peer == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    p->connect_pending = false;
+    p->channels_pending = false;
+    p->channels_open = false;
+    p->channel_count = 0;
+    return ESP_PEER_ERR_NONE;
+}
+
+int esp_peer_close(esp_peer_handle_t peer)
+{
+    if (peer == NULL) {
+        return ESP_PEER_ERR_INVALID_ARG;
+    }
+    host_peer_t *p = peer;
+    pthread_mutex_lock(&last_peer_lock);
+    if (last_peer == p) {
+        last_peer = NULL;
+    }
+    pthread_mutex_unlock(&last_peer_lock);
+    loopback_frame_t *item = p->head;
+    while (item != NULL) {
+        loopback_frame_t *next = item->next;
+        free(item);
+        item = next;
+    }
+    pthread_mutex_destroy(&p->lock);
+    free(p);
+    return ESP_PEER_ERR_NONE;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "esp_chip_info.h"
+#include "esp_idf_version.h"
+
+#include "host_time.h"
+
+// MARK: - Logging
+
+static _Atomic esp_log_level_t log_level = ESP_LOG_INFO;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    if (tag != NULL && strcmp(tag, "*") == 0) {
+        log_level = level;
+    }
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    if (level > log_level) return;
+    static const char letters[] = { 'N', 'E', 'W', 'I', 'D', 'V' };
+    fprintf(stderr, "%c (%" PRIu64 ") %s: ", letters[level], (uint64_t)(host_time_now_ns() / 1000000), tag);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+// MARK: - System
+
+void esp_system_abort(const char *details)
+{
+    fprintf(stderr, "abort() was called: %s\n", details);
+    abort();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(host_time_now_ns() / 1000ULL);
+}
+
+uint32_t esp_random(void)
+{
+    // Deterministic across runs so benchmark and test results are reproducible.
+    static _Atomic uint32_t state = 0x9e3779b9u;
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+}
+
+void esp_chip_info(esp_chip_info_t *out_info)
+{
+    memset(out_info, 0, sizeof(*out_info));
+    out_info->model = CHIP_POSIX_LINUX;
+    out_info->cores = 1;
+}
+
+const char *esp_get_idf_version(void)
+{
+    return "host";
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "freertos/task.h"
+#include "esp_websocket_client.h"
+#include "esp_websocket_client_fake.h"
+
+// Inert stand-in for esp_websocket_client: the client never connects and
+// sends are reported as successful without leaving the process.
+// esp_websocket_client_fake_configure can make sends block or observe them,
+// and esp_websocket_client_fake_emit delivers events as the server would.
+
+struct host_websocket {
+    esp_websocket_client_config_t config;
+    esp_event_handler_t handler;
+    void *handler_arg;
+    char *uri;
+};
+
+static esp_websocket_client_fake_cfg_t fake_cfg;
+static atomic_uint_fast64_t sent_count;
+static atomic_uint start_count;
+
+/// Most recently started client, guarded by `started_lock`.
+static pthread_mutex_t started_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct host_websocket *started;
+static char started_uri[512];
+
+void esp_websocket_client_fake_configure(const esp_websocket_client_fake_cfg_t *cfg)
+{
+    fake_cfg = *cfg;
+}
+
+uint64_t esp_websocket_client_fake_sent_count(void)
+{
+    return atomic_load(&sent_count);
+}
+
+uint32_t esp_websocket_client_fake_start_count(void)
+{
+    return atomic_load(&start_count);
+}
+
+bool esp_websocket_client_fake_last_uri(char *buf, size_t size)
+{
+    pthread_mutex_lock(&started_lock);
+    bool is_started = started != NULL;
+    snprintf(buf, size, "%s", started_uri);
+    pthread_mutex_unlock(&started_lock);
+    return is_started;
+}
+
+void esp_websocket_client_fake_emit(esp_websocket_event_id_t event, const uint8_t *data, int len)
+{
+    pthread_mutex_lock(&started_lock);
+    struct host_websocket *ws = started;
+    pthread_mutex_unlock(&started_lock);
+    if (ws == NULL || ws->handler == NULL) {
+        return;
+    }
+    esp_websocket_event_data_t event_data = {
+        .data_ptr = (const char *)data,
+        .data_len = len,
+        .fin = true,
+        .op_code = WS_TRANSPORT_OPCODES_BINARY,
+        .client = ws,
+        .payload_len = len
+    };
+    ws->handler(ws->handler_arg, NULL, event, &event_data);
+}
+
+esp_websocket_client_handle_t esp_websocket_client_init(const esp_websocket_client_config_t *config)
+{
+    if (config == NULL) return NULL;
+    struct host_websocket *ws = calloc(1, sizeof(*ws));
+    if (ws == NULL) return NULL;
+    ws->config = *config;
+    return ws;
+}
+
+esp_err_t esp_websocket_client_destroy(esp_websocket_client_handle_t client)
+{
+    if (client == NULL) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&started_lock);
+    if (started == client) {
+        started = NULL;
+    }
+    pthread_mutex_unlock(&started_lock);
+    free(client->uri);
+    free(client);
+    return ESP_OK;
+}
+
+esp_err_t esp_websocket_client_set_uri(esp_websocket_client_handle_t client, const char *uri)
+{
+    if (client == NULL || uri == NULL) return ESP_ERR_INVALID_ARG;
+    free(client->uri);
+    client->uri = strdup(uri);
+    return client->uri ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t esp_websocket_client_start(esp_websocket_client_handle_t client)
+{
+    if (client == NULL) return ESP_ERR_INVALID_ARG;
+    pthread_mutex_lock(&started_lock);
+    started = client;
+    snprintf(started_uri, sizeof(started_uri), "%s", client->uri ? client->uri : "");
+    pthread_mutex_unlock(&started_lock);
+    atomic_fetch_add(&start_count, 1);
+    return ESP_OK;
+}
+
+esp_err_t esp_websocket_client_stop(esp_websocket_client_handle_t client)
+{
+    return client ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_websocket_client_close(esp_websocket_client_handle_t client, TickType_t timeout)
+{
+    (void)timeout;
+    return client ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+bool esp_websocket_client_is_connected(esp_websocket_client_handle_t client)
+{
+    (void)client;
+    return false;
+}
+
+int esp_websocket_client_send_bin(esp_websocket_client_handle_t client, const char *data, int len, TickType_t timeout)
+{
+    (void)timeout;
+    if (client == NULL || data == NULL) return -1;
+    if (fake_cfg.send_delay_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(fake_cfg.send_delay_ms));
+    }
+    atomic_fetch_add(&sent_count, 1);
+    if (fake_cfg.on_send != NULL) {
+        fake_cfg.on_send((const uint8_t *)data, len, fake_cfg.ctx);
+    }
+    return len;
+}
+
+esp_err_t esp_websocket_register_events(
+    esp_websocket_client_handle_t client,
+    esp_websocket_event_id_t event,
+    esp_event_handler_t event_handler,
+    void *event_handler_arg
+) {
+    (void)event;
+    if (client == NULL) return ESP_ERR_INVALID_ARG;
+    client->handler = event_handler;
+    client->handler_arg = event_handler_arg;
+    return ESP_OK;
+}
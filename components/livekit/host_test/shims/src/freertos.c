@@ -0,0 +1,718 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/timers.h"
+
+#include "host_time.h"
+
+// MARK: - Time helpers
+
+uint64_t host_time_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/// Converts a relative tick timeout to an absolute deadline for `pthread_cond_timedwait`.
+static inline struct timespec deadline_from_ticks(TickType_t ticks)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ms = pdTICKS_TO_MS(ticks);
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void unlock_mutex(void *mutex)
+{
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+static inline void cond_init_monotonic(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/// Waits on `cond` until `ready` returns true or the timeout elapses.
+///
+/// Must be called with `mutex` held; returns with it held. A cleanup handler
+/// releases the mutex if the waiting thread is cancelled by `vTaskDelete`.
+///
+static bool cond_wait_until(
+    pthread_cond_t *cond,
+    pthread_mutex_t *mutex,
+    TickType_t ticks,
+    bool (*ready)(void *ctx),
+    void *ctx
+) {
+    if (ready(ctx)) return true;
+    if (ticks == 0) return false;
+
+    bool result = true;
+    struct timespec deadline = deadline_from_ticks(ticks);
+    pthread_cleanup_push(unlock_mutex, mutex);
+    while (!ready(ctx)) {
+        if (ticks == portMAX_DELAY) {
+            pthread_cond_wait(cond, mutex);
+        } else if (pthread_cond_timedwait(cond, mutex, &deadline) == ETIMEDOUT) {
+            result = ready(ctx);
+            break;
+        }
+    }
+    pthread_cleanup_pop(0);
+    return result;
+}
+
+// MARK: - Tasks
+
+struct host_task {
+    pthread_t thread;
+    TaskFunction_t fn;
+    void *arg;
+    pthread_mutex_t lock;
+    pthread_cond_t notify_cond;
+    uint32_t notify_count;
+};
+
+static pthread_key_t task_key;
+static pthread_once_t task_key_once = PTHREAD_ONCE_INIT;
+
+static void task_key_create(void)
+{
+    pthread_key_create(&task_key, NULL);
+}
+
+static void *task_entry(void *arg)
+{
+    struct host_task *task = (struct host_task *)arg;
+    pthread_setspecific(task_key, task);
+    task->fn(task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t fn,
+    const char *name,
+    uint32_t stack_depth,
+    void *arg,
+    UBaseType_t priority,
+    TaskHandle_t *out_handle,
+    BaseType_t core_id
+) {
+    (void)name; (void)stack_depth; (void)priority; (void)core_id;
+    pthread_once(&task_key_once, task_key_create);
+
+    struct host_task *task = calloc(1, sizeof(*task));
+    if (task == NULL) return pdFAIL;
+    task->fn = fn;
+    task->arg = arg;
+    pthread_mutex_init(&task->lock, NULL);
+    cond_init_monotonic(&task->notify_cond);
+
+    if (pthread_create(&task->thread, NULL, task_entry, task) != 0) {
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(task->thread);
+    if (out_handle) *out_handle = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(
+    TaskFunction_t fn,
+    const char *name,
+    uint32_t stack_depth,
+    void *arg,
+    UBaseType_t priority,
+    TaskHandle_t *out_handle
+) {
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, arg, priority, out_handle, -1);
+}
+
+void vTaskDelete(TaskHandle_t handle)
+{
+    // Task control blocks are intentionally leaked: a deleted task may still
+    // be referenced by a handle held elsewhere, as with static TCBs on target.
+    if (handle == NULL) {
+        pthread_exit(NULL);
+    }
+    if (pthread_equal(handle->thread, pthread_self())) {
+        pthread_exit(NULL);
+    }
+    pthread_cancel(handle->thread);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    usleep((useconds_t)pdTICKS_TO_MS(ticks) * 1000);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(host_time_now_ns() / 1000000ULL);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    pthread_once(&task_key_once, task_key_create);
+    return (TaskHandle_t)pthread_getspecific(task_key);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle)
+{
+    if (handle == NULL) return pdFAIL;
+    pthread_mutex_lock(&handle->lock);
+    handle->notify_count++;
+    pthread_cond_signal(&handle->notify_cond);
+    pthread_mutex_unlock(&handle->lock);
+    return pdPASS;
+}
+
+static bool task_notified(void *ctx)
+{
+    return ((struct host_task *)ctx)->notify_count > 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    struct host_task *task = xTaskGetCurrentTaskHandle();
+    if (task == NULL) {
+        vTaskDelay(ticks_to_wait == portMAX_DELAY ? 0 : ticks_to_wait);
+        return 0;
+    }
+    pthread_mutex_lock(&task->lock);
+    uint32_t value = 0;
+    if (cond_wait_until(&task->notify_cond, &task->lock, ticks_to_wait, task_notified, task)) {
+        value = task->notify_count;
+        task->notify_count = clear_on_exit ? 0 : task->notify_count - 1;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+// MARK: - Queues
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+    uint8_t *storage;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    if (length == 0) return NULL;
+    struct host_queue *q = calloc(1, sizeof(*q));
+    if (q == NULL) return NULL;
+    q->storage = calloc(length, item_size > 0 ? item_size : 1);
+    if (q->storage == NULL) {
+        free(q);
+        return NULL;
+    }
+    q->length = length;
+    q->item_size = item_size;
+    pthread_mutex_init(&q->lock, NULL);
+    cond_init_monotonic(&q->not_empty);
+    cond_init_monotonic(&q->not_full);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+    if (q == NULL) return;
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    free(q->storage);
+    free(q);
+}
+
+static bool queue_has_space(void *ctx)
+{
+    struct host_queue *q = ctx;
+    return q->count < q->length;
+}
+
+static bool queue_has_item(void *ctx)
+{
+    return ((struct host_queue *)ctx)->count > 0;
+}
+
+static BaseType_t queue_send(QueueHandle_t q, const void *item, TickType_t ticks, bool to_front)
+{
+    if (q == NULL) return pdFAIL;
+    pthread_mutex_lock(&q->lock);
+    if (!cond_wait_until(&q->not_full, &q->lock, ticks, queue_has_space, q)) {
+        pthread_mutex_unlock(&q->lock);
+        return pdFAIL;
+    }
+    UBaseType_t slot;
+    if (to_front) {
+        q->head = (q->head + q->length - 1) % q->length;
+        slot = q->head;
+    } else {
+        slot = (q->head + q->count) % q->length;
+    }
+    if (q->item_size > 0) {
+        memcpy(q->storage + (size_t)slot * q->item_size, item, q->item_size);
+    }
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    return queue_send(q, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void *item, TickType_t ticks)
+{
+    return queue_send(q, item, ticks, true);
+}
+
+static BaseType_t queue_receive(QueueHandle_t q, void *out_item, TickType_t ticks, bool remove)
+{
+    if (q == NULL) return pdFAIL;
+    pthread_mutex_lock(&q->lock);
+    if (!cond_wait_until(&q->not_empty, &q->lock, ticks, queue_has_item, q)) {
+        pthread_mutex_unlock(&q->lock);
+        return pdFAIL;
+    }
+    if (q->item_size > 0 && out_item != NULL) {
+        memcpy(out_item, q->storage + (size_t)q->head * q->item_size, q->item_size);
+    }
+    if (remove) {
+        q->head = (q->head + 1) % q->length;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *out_item, TickType_t ticks)
+{
+    return queue_receive(q, out_item, ticks, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void *out_item, TickType_t ticks)
+{
+    return queue_receive(q, out_item, ticks, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t q)
+{
+    if (q == NULL) return pdFAIL;
+    pthread_mutex_lock(&q->lock);
+    q->head = 0;
+    q->count = 0;
+    pthread_cond_broadcast(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    if (q == NULL) return 0;
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t count = q->count;
+    pthread_mutex_unlock(&q->lock);
+    return count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q)
+{
+    if (q == NULL) return 0;
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t spaces = q->length - q->count;
+    pthread_mutex_unlock(&q->lock);
+    return spaces;
+}
+
+// MARK: - Semaphores
+
+struct host_semaphore {
+    pthread_mutex_t lock;
+    pthread_cond_t available;
+    UBaseType_t count;
+    UBaseType_t max_count;
+};
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    struct host_semaphore *sem = calloc(1, sizeof(*sem));
+    if (sem == NULL) return NULL;
+    pthread_mutex_init(&sem->lock, NULL);
+    cond_init_monotonic(&sem->available);
+    sem->count = initial_count;
+    sem->max_count = max_count;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    if (sem == NULL) return;
+    pthread_mutex_destroy(&sem->lock);
+    pthread_cond_destroy(&sem->available);
+    free(sem);
+}
+
+static bool sem_available(void *ctx)
+{
+    return ((struct host_semaphore *)ctx)->count > 0;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    if (sem == NULL) return pdFAIL;
+    pthread_mutex_lock(&sem->lock);
+    bool taken = cond_wait_until(&sem->available, &sem->lock, ticks, sem_available, sem);
+    if (taken) sem->count--;
+    pthread_mutex_unlock(&sem->lock);
+    return taken ? pdPASS : pdFAIL;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem == NULL) return pdFAIL;
+    pthread_mutex_lock(&sem->lock);
+    bool given = sem->count < sem->max_count;
+    if (given) {
+        sem->count++;
+        pthread_cond_signal(&sem->available);
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return given ? pdPASS : pdFAIL;
+}
+
+// MARK: - Event groups
+
+struct host_event_group {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    EventBits_t bits;
+    EventBits_t wait_bits;
+    bool wait_for_all;
+};
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    struct host_event_group *group = calloc(1, sizeof(*group));
+    if (group == NULL) return NULL;
+    pthread_mutex_init(&group->lock, NULL);
+    cond_init_monotonic(&group->changed);
+    return group;
+}
+
+void vEventGroupDelete(EventGroupHandle_t group)
+{
+    if (group == NULL) return;
+    pthread_mutex_destroy(&group->lock);
+    pthread_cond_destroy(&group->changed);
+    free(group);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    pthread_mutex_lock(&group->lock);
+    group->bits |= bits;
+    EventBits_t result = group->bits;
+    pthread_cond_broadcast(&group->changed);
+    pthread_mutex_unlock(&group->lock);
+    return result;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    pthread_mutex_lock(&group->lock);
+    EventBits_t result = group->bits;
+    group->bits &= ~bits;
+    pthread_mutex_unlock(&group->lock);
+    return result;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+    pthread_mutex_lock(&group->lock);
+    EventBits_t result = group->bits;
+    pthread_mutex_unlock(&group->lock);
+    return result;
+}
+
+typedef struct {
+    struct host_event_group *group;
+    EventBits_t bits;
+    bool wait_for_all;
+} event_wait_t;
+
+static bool event_bits_ready(void *ctx)
+{
+    event_wait_t *wait = ctx;
+    EventBits_t set = wait->group->bits & wait->bits;
+    return wait->wait_for_all ? set == wait->bits : set != 0;
+}
+
+EventBits_t xEventGroupWaitBits(
+    EventGroupHandle_t group,
+    EventBits_t bits,
+    BaseType_t clear_on_exit,
+    BaseType_t wait_for_all,
+    TickType_t ticks
+) {
+    pthread_mutex_lock(&group->lock);
+    event_wait_t wait = { .group = group, .bits = bits, .wait_for_all = wait_for_all };
+    bool ready = cond_wait_until(&group->changed, &group->lock, ticks, event_bits_ready, &wait);
+    EventBits_t result = group->bits;
+    if (ready && clear_on_exit) {
+        group->bits &= ~bits;
+    }
+    pthread_mutex_unlock(&group->lock);
+    return result;
+}
+
+// MARK: - Software timers
+
+struct host_timer {
+    struct host_timer *next;
+    TimerCallbackFunction_t callback;
+    void *timer_id;
+    TickType_t period;
+    bool auto_reload;
+    bool active;
+    uint64_t expiry_ns;
+};
+
+struct pended_call {
+    struct pended_call *next;
+    PendedFunction_t function;
+    void *param1;
+    uint32_t param2;
+};
+
+static pthread_mutex_t timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_cond;
+static pthread_once_t timer_once = PTHREAD_ONCE_INIT;
+static struct host_timer *timer_list;
+/// Functions waiting to run on the daemon, oldest first.
+static struct pended_call *pended_head;
+static struct pended_call **pended_tail = &pended_head;
+
+/// Shared daemon that runs all timer callbacks, mirroring the FreeRTOS timer service task.
+static void *timer_daemon(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&timer_lock);
+    for (;;) {
+        struct pended_call *call = pended_head;
+        if (call != NULL) {
+            pended_head = call->next;
+            if (pended_head == NULL) {
+                pended_tail = &pended_head;
+            }
+            pthread_mutex_unlock(&timer_lock);
+            call->function(call->param1, call->param2);
+            free(call);
+            pthread_mutex_lock(&timer_lock);
+            continue;
+        }
+        uint64_t now = host_time_now_ns();
+        struct host_timer *next = NULL;
+        for (struct host_timer *t = timer_list; t != NULL; t = t->next) {
+            if (t->active && (next == NULL || t->expiry_ns < next->expiry_ns)) {
+                next = t;
+            }
+        }
+        if (next == NULL) {
+            pthread_cond_wait(&timer_cond, &timer_lock);
+            continue;
+        }
+        if (next->expiry_ns > now) {
+            struct timespec ts = {
+                .tv_sec = (time_t)(next->expiry_ns / 1000000000ULL),
+                .tv_nsec = (long)(next->expiry_ns % 1000000000ULL)
+            };
+            pthread_cond_timedwait(&timer_cond, &timer_lock, &ts);
+            continue;
+        }
+        if (next->auto_reload) {
+            next->expiry_ns += (uint64_t)pdTICKS_TO_MS(next->period) * 1000000ULL;
+        } else {
+            next->active = false;
+        }
+        pthread_mutex_unlock(&timer_lock);
+        next->callback(next);
+        pthread_mutex_lock(&timer_lock);
+    }
+    return NULL;
+}
+
+static void timer_daemon_start(void)
+{
+    cond_init_monotonic(&timer_cond);
+    pthread_t thread;
+    pthread_create(&thread, NULL, timer_daemon, NULL);
+    pthread_detach(thread);
+}
+
+TimerHandle_t xTimerCreate(
+    const char *name,
+    TickType_t period,
+    UBaseType_t auto_reload,
+    void *timer_id,
+    TimerCallbackFunction_t callback
+) {
+    (void)name;
+    pthread_once(&timer_once, timer_daemon_start);
+    struct host_timer *timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) return NULL;
+    timer->callback = callback;
+    timer->timer_id = timer_id;
+    timer->period = period;
+    timer->auto_reload = auto_reload;
+
+    pthread_mutex_lock(&timer_lock);
+    timer->next = timer_list;
+    timer_list = timer;
+    pthread_mutex_unlock(&timer_lock);
+    return timer;
+}
+
+static inline void timer_arm_locked(struct host_timer *timer)
+{
+    timer->expiry_ns = host_time_now_ns() + (uint64_t)pdTICKS_TO_MS(timer->period) * 1000000ULL;
+    timer->active = true;
+    pthread_cond_signal(&timer_cond);
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    if (timer == NULL) return pdFAIL;
+    pthread_mutex_lock(&timer_lock);
+    timer_arm_locked(timer);
+    pthread_mutex_unlock(&timer_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticks)
+{
+    return xTimerStart(timer, ticks);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    if (timer == NULL) return pdFAIL;
+    pthread_mutex_lock(&timer_lock);
+    timer->active = false;
+    pthread_mutex_unlock(&timer_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticks)
+{
+    (void)ticks;
+    if (timer == NULL) return pdFAIL;
+    pthread_mutex_lock(&timer_lock);
+    timer->period = period;
+    timer_arm_locked(timer);
+    pthread_mutex_unlock(&timer_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    if (timer == NULL) return pdFAIL;
+    pthread_mutex_lock(&timer_lock);
+    for (struct host_timer **it = &timer_list; *it != NULL; it = &(*it)->next) {
+        if (*it == timer) {
+            *it = timer->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&timer_lock);
+    free(timer);
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer)
+{
+    if (timer == NULL) return pdFALSE;
+    pthread_mutex_lock(&timer_lock);
+    bool active = timer->active;
+    pthread_mutex_unlock(&timer_lock);
+    return active ? pdTRUE : pdFALSE;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer)
+{
+    return timer ? timer->timer_id : NULL;
+}
+
+BaseType_t xTimerPendFunctionCall(PendedFunction_t function, void *param1, uint32_t param2, TickType_t ticks)
+{
+    (void)ticks;
+    if (function == NULL) return pdFAIL;
+    pthread_once(&timer_once, timer_daemon_start);
+    struct pended_call *call = calloc(1, sizeof(*call));
+    if (call == NULL) return pdFAIL;
+    call->function = function;
+    call->param1 = param1;
+    call->param2 = param2;
+
+    pthread_mutex_lock(&timer_lock);
+    *pended_tail = call;
+    pended_tail = &call->next;
+    pthread_cond_signal(&timer_cond);
+    pthread_mutex_unlock(&timer_lock);
+    return pdPASS;
+}
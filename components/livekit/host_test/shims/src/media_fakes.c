@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "esp_capture.h"
+#include "esp_capture_sink.h"
+#include "esp_capture_fake.h"
+#include "av_render.h"
+
+// Inert stand-ins for esp_capture and av_render: capture never produces a
+// frame and the renderer discards everything it is given. The run mode of each
+// capture path is recorded for esp_capture_fake_path_run_mode.
+
+struct host_capture_sink {
+    esp_capture_sink_cfg_t cfg;
+    esp_capture_run_mode_t run_mode;
+};
+
+static struct host_capture_sink *path_sinks[ESP_CAPTURE_FAKE_MAX_PATHS];
+
+esp_capture_run_mode_t esp_capture_fake_path_run_mode(uint8_t path)
+{
+    if (path >= ESP_CAPTURE_FAKE_MAX_PATHS || path_sinks[path] == NULL) {
+        return ESP_CAPTURE_RUN_MODE_DISABLE;
+    }
+    return path_sinks[path]->run_mode;
+}
+
+void esp_capture_fake_reset(void)
+{
+    for (int i = 0; i < ESP_CAPTURE_FAKE_MAX_PATHS; i++) {
+        path_sinks[i] = NULL;
+    }
+}
+
+esp_capture_err_t esp_capture_set_thread_scheduler(esp_capture_thread_scheduler_cb_t scheduler)
+{
+    (void)scheduler;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+esp_capture_err_t esp_capture_start(esp_capture_handle_t capture)
+{
+    (void)capture;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+esp_capture_err_t esp_capture_stop(esp_capture_handle_t capture)
+{
+    (void)capture;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+esp_capture_err_t esp_capture_sink_setup(
+    esp_capture_handle_t capture,
+    uint8_t path,
+    esp_capture_sink_cfg_t *sink_info,
+    esp_capture_sink_handle_t *sink
+) {
+    (void)capture;
+    if (sink_info == NULL || sink == NULL) {
+        return ESP_CAPTURE_ERR_INVALID_ARG;
+    }
+    struct host_capture_sink *s = calloc(1, sizeof(*s));
+    if (s == NULL) {
+        return ESP_CAPTURE_ERR_NO_MEM;
+    }
+    s->cfg = *sink_info;
+    if (path < ESP_CAPTURE_FAKE_MAX_PATHS) {
+        path_sinks[path] = s;
+    }
+    *sink = s;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+esp_capture_err_t esp_capture_sink_enable(esp_capture_sink_handle_t sink, esp_capture_run_mode_t run_type)
+{
+    if (sink == NULL) {
+        return ESP_CAPTURE_ERR_INVALID_ARG;
+    }
+    sink->run_mode = run_type;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+esp_capture_err_t esp_capture_sink_acquire_frame(esp_capture_sink_handle_t sink, esp_capture_stream_frame_t *frame, bool no_wait)
+{
+    (void)sink; (void)frame; (void)no_wait;
+    return ESP_CAPTURE_ERR_NOT_ENOUGH;
+}
+
+esp_capture_err_t esp_capture_sink_release_frame(esp_capture_sink_handle_t sink, esp_capture_stream_frame_t *frame)
+{
+    (void)sink; (void)frame;
+    return ESP_CAPTURE_ERR_OK;
+}
+
+int av_render_add_audio_stream(av_render_handle_t render, av_render_audio_info_t *audio_info)
+{
+    (void)render; (void)audio_info;
+    return ESP_MEDIA_ERR_OK;
+}
+
+int av_render_add_audio_data(av_render_handle_t render, av_render_audio_data_t *audio_data)
+{
+    (void)render; (void)audio_data;
+    return ESP_MEDIA_ERR_OK;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "media_lib_os.h"
+#include "media_lib_adapter.h"
+
+// Maps media_lib_sal's OS abstraction onto the FreeRTOS shims, as the
+// default adapter does on target.
+
+static media_lib_thread_schedule_cb schedule_cb;
+
+static inline TickType_t timeout_to_ticks(uint32_t timeout)
+{
+    return timeout == MEDIA_LIB_MAX_LOCK_TIME ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+}
+
+int media_lib_thread_create_from_scheduler(
+    media_lib_thread_handle_t *handle,
+    const char *name,
+    void (*body)(void *arg),
+    void *arg
+) {
+    media_lib_thread_cfg_t cfg = { .stack_size = 4 * 1024, .priority = 5, .core_id = 0 };
+    if (schedule_cb != NULL) {
+        schedule_cb(name, &cfg);
+    }
+    TaskHandle_t task = NULL;
+    if (xTaskCreatePinnedToCore(body, name, cfg.stack_size, arg, cfg.priority, &task, cfg.core_id) != pdPASS) {
+        return ESP_FAIL;
+    }
+    if (handle != NULL) *handle = task;
+    return ESP_OK;
+}
+
+void media_lib_thread_destroy(media_lib_thread_handle_t handle)
+{
+    vTaskDelete((TaskHandle_t)handle);
+}
+
+void media_lib_thread_sleep(int ms)
+{
+    usleep((useconds_t)ms * 1000);
+}
+
+int media_lib_thread_set_schedule_cb(media_lib_thread_schedule_cb cb)
+{
+    schedule_cb = cb;
+    return ESP_OK;
+}
+
+int media_lib_mutex_create(media_lib_mutex_handle_t *mutex)
+{
+    *mutex = xSemaphoreCreateMutex();
+    return *mutex ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+int media_lib_mutex_lock(media_lib_mutex_handle_t mutex, uint32_t timeout)
+{
+    return xSemaphoreTake((SemaphoreHandle_t)mutex, timeout_to_ticks(timeout)) == pdPASS ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+int media_lib_mutex_unlock(media_lib_mutex_handle_t mutex)
+{
+    xSemaphoreGive((SemaphoreHandle_t)mutex);
+    return ESP_OK;
+}
+
+int media_lib_mutex_destroy(media_lib_mutex_handle_t mutex)
+{
+    vSemaphoreDelete((SemaphoreHandle_t)mutex);
+    return ESP_OK;
+}
+
+int media_lib_sema_create(media_lib_sema_handle_t *sema)
+{
+    *sema = xSemaphoreCreateCounting(0xFFFF, 0);
+    return *sema ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+int media_lib_sema_lock(media_lib_sema_handle_t sema, uint32_t timeout)
+{
+    return xSemaphoreTake((SemaphoreHandle_t)sema, timeout_to_ticks(timeout)) == pdPASS ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+int media_lib_sema_unlock(media_lib_sema_handle_t sema)
+{
+    xSemaphoreGive((SemaphoreHandle_t)sema);
+    return ESP_OK;
+}
+
+int media_lib_sema_destroy(media_lib_sema_handle_t sema)
+{
+    vSemaphoreDelete((SemaphoreHandle_t)sema);
+    return ESP_OK;
+}
+
+int media_lib_event_group_create(media_lib_event_grp_handle_t *event_handle)
+{
+    *event_handle = xEventGroupCreate();
+    return *event_handle ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+uint32_t media_lib_event_group_set_bits(media_lib_event_grp_handle_t event_group, uint32_t bits)
+{
+    return xEventGroupSetBits((EventGroupHandle_t)event_group, bits);
+}
+
+uint32_t media_lib_event_group_clr_bits(media_lib_event_grp_handle_t event_group, uint32_t bits)
+{
+    return xEventGroupClearBits((EventGroupHandle_t)event_group, bits);
+}
+
+uint32_t media_lib_event_group_wait_bits(media_lib_event_grp_handle_t event_group, uint32_t bits, uint32_t timeout)
+{
+    return xEventGroupWaitBits((EventGroupHandle_t)event_group, bits, pdFALSE, pdTRUE, timeout_to_ticks(timeout));
+}
+
+int media_lib_event_group_destroy(media_lib_event_grp_handle_t event_group)
+{
+    vEventGroupDelete((EventGroupHandle_t)event_group);
+    return ESP_OK;
+}
+
+esp_err_t media_lib_add_default_adapter(void)
+{
+    return ESP_OK;
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/task.h"
+#include "pb_encode.h"
+#include "pb_decode.h"
+#include "esp_peer_fake.h"
+#include "esp_websocket_client_fake.h"
+#include "engine_fixture.h"
+
+#define SERVER_URL "wss://example.livekit.cloud"
+#define TOKEN      "token"
+#define MAX_SENT   64
+
+/// Signal requests sent by the engine, guarded by `sent_lock`.
+static SemaphoreHandle_t sent_lock;
+static struct {
+    uint8_t *data;
+    int len;
+} sent[MAX_SENT];
+static int sent_count;
+
+static void on_ws_send(const uint8_t *data, int len, void *ctx)
+{
+    uint8_t *copy = malloc(len);
+    if (copy == NULL) {
+        return;
+    }
+    memcpy(copy, data, len);
+    xSemaphoreTake(sent_lock, portMAX_DELAY);
+    if (sent_count < MAX_SENT) {
+        sent[sent_count].data = copy;
+        sent[sent_count].len = len;
+        sent_count++;
+        copy = NULL;
+    }
+    xSemaphoreGive(sent_lock);
+    free(copy);
+}
+
+/// Removes the oldest request sent, if any.
+static bool pop_sent(uint8_t **data, int *len)
+{
+    xSemaphoreTake(sent_lock, portMAX_DELAY);
+    bool has_sent = sent_count > 0;
+    if (has_sent) {
+        *data = sent[0].data;
+        *len = sent[0].len;
+        sent_count--;
+        memmove(&sent[0], &sent[1], sent_count * sizeof(sent[0]));
+    }
+    xSemaphoreGive(sent_lock);
+    return has_sent;
+}
+
+static void on_state_changed(livekit_connection_state_t state, void *ctx)
+{
+    engine_fixture_t *fixture = ctx;
+    atomic_store(&fixture->state, state);
+    if (state == LIVEKIT_CONNECTION_STATE_CONNECTED) {
+        atomic_fetch_add(&fixture->connected_count, 1);
+    }
+}
+
+static void on_data_packet(livekit_pb_data_packet_t *packet, void *ctx)
+{
+    engine_fixture_t *fixture = ctx;
+    xSemaphoreTake(fixture->lock, portMAX_DELAY);
+    if (fixture->packet_count < ENGINE_FIXTURE_MAX_PACKETS) {
+        fixture->packets[fixture->packet_count++] = (engine_fixture_packet_t){
+            .sequence = packet->sequence,
+            .payload_size = packet->which_value == LIVEKIT_PB_DATA_PACKET_USER_TAG &&
+                packet->value.user.payload != NULL ? packet->value.user.payload->size : 0
+        };
+    }
+    xSemaphoreGive(fixture->lock);
+    if (fixture->on_packet != NULL) {
+        fixture->on_packet(packet, fixture->on_packet_ctx);
+    }
+}
+
+static size_t packet_count(engine_fixture_t *fixture)
+{
+    xSemaphoreTake(fixture->lock, portMAX_DELAY);
+    size_t count = fixture->packet_count;
+    xSemaphoreGive(fixture->lock);
+    return count;
+}
+
+/// Waits up to the fixture timeout for a condition to hold.
+#define WAIT_UNTIL(cond) ({                                              \
+    bool _ok = false;                                                    \
+    for (int _ms = 0; _ms < ENGINE_FIXTURE_TIMEOUT_MS; _ms++) {          \
+        if (cond) { _ok = true; break; }                                 \
+        vTaskDelay(pdMS_TO_TICKS(1));                                    \
+    }                                                                    \
+    _ok;                                                                 \
+})
+
+bool engine_fixture_create(engine_fixture_t *fixture)
+{
+    memset(fixture, 0, sizeof(*fixture));
+    fixture->lock = xSemaphoreCreateMutex();
+    if (sent_lock == NULL) {
+        sent_lock = xSemaphoreCreateMutex();
+    }
+    if (fixture->lock == NULL || sent_lock == NULL) {
+        return false;
+    }
+    esp_peer_fake_configure(&(esp_peer_fake_cfg_t){ .auto_connect = true, .loopback = true });
+    esp_websocket_client_fake_configure(&(esp_websocket_client_fake_cfg_t){ .on_send = on_ws_send });
+
+    engine_options_t options = {
+        .ctx = fixture,
+        .on_state_changed = on_state_changed,
+        .on_data_packet = on_data_packet,
+        .media = {
+            .audio_info = { .codec = ESP_PEER_AUDIO_CODEC_NONE },
+            .video_info = { .codec = ESP_PEER_VIDEO_CODEC_NONE }
+        }
+    };
+    fixture->engine = engine_init(&options);
+    return fixture->engine != NULL;
+}
+
+void engine_fixture_destroy(engine_fixture_t *fixture)
+{
+    if (fixture->engine != NULL) {
+        engine_close(fixture->engine);
+        WAIT_UNTIL(atomic_load(&fixture->state) == LIVEKIT_CONNECTION_STATE_DISCONNECTED);
+        engine_destroy(fixture->engine);
+        fixture->engine = NULL;
+    }
+    esp_websocket_client_fake_configure(&(esp_websocket_client_fake_cfg_t){});
+    esp_peer_fake_configure(&(esp_peer_fake_cfg_t){});
+    esp_peer_fake_set_send_rejected(false);
+    uint8_t *data;
+    int len;
+    while (pop_sent(&data, &len)) {
+        free(data);
+    }
+    if (fixture->lock != NULL) {
+        vSemaphoreDelete(fixture->lock);
+        fixture->lock = NULL;
+    }
+}
+
+bool engine_fixture_accept(uint32_t count, char *uri, size_t uri_size)
+{
+    if (!WAIT_UNTIL(esp_websocket_client_fake_start_count() >= count)) {
+        return false;
+    }
+    esp_websocket_client_fake_last_uri(uri, uri_size);
+    esp_websocket_client_fake_emit(WEBSOCKET_EVENT_BEFORE_CONNECT, NULL, 0);
+    esp_websocket_client_fake_emit(WEBSOCKET_EVENT_CONNECTED, NULL, 0);
+    return true;
+}
+
+bool engine_fixture_send_response(const livekit_pb_signal_response_t *res)
+{
+    size_t size = 0;
+    if (!pb_get_encoded_size(&size, LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, res)) {
+        return false;
+    }
+    uint8_t *buf = malloc(size);
+    if (buf == NULL) {
+        return false;
+    }
+    pb_ostream_t stream = pb_ostream_from_buffer(buf, size);
+    bool encoded = pb_encode(&stream, LIVEKIT_PB_SIGNAL_RESPONSE_FIELDS, res);
+    if (encoded) {
+        esp_websocket_client_fake_emit(WEBSOCKET_EVENT_DATA, buf, (int)size);
+    }
+    free(buf);
+    return encoded;
+}
+
+bool engine_fixture_take_request(pb_size_t which_message, livekit_pb_signal_request_t *out)
+{
+    for (int ms = 0; ms < ENGINE_FIXTURE_TIMEOUT_MS; ms++) {
+        uint8_t *data;
+        int len;
+        if (!pop_sent(&data, &len)) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+            continue;
+        }
+        memset(out, 0, sizeof(*out));
+        pb_istream_t stream = pb_istream_from_buffer(data, len);
+        bool decoded = pb_decode(&stream, LIVEKIT_PB_SIGNAL_REQUEST_FIELDS, out);
+        free(data);
+        if (!decoded) {
+            continue;
+        }
+        if (out->which_message == which_message) {
+            return true;
+        }
+        pb_release(LIVEKIT_PB_SIGNAL_REQUEST_FIELDS, out);
+    }
+    return false;
+}
+
+bool engine_fixture_connect(engine_fixture_t *fixture)
+{
+    uint32_t start_count = esp_websocket_client_fake_start_count();
+    if (engine_connect(fixture->engine, SERVER_URL, TOKEN) != ENGINE_ERR_NONE) {
+        return false;
+    }
+    char uri[512];
+    return engine_fixture_join(fixture, start_count + 1, uri, sizeof(uri));
+}
+
+bool engine_fixture_join(engine_fixture_t *fixture, uint32_t count, char *uri, size_t uri_size)
+{
+    if (!engine_fixture_accept(count, uri, uri_size)) {
+        return false;
+    }
+    char *urls[] = { "stun:stun.example.com:3478" };
+    livekit_pb_signal_response_t res = {
+        .which_message = LIVEKIT_PB_SIGNAL_RESPONSE_JOIN_TAG,
+        .message.join = {
+            .participant = { .sid = "PA_local", .identity = "local" },
+            .ice_servers_count = 1,
+            .ice_servers = {{ .urls_count = 1, .urls = urls }},
+            .ping_interval = 30,
+            .ping_timeout = 60
+        }
+    };
+    return engine_fixture_send_response(&res) &&
+        engine_fixture_wait_connected(fixture, atomic_load(&fixture->connected_count) + 1);
+}
+
+bool engine_fixture_wait_connected(engine_fixture_t *fixture, uint32_t count)
+{
+    return WAIT_UNTIL(atomic_load(&fixture->connected_count) >= count);
+}
+
+bool engine_fixture_wait_packets(engine_fixture_t *fixture, size_t count)
+{
+    return WAIT_UNTIL(packet_count(fixture) >= count);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Runs an engine against a fake server played through the WebSocket and
+// esp_peer stand-ins. Peers connect on their own and data packets sent on the
+// publisher are looped back and received by the engine, so the packets the
+// engine sends can be observed through its `on_data_packet` handler.
+
+#define ENGINE_FIXTURE_MAX_PACKETS 32
+#define ENGINE_FIXTURE_TIMEOUT_MS  3000
+
+/// A data packet received by the engine.
+typedef struct {
+    uint32_t sequence;
+    size_t payload_size;
+} engine_fixture_packet_t;
+
+typedef struct {
+    engine_handle_t engine;
+    _Atomic int state;
+    /// Number of times the engine reported `LIVEKIT_CONNECTION_STATE_CONNECTED`.
+    _Atomic uint32_t connected_count;
+
+    /// Packets received by the engine, guarded by `lock`.
+    engine_fixture_packet_t packets[ENGINE_FIXTURE_MAX_PACKETS];
+    size_t packet_count;
+    SemaphoreHandle_t lock;
+
+    /// Invoked for every data packet received by the engine, if set.
+    void (*on_packet)(livekit_pb_data_packet_t *packet, void *ctx);
+    void *on_packet_ctx;
+} engine_fixture_t;
+
+/// Creates an engine without media and configures the stand-ins.
+bool engine_fixture_create(engine_fixture_t *fixture);
+
+/// Closes and destroys the engine and resets the stand-ins.
+void engine_fixture_destroy(engine_fixture_t *fixture);
+
+/// Connects the engine and waits until it is connected.
+bool engine_fixture_connect(engine_fixture_t *fixture);
+
+/// Waits for the `count`th WebSocket start, then accepts the connection and
+/// joins, waiting until the engine is connected.
+///
+/// @returns Whether the engine connected, with the URI it connected to copied to `uri`.
+///
+bool engine_fixture_join(engine_fixture_t *fixture, uint32_t count, char *uri, size_t uri_size);
+
+/// Waits for the `count`th WebSocket start and accepts the connection.
+///
+/// @returns Whether the connection was started, with its URI copied to `uri`.
+///
+bool engine_fixture_accept(uint32_t count, char *uri, size_t uri_size);
+
+/// Sends a signal response to the engine.
+bool engine_fixture_send_response(const livekit_pb_signal_response_t *res);
+
+/// Takes the oldest signal request of the given type sent by the engine,
+/// discarding requests of other types sent before it.
+///
+/// The request is decoded with nanopb's allocator; release it with `pb_release`.
+///
+bool engine_fixture_take_request(pb_size_t which_message, livekit_pb_signal_request_t *out);
+
+/// Waits until the engine has reported connected `count` times.
+bool engine_fixture_wait_connected(engine_fixture_t *fixture, uint32_t count);
+
+/// Waits until the engine has received `count` data packets.
+bool engine_fixture_wait_packets(engine_fixture_t *fixture, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
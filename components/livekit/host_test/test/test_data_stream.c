@@ -0,0 +1,336 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_peer_fake.h"
+#include "engine_fixture.h"
+#include "data_stream.h"
+
+// Feeds a data stream manager hand-built packets to check how incoming streams
+// are reassembled and closed, checks where outgoing text chunks are split, and
+// sends a stream through an engine connected to the fake server while the peer
+// rejects sends, checking that the writer waits for the window and completes
+// once the peer takes packets again.
+
+#define STREAM_ID "00000000-0000-4000-8000-000000000001"
+
+/// Content sent through the engine; several chunks, more than the window.
+#define WINDOW_CONTENT_SIZE (CONFIG_LK_DATA_STREAM_CHUNK_SIZE * 6)
+
+/// Text of three-byte characters, so chunk boundaries fall inside characters.
+#define TEXT_CHAR "\xE2\x82\xAC"
+#define TEXT_CHAR_COUNT 1000
+
+static int failures;
+
+static void check(bool ok, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s\n", step, what);
+        failures++;
+    }
+}
+
+// MARK: - Receiving
+
+/// Content and outcome of the most recent incoming stream.
+typedef struct {
+    uint8_t content[WINDOW_CONTENT_SIZE];
+    size_t size;
+    _Atomic bool is_closed;
+    livekit_data_stream_close_reason_t reason;
+} received_t;
+
+static received_t received;
+
+static bool on_open(const livekit_data_stream_info_t *info, void **stream_ctx, void *ctx)
+{
+    memset(&received, 0, sizeof(received));
+    return true;
+}
+
+static bool on_chunk(const uint8_t *data, size_t size, void *stream_ctx)
+{
+    if (received.size + size > sizeof(received.content)) {
+        return false;
+    }
+    memcpy(received.content + received.size, data, size);
+    received.size += size;
+    return true;
+}
+
+static void on_close(livekit_data_stream_close_reason_t reason, void *stream_ctx)
+{
+    received.reason = reason;
+    atomic_store(&received.is_closed, true);
+}
+
+static const livekit_data_stream_handler_t handler = {
+    .on_open = on_open,
+    .on_chunk = on_chunk,
+    .on_close = on_close
+};
+
+static void handle_header(data_stream_manager_handle_t manager, uint64_t total_length)
+{
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_HEADER_TAG,
+        .participant_identity = "remote",
+        .value.stream_header = {
+            .stream_id = STREAM_ID,
+            .topic = "test",
+            .has_total_length = total_length > 0,
+            .total_length = total_length,
+            .which_content_header = LIVEKIT_PB_DATA_STREAM_HEADER_BYTE_HEADER_TAG
+        }
+    };
+    data_stream_manager_handle_packet(manager, &packet);
+}
+
+static void handle_chunk(data_stream_manager_handle_t manager, uint64_t index, const char *content)
+{
+    size_t size = strlen(content);
+    pb_bytes_array_t *bytes = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+    bytes->size = size;
+    memcpy(bytes->bytes, content, size);
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG,
+        .value.stream_chunk = {
+            .stream_id = STREAM_ID,
+            .chunk_index = index,
+            .content = bytes
+        }
+    };
+    data_stream_manager_handle_packet(manager, &packet);
+    free(bytes);
+}
+
+static void handle_trailer(data_stream_manager_handle_t manager)
+{
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_STREAM_TRAILER_TAG,
+        .value.stream_trailer = { .stream_id = STREAM_ID }
+    };
+    data_stream_manager_handle_packet(manager, &packet);
+}
+
+// MARK: - Sending
+
+/// Content of chunks sent by a manager without an engine.
+static struct {
+    uint8_t content[TEXT_CHAR_COUNT * 3];
+    size_t size;
+    size_t chunk_sizes[8];
+    int chunk_count;
+} sent;
+
+static bool capture_packet(const livekit_pb_data_packet_t *packet, void *ctx)
+{
+    if (packet->which_value != LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG) {
+        return true;
+    }
+    const pb_bytes_array_t *content = packet->value.stream_chunk.content;
+    if (sent.chunk_count >= 8 || sent.size + content->size > sizeof(sent.content)) {
+        return false;
+    }
+    memcpy(sent.content + sent.size, content->bytes, content->size);
+    sent.size += content->size;
+    sent.chunk_sizes[sent.chunk_count++] = content->size;
+    return true;
+}
+
+static size_t nothing_buffered(void *ctx)
+{
+    return 0;
+}
+
+static bool send_engine_packet(const livekit_pb_data_packet_t *packet, void *ctx)
+{
+    return engine_send_data_packet((engine_handle_t)ctx, packet, true) == ENGINE_ERR_NONE;
+}
+
+static size_t get_engine_buffered(void *ctx)
+{
+    engine_reliable_buffer_stats_t stats;
+    if (engine_get_reliable_buffer_stats((engine_handle_t)ctx, &stats) != ENGINE_ERR_NONE) {
+        return 0;
+    }
+    return stats.used_bytes;
+}
+
+static void on_engine_packet(livekit_pb_data_packet_t *packet, void *ctx)
+{
+    data_stream_manager_handle_packet((data_stream_manager_handle_t)ctx, packet);
+}
+
+typedef struct {
+    data_stream_manager_handle_t manager;
+    uint8_t *content;
+    _Atomic bool is_done;
+    data_stream_err_t result;
+} writer_task_t;
+
+static void writer_task(void *arg)
+{
+    writer_task_t *task = arg;
+    livekit_data_stream_writer_handle_t writer;
+    livekit_data_stream_options_t options = {
+        .topic = "test",
+        .total_length = WINDOW_CONTENT_SIZE
+    };
+    task->result = data_stream_writer_open(task->manager, &options, &writer);
+    if (task->result == DATA_STREAM_ERR_NONE) {
+        task->result = data_stream_writer_write(writer, task->content, WINDOW_CONTENT_SIZE);
+        data_stream_err_t close_ret = data_stream_writer_close(writer, NULL);
+        if (task->result == DATA_STREAM_ERR_NONE) {
+            task->result = close_ret;
+        }
+    }
+    atomic_store(&task->is_done, true);
+    vTaskDelete(NULL);
+}
+
+static bool wait_until_closed(void)
+{
+    for (int ms = 0; ms < ENGINE_FIXTURE_TIMEOUT_MS; ms++) {
+        if (atomic_load(&received.is_closed)) {
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return false;
+}
+
+int main(void)
+{
+    data_stream_manager_handle_t manager = NULL;
+    data_stream_manager_options_t options = {
+        .send_packet = capture_packet,
+        .get_buffered_amount = nothing_buffered,
+        .window_size = CONFIG_LK_DATA_STREAM_WINDOW_SIZE
+    };
+    if (data_stream_manager_create(&manager, &options) != DATA_STREAM_ERR_NONE ||
+        data_stream_manager_register(manager, "test", &handler) != DATA_STREAM_ERR_NONE) {
+        fprintf(stderr, "FAIL setup: manager not created\n");
+        return EXIT_FAILURE;
+    }
+
+    // 1. Chunks are delivered in order and the stream completes.
+    const char *step = "reassembly";
+    handle_header(manager, 10);
+    handle_chunk(manager, 0, "hello");
+    handle_chunk(manager, 0, "hello");
+    handle_chunk(manager, 1, "world");
+    handle_trailer(manager);
+    check(atomic_load(&received.is_closed), step, "not closed");
+    check(received.reason == LIVEKIT_DATA_STREAM_CLOSE_REASON_COMPLETE, step, "not complete");
+    check(received.size == 10 && memcmp(received.content, "helloworld", 10) == 0, step, "content");
+
+    // 2. A missing chunk closes the stream as incomplete right away.
+    step = "missing chunk";
+    handle_header(manager, 0);
+    handle_chunk(manager, 0, "hello");
+    handle_chunk(manager, 2, "world");
+    check(atomic_load(&received.is_closed), step, "not closed");
+    check(received.reason == LIVEKIT_DATA_STREAM_CLOSE_REASON_INCOMPLETE, step, "not incomplete");
+    check(received.size == 5, step, "chunk after gap delivered");
+
+    // 3. Content shorter than the header's total length is incomplete.
+    step = "length mismatch";
+    handle_header(manager, 20);
+    handle_chunk(manager, 0, "hello");
+    handle_trailer(manager);
+    check(atomic_load(&received.is_closed), step, "not closed");
+    check(received.reason == LIVEKIT_DATA_STREAM_CLOSE_REASON_INCOMPLETE, step, "not incomplete");
+
+    // 4. Text chunks end on character boundaries, holding back partial characters.
+    step = "utf8 boundary";
+    static uint8_t text[TEXT_CHAR_COUNT * 3];
+    for (int i = 0; i < TEXT_CHAR_COUNT; i++) {
+        memcpy(text + i * 3, TEXT_CHAR, 3);
+    }
+    livekit_data_stream_writer_handle_t writer;
+    check(data_stream_writer_open(manager, &(livekit_data_stream_options_t){
+        .topic = "text",
+        .kind = LIVEKIT_DATA_STREAM_KIND_TEXT
+    }, &writer) == DATA_STREAM_ERR_NONE, step, "not opened");
+    check(data_stream_writer_write(writer, text, sizeof(text)) == DATA_STREAM_ERR_NONE, step, "not written");
+    check(data_stream_writer_close(writer, NULL) == DATA_STREAM_ERR_NONE, step, "not closed");
+    check(sent.chunk_count > 1, step, "expected several chunks");
+    for (int i = 0; i < sent.chunk_count; i++) {
+        check(sent.chunk_sizes[i] % 3 == 0, step, "chunk splits a character");
+    }
+    check(sent.size == sizeof(text) && memcmp(sent.content, text, sizeof(text)) == 0, step, "content");
+    data_stream_manager_destroy(manager);
+
+    // 5. Through an engine whose peer rejects sends, the writer queues no more
+    //    than the window and waits; once the peer takes packets again, queued
+    //    chunks are retried and the stream completes.
+    step = "window";
+    engine_fixture_t fixture;
+    if (!engine_fixture_create(&fixture) || !engine_fixture_connect(&fixture)) {
+        fprintf(stderr, "FAIL setup: engine not connected\n");
+        return EXIT_FAILURE;
+    }
+    options = (data_stream_manager_options_t){
+        .send_packet = send_engine_packet,
+        .get_buffered_amount = get_engine_buffered,
+        .window_size = CONFIG_LK_DATA_STREAM_WINDOW_SIZE,
+        .ctx = fixture.engine
+    };
+    check(data_stream_manager_create(&manager, &options) == DATA_STREAM_ERR_NONE &&
+          data_stream_manager_register(manager, "test", &handler) == DATA_STREAM_ERR_NONE,
+          step, "manager not created");
+    fixture.on_packet_ctx = manager;
+    fixture.on_packet = on_engine_packet;
+
+    static uint8_t content[WINDOW_CONTENT_SIZE];
+    for (size_t i = 0; i < sizeof(content); i++) {
+        content[i] = (uint8_t)i;
+    }
+    static writer_task_t task;
+    task = (writer_task_t){ .manager = manager, .content = content };
+    memset(&received, 0, sizeof(received));
+    esp_peer_fake_set_send_rejected(true);
+    xTaskCreate(writer_task, "writer", 4096, &task, 5, NULL);
+    vTaskDelay(pdMS_TO_TICKS(300));
+    check(!atomic_load(&task.is_done), step, "writer did not wait");
+    check(get_engine_buffered(fixture.engine) <= CONFIG_LK_DATA_STREAM_WINDOW_SIZE, step, "window exceeded");
+
+    esp_peer_fake_set_send_rejected(false);
+    check(wait_until_closed(), step, "stream not received");
+    check(atomic_load(&task.is_done) && task.result == DATA_STREAM_ERR_NONE, step, "write failed");
+    check(received.reason == LIVEKIT_DATA_STREAM_CLOSE_REASON_COMPLETE, step, "not complete");
+    check(received.size == sizeof(content) && memcmp(received.content, content, sizeof(content)) == 0,
+          step, "content");
+
+    fixture.on_packet = NULL;
+    engine_fixture_destroy(&fixture);
+    data_stream_manager_destroy(manager);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All data stream tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pb_decode.h"
+#include "protocol.h"
+
+// Decodes the same packet with the shared nanopb library and with the core's
+// decoder, which allocates pointer fields from its own arena. Decoding with
+// the shared library must keep using the heap, both during and after a decode
+// by the core.
+
+#define TOPIC "lk.test"
+
+static int failures;
+
+static void check(bool ok, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s\n", step, what);
+        failures++;
+    }
+}
+
+static bool decode_shared(const uint8_t *buf, size_t len, const char *step)
+{
+    livekit_pb_data_packet_t packet = {};
+    pb_istream_t stream = pb_istream_from_buffer(buf, len);
+    if (!pb_decode(&stream, LIVEKIT_PB_DATA_PACKET_FIELDS, &packet)) {
+        check(false, step, PB_GET_ERROR(&stream));
+        return false;
+    }
+    check(packet.value.user.topic != NULL && strcmp(packet.value.user.topic, TOPIC) == 0, step, "topic");
+    check(packet.participant_identity != NULL && strcmp(packet.participant_identity, "sender") == 0, step, "identity");
+    pb_release(LIVEKIT_PB_DATA_PACKET_FIELDS, &packet);
+    check(packet.value.user.topic == NULL && packet.participant_identity == NULL, step, "released");
+    return true;
+}
+
+int main(void)
+{
+    uint8_t payload_bytes[PB_BYTES_ARRAY_T_ALLOCSIZE(4)];
+    pb_bytes_array_t *payload = (pb_bytes_array_t *)payload_bytes;
+    payload->size = 4;
+    memcpy(payload->bytes, "ping", 4);
+
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_USER_TAG,
+        .value.user = { .payload = payload, .topic = TOPIC },
+        .participant_identity = "sender"
+    };
+    uint8_t buf[128];
+    size_t len = protocol_data_packet_encoded_size(&packet);
+    if (len == 0 || len > sizeof(buf) || !protocol_data_packet_encode(&packet, buf, len)) {
+        fprintf(stderr, "FAIL encode\n");
+        return EXIT_FAILURE;
+    }
+
+    decode_shared(buf, len, "shared before core");
+
+    livekit_pb_data_packet_t *decoded = NULL;
+    if (protocol_data_packet_decode(buf, len, &decoded)) {
+        check(decoded->value.user.payload->size == 4 &&
+              memcmp(decoded->value.user.payload->bytes, "ping", 4) == 0, "core", "payload");
+        check(strcmp(decoded->value.user.topic, TOPIC) == 0, "core", "topic");
+
+        // Decode with the shared library while the core's packet is held.
+        decode_shared(buf, len, "shared while core packet held");
+        protocol_data_packet_free(decoded);
+    } else {
+        check(false, "core", "decode failed");
+    }
+
+    decode_shared(buf, len, "shared after core");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All protocol arena tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/task.h"
+#include "esp_websocket_client_fake.h"
+#include "engine_fixture.h"
+
+// Drops the signal connection of an engine connected to the fake server and
+// checks that the room is rejoined with a new session, without resending
+// reliable packets sent over the previous one, and that reliable packets sent
+// while reconnecting are sent once rejoined.
+
+#define PAYLOAD_SIZE 64
+
+static int failures;
+
+static void check(bool ok, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s\n", step, what);
+        failures++;
+    }
+}
+
+static engine_err_t send_user_packet(engine_handle_t engine)
+{
+    uint8_t bytes[PB_BYTES_ARRAY_T_ALLOCSIZE(PAYLOAD_SIZE)];
+    pb_bytes_array_t *payload = (pb_bytes_array_t *)bytes;
+    payload->size = PAYLOAD_SIZE;
+    memset(payload->bytes, 'x', PAYLOAD_SIZE);
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_USER_TAG,
+        .value.user = { .payload = payload, .topic = "test" }
+    };
+    return engine_send_data_packet(engine, &packet, true);
+}
+
+static bool wait_state(engine_fixture_t *fixture, livekit_connection_state_t state)
+{
+    for (int ms = 0; ms < ENGINE_FIXTURE_TIMEOUT_MS; ms++) {
+        if (atomic_load(&fixture->state) == (int)state) {
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return false;
+}
+
+int main(void)
+{
+    engine_fixture_t fixture;
+    if (!engine_fixture_create(&fixture)) {
+        fprintf(stderr, "FAIL setup: engine not created\n");
+        return EXIT_FAILURE;
+    }
+    engine_handle_t engine = fixture.engine;
+
+    // 1. Packets 1 to 3 are received before the signal connection drops.
+    const char *step = "connect";
+    check(engine_fixture_connect(&fixture), step, "not connected");
+    for (int i = 0; i < 3; i++) {
+        check(send_user_packet(engine) == ENGINE_ERR_NONE, step, "packet not sent");
+    }
+    check(engine_fixture_wait_packets(&fixture, 3), step, "packets not received");
+
+    // 2. Packet 4 is buffered while reconnecting.
+    step = "reconnecting";
+    esp_websocket_client_fake_emit(WEBSOCKET_EVENT_DISCONNECTED, NULL, 0);
+    check(wait_state(&fixture, LIVEKIT_CONNECTION_STATE_RECONNECTING), step, "not reconnecting");
+    check(send_user_packet(engine) == ENGINE_ERR_NONE, step, "packet not accepted");
+
+    // 3. After backing off, the engine joins again rather than resuming.
+    step = "rejoin";
+    char uri[512] = "";
+    check(engine_fixture_join(&fixture, 2, uri, sizeof(uri)), step, "not connected");
+    check(strstr(uri, "reconnect=1") == NULL, step, "URI asks to resume");
+
+    // 4. Packet 4 is sent once rejoined, followed by packets sent later; packets
+    //    sent over the previous session are not resent.
+    step = "rejoined";
+    check(send_user_packet(engine) == ENGINE_ERR_NONE, step, "packet not sent");
+    check(engine_fixture_wait_packets(&fixture, 5), step, "packets not received");
+
+    xSemaphoreTake(fixture.lock, portMAX_DELAY);
+    check(fixture.packet_count == 5, step, "unexpected packet count");
+    for (size_t i = 0; i < fixture.packet_count && i < 5; i++) {
+        check(fixture.packets[i].sequence == i + 1, step, "packets out of sequence");
+    }
+    xSemaphoreGive(fixture.lock);
+
+    // 5. Once closed, packets are rejected.
+    step = "closed";
+    engine_close(engine);
+    check(wait_state(&fixture, LIVEKIT_CONNECTION_STATE_DISCONNECTED), step, "not disconnected");
+    check(send_user_packet(engine) != ENGINE_ERR_NONE, step, "packet accepted");
+
+    engine_fixture_destroy(&fixture);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All reconnect tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_peer_fake.h"
+#include "engine_fixture.h"
+
+// Sends reliable data packets smaller and larger than the reliable buffer
+// through an engine connected to the fake server, and checks which are
+// rejected, which are buffered and which arrive.
+
+#define SMALL_PAYLOAD_SIZE 64
+#define LARGE_PAYLOAD_SIZE (CONFIG_LK_RELIABLE_BUFFER_SIZE * 2)
+
+static int failures;
+
+static void check(bool ok, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s\n", step, what);
+        failures++;
+    }
+}
+
+static engine_err_t send_user_packet(engine_handle_t engine, size_t payload_size)
+{
+    pb_bytes_array_t *payload = calloc(1, PB_BYTES_ARRAY_T_ALLOCSIZE(payload_size));
+    if (payload == NULL) {
+        return ENGINE_ERR_NO_MEM;
+    }
+    payload->size = payload_size;
+    memset(payload->bytes, 'x', payload_size);
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_USER_TAG,
+        .value.user = { .payload = payload, .topic = "test" }
+    };
+    engine_err_t ret = engine_send_data_packet(engine, &packet, true);
+    free(payload);
+    return ret;
+}
+
+int main(void)
+{
+    engine_fixture_t fixture;
+    if (!engine_fixture_create(&fixture)) {
+        fprintf(stderr, "FAIL setup: engine not created\n");
+        return EXIT_FAILURE;
+    }
+    engine_handle_t engine = fixture.engine;
+    engine_reliable_buffer_stats_t stats;
+
+    // 1. Before connecting, packets are rejected rather than held for a room
+    //    that may never be joined.
+    const char *step = "disconnected";
+    check(send_user_packet(engine, SMALL_PAYLOAD_SIZE) != ENGINE_ERR_NONE, step, "small packet accepted");
+    check(send_user_packet(engine, LARGE_PAYLOAD_SIZE) != ENGINE_ERR_NONE, step, "large packet accepted");
+    engine_get_reliable_buffer_stats(engine, &stats);
+    check(stats.count == 0 && stats.dropped == 0, step, "packet buffered");
+
+    // 2. Once connected, packets are sent right away.
+    step = "connect";
+    check(engine_fixture_connect(&fixture), step, "not connected");
+    check(send_user_packet(engine, SMALL_PAYLOAD_SIZE) == ENGINE_ERR_NONE, step, "small packet not sent");
+    check(engine_fixture_wait_packets(&fixture, 1), step, "packet not received");
+
+    // 3. A large packet is sent without being buffered, in order with packets
+    //    sent before and after it.
+    step = "connected";
+    check(send_user_packet(engine, LARGE_PAYLOAD_SIZE) == ENGINE_ERR_NONE, step, "large packet not sent");
+    check(send_user_packet(engine, SMALL_PAYLOAD_SIZE) == ENGINE_ERR_NONE, step, "small packet not sent");
+    check(engine_fixture_wait_packets(&fixture, 3), step, "packets not received");
+    engine_get_reliable_buffer_stats(engine, &stats);
+    check(stats.count == 0 && stats.dropped == 0, step, "packets left in buffer");
+    check(stats.high_water_bytes < LARGE_PAYLOAD_SIZE, step, "large packet buffered");
+
+    xSemaphoreTake(fixture.lock, portMAX_DELAY);
+    size_t expected_sizes[] = { SMALL_PAYLOAD_SIZE, LARGE_PAYLOAD_SIZE, SMALL_PAYLOAD_SIZE };
+    for (size_t i = 0; i < fixture.packet_count && i < 3; i++) {
+        check(fixture.packets[i].sequence == i + 1, step, "packets out of sequence");
+        check(fixture.packets[i].payload_size == expected_sizes[i], step, "payload size");
+    }
+    xSemaphoreGive(fixture.lock);
+
+    // 4. A packet the peer cannot take is kept and retried without waiting for
+    //    another packet to be sent.
+    step = "rejected";
+    esp_peer_fake_set_send_rejected(true);
+    check(send_user_packet(engine, SMALL_PAYLOAD_SIZE) == ENGINE_ERR_NONE, step, "packet not buffered");
+    engine_get_reliable_buffer_stats(engine, &stats);
+    check(stats.count == 1, step, "packet not kept");
+    esp_peer_fake_set_send_rejected(false);
+    check(engine_fixture_wait_packets(&fixture, 4), step, "packet not retried");
+    engine_get_reliable_buffer_stats(engine, &stats);
+    check(stats.count == 0 && stats.dropped == 0, step, "packet left in buffer");
+
+    engine_fixture_destroy(&fixture);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All reliable data tests passed\n");
+    return EXIT_SUCCESS;
+}
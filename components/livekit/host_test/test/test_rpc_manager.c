@@ -0,0 +1,262 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "rpc_manager.h"
+
+// Drives an RPC manager with hand-built packets, checking the packets it sends
+// and the results it delivers for invocations that are answered, left
+// unacknowledged, or acknowledged without a response.
+
+#define MAX_RECORDS 16
+
+/// Shortest response timeout the manager allows: the ack timeout plus one tick.
+#define RESPONSE_TIMEOUT_MS 7100
+
+/// Time to wait for either timeout, allowing for the timeout tick.
+#define TIMEOUT_WAIT_MS (RESPONSE_TIMEOUT_MS + 1000)
+
+typedef struct {
+    char id[LIVEKIT_RPC_ID_SIZE];
+    livekit_rpc_result_code_t code;
+    char payload[32];
+} result_record_t;
+
+typedef struct {
+    pb_size_t which_value;
+    char id[LIVEKIT_RPC_ID_SIZE];
+    char payload[32];
+} packet_record_t;
+
+/// Results and packets sent, guarded by `lock`.
+static SemaphoreHandle_t lock;
+static result_record_t results[MAX_RECORDS];
+static int result_count;
+static packet_record_t packets[MAX_RECORDS];
+static int packet_count;
+
+static int failures;
+
+static void check(bool ok, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s\n", step, what);
+        failures++;
+    }
+}
+
+static void copy_string(char *dest, size_t size, const char *src)
+{
+    if (src != NULL) {
+        strncpy(dest, src, size - 1);
+    }
+}
+
+static void on_result(const livekit_rpc_result_t *result, void *ctx)
+{
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (result_count < MAX_RECORDS) {
+        result_record_t *record = &results[result_count++];
+        *record = (result_record_t){ .code = result->code };
+        copy_string(record->id, sizeof(record->id), result->id);
+        copy_string(record->payload, sizeof(record->payload), result->payload);
+    }
+    xSemaphoreGive(lock);
+}
+
+static bool send_packet(const livekit_pb_data_packet_t *packet, void *ctx)
+{
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (packet_count < MAX_RECORDS) {
+        packet_record_t *record = &packets[packet_count++];
+        *record = (packet_record_t){ .which_value = packet->which_value };
+        switch (packet->which_value) {
+            case LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG:
+                copy_string(record->id, sizeof(record->id), packet->value.rpc_request.id);
+                copy_string(record->payload, sizeof(record->payload), packet->value.rpc_request.payload);
+                break;
+            case LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG:
+                copy_string(record->id, sizeof(record->id), packet->value.rpc_ack.request_id);
+                break;
+            case LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG:
+                copy_string(record->id, sizeof(record->id), packet->value.rpc_response.request_id);
+                if (packet->value.rpc_response.which_value == LIVEKIT_PB_RPC_RESPONSE_PAYLOAD_TAG) {
+                    copy_string(record->payload, sizeof(record->payload), packet->value.rpc_response.value.payload);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    xSemaphoreGive(lock);
+    return true;
+}
+
+static void on_echo(const livekit_rpc_invocation_t *invocation, void *ctx)
+{
+    livekit_rpc_return_ok(invocation->payload);
+}
+
+/// Finds the result for an invocation, waiting up to `timeout_ms` for it.
+static bool wait_result(const char *id, uint32_t timeout_ms, result_record_t *out)
+{
+    for (uint32_t waited_ms = 0;; waited_ms += 10) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        int matches = 0;
+        for (int i = 0; i < result_count; i++) {
+            if (strcmp(results[i].id, id) == 0) {
+                *out = results[i];
+                matches++;
+            }
+        }
+        xSemaphoreGive(lock);
+        if (matches > 0 || waited_ms >= timeout_ms) {
+            return matches == 1;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+static int count_results(void)
+{
+    xSemaphoreTake(lock, portMAX_DELAY);
+    int count = result_count;
+    xSemaphoreGive(lock);
+    return count;
+}
+
+static void handle_ack(rpc_manager_handle_t rpc, const char *id)
+{
+    livekit_pb_data_packet_t packet = { .which_value = LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG };
+    strncpy(packet.value.rpc_ack.request_id, id, sizeof(packet.value.rpc_ack.request_id));
+    rpc_manager_handle_packet(rpc, &packet);
+}
+
+static void handle_response(rpc_manager_handle_t rpc, const char *id, char *payload)
+{
+    livekit_pb_data_packet_t packet = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG,
+        .value.rpc_response = {
+            .which_value = LIVEKIT_PB_RPC_RESPONSE_PAYLOAD_TAG,
+            .value.payload = payload
+        }
+    };
+    strncpy(packet.value.rpc_response.request_id, id, sizeof(packet.value.rpc_response.request_id));
+    rpc_manager_handle_packet(rpc, &packet);
+}
+
+static bool invoke(rpc_manager_handle_t rpc, char *out_id)
+{
+    livekit_rpc_invoke_options_t options = {
+        .destination_identity = "remote",
+        .method = "echo",
+        .payload = "ping",
+        .response_timeout_ms = RESPONSE_TIMEOUT_MS
+    };
+    return rpc_manager_invoke(rpc, &options, out_id) == RPC_MANAGER_ERR_NONE;
+}
+
+int main(void)
+{
+    lock = xSemaphoreCreateMutex();
+    rpc_manager_handle_t rpc = NULL;
+    rpc_manager_options_t options = {
+        .on_result = on_result,
+        .send_packet = send_packet
+    };
+    if (lock == NULL || rpc_manager_create(&rpc, &options) != RPC_MANAGER_ERR_NONE) {
+        fprintf(stderr, "FAIL setup: manager not created\n");
+        return EXIT_FAILURE;
+    }
+    result_record_t result;
+
+    // 1. An inbound invocation is acknowledged, then answered with the handler's result.
+    const char *step = "inbound";
+    check(rpc_manager_register(rpc, "echo", on_echo, NULL) == RPC_MANAGER_ERR_NONE, step, "not registered");
+    livekit_pb_data_packet_t request = {
+        .which_value = LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG,
+        .participant_identity = "remote",
+        .value.rpc_request = {
+            .id = "00000000-0000-4000-8000-000000000001",
+            .method = "echo",
+            .payload = "hello",
+            .version = 1
+        }
+    };
+    check(rpc_manager_handle_packet(rpc, &request) == RPC_MANAGER_ERR_NONE, step, "request not handled");
+    xSemaphoreTake(lock, portMAX_DELAY);
+    check(packet_count == 2, step, "expected ack and response");
+    check(packets[0].which_value == LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG &&
+          strcmp(packets[0].id, request.value.rpc_request.id) == 0, step, "ack");
+    check(packets[1].which_value == LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG &&
+          strcmp(packets[1].id, request.value.rpc_request.id) == 0 &&
+          strcmp(packets[1].payload, "hello") == 0, step, "response");
+    packet_count = 0;
+    xSemaphoreGive(lock);
+
+    // 2. An outbound invocation is sent, and its response is delivered once; the
+    //    ack alone delivers nothing.
+    step = "response";
+    char answered_id[LIVEKIT_RPC_ID_SIZE] = {};
+    check(invoke(rpc, answered_id), step, "not invoked");
+    xSemaphoreTake(lock, portMAX_DELAY);
+    check(packet_count == 1 && packets[0].which_value == LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG &&
+          strcmp(packets[0].id, answered_id) == 0 && strcmp(packets[0].payload, "ping") == 0,
+          step, "request not sent");
+    xSemaphoreGive(lock);
+    handle_ack(rpc, answered_id);
+    check(count_results() == 0, step, "result delivered on ack");
+    handle_response(rpc, answered_id, "pong");
+    handle_response(rpc, answered_id, "pong");
+    check(wait_result(answered_id, 0, &result), step, "expected one result");
+    check(result.code == LIVEKIT_RPC_RESULT_OK && strcmp(result.payload, "pong") == 0, step, "result");
+
+    // 3. With no invocations left, the timeout tick lapses. Invocations made after
+    //    that still time out: one never acknowledged, and one acknowledged but
+    //    never answered.
+    step = "timeouts";
+    vTaskDelay(pdMS_TO_TICKS(300));
+    char unacked_id[LIVEKIT_RPC_ID_SIZE] = {};
+    char unanswered_id[LIVEKIT_RPC_ID_SIZE] = {};
+    check(invoke(rpc, unacked_id), step, "unacked not invoked");
+    check(invoke(rpc, unanswered_id), step, "unanswered not invoked");
+    handle_ack(rpc, unanswered_id);
+    check(wait_result(unacked_id, TIMEOUT_WAIT_MS, &result), step, "no ack timeout");
+    check(result.code == LIVEKIT_RPC_RESULT_CONNECTION_TIMEOUT, step, "ack timeout code");
+    check(wait_result(unanswered_id, TIMEOUT_WAIT_MS, &result), step, "no response timeout");
+    check(result.code == LIVEKIT_RPC_RESULT_RESPONSE_TIMEOUT, step, "response timeout code");
+
+    // 4. A response arriving after the timeout is ignored.
+    step = "late";
+    handle_response(rpc, unanswered_id, "late");
+    check(count_results() == 3, step, "late response delivered");
+
+    rpc_manager_destroy(rpc);
+    vSemaphoreDelete(lock);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All RPC manager tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+#include "esp_capture_fake.h"
+#include "video_layers.h"
+
+// Replays subscribed quality updates and mute changes against the video layers
+// and checks which capture paths are left running.
+
+#define ON  ESP_CAPTURE_RUN_MODE_ALWAYS
+#define OFF ESP_CAPTURE_RUN_MODE_DISABLE
+
+#define LOW    LIVEKIT_PB_VIDEO_QUALITY_LOW
+#define MEDIUM LIVEKIT_PB_VIDEO_QUALITY_MEDIUM
+#define HIGH   LIVEKIT_PB_VIDEO_QUALITY_HIGH
+
+static int failures;
+
+static void check(bool ok, const char *test, const char *step, const char *what)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s: %s\n", test, step, what);
+        failures++;
+    }
+}
+
+/// Builds an update with a single codec enabling the given qualities.
+static livekit_pb_subscribed_quality_update_t make_update(bool low, bool medium, bool high)
+{
+    livekit_pb_subscribed_quality_update_t update = {
+        .subscribed_codecs_count = 1,
+        .subscribed_codecs = {{
+            .qualities_count = 3,
+            .qualities = {
+                { .quality = LOW,    .enabled = low },
+                { .quality = MEDIUM, .enabled = medium },
+                { .quality = HIGH,   .enabled = high },
+            }
+        }}
+    };
+    return update;
+}
+
+typedef enum {
+    ACTION_UPDATE,      /// Apply a quality update.
+    ACTION_RESET,       /// Start a new session.
+    ACTION_MUTE,
+    ACTION_UNMUTE,
+    ACTION_AUDIO_MUTE,  /// Audio stops sharing the base path.
+    ACTION_AUDIO_UNMUTE
+} action_t;
+
+typedef struct {
+    const char *step;
+    bool low, medium, high;
+    /// Expected run mode of paths 0 to 3.
+    esp_capture_run_mode_t paths[ESP_CAPTURE_FAKE_MAX_PATHS];
+    /// Expected path to take frames from, or -1 for none.
+    int path;
+    bool send;
+    action_t action;
+} step_t;
+
+static video_layers_handle_t create(const char *test, bool is_base_path_shared,
+                                    esp_capture_sink_handle_t *paths)
+{
+    esp_capture_fake_reset();
+    esp_capture_sink_cfg_t cfg = {};
+    for (int i = 0; i < ESP_CAPTURE_FAKE_MAX_PATHS; i++) {
+        paths[i] = NULL;
+    }
+    if (esp_capture_sink_setup(NULL, 0, &cfg, &paths[0]) != ESP_CAPTURE_ERR_OK ||
+        esp_capture_sink_enable(paths[0], ON) != ESP_CAPTURE_ERR_OK) {
+        check(false, test, "setup", "base path not set up");
+        return NULL;
+    }
+    video_layers_options_t options = {
+        .base_path = paths[0],
+        .is_base_path_shared = is_base_path_shared
+    };
+    video_layers_handle_t layers = NULL;
+    if (video_layers_create(&layers, &options) != VIDEO_LAYERS_ERR_NONE) {
+        check(false, test, "setup", "layers not created");
+        return NULL;
+    }
+    return layers;
+}
+
+static void check_step(const char *test, video_layers_handle_t layers,
+                       esp_capture_sink_handle_t base_path, const step_t *step)
+{
+    char what[64];
+    for (int i = 0; i < ESP_CAPTURE_FAKE_MAX_PATHS; i++) {
+        snprintf(what, sizeof(what), "path %d should be %s", i, step->paths[i] == ON ? "enabled" : "disabled");
+        check(esp_capture_fake_path_run_mode(i) == step->paths[i], test, step->step, what);
+    }
+    bool send = false;
+    esp_capture_sink_handle_t path = video_layers_get_path(layers, &send);
+    if (step->path < 0) {
+        check(path == NULL, test, step->step, "no path should be captured");
+        return;
+    }
+    check(path != NULL, test, step->step, "a path should be captured");
+    check(send == step->send, test, step->step, step->send ? "frames should be sent" : "frames should be dropped");
+    check(step->path != 0 || path == base_path, test, step->step, "base path should be captured");
+}
+
+static void run(const char *test, bool is_base_path_shared,
+                const step_t *initial, const step_t *steps, size_t step_count)
+{
+    esp_capture_sink_handle_t paths[ESP_CAPTURE_FAKE_MAX_PATHS];
+    video_layers_handle_t layers = create(test, is_base_path_shared, paths);
+    if (layers == NULL) {
+        return;
+    }
+    check_step(test, layers, paths[0], initial);
+    for (size_t i = 0; i < step_count; i++) {
+        const step_t *step = &steps[i];
+        switch (step->action) {
+            case ACTION_UPDATE:
+                livekit_pb_subscribed_quality_update_t update = make_update(step->low, step->medium, step->high);
+                video_layers_handle_update(layers, &update);
+                break;
+            case ACTION_RESET:       video_layers_reset(layers); break;
+            case ACTION_MUTE:        video_layers_set_muted(layers, true); break;
+            case ACTION_UNMUTE:      video_layers_set_muted(layers, false); break;
+            case ACTION_AUDIO_MUTE:  video_layers_set_base_path_shared(layers, false); break;
+            case ACTION_AUDIO_UNMUTE: video_layers_set_base_path_shared(layers, true); break;
+        }
+        check_step(test, layers, paths[0], step);
+    }
+    video_layers_destroy(layers);
+}
+
+static void test_single_layer(void)
+{
+    // Video only on path 0, which is stopped while no quality is subscribed.
+    const step_t initial = { "initial", .paths = { ON }, .path = 0, .send = true };
+    const step_t steps[] = {
+        { "low",    true,  false, false, { ON  },  0, true,  ACTION_UPDATE },
+        { "none",   false, false, false, { OFF }, -1, false, ACTION_UPDATE },
+        { "high",   false, false, true,  { ON  },  0, true,  ACTION_UPDATE },
+        { "none",   false, false, false, { OFF }, -1, false, ACTION_UPDATE },
+        { "reset",  .paths = { ON }, .path = 0, .send = true, .action = ACTION_RESET },
+    };
+    run("single_layer", false, &initial, steps, sizeof(steps) / sizeof(steps[0]));
+}
+
+static void test_single_layer_shared(void)
+{
+    // Path 0 also captures audio, so it keeps running; video frames are dropped.
+    const step_t initial = { "initial", .paths = { ON }, .path = 0, .send = true };
+    const step_t steps[] = {
+        { "none",   false, false, false, { ON },  0, false, ACTION_UPDATE },
+        { "medium", false, true,  false, { ON },  0, true,  ACTION_UPDATE },
+    };
+    run("single_layer_shared", true, &initial, steps, sizeof(steps) / sizeof(steps[0]));
+}
+
+static void test_muted(void)
+{
+    // Muting pauses video whatever is requested; unmuting resumes it if a quality
+    // was requested meanwhile. A new session does not unmute.
+    const step_t initial = { "initial", .paths = { ON }, .path = 0, .send = true };
+    const step_t steps[] = {
+        { "mute",     .paths = { OFF }, .path = -1, .action = ACTION_MUTE },
+        { "low",      true,  false, false, { OFF }, -1, false, ACTION_UPDATE },
+        { "reset",    .paths = { OFF }, .path = -1, .action = ACTION_RESET },
+        { "medium",   false, true,  false, { OFF }, -1, false, ACTION_UPDATE },
+        { "unmute",   .paths = { ON  }, .path = 0, .send = true, .action = ACTION_UNMUTE },
+        { "none",     false, false, false, { OFF }, -1, false, ACTION_UPDATE },
+        { "mute",     .paths = { OFF }, .path = -1, .action = ACTION_MUTE },
+        { "unmute",   .paths = { OFF }, .path = -1, .action = ACTION_UNMUTE },
+        { "high",     false, false, true,  { ON  },  0, true,  ACTION_UPDATE },
+    };
+    run("muted", false, &initial, steps, sizeof(steps) / sizeof(steps[0]));
+}
+
+static void test_muted_shared(void)
+{
+    // Path 0 captures audio and the only video layer; it stops only while both
+    // are muted.
+    const step_t initial = { "initial", .paths = { ON }, .path = 0, .send = true };
+    const step_t steps[] = {
+        { "audio mute",   .paths = { ON  }, .path = 0, .send = true, .action = ACTION_AUDIO_MUTE },
+        { "mute",         .paths = { OFF }, .path = -1, .action = ACTION_MUTE },
+        { "audio unmute", .paths = { ON  }, .path = 0, .send = false, .action = ACTION_AUDIO_UNMUTE },
+        { "unmute",       .paths = { ON  }, .path = 0, .send = true, .action = ACTION_UNMUTE },
+        { "none",         false, false, false, { ON },  0, false, ACTION_UPDATE },
+        { "audio mute",   .paths = { OFF }, .path = -1, .action = ACTION_AUDIO_MUTE },
+        { "low",          true,  false, false, { ON },  0, true,  ACTION_UPDATE },
+    };
+    run("muted_shared", true, &initial, steps, sizeof(steps) / sizeof(steps[0]));
+}
+
+static void test_empty_update(void)
+{
+    // An update without codecs means no subscriber wants the track.
+    esp_capture_sink_handle_t paths[ESP_CAPTURE_FAKE_MAX_PATHS];
+    video_layers_handle_t layers = create("empty_update", false, paths);
+    if (layers == NULL) {
+        return;
+    }
+    livekit_pb_subscribed_quality_update_t update = {};
+    video_layers_handle_update(layers, &update);
+    const step_t paused = { "empty", .paths = { OFF }, .path = -1 };
+    check_step("empty_update", layers, paths[0], &paused);
+    video_layers_destroy(layers);
+}
+
+int main(void)
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    test_single_layer();
+    test_single_layer_shared();
+    test_muted();
+    test_muted_shared();
+    test_empty_update();
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All video layer tests passed\n");
+    return EXIT_SUCCESS;
+}
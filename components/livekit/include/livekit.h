@@ -22,6 +22,7 @@
 
 #include "livekit_types.h"
 #include "livekit_rpc.h"
+#include "livekit_data_stream.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +76,22 @@ typedef struct {
     uint8_t channel_count;        ///< Output number of channels
 } livekit_audio_encode_options_t;
 
+/// Options for gating published audio on voice activity.
+///
+/// While no voice is detected, no audio frames are sent, saving bandwidth and
+/// power; RTCP reports keep the stream alive meanwhile.
+/// Voice is detected on PCM captured on an extra capture path at index 1.
+///
+typedef struct {
+    /// Whether to stop sending audio while no voice is detected.
+    bool enabled;
+    /// Level below which audio is silent in dBFS; 0 uses `CONFIG_LK_VAD_THRESHOLD_DBFS`.
+    int8_t threshold_dbfs;
+    /// How long to keep sending after voice was last detected in milliseconds;
+    /// 0 uses `CONFIG_LK_VAD_HANGOVER_MS`.
+    uint16_t hangover_ms;
+} livekit_audio_vad_options_t;
+
 /// Options for publishing media.
 typedef struct {
     /// Kind of media that can be published.
@@ -88,11 +105,61 @@ typedef struct {
     /// @note Only required if the room publishes audio.
     livekit_audio_encode_options_t audio_encode;
 
+    /// Voice activity gating of published audio.
+    /// @note Only used if the room publishes audio.
+    livekit_audio_vad_options_t audio_vad;
+
+    /// Capture audio from when the room starts connecting and send it to the first
+    /// agent to become active, so speech before the connection is established is
+    /// not lost.
+    ///
+    /// Up to `CONFIG_LK_PRE_CONNECT_BUFFER_MS` of PCM is kept, on the same extra capture
+    /// path as @ref livekit_audio_vad_options_t, and sent as a byte stream on the
+    /// topic agents expect. It is discarded if no agent becomes active within
+    /// `CONFIG_LK_PRE_CONNECT_TIMEOUT_MS`.
+    ///
+    /// The PCM is buffered uncompressed in a single heap allocation made when the
+    /// room starts connecting and held until it is sent: sample rate × channels ×
+    /// 2 bytes per second (64 KB for 2 s at 16 kHz mono), capped at
+    /// `CONFIG_LK_PRE_CONNECT_BUFFER_SIZE` bytes, which shortens the audio kept at
+    /// higher sample rates or with stereo.
+    ///
+    /// @note Only used if the room publishes audio.
+    ///
+    bool pre_connect_audio;
+
     /// Capturer to use for obtaining media to publish.
     /// @note Only required if the room publishes media.
     esp_capture_handle_t capturer;
 } livekit_pub_options_t;
 
+/// Participant kind.
+/// @ingroup Info
+typedef enum {
+    /// A regular participant, typically an end-user in your application.
+    LIVEKIT_PARTICIPANT_KIND_STANDARD = 0,
+    /// A server-side process that is ingesting media into the session
+    /// using [LiveKit Ingress](https://docs.livekit.io/home/ingress/overview/).
+    LIVEKIT_PARTICIPANT_KIND_INGRESS = 1,
+    /// A server-side process that is recording the session using
+    /// [LiveKit Egress](https://docs.livekit.io/home/egress/overview/).
+    LIVEKIT_PARTICIPANT_KIND_EGRESS = 2,
+    /// A telephony user connected via [SIP](https://docs.livekit.io/sip/).
+    LIVEKIT_PARTICIPANT_KIND_SIP = 3,
+    /// An agent spawned with the [Agents Framework](https://docs.livekit.io/agents/).
+    LIVEKIT_PARTICIPANT_KIND_AGENT = 4
+} livekit_participant_kind_t;
+
+/// Which remote participants' audio tracks to subscribe to.
+typedef enum {
+    /// Audio tracks of any participant.
+    LIVEKIT_SUB_AUDIO_POLICY_ALL = 0,
+    /// Audio tracks of participants of a given kind (e.g., agents).
+    LIVEKIT_SUB_AUDIO_POLICY_KIND = 1,
+    /// Audio tracks of participants whose identity is in an allow-list.
+    LIVEKIT_SUB_AUDIO_POLICY_IDENTITY = 2
+} livekit_sub_audio_policy_t;
+
 /// Options for subscribing to media.
 typedef struct {
     /// Kind of media that can be subscribed to.
@@ -101,6 +168,33 @@ typedef struct {
     /// Renderer to use for subscribed media tracks.
     /// @note Only required if the room subscribes to media.
     av_render_handle_t renderer;
+
+    /// Which remote participants' audio tracks to subscribe to.
+    ///
+    /// Only one remote audio track can be played back, so one track is
+    /// subscribed to at a time: the first one published, until it ends.
+    ///
+    livekit_sub_audio_policy_t audio_policy;
+
+    /// Switch the audio subscription to the loudest active speaker.
+    ///
+    /// Only the loudest speaker is followed, since one track is subscribed to at a
+    /// time. When a participant selected by the policy starts speaking, their track
+    /// replaces the subscribed one once its participant has been silent for at
+    /// least `CONFIG_LK_SPEAKER_HOLD_MS`; if several are speaking, the loudest is
+    /// chosen.
+    ///
+    bool audio_follow_speakers;
+
+    /// Participant kind to subscribe to with @ref LIVEKIT_SUB_AUDIO_POLICY_KIND.
+    livekit_participant_kind_t audio_participant_kind;
+
+    /// Identities to subscribe to with @ref LIVEKIT_SUB_AUDIO_POLICY_IDENTITY.
+    /// @note The list must remain valid for the lifetime of the room.
+    const char* const* audio_identities;
+
+    /// Number of entries in `audio_identities`.
+    size_t audio_identity_count;
 } livekit_sub_options_t;
 
 /// Payload containing a pointer to data and its size.
@@ -139,23 +233,6 @@ typedef struct {
     bool active_recording;
 } livekit_room_info_t;
 
-/// Participant kind.
-/// @ingroup Info
-typedef enum {
-    /// A regular participant, typically an end-user in your application.
-    LIVEKIT_PARTICIPANT_KIND_STANDARD = 0,
-    /// A server-side process that is ingesting media into the session
-    /// using [LiveKit Ingress](https://docs.livekit.io/home/ingress/overview/).
-    LIVEKIT_PARTICIPANT_KIND_INGRESS = 1,
-    /// A server-side process that is recording the session using
-    /// [LiveKit Egress](https://docs.livekit.io/home/egress/overview/).
-    LIVEKIT_PARTICIPANT_KIND_EGRESS = 2,
-    /// A telephony user connected via [SIP](https://docs.livekit.io/sip/).
-    LIVEKIT_PARTICIPANT_KIND_SIP = 3,
-    /// An agent spawned with the [Agents Framework](https://docs.livekit.io/agents/).
-    LIVEKIT_PARTICIPANT_KIND_AGENT = 4
-} livekit_participant_kind_t;
-
 /// Participant state.
 /// @ingroup Info
 typedef enum {
@@ -214,6 +291,22 @@ typedef struct {
     /// @see DataPackets
     void (*on_data_received)(const livekit_data_received_t* data, void* ctx);
 
+    /// Handler for when a received reliable data packet is dropped because
+    /// handlers fell behind; see `drop_reliable_on_overflow`.
+    /// @note Invoked on the thread receiving data, so it must return quickly.
+    /// @see DataPackets
+    void (*on_data_dropped)(void* ctx);
+
+    /// Drop received reliable data packets once `CONFIG_LK_DATA_QUEUE_SIZE`
+    /// packets are waiting for handlers, reporting each through `on_data_dropped`.
+    ///
+    /// By default, reliable packets are never dropped: those arriving while the
+    /// queue is full are held on the heap, in order, until handlers catch up.
+    /// Set this to bound memory use when handlers may fall behind for long.
+    /// Lossy packets are dropped once the queue is nearly full either way.
+    ///
+    bool drop_reliable_on_overflow;
+
     /// Handler for when room information is received.
     /// @see Info
     void (*on_room_info)(const livekit_room_info_t* info, void* ctx);
@@ -222,6 +315,10 @@ typedef struct {
     /// @see Info
     void (*on_participant_info)(const livekit_participant_info_t* info, void* ctx);
 
+    /// Handler for when voice activity in published audio starts or stops.
+    /// @note Only invoked if @ref livekit_audio_vad_options_t::enabled is set.
+    void (*on_speaking_changed)(bool is_speaking, void* ctx);
+
     /// User context passed to all handlers.
     void* ctx;
 } livekit_room_options_t;
@@ -331,6 +428,54 @@ livekit_failure_reason_t livekit_room_get_failure_reason(livekit_room_handle_t h
 ///
 const char* livekit_failure_reason_str(livekit_failure_reason_t reason);
 
+/// Gets the timeline of the most recent connection attempt.
+///
+/// Use this to find out how long each phase of joining a room took, for example by
+/// reporting the timeline once the room's state changes to
+/// `LIVEKIT_CONNECTION_STATE_CONNECTED` and again after the first audio frames.
+///
+/// @param handle[in] Room handle.
+/// @param out_timeline[out] Timeline of the attempt.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_get_connect_timeline(livekit_room_handle_t handle, livekit_connect_timeline_t *out_timeline);
+
+/// Gets a string representation of a connection phase.
+///
+/// @param phase[in] Connection phase.
+/// @return String representation of the connection phase.
+///
+const char* livekit_connect_phase_str(livekit_connect_phase_t phase);
+
+/// Gets counters describing how a room is doing.
+///
+/// Counters are updated without locking, so counting never holds back media or
+/// data. Reading them only briefly locks the data and signal queues, so this is
+/// cheap enough to poll frequently (e.g., to report degraded devices remotely).
+///
+/// @param handle[in] Room handle.
+/// @param out_stats[out] Room statistics.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_get_stats(livekit_room_handle_t handle, livekit_room_stats_t *out_stats);
+
+/// Mutes or unmutes published tracks.
+///
+/// While a track is muted, remote participants see it as muted and its capture path
+/// is disabled, so the encoder stops running; a path that also captures the other,
+/// unmuted track keeps running, but the muted track's frames are not sent. Unmuting
+/// resumes sending with the next captured frame.
+///
+/// Tracks can be muted before connecting, in which case they are published muted.
+/// The mute state is kept when the room reconnects.
+///
+/// @param handle[in] Room handle.
+/// @param kind[in] Kind of tracks to mute or unmute; must be published by the room.
+/// @param muted[in] Whether to mute (true) or unmute (false).
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_set_track_muted(livekit_room_handle_t handle, livekit_media_kind_t kind, bool muted);
+
 /// @}
 
 /// @defgroup Info Room & Participant Info
@@ -398,6 +543,11 @@ typedef struct {
 
 /// Publishes a data packet to participants in a room asynchronously.
 ///
+/// Reliable packets published while the room is reconnecting are held, up to
+/// `CONFIG_LK_RELIABLE_BUFFER_SIZE` bytes, and sent once reconnected; packets
+/// dropped when the buffer is full are counted in @ref livekit_room_stats_t.
+/// Publishing fails while the room is not connected or reconnecting.
+///
 /// @param handle[in] Room handle.
 /// @param options[in] Data to send with options (e.g. reliability, topic, etc.).
 /// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
@@ -423,6 +573,75 @@ livekit_err_t livekit_room_publish_data(livekit_room_handle_t handle, livekit_da
 
 /// @}
 
+/// @defgroup DataStreams Data Streams
+///
+/// Send and receive content of any size, such as files or logs, in chunks
+/// over the reliable data channel.
+///
+/// - **Sending**: open a stream with @ref livekit_room_data_stream_open, write
+///                to it with @ref livekit_data_stream_write, then close it with
+///                @ref livekit_data_stream_close.
+/// - **Receiving**: register a handler for a topic with
+///                  @ref livekit_room_data_stream_register.
+///
+/// For more information about this feature, see the
+/// [LiveKit documentation](https://docs.livekit.io/home/client/data/byte-streams/).
+/// @{
+
+/// Registers a handler for incoming data streams on a topic.
+///
+/// @param handle[in] Room handle.
+/// @param topic[in] Topic to receive streams for.
+/// @param handler[in] Handler to deliver streams to; copied.
+/// @exception If a handler for the topic is already registered, an error is returned.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_data_stream_register(livekit_room_handle_t handle, const char* topic, const livekit_data_stream_handler_t* handler);
+
+/// Unregisters the handler for a topic.
+///
+/// Streams that have already begun continue to be delivered.
+///
+/// @param handle[in] Room handle.
+/// @param topic[in] Topic to unregister.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_data_stream_unregister(livekit_room_handle_t handle, const char* topic);
+
+/// Opens a data stream to send to participants in the room.
+///
+/// @param handle[in] Room handle.
+/// @param options[in] Stream options.
+/// @param out_writer[out] Writer for the stream's content.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_data_stream_open(livekit_room_handle_t handle, const livekit_data_stream_options_t* options, livekit_data_stream_writer_handle_t* out_writer);
+
+/// Writes content to a data stream.
+///
+/// Content is sent in chunks as it is written. If the data channel has too much
+/// queued, this blocks until it drains, or fails once the room is closed.
+///
+/// @param writer[in] Stream writer.
+/// @param data[in] Content to write.
+/// @param size[in] Number of bytes to write.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_data_stream_write(livekit_data_stream_writer_handle_t writer, const uint8_t* data, size_t size);
+
+/// Closes a data stream, sending any remaining content.
+///
+/// The writer is freed, even if an error is returned.
+///
+/// @param writer[in] Stream writer.
+/// @param reason[in] Short reason the stream ended early (e.g. "error"), or NULL
+///                   if the content is complete.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_data_stream_close(livekit_data_stream_writer_handle_t writer, const char* reason);
+
+/// @}
+
 /// @defgroup RPC Remote Method Calls (RPC)
 ///
 /// Use RPC to execute custom methods on other participants in the room and
@@ -444,6 +663,17 @@ livekit_err_t livekit_room_publish_data(livekit_room_handle_t handle, livekit_da
 ///
 livekit_err_t livekit_room_rpc_register(livekit_room_handle_t handle, const char* method, livekit_rpc_handler_t handler);
 
+/// Registers a handler for an RPC method with options.
+///
+/// @param handle[in] Room handle.
+/// @param method[in] Name of the method to register.
+/// @param handler[in] Handler function to call when the method is invoked by a remote participant.
+/// @param options[in] Handler options.
+/// @exception If a handler for the method is already registered, an error is returned.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_rpc_register_with_options(livekit_room_handle_t handle, const char* method, livekit_rpc_handler_t handler, const livekit_rpc_handler_options_t* options);
+
 /// Unregisters a handler for an RPC method.
 ///
 /// @param handle[in] Room handle.
@@ -452,6 +682,34 @@ livekit_err_t livekit_room_rpc_register(livekit_room_handle_t handle, const char
 ///
 livekit_err_t livekit_room_rpc_unregister(livekit_room_handle_t handle, const char* method);
 
+/// Gets statistics for an RPC method.
+///
+/// Statistics are kept for any method that has been registered, including after
+/// it is unregistered.
+///
+/// @param handle[in] Room handle.
+/// @param method[in] Name of the method.
+/// @param out_stats[out] Statistics for the method.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_rpc_get_method_stats(livekit_room_handle_t handle, const char* method, livekit_rpc_method_stats_t* out_stats);
+
+/// Invokes an RPC method on a remote participant.
+///
+/// The result is delivered to the room's `on_rpc_result` handler with the
+/// same invocation identifier. If the recipient does not acknowledge or respond
+/// in time, the handler is invoked with @ref LIVEKIT_RPC_RESULT_CONNECTION_TIMEOUT
+/// or @ref LIVEKIT_RPC_RESULT_RESPONSE_TIMEOUT respectively.
+///
+/// @param handle[in] Room handle.
+/// @param options[in] Invocation options.
+/// @param out_id[out] Buffer of at least @ref LIVEKIT_RPC_ID_SIZE bytes to receive
+///                    the invocation identifier, or NULL.
+/// @note The result handler may be invoked from an internal timer task.
+/// @return @ref LIVEKIT_ERR_NONE if successful, otherwise an error code.
+///
+livekit_err_t livekit_room_rpc_invoke(livekit_room_handle_t handle, const livekit_rpc_invoke_options_t* options, char* out_id);
+
 /// @}
 
 #ifdef __cplusplus
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2025 LiveKit, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Size of a data stream identifier, including the NULL terminator.
+/// @ingroup DataStreams
+#define LIVEKIT_DATA_STREAM_ID_SIZE 37
+
+/// Kind of content carried by a data stream.
+/// @ingroup DataStreams
+typedef enum {
+    /// Arbitrary bytes, such as a file.
+    LIVEKIT_DATA_STREAM_KIND_BYTE = 0,
+
+    /// UTF-8 text.
+    LIVEKIT_DATA_STREAM_KIND_TEXT = 1
+} livekit_data_stream_kind_t;
+
+/// Reason an incoming data stream ended.
+/// @ingroup DataStreams
+typedef enum {
+    /// All content was received.
+    LIVEKIT_DATA_STREAM_CLOSE_REASON_COMPLETE = 0,
+
+    /// The sender ended the stream early, the stream was abandoned, or the room was closed.
+    LIVEKIT_DATA_STREAM_CLOSE_REASON_INTERRUPTED = 1,
+
+    /// Content was lost: a chunk is missing or the length does not match the header.
+    LIVEKIT_DATA_STREAM_CLOSE_REASON_INCOMPLETE = 2,
+
+    /// The handler rejected a chunk.
+    LIVEKIT_DATA_STREAM_CLOSE_REASON_REJECTED = 3
+} livekit_data_stream_close_reason_t;
+
+/// Information about an incoming data stream.
+/// @ingroup DataStreams
+typedef struct {
+    /// Stream identifier.
+    char* id;
+
+    /// Topic the stream was sent under.
+    char* topic;
+
+    /// MIME type of the content.
+    char* mime_type;
+
+    /// File name for byte streams if provided by the sender, otherwise NULL.
+    char* name;
+
+    /// Identity of the participant who sent the stream.
+    char* sender_identity;
+
+    /// Kind of content.
+    livekit_data_stream_kind_t kind;
+
+    /// Whether the sender specified the total length.
+    bool has_total_length;
+
+    /// Total length of the content in bytes, if specified.
+    uint64_t total_length;
+} livekit_data_stream_info_t;
+
+/// Receives incoming data streams on a topic as they arrive.
+///
+/// Content is passed to the handler chunk by chunk and is never assembled in memory
+/// by the SDK. All callbacks for a stream are invoked from the same task.
+///
+/// @ingroup DataStreams
+typedef struct {
+    /// Invoked when a stream begins.
+    ///
+    /// Return false to ignore the stream. Otherwise, `stream_ctx` may be set to a
+    /// value passed to the other callbacks for this stream.
+    ///
+    bool (*on_open)(const livekit_data_stream_info_t* info, void** stream_ctx, void* ctx);
+
+    /// Invoked with the next chunk of content, in order.
+    ///
+    /// Return false to stop receiving the stream; `on_close` is then invoked with
+    /// @ref LIVEKIT_DATA_STREAM_CLOSE_REASON_REJECTED.
+    ///
+    bool (*on_chunk)(const uint8_t* data, size_t size, void* stream_ctx);
+
+    /// Invoked once when the stream ends.
+    void (*on_close)(livekit_data_stream_close_reason_t reason, void* stream_ctx);
+
+    /// Context passed to `on_open`.
+    void* ctx;
+} livekit_data_stream_handler_t;
+
+/// Attribute sent in a data stream's header.
+/// @ingroup DataStreams
+typedef struct {
+    char* key;
+    char* value;
+} livekit_data_stream_attribute_t;
+
+/// Options for sending a data stream.
+/// @ingroup DataStreams
+typedef struct {
+    /// Topic to send the stream under.
+    char* topic;
+
+    /// Kind of content.
+    livekit_data_stream_kind_t kind;
+
+    /// MIME type of the content. If NULL, "application/octet-stream" is used
+    /// for byte streams and "text/plain" for text streams.
+    char* mime_type;
+
+    /// File name for byte streams, or NULL.
+    char* name;
+
+    /// Total length of the content in bytes, or zero if unknown.
+    uint64_t total_length;
+
+    /// Identities of participants to send the stream to. If not specified, the
+    /// stream is sent to all participants.
+    char** destination_identities;
+
+    /// Number of destination identities.
+    int destination_identities_count;
+
+    /// Attributes describing the content to the receiver, or NULL.
+    livekit_data_stream_attribute_t* attributes;
+
+    /// Number of attributes.
+    int attributes_count;
+} livekit_data_stream_options_t;
+
+/// Handle to an outgoing data stream.
+/// @ingroup DataStreams
+typedef void *livekit_data_stream_writer_handle_t;
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
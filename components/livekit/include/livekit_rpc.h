@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +27,10 @@ extern "C" {
 /// @ingroup RPC
 #define LIVEKIT_RPC_MAX_PAYLOAD_BYTES 15360 // 15 KB
 
+/// Size of an RPC invocation identifier, including the NULL terminator.
+/// @ingroup RPC
+#define LIVEKIT_RPC_ID_SIZE 37
+
 /// Built-in RPC error codes.
 typedef enum {
     /// The RPC method returned normally.
@@ -100,12 +105,77 @@ typedef struct {
     char* payload;
 
     /// Sends the result of the invocation to the caller.
+    ///
+    /// Must be called exactly once per invocation. It may be called from any task,
+    /// including after the handler returns; the invocation remains valid until
+    /// its result is sent.
+    ///
+    /// @warning Must not be called once @ref livekit_room_destroy has been called
+    ///          for the room; results not sent by then are dropped.
+    ///
     bool (*send_result)(const livekit_rpc_result_t* res, void* ctx);
 
     /// Context for the callback.
     void *ctx;
 } livekit_rpc_invocation_t;
 
+/// Options for invoking an RPC method on a remote participant.
+typedef struct {
+    /// Identity of the participant to invoke the method on.
+    char* destination_identity;
+
+    /// The name of the method to invoke.
+    char* method;
+
+    /// Payload to send to the recipient or NULL.
+    char* payload;
+
+    /// Maximum time to wait for a response in milliseconds, including the time
+    /// for the recipient to acknowledge the invocation.
+    ///
+    /// If zero, the default of 15 seconds is used. Values below 8 seconds are
+    /// raised to 8 seconds.
+    ///
+    uint32_t response_timeout_ms;
+} livekit_rpc_invoke_options_t;
+
+/// Options for an RPC method handler.
+/// @ingroup RPC
+typedef struct {
+    /// Maximum number of invocations awaiting a result at once, or zero for no limit.
+    ///
+    /// Invocations beyond the limit are rejected with @ref LIVEKIT_RPC_RESULT_APPLICATION.
+    ///
+    uint32_t max_concurrent;
+} livekit_rpc_handler_options_t;
+
+/// Number of buckets in @ref livekit_rpc_method_stats_t::latency_histogram.
+/// @ingroup RPC
+#define LIVEKIT_RPC_LATENCY_BUCKET_COUNT 16
+
+/// Statistics for a registered RPC method.
+/// @ingroup RPC
+typedef struct {
+    /// Invocations passed to the handler.
+    uint32_t invocations;
+
+    /// Invocations rejected because too many were in flight.
+    uint32_t rejected;
+
+    /// Invocations awaiting a result.
+    uint32_t in_flight;
+
+    /// Longest time from receiving an invocation to sending its result.
+    uint32_t max_latency_ms;
+
+    /// Distribution of the time from receiving an invocation to sending its result.
+    ///
+    /// Bucket 0 counts results sent in under 1 ms; bucket `n` counts those sent in
+    /// [2^(n-1), 2^n) ms. The last bucket also counts anything slower.
+    ///
+    uint32_t latency_histogram[LIVEKIT_RPC_LATENCY_BUCKET_COUNT];
+} livekit_rpc_method_stats_t;
+
 /// Handler for an RPC invocation.
 /// @ingroup RPC
 typedef void (*livekit_rpc_handler_t)(const livekit_rpc_invocation_t* invocation, void* ctx);
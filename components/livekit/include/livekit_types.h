@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -197,6 +200,162 @@ typedef enum {
     LIVEKIT_FAILURE_REASON_OTHER
 } livekit_failure_reason_t;
 
+/// Phase of a connection attempt.
+/// @ingroup Connection
+typedef enum {
+    /// Signal URL built and WebSocket connection started.
+    LIVEKIT_CONNECT_PHASE_URL_BUILT,
+
+    /// WebSocket connection established.
+    LIVEKIT_CONNECT_PHASE_SIGNAL_CONNECTED,
+
+    /// Join response received.
+    LIVEKIT_CONNECT_PHASE_JOIN_RECEIVED,
+
+    /// Publisher and subscriber peer connections created.
+    LIVEKIT_CONNECT_PHASE_PEERS_CREATED,
+
+    /// Publisher offer sent.
+    LIVEKIT_CONNECT_PHASE_OFFER_SENT,
+
+    /// Answer to the publisher offer received.
+    LIVEKIT_CONNECT_PHASE_ANSWER_RECEIVED,
+
+    /// First ICE candidate received from the server.
+    LIVEKIT_CONNECT_PHASE_FIRST_CANDIDATE,
+
+    /// ICE connectivity established on the primary peer connection.
+    LIVEKIT_CONNECT_PHASE_ICE_CONNECTED,
+
+    /// DTLS handshake completed on the primary peer connection.
+    LIVEKIT_CONNECT_PHASE_DTLS_CONNECTED,
+
+    /// Reliable and lossy data channels both open.
+    LIVEKIT_CONNECT_PHASE_DATA_CHANNELS_OPEN,
+
+    /// First audio frame sent.
+    LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_SENT,
+
+    /// First audio frame received.
+    LIVEKIT_CONNECT_PHASE_FIRST_AUDIO_RECEIVED,
+
+    /// Number of phases.
+    LIVEKIT_CONNECT_PHASE_MAX
+} livekit_connect_phase_t;
+
+/// Timeline of the most recent connection attempt.
+///
+/// Each phase is recorded the first time it is reached during the attempt. Phases
+/// that have not been reached yet are -1.
+///
+/// @ingroup Connection
+typedef struct {
+    /// Number of the attempt since connecting, starting at 1 and counting each
+    /// retry.
+    uint32_t attempt;
+
+    /// Monotonic time the attempt started in microseconds (`esp_timer_get_time`).
+    int64_t start_us;
+
+    /// Time each phase was reached in microseconds since `start_us`, or -1,
+    /// indexed by @ref livekit_connect_phase_t.
+    int64_t phase_us[LIVEKIT_CONNECT_PHASE_MAX];
+} livekit_connect_timeline_t;
+
+/// Counters describing how a room is doing, for monitoring.
+///
+/// Counters accumulate from when the room is created and are not reset when
+/// reconnecting.
+///
+/// @ingroup Connection
+typedef struct {
+    /// Round-trip time to the server measured by the last signal ping in
+    /// milliseconds, or 0 if none has been measured.
+    uint32_t signal_rtt_ms;
+    /// Highest number of signal requests waiting to be sent at once.
+    uint32_t signal_queue_high_water;
+    /// Number of signal requests dropped because the send queue was full.
+    uint32_t signal_requests_dropped;
+    /// Number of signal requests that failed to send (e.g., while disconnected).
+    uint32_t signal_requests_failed;
+    /// Longest time from queueing a signal request to sending it in microseconds.
+    uint32_t signal_send_latency_max_us;
+    /// Mean time from queueing a signal request to sending it in microseconds.
+    uint32_t signal_send_latency_mean_us;
+
+    /// Number of audio frames sent.
+    uint32_t audio_frames_sent;
+    /// Number of audio frames not sent because no voice was detected.
+    uint32_t audio_frames_suppressed;
+    /// Bytes of audio sent.
+    uint64_t audio_bytes_sent;
+    /// Number of audio frames received.
+    uint32_t audio_frames_received;
+    /// Bytes of audio received.
+    uint64_t audio_bytes_received;
+    /// Latency between capture and send of the most recent audio frame sent in
+    /// milliseconds, since the last connection.
+    uint32_t audio_send_latency_ms;
+    /// Highest latency between capture and send of an audio frame in
+    /// milliseconds, since the last connection.
+    uint32_t audio_send_latency_max_ms;
+    /// Mean latency between capture and send of audio frames in milliseconds,
+    /// since the last connection.
+    uint32_t audio_send_latency_mean_ms;
+
+    /// Number of video frames sent.
+    uint32_t video_frames_sent;
+    /// Bytes of video sent.
+    uint64_t video_bytes_sent;
+    /// Number of video frames received.
+    uint32_t video_frames_received;
+    /// Bytes of video received.
+    uint64_t video_bytes_received;
+
+    /// Number of captured audio or video frames that failed to send.
+    uint32_t capture_send_failures;
+    /// Number of received audio frames the renderer failed to accept.
+    uint32_t render_failures;
+
+    /// Number of data packets sent on the reliable channel.
+    uint32_t reliable_packets_sent;
+    /// Number of data packets received on the reliable channel.
+    uint32_t reliable_packets_received;
+    /// Number of data packets sent on the lossy channel.
+    uint32_t lossy_packets_sent;
+    /// Number of data packets received on the lossy channel.
+    uint32_t lossy_packets_received;
+    /// Number of reliable data packets dropped because the buffer holding them
+    /// while reconnecting was full.
+    uint32_t reliable_packets_dropped;
+    /// Highest number of bytes of reliable data packets buffered at once, out of
+    /// `CONFIG_LK_RELIABLE_BUFFER_SIZE`.
+    uint32_t reliable_buffer_high_water;
+    /// Number of received lossy data packets dropped because handlers fell behind.
+    uint32_t received_lossy_dropped;
+    /// Number of received reliable data packets dropped because handlers fell
+    /// behind; only with `drop_reliable_on_overflow` or if out of memory.
+    uint32_t received_reliable_dropped;
+    /// Highest number of received data packets waiting for handlers at once, out
+    /// of `CONFIG_LK_DATA_QUEUE_SIZE`.
+    uint32_t data_queue_high_water;
+    /// Highest number of received reliable data packets held beyond
+    /// `CONFIG_LK_DATA_QUEUE_SIZE` at once while handlers fell behind.
+    uint32_t data_overflow_high_water;
+    /// Longest time spent handling a received data packet in microseconds.
+    uint32_t data_handler_max_us;
+    /// Mean time spent handling a received data packet in microseconds.
+    uint32_t data_handler_mean_us;
+
+    /// Highest number of engine events queued at once, out of
+    /// `CONFIG_LK_ENGINE_QUEUE_SIZE`.
+    uint32_t engine_queue_high_water;
+
+    /// Number of attempts to reconnect after the connection was lost
+    /// or failed to establish.
+    uint32_t reconnects;
+} livekit_room_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -290,7 +290,7 @@ typedef struct livekit_pb_active_speaker_update {
 } livekit_pb_active_speaker_update_t;
 
 typedef struct livekit_pb_speaker_info {
-    pb_callback_t sid;
+    char sid[16];
     /* audio level, 0-1.0, 1 is loudest */
     float level;
     /* true if speaker is currently active */
@@ -361,6 +361,55 @@ typedef struct livekit_pb_rpc_response {
     } value;
 } livekit_pb_rpc_response_t;
 
+/* header properties specific to text streams */
+typedef struct livekit_pb_data_stream_text_header {
+    livekit_pb_data_stream_operation_type_t operation_type;
+    int32_t version; /* Optional: Version for updates/edits */
+    pb_callback_t reply_to_stream_id; /* Optional: Reply to specific message */
+    pb_callback_t attached_stream_ids; /* file attachments for text streams */
+    bool generated; /* true if the text has been generated by an agent from a participant's audio transcription */
+} livekit_pb_data_stream_text_header_t;
+
+/* header properties specific to byte or file streams */
+typedef struct livekit_pb_data_stream_byte_header {
+    char *name;
+} livekit_pb_data_stream_byte_header_t;
+
+/* main DataStream.Header that contains a oneof for specific headers */
+typedef struct livekit_pb_data_stream_header {
+    char stream_id[37]; /* unique identifier for this data stream */
+    int64_t timestamp; /* using int64 for Unix timestamp */
+    char *topic;
+    char *mime_type;
+    bool has_total_length;
+    uint64_t total_length; /* only populated for finite streams, if it's a stream of unknown size this stays empty */
+    /* user defined attributes map that can carry additional info */
+    pb_size_t attributes_count;
+    struct livekit_pb_data_stream_header_attributes_entry *attributes;
+    pb_size_t which_content_header;
+    union {
+        livekit_pb_data_stream_text_header_t text_header;
+        livekit_pb_data_stream_byte_header_t byte_header;
+    } content_header;
+} livekit_pb_data_stream_header_t;
+
+typedef struct livekit_pb_data_stream_header_attributes_entry {
+    char *key;
+    char *value;
+} livekit_pb_data_stream_header_attributes_entry_t;
+
+typedef struct livekit_pb_data_stream_chunk {
+    char stream_id[37]; /* unique identifier for this data stream to map it to the correct header */
+    uint64_t chunk_index;
+    pb_bytes_array_t *content; /* content as binary (bytes) */
+    int32_t version; /* a version indicating that this chunk_index has been retroactively modified and the original one needs to be replaced */
+} livekit_pb_data_stream_chunk_t;
+
+typedef struct livekit_pb_data_stream_trailer {
+    char stream_id[37]; /* unique identifier for this data stream */
+    char reason[16]; /* reason why the stream was closed (could contain "error" / "interrupted" / empty for expected end) */
+} livekit_pb_data_stream_trailer_t;
+
 /* new DataPacket API */
 typedef struct livekit_pb_data_packet {
     pb_size_t which_value;
@@ -369,6 +418,9 @@ typedef struct livekit_pb_data_packet {
         livekit_pb_rpc_request_t rpc_request;
         livekit_pb_rpc_ack_t rpc_ack;
         livekit_pb_rpc_response_t rpc_response;
+        livekit_pb_data_stream_header_t stream_header;
+        livekit_pb_data_stream_chunk_t stream_chunk;
+        livekit_pb_data_stream_trailer_t stream_trailer;
     } value;
     /* participant identity of user that sent the message */
     char *participant_identity;
@@ -564,47 +616,6 @@ typedef struct livekit_pb_data_stream {
     char dummy_field;
 } livekit_pb_data_stream_t;
 
-/* header properties specific to text streams */
-typedef struct livekit_pb_data_stream_text_header {
-    livekit_pb_data_stream_operation_type_t operation_type;
-    int32_t version; /* Optional: Version for updates/edits */
-    pb_callback_t reply_to_stream_id; /* Optional: Reply to specific message */
-    pb_callback_t attached_stream_ids; /* file attachments for text streams */
-    bool generated; /* true if the text has been generated by an agent from a participant's audio transcription */
-} livekit_pb_data_stream_text_header_t;
-
-/* header properties specific to byte or file streams */
-typedef struct livekit_pb_data_stream_byte_header {
-    pb_callback_t name;
-} livekit_pb_data_stream_byte_header_t;
-
-/* main DataStream.Header that contains a oneof for specific headers */
-typedef struct livekit_pb_data_stream_header {
-    char stream_id[37]; /* unique identifier for this data stream */
-    int64_t timestamp; /* using int64 for Unix timestamp */
-    char *topic;
-    char *mime_type;
-    bool has_total_length;
-    uint64_t total_length; /* only populated for finite streams, if it's a stream of unknown size this stays empty */
-    pb_size_t which_content_header;
-    union {
-        livekit_pb_data_stream_text_header_t text_header;
-        livekit_pb_data_stream_byte_header_t byte_header;
-    } content_header;
-} livekit_pb_data_stream_header_t;
-
-typedef struct livekit_pb_data_stream_chunk {
-    char stream_id[37]; /* unique identifier for this data stream to map it to the correct header */
-    uint64_t chunk_index;
-    pb_bytes_array_t *content; /* content as binary (bytes) */
-    int32_t version; /* a version indicating that this chunk_index has been retroactively modified and the original one needs to be replaced */
-} livekit_pb_data_stream_chunk_t;
-
-typedef struct livekit_pb_data_stream_trailer {
-    char stream_id[37]; /* unique identifier for this data stream */
-    char reason[16]; /* reason why the stream was closed (could contain "error" / "interrupted" / empty for expected end) */
-} livekit_pb_data_stream_trailer_t;
-
 typedef struct livekit_pb_webhook_config {
     pb_callback_t url;
     pb_callback_t signing_key;
@@ -770,7 +781,7 @@ extern "C" {
 #define LIVEKIT_PB_VIDEO_LAYER_INIT_DEFAULT      {_LIVEKIT_PB_VIDEO_QUALITY_MIN, 0, 0}
 #define LIVEKIT_PB_DATA_PACKET_INIT_DEFAULT      {0, {LIVEKIT_PB_USER_PACKET_INIT_DEFAULT}, NULL, 0, NULL, 0, ""}
 #define LIVEKIT_PB_ACTIVE_SPEAKER_UPDATE_INIT_DEFAULT {{{NULL}, NULL}}
-#define LIVEKIT_PB_SPEAKER_INFO_INIT_DEFAULT     {{{NULL}, NULL}, 0, 0}
+#define LIVEKIT_PB_SPEAKER_INFO_INIT_DEFAULT     {"", 0, 0}
 #define LIVEKIT_PB_USER_PACKET_INIT_DEFAULT      {NULL, NULL}
 #define LIVEKIT_PB_SIP_DTMF_INIT_DEFAULT         {0, ""}
 #define LIVEKIT_PB_TRANSCRIPTION_INIT_DEFAULT    {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
@@ -796,8 +807,9 @@ extern "C" {
 #define LIVEKIT_PB_TIMED_VERSION_INIT_DEFAULT    {0, 0}
 #define LIVEKIT_PB_DATA_STREAM_INIT_DEFAULT      {0}
 #define LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_DEFAULT {_LIVEKIT_PB_DATA_STREAM_OPERATION_TYPE_MIN, 0, {{NULL}, NULL}, {{NULL}, NULL}, 0}
-#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_DEFAULT {{{NULL}, NULL}}
-#define LIVEKIT_PB_DATA_STREAM_HEADER_INIT_DEFAULT {"", 0, NULL, NULL, false, 0, 0, {LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_DEFAULT}}
+#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_DEFAULT {NULL}
+#define LIVEKIT_PB_DATA_STREAM_HEADER_INIT_DEFAULT {"", 0, NULL, NULL, false, 0, 0, NULL, 0, {LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_DEFAULT}}
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_DEFAULT {NULL, NULL}
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_INIT_DEFAULT {"", 0, NULL, 0}
 #define LIVEKIT_PB_DATA_STREAM_TRAILER_INIT_DEFAULT {"", ""}
 #define LIVEKIT_PB_WEBHOOK_CONFIG_INIT_DEFAULT   {{{NULL}, NULL}, {{NULL}, NULL}}
@@ -814,7 +826,7 @@ extern "C" {
 #define LIVEKIT_PB_VIDEO_LAYER_INIT_ZERO         {_LIVEKIT_PB_VIDEO_QUALITY_MIN, 0, 0}
 #define LIVEKIT_PB_DATA_PACKET_INIT_ZERO         {0, {LIVEKIT_PB_USER_PACKET_INIT_ZERO}, NULL, 0, NULL, 0, ""}
 #define LIVEKIT_PB_ACTIVE_SPEAKER_UPDATE_INIT_ZERO {{{NULL}, NULL}}
-#define LIVEKIT_PB_SPEAKER_INFO_INIT_ZERO        {{{NULL}, NULL}, 0, 0}
+#define LIVEKIT_PB_SPEAKER_INFO_INIT_ZERO        {"", 0, 0}
 #define LIVEKIT_PB_USER_PACKET_INIT_ZERO         {NULL, NULL}
 #define LIVEKIT_PB_SIP_DTMF_INIT_ZERO            {0, ""}
 #define LIVEKIT_PB_TRANSCRIPTION_INIT_ZERO       {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}}
@@ -840,8 +852,9 @@ extern "C" {
 #define LIVEKIT_PB_TIMED_VERSION_INIT_ZERO       {0, 0}
 #define LIVEKIT_PB_DATA_STREAM_INIT_ZERO         {0}
 #define LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_ZERO {_LIVEKIT_PB_DATA_STREAM_OPERATION_TYPE_MIN, 0, {{NULL}, NULL}, {{NULL}, NULL}, 0}
-#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_ZERO {{{NULL}, NULL}}
-#define LIVEKIT_PB_DATA_STREAM_HEADER_INIT_ZERO  {"", 0, NULL, NULL, false, 0, 0, {LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_ZERO}}
+#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_ZERO {NULL}
+#define LIVEKIT_PB_DATA_STREAM_HEADER_INIT_ZERO  {"", 0, NULL, NULL, false, 0, 0, NULL, 0, {LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_ZERO}}
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_ZERO {NULL, NULL}
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_INIT_ZERO   {"", 0, NULL, 0}
 #define LIVEKIT_PB_DATA_STREAM_TRAILER_INIT_ZERO {"", ""}
 #define LIVEKIT_PB_WEBHOOK_CONFIG_INIT_ZERO      {{{NULL}, NULL}, {{NULL}, NULL}}
@@ -922,6 +935,9 @@ extern "C" {
 #define LIVEKIT_PB_DATA_PACKET_RPC_REQUEST_TAG   10
 #define LIVEKIT_PB_DATA_PACKET_RPC_ACK_TAG       11
 #define LIVEKIT_PB_DATA_PACKET_RPC_RESPONSE_TAG  12
+#define LIVEKIT_PB_DATA_PACKET_STREAM_HEADER_TAG 13
+#define LIVEKIT_PB_DATA_PACKET_STREAM_CHUNK_TAG  14
+#define LIVEKIT_PB_DATA_PACKET_STREAM_TRAILER_TAG 15
 #define LIVEKIT_PB_DATA_PACKET_PARTICIPANT_IDENTITY_TAG 4
 #define LIVEKIT_PB_DATA_PACKET_DESTINATION_IDENTITIES_TAG 5
 #define LIVEKIT_PB_DATA_PACKET_SEQUENCE_TAG      16
@@ -1048,8 +1064,11 @@ extern "C" {
 #define LIVEKIT_PB_DATA_STREAM_HEADER_TOPIC_TAG  3
 #define LIVEKIT_PB_DATA_STREAM_HEADER_MIME_TYPE_TAG 4
 #define LIVEKIT_PB_DATA_STREAM_HEADER_TOTAL_LENGTH_TAG 5
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_TAG 8
 #define LIVEKIT_PB_DATA_STREAM_HEADER_TEXT_HEADER_TAG 9
 #define LIVEKIT_PB_DATA_STREAM_HEADER_BYTE_HEADER_TAG 10
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_KEY_TAG 1
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_VALUE_TAG 2
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_STREAM_ID_TAG 1
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_CHUNK_INDEX_TAG 2
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_CONTENT_TAG 3
@@ -1152,6 +1171,9 @@ X(a, POINTER,  REPEATED, STRING,   destination_identities,   5) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (value,rpc_request,value.rpc_request),  10) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (value,rpc_ack,value.rpc_ack),  11) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (value,rpc_response,value.rpc_response),  12) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (value,stream_header,value.stream_header),  13) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (value,stream_chunk,value.stream_chunk),  14) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (value,stream_trailer,value.stream_trailer),  15) \
 X(a, STATIC,   SINGULAR, UINT32,   sequence,         16) \
 X(a, STATIC,   SINGULAR, STRING,   participant_sid,  17)
 #define LIVEKIT_PB_DATA_PACKET_CALLBACK NULL
@@ -1160,6 +1182,9 @@ X(a, STATIC,   SINGULAR, STRING,   participant_sid,  17)
 #define livekit_pb_data_packet_t_value_rpc_request_MSGTYPE livekit_pb_rpc_request_t
 #define livekit_pb_data_packet_t_value_rpc_ack_MSGTYPE livekit_pb_rpc_ack_t
 #define livekit_pb_data_packet_t_value_rpc_response_MSGTYPE livekit_pb_rpc_response_t
+#define livekit_pb_data_packet_t_value_stream_header_MSGTYPE livekit_pb_data_stream_header_t
+#define livekit_pb_data_packet_t_value_stream_chunk_MSGTYPE livekit_pb_data_stream_chunk_t
+#define livekit_pb_data_packet_t_value_stream_trailer_MSGTYPE livekit_pb_data_stream_trailer_t
 
 #define LIVEKIT_PB_ACTIVE_SPEAKER_UPDATE_FIELDLIST(X, a) \
 X(a, CALLBACK, REPEATED, MESSAGE,  speakers,          1)
@@ -1168,10 +1193,10 @@ X(a, CALLBACK, REPEATED, MESSAGE,  speakers,          1)
 #define livekit_pb_active_speaker_update_t_speakers_MSGTYPE livekit_pb_speaker_info_t
 
 #define LIVEKIT_PB_SPEAKER_INFO_FIELDLIST(X, a) \
-X(a, CALLBACK, SINGULAR, STRING,   sid,               1) \
+X(a, STATIC,   SINGULAR, STRING,   sid,               1) \
 X(a, STATIC,   SINGULAR, FLOAT,    level,             2) \
 X(a, STATIC,   SINGULAR, BOOL,     active,            3)
-#define LIVEKIT_PB_SPEAKER_INFO_CALLBACK pb_default_field_callback
+#define LIVEKIT_PB_SPEAKER_INFO_CALLBACK NULL
 #define LIVEKIT_PB_SPEAKER_INFO_DEFAULT NULL
 
 #define LIVEKIT_PB_USER_PACKET_FIELDLIST(X, a) \
@@ -1442,8 +1467,8 @@ X(a, STATIC,   SINGULAR, BOOL,     generated,         5)
 #define LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_DEFAULT NULL
 
 #define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_FIELDLIST(X, a) \
-X(a, CALLBACK, SINGULAR, STRING,   name,              1)
-#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_CALLBACK pb_default_field_callback
+X(a, POINTER,  SINGULAR, STRING,   name,              1)
+#define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_CALLBACK NULL
 #define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_DEFAULT NULL
 
 #define LIVEKIT_PB_DATA_STREAM_HEADER_FIELDLIST(X, a) \
@@ -1452,13 +1477,21 @@ X(a, STATIC,   SINGULAR, INT64,    timestamp,         2) \
 X(a, POINTER,  SINGULAR, STRING,   topic,             3) \
 X(a, POINTER,  SINGULAR, STRING,   mime_type,         4) \
 X(a, STATIC,   OPTIONAL, UINT64,   total_length,      5) \
+X(a, POINTER,  REPEATED, MESSAGE,  attributes,        8) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (content_header,text_header,content_header.text_header),   9) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (content_header,byte_header,content_header.byte_header),  10)
 #define LIVEKIT_PB_DATA_STREAM_HEADER_CALLBACK NULL
 #define LIVEKIT_PB_DATA_STREAM_HEADER_DEFAULT NULL
+#define livekit_pb_data_stream_header_t_attributes_MSGTYPE livekit_pb_data_stream_header_attributes_entry_t
 #define livekit_pb_data_stream_header_t_content_header_text_header_MSGTYPE livekit_pb_data_stream_text_header_t
 #define livekit_pb_data_stream_header_t_content_header_byte_header_MSGTYPE livekit_pb_data_stream_byte_header_t
 
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_FIELDLIST(X, a) \
+X(a, POINTER,  SINGULAR, STRING,   key,               1) \
+X(a, POINTER,  SINGULAR, STRING,   value,             2)
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_CALLBACK NULL
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_DEFAULT NULL
+
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, STRING,   stream_id,         1) \
 X(a, STATIC,   SINGULAR, UINT64,   chunk_index,       2) \
@@ -1520,6 +1553,7 @@ extern const pb_msgdesc_t livekit_pb_data_stream_t_msg;
 extern const pb_msgdesc_t livekit_pb_data_stream_text_header_t_msg;
 extern const pb_msgdesc_t livekit_pb_data_stream_byte_header_t_msg;
 extern const pb_msgdesc_t livekit_pb_data_stream_header_t_msg;
+extern const pb_msgdesc_t livekit_pb_data_stream_header_attributes_entry_t_msg;
 extern const pb_msgdesc_t livekit_pb_data_stream_chunk_t_msg;
 extern const pb_msgdesc_t livekit_pb_data_stream_trailer_t_msg;
 extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
@@ -1566,6 +1600,7 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 #define LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_FIELDS &livekit_pb_data_stream_text_header_t_msg
 #define LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_FIELDS &livekit_pb_data_stream_byte_header_t_msg
 #define LIVEKIT_PB_DATA_STREAM_HEADER_FIELDS &livekit_pb_data_stream_header_t_msg
+#define LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_FIELDS &livekit_pb_data_stream_header_attributes_entry_t_msg
 #define LIVEKIT_PB_DATA_STREAM_CHUNK_FIELDS &livekit_pb_data_stream_chunk_t_msg
 #define LIVEKIT_PB_DATA_STREAM_TRAILER_FIELDS &livekit_pb_data_stream_trailer_t_msg
 #define LIVEKIT_PB_WEBHOOK_CONFIG_FIELDS &livekit_pb_webhook_config_t_msg
@@ -1580,7 +1615,6 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 /* livekit_pb_TrackInfo_size depends on runtime parameters */
 /* livekit_pb_DataPacket_size depends on runtime parameters */
 /* livekit_pb_ActiveSpeakerUpdate_size depends on runtime parameters */
-/* livekit_pb_SpeakerInfo_size depends on runtime parameters */
 /* livekit_pb_UserPacket_size depends on runtime parameters */
 /* livekit_pb_Transcription_size depends on runtime parameters */
 /* livekit_pb_TranscriptionSegment_size depends on runtime parameters */
@@ -1597,6 +1631,7 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 /* livekit_pb_DataStream_TextHeader_size depends on runtime parameters */
 /* livekit_pb_DataStream_ByteHeader_size depends on runtime parameters */
 /* livekit_pb_DataStream_Header_size depends on runtime parameters */
+/* livekit_pb_DataStream_Header_AttributesEntry_size depends on runtime parameters */
 /* livekit_pb_DataStream_Chunk_size depends on runtime parameters */
 /* livekit_pb_WebhookConfig_size depends on runtime parameters */
 #define LIVEKIT_LIVEKIT_MODELS_PB_H_MAX_SIZE     LIVEKIT_PB_RTP_DRIFT_SIZE
@@ -1612,6 +1647,7 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 #define LIVEKIT_PB_RTP_MUNGER_STATE_SIZE         48
 #define LIVEKIT_PB_RTP_STATS_GAP_HISTOGRAM_ENTRY_SIZE 17
 #define LIVEKIT_PB_SIP_DTMF_SIZE                 9
+#define LIVEKIT_PB_SPEAKER_INFO_SIZE             24
 #define LIVEKIT_PB_TIMED_VERSION_SIZE            22
 #define LIVEKIT_PB_VIDEO_CONFIGURATION_SIZE      2
 #define LIVEKIT_PB_VIDEO_LAYER_SIZE              14
@@ -1790,6 +1826,7 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 #define LIVEKIT_DATA_STREAM_TEXT_HEADER_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_DEFAULT
 #define LIVEKIT_DATA_STREAM_BYTE_HEADER_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_DEFAULT
 #define LIVEKIT_DATA_STREAM_HEADER_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_HEADER_INIT_DEFAULT
+#define LIVEKIT_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_DEFAULT
 #define LIVEKIT_DATA_STREAM_CHUNK_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_CHUNK_INIT_DEFAULT
 #define LIVEKIT_DATA_STREAM_TRAILER_INIT_DEFAULT LIVEKIT_PB_DATA_STREAM_TRAILER_INIT_DEFAULT
 #define LIVEKIT_WEBHOOK_CONFIG_INIT_DEFAULT LIVEKIT_PB_WEBHOOK_CONFIG_INIT_DEFAULT
@@ -1834,6 +1871,7 @@ extern const pb_msgdesc_t livekit_pb_webhook_config_t_msg;
 #define LIVEKIT_DATA_STREAM_TEXT_HEADER_INIT_ZERO LIVEKIT_PB_DATA_STREAM_TEXT_HEADER_INIT_ZERO
 #define LIVEKIT_DATA_STREAM_BYTE_HEADER_INIT_ZERO LIVEKIT_PB_DATA_STREAM_BYTE_HEADER_INIT_ZERO
 #define LIVEKIT_DATA_STREAM_HEADER_INIT_ZERO LIVEKIT_PB_DATA_STREAM_HEADER_INIT_ZERO
+#define LIVEKIT_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_ZERO LIVEKIT_PB_DATA_STREAM_HEADER_ATTRIBUTES_ENTRY_INIT_ZERO
 #define LIVEKIT_DATA_STREAM_CHUNK_INIT_ZERO LIVEKIT_PB_DATA_STREAM_CHUNK_INIT_ZERO
 #define LIVEKIT_DATA_STREAM_TRAILER_INIT_ZERO LIVEKIT_PB_DATA_STREAM_TRAILER_INIT_ZERO
 #define LIVEKIT_WEBHOOK_CONFIG_INIT_ZERO LIVEKIT_PB_WEBHOOK_CONFIG_INIT_ZERO
@@ -68,7 +68,7 @@ typedef struct livekit_pb_trickle_request {
 } livekit_pb_trickle_request_t;
 
 typedef struct livekit_pb_mute_track_request {
-    pb_callback_t sid;
+    char *sid;
     bool muted;
 } livekit_pb_mute_track_request_t;
 
@@ -83,7 +83,9 @@ typedef struct livekit_pb_reconnect_response {
 } livekit_pb_reconnect_response_t;
 
 typedef struct livekit_pb_track_published_response {
-    char dummy_field;
+    char cid[16];
+    bool has_track;
+    livekit_pb_track_info_t track;
 } livekit_pb_track_published_response_t;
 
 typedef struct livekit_pb_track_unpublished_response {
@@ -182,7 +184,8 @@ typedef struct livekit_pb_join_response {
 } livekit_pb_join_response_t;
 
 typedef struct livekit_pb_speakers_changed {
-    pb_callback_t speakers;
+    pb_size_t speakers_count;
+    struct livekit_pb_speaker_info *speakers;
 } livekit_pb_speakers_changed_t;
 
 typedef struct livekit_pb_room_update {
@@ -216,13 +219,13 @@ typedef struct livekit_pb_subscribed_quality {
 } livekit_pb_subscribed_quality_t;
 
 typedef struct livekit_pb_subscribed_codec {
-    pb_callback_t codec;
-    pb_callback_t qualities;
+    pb_size_t qualities_count;
+    livekit_pb_subscribed_quality_t qualities[3];
 } livekit_pb_subscribed_codec_t;
 
 typedef struct livekit_pb_subscribed_quality_update {
-    pb_callback_t track_sid;
-    pb_callback_t subscribed_codecs;
+    pb_size_t subscribed_codecs_count;
+    livekit_pb_subscribed_codec_t subscribed_codecs[2];
 } livekit_pb_subscribed_quality_update_t;
 
 typedef struct livekit_pb_track_permission {
@@ -367,10 +370,16 @@ typedef struct livekit_pb_signal_response {
         livekit_pb_trickle_request_t trickle;
         /* sent when participants in the room has changed */
         livekit_pb_participant_update_t update;
+        /* sent to the participant when their track has been published */
+        livekit_pb_track_published_response_t track_published;
         /* Immediately terminate session */
         livekit_pb_leave_request_t leave;
+        /* indicates changes to speaker status, including when they've gone to not speaking */
+        livekit_pb_speakers_changed_t speakers_changed;
         /* sent when metadata of the room has changed */
         livekit_pb_room_update_t room_update;
+        /* when max subscribe quality changed, used by dynamic broadcasting to disable unused layers */
+        livekit_pb_subscribed_quality_update_t subscribed_quality_update;
         /* respond to ping */
         int64_t pong; /* deprecated by pong_resp (message Pong) */
         /* respond to Ping */
@@ -495,10 +504,10 @@ extern "C" {
 #define LIVEKIT_PB_SIMULCAST_CODEC_INIT_DEFAULT  {{{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_ADD_TRACK_REQUEST_INIT_DEFAULT {"", "", _LIVEKIT_PB_TRACK_TYPE_MIN, 0, _LIVEKIT_PB_TRACK_SOURCE_MIN, 0, {LIVEKIT_PB_VIDEO_LAYER_INIT_DEFAULT}, 0, {_LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN}}
 #define LIVEKIT_PB_TRICKLE_REQUEST_INIT_DEFAULT  {NULL, _LIVEKIT_PB_SIGNAL_TARGET_MIN, 0}
-#define LIVEKIT_PB_MUTE_TRACK_REQUEST_INIT_DEFAULT {{{NULL}, NULL}, 0}
+#define LIVEKIT_PB_MUTE_TRACK_REQUEST_INIT_DEFAULT {NULL, 0}
 #define LIVEKIT_PB_JOIN_RESPONSE_INIT_DEFAULT    {false, LIVEKIT_PB_ROOM_INIT_DEFAULT, LIVEKIT_PB_PARTICIPANT_INFO_INIT_DEFAULT, 0, NULL, 0, {LIVEKIT_PB_ICE_SERVER_INIT_DEFAULT, LIVEKIT_PB_ICE_SERVER_INIT_DEFAULT, LIVEKIT_PB_ICE_SERVER_INIT_DEFAULT, LIVEKIT_PB_ICE_SERVER_INIT_DEFAULT}, 0, false, LIVEKIT_PB_CLIENT_CONFIGURATION_INIT_DEFAULT, 0, 0}
 #define LIVEKIT_PB_RECONNECT_RESPONSE_INIT_DEFAULT {{{NULL}, NULL}, false, LIVEKIT_PB_CLIENT_CONFIGURATION_INIT_DEFAULT, false, LIVEKIT_PB_SERVER_INFO_INIT_DEFAULT, 0}
-#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_INIT_DEFAULT {0}
+#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_INIT_DEFAULT {"", false, LIVEKIT_PB_TRACK_INFO_INIT_DEFAULT}
 #define LIVEKIT_PB_TRACK_UNPUBLISHED_RESPONSE_INIT_DEFAULT {{{NULL}, NULL}}
 #define LIVEKIT_PB_SESSION_DESCRIPTION_INIT_DEFAULT {"", NULL, 0}
 #define LIVEKIT_PB_PARTICIPANT_UPDATE_INIT_DEFAULT {0, NULL}
@@ -510,15 +519,15 @@ extern "C" {
 #define LIVEKIT_PB_UPDATE_PARTICIPANT_METADATA_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}, 0}
 #define LIVEKIT_PB_UPDATE_PARTICIPANT_METADATA_ATTRIBUTES_ENTRY_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_ICE_SERVER_INIT_DEFAULT       {0, NULL, NULL, NULL}
-#define LIVEKIT_PB_SPEAKERS_CHANGED_INIT_DEFAULT {{{NULL}, NULL}}
+#define LIVEKIT_PB_SPEAKERS_CHANGED_INIT_DEFAULT {0, NULL}
 #define LIVEKIT_PB_ROOM_UPDATE_INIT_DEFAULT      {false, LIVEKIT_PB_ROOM_INIT_DEFAULT}
 #define LIVEKIT_PB_CONNECTION_QUALITY_INFO_INIT_DEFAULT {{{NULL}, NULL}, _LIVEKIT_PB_CONNECTION_QUALITY_MIN, 0}
 #define LIVEKIT_PB_CONNECTION_QUALITY_UPDATE_INIT_DEFAULT {{{NULL}, NULL}}
 #define LIVEKIT_PB_STREAM_STATE_INFO_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}, _LIVEKIT_PB_STREAM_STATE_MIN}
 #define LIVEKIT_PB_STREAM_STATE_UPDATE_INIT_DEFAULT {{{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_DEFAULT {_LIVEKIT_PB_VIDEO_QUALITY_MIN, 0}
-#define LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}}
-#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}}
+#define LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_DEFAULT {0, {LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_DEFAULT, LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_DEFAULT, LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_DEFAULT}}
+#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_INIT_DEFAULT {0, {LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_DEFAULT, LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_DEFAULT}}
 #define LIVEKIT_PB_TRACK_PERMISSION_INIT_DEFAULT {{{NULL}, NULL}, 0, {{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIPTION_PERMISSION_INIT_DEFAULT {0, {{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIPTION_PERMISSION_UPDATE_INIT_DEFAULT {{{NULL}, NULL}, {{NULL}, NULL}, 0}
@@ -539,10 +548,10 @@ extern "C" {
 #define LIVEKIT_PB_SIMULCAST_CODEC_INIT_ZERO     {{{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_ADD_TRACK_REQUEST_INIT_ZERO   {"", "", _LIVEKIT_PB_TRACK_TYPE_MIN, 0, _LIVEKIT_PB_TRACK_SOURCE_MIN, 0, {LIVEKIT_PB_VIDEO_LAYER_INIT_ZERO}, 0, {_LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN, _LIVEKIT_PB_AUDIO_TRACK_FEATURE_MIN}}
 #define LIVEKIT_PB_TRICKLE_REQUEST_INIT_ZERO     {NULL, _LIVEKIT_PB_SIGNAL_TARGET_MIN, 0}
-#define LIVEKIT_PB_MUTE_TRACK_REQUEST_INIT_ZERO  {{{NULL}, NULL}, 0}
+#define LIVEKIT_PB_MUTE_TRACK_REQUEST_INIT_ZERO  {NULL, 0}
 #define LIVEKIT_PB_JOIN_RESPONSE_INIT_ZERO       {false, LIVEKIT_PB_ROOM_INIT_ZERO, LIVEKIT_PB_PARTICIPANT_INFO_INIT_ZERO, 0, NULL, 0, {LIVEKIT_PB_ICE_SERVER_INIT_ZERO, LIVEKIT_PB_ICE_SERVER_INIT_ZERO, LIVEKIT_PB_ICE_SERVER_INIT_ZERO, LIVEKIT_PB_ICE_SERVER_INIT_ZERO}, 0, false, LIVEKIT_PB_CLIENT_CONFIGURATION_INIT_ZERO, 0, 0}
 #define LIVEKIT_PB_RECONNECT_RESPONSE_INIT_ZERO  {{{NULL}, NULL}, false, LIVEKIT_PB_CLIENT_CONFIGURATION_INIT_ZERO, false, LIVEKIT_PB_SERVER_INFO_INIT_ZERO, 0}
-#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_INIT_ZERO {0}
+#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_INIT_ZERO {"", false, LIVEKIT_PB_TRACK_INFO_INIT_ZERO}
 #define LIVEKIT_PB_TRACK_UNPUBLISHED_RESPONSE_INIT_ZERO {{{NULL}, NULL}}
 #define LIVEKIT_PB_SESSION_DESCRIPTION_INIT_ZERO {"", NULL, 0}
 #define LIVEKIT_PB_PARTICIPANT_UPDATE_INIT_ZERO  {0, NULL}
@@ -554,15 +563,15 @@ extern "C" {
 #define LIVEKIT_PB_UPDATE_PARTICIPANT_METADATA_INIT_ZERO {{{NULL}, NULL}, {{NULL}, NULL}, {{NULL}, NULL}, 0}
 #define LIVEKIT_PB_UPDATE_PARTICIPANT_METADATA_ATTRIBUTES_ENTRY_INIT_ZERO {{{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_ICE_SERVER_INIT_ZERO          {0, NULL, NULL, NULL}
-#define LIVEKIT_PB_SPEAKERS_CHANGED_INIT_ZERO    {{{NULL}, NULL}}
+#define LIVEKIT_PB_SPEAKERS_CHANGED_INIT_ZERO    {0, NULL}
 #define LIVEKIT_PB_ROOM_UPDATE_INIT_ZERO         {false, LIVEKIT_PB_ROOM_INIT_ZERO}
 #define LIVEKIT_PB_CONNECTION_QUALITY_INFO_INIT_ZERO {{{NULL}, NULL}, _LIVEKIT_PB_CONNECTION_QUALITY_MIN, 0}
 #define LIVEKIT_PB_CONNECTION_QUALITY_UPDATE_INIT_ZERO {{{NULL}, NULL}}
 #define LIVEKIT_PB_STREAM_STATE_INFO_INIT_ZERO   {{{NULL}, NULL}, {{NULL}, NULL}, _LIVEKIT_PB_STREAM_STATE_MIN}
 #define LIVEKIT_PB_STREAM_STATE_UPDATE_INIT_ZERO {{{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_ZERO  {_LIVEKIT_PB_VIDEO_QUALITY_MIN, 0}
-#define LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_ZERO    {{{NULL}, NULL}, {{NULL}, NULL}}
-#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_INIT_ZERO {{{NULL}, NULL}, {{NULL}, NULL}}
+#define LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_ZERO    {0, {LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_ZERO, LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_ZERO, LIVEKIT_PB_SUBSCRIBED_QUALITY_INIT_ZERO}}
+#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_INIT_ZERO {0, {LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_ZERO, LIVEKIT_PB_SUBSCRIBED_CODEC_INIT_ZERO}}
 #define LIVEKIT_PB_TRACK_PERMISSION_INIT_ZERO    {{{NULL}, NULL}, 0, {{NULL}, NULL}, {{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIPTION_PERMISSION_INIT_ZERO {0, {{NULL}, NULL}}
 #define LIVEKIT_PB_SUBSCRIPTION_PERMISSION_UPDATE_INIT_ZERO {{{NULL}, NULL}, {{NULL}, NULL}, 0}
@@ -597,6 +606,8 @@ extern "C" {
 #define LIVEKIT_PB_RECONNECT_RESPONSE_ICE_SERVERS_TAG 1
 #define LIVEKIT_PB_RECONNECT_RESPONSE_CLIENT_CONFIGURATION_TAG 2
 #define LIVEKIT_PB_RECONNECT_RESPONSE_SERVER_INFO_TAG 3
+#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_CID_TAG 1
+#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_TRACK_TAG 2
 #define LIVEKIT_PB_RECONNECT_RESPONSE_LAST_MESSAGE_SEQ_TAG 4
 #define LIVEKIT_PB_TRACK_UNPUBLISHED_RESPONSE_TRACK_SID_TAG 1
 #define LIVEKIT_PB_SESSION_DESCRIPTION_TYPE_TAG  1
@@ -648,9 +659,7 @@ extern "C" {
 #define LIVEKIT_PB_STREAM_STATE_UPDATE_STREAM_STATES_TAG 1
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_QUALITY_TAG 1
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_ENABLED_TAG 2
-#define LIVEKIT_PB_SUBSCRIBED_CODEC_CODEC_TAG    1
 #define LIVEKIT_PB_SUBSCRIBED_CODEC_QUALITIES_TAG 2
-#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_TRACK_SID_TAG 1
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_SUBSCRIBED_CODECS_TAG 3
 #define LIVEKIT_PB_TRACK_PERMISSION_PARTICIPANT_SID_TAG 1
 #define LIVEKIT_PB_TRACK_PERMISSION_ALL_TRACKS_TAG 2
@@ -711,8 +720,11 @@ extern "C" {
 #define LIVEKIT_PB_SIGNAL_RESPONSE_OFFER_TAG     3
 #define LIVEKIT_PB_SIGNAL_RESPONSE_TRICKLE_TAG   4
 #define LIVEKIT_PB_SIGNAL_RESPONSE_UPDATE_TAG    5
+#define LIVEKIT_PB_SIGNAL_RESPONSE_TRACK_PUBLISHED_TAG 6
 #define LIVEKIT_PB_SIGNAL_RESPONSE_LEAVE_TAG     8
+#define LIVEKIT_PB_SIGNAL_RESPONSE_SPEAKERS_CHANGED_TAG 10
 #define LIVEKIT_PB_SIGNAL_RESPONSE_ROOM_UPDATE_TAG 11
+#define LIVEKIT_PB_SIGNAL_RESPONSE_SUBSCRIBED_QUALITY_UPDATE_TAG 14
 #define LIVEKIT_PB_SIGNAL_RESPONSE_PONG_TAG      18
 #define LIVEKIT_PB_SIGNAL_RESPONSE_PONG_RESP_TAG 20
 #define LIVEKIT_PB_REGION_SETTINGS_REGIONS_TAG   1
@@ -767,8 +779,11 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (message,answer,message.answer),   2) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,offer,message.offer),   3) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,trickle,message.trickle),   4) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,update,message.update),   5) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,track_published,message.track_published),   6) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,leave,message.leave),   8) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,speakers_changed,message.speakers_changed),  10) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,room_update,message.room_update),  11) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (message,subscribed_quality_update,message.subscribed_quality_update),  14) \
 X(a, STATIC,   ONEOF,    INT64,    (message,pong,message.pong),  18) \
 X(a, STATIC,   ONEOF,    MESSAGE,  (message,pong_resp,message.pong_resp),  20)
 #define LIVEKIT_PB_SIGNAL_RESPONSE_CALLBACK NULL
@@ -778,8 +793,12 @@ X(a, STATIC,   ONEOF,    MESSAGE,  (message,pong_resp,message.pong_resp),  20)
 #define livekit_pb_signal_response_t_message_offer_MSGTYPE livekit_pb_session_description_t
 #define livekit_pb_signal_response_t_message_trickle_MSGTYPE livekit_pb_trickle_request_t
 #define livekit_pb_signal_response_t_message_update_MSGTYPE livekit_pb_participant_update_t
+#define livekit_pb_signal_response_t_message_track_published_MSGTYPE livekit_pb_track_published_response_t
 #define livekit_pb_signal_response_t_message_leave_MSGTYPE livekit_pb_leave_request_t
+#define livekit_pb_signal_response_t_message_speakers_changed_MSGTYPE livekit_pb_speakers_changed_t
 #define livekit_pb_signal_response_t_message_room_update_MSGTYPE livekit_pb_room_update_t
+#define livekit_pb_signal_response_t_message_subscribed_quality_update_MSGTYPE livekit_pb_subscribed_quality_update_t
+#define livekit_pb_signal_response_t_message_reconnect_MSGTYPE livekit_pb_reconnect_response_t
 #define livekit_pb_signal_response_t_message_pong_resp_MSGTYPE livekit_pb_pong_t
 
 #define LIVEKIT_PB_SIMULCAST_CODEC_FIELDLIST(X, a) \
@@ -808,9 +827,9 @@ X(a, STATIC,   SINGULAR, BOOL,     final,             3)
 #define LIVEKIT_PB_TRICKLE_REQUEST_DEFAULT NULL
 
 #define LIVEKIT_PB_MUTE_TRACK_REQUEST_FIELDLIST(X, a) \
-X(a, CALLBACK, SINGULAR, STRING,   sid,               1) \
+X(a, POINTER,  SINGULAR, STRING,   sid,               1) \
 X(a, STATIC,   SINGULAR, BOOL,     muted,             2)
-#define LIVEKIT_PB_MUTE_TRACK_REQUEST_CALLBACK pb_default_field_callback
+#define LIVEKIT_PB_MUTE_TRACK_REQUEST_CALLBACK NULL
 #define LIVEKIT_PB_MUTE_TRACK_REQUEST_DEFAULT NULL
 
 #define LIVEKIT_PB_JOIN_RESPONSE_FIELDLIST(X, a) \
@@ -842,9 +861,11 @@ X(a, STATIC,   SINGULAR, UINT32,   last_message_seq,   4)
 #define livekit_pb_reconnect_response_t_server_info_MSGTYPE livekit_pb_server_info_t
 
 #define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_FIELDLIST(X, a) \
-
+X(a, STATIC,   SINGULAR, STRING,   cid,               1) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  track,             2)
 #define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_CALLBACK NULL
 #define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_DEFAULT NULL
+#define livekit_pb_track_published_response_t_track_MSGTYPE livekit_pb_track_info_t
 
 #define LIVEKIT_PB_TRACK_UNPUBLISHED_RESPONSE_FIELDLIST(X, a) \
 X(a, CALLBACK, SINGULAR, STRING,   track_sid,         1)
@@ -923,8 +944,8 @@ X(a, POINTER,  SINGULAR, STRING,   credential,        3)
 #define LIVEKIT_PB_ICE_SERVER_DEFAULT NULL
 
 #define LIVEKIT_PB_SPEAKERS_CHANGED_FIELDLIST(X, a) \
-X(a, CALLBACK, REPEATED, MESSAGE,  speakers,          1)
-#define LIVEKIT_PB_SPEAKERS_CHANGED_CALLBACK pb_default_field_callback
+X(a, POINTER,  REPEATED, MESSAGE,  speakers,          1)
+#define LIVEKIT_PB_SPEAKERS_CHANGED_CALLBACK NULL
 #define LIVEKIT_PB_SPEAKERS_CHANGED_DEFAULT NULL
 #define livekit_pb_speakers_changed_t_speakers_MSGTYPE livekit_pb_speaker_info_t
 
@@ -967,16 +988,14 @@ X(a, STATIC,   SINGULAR, BOOL,     enabled,           2)
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_DEFAULT NULL
 
 #define LIVEKIT_PB_SUBSCRIBED_CODEC_FIELDLIST(X, a) \
-X(a, CALLBACK, SINGULAR, STRING,   codec,             1) \
-X(a, CALLBACK, REPEATED, MESSAGE,  qualities,         2)
-#define LIVEKIT_PB_SUBSCRIBED_CODEC_CALLBACK pb_default_field_callback
+X(a, STATIC,   REPEATED, MESSAGE,  qualities,         2)
+#define LIVEKIT_PB_SUBSCRIBED_CODEC_CALLBACK NULL
 #define LIVEKIT_PB_SUBSCRIBED_CODEC_DEFAULT NULL
 #define livekit_pb_subscribed_codec_t_qualities_MSGTYPE livekit_pb_subscribed_quality_t
 
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_FIELDLIST(X, a) \
-X(a, CALLBACK, SINGULAR, STRING,   track_sid,         1) \
-X(a, CALLBACK, REPEATED, MESSAGE,  subscribed_codecs,   3)
-#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_CALLBACK pb_default_field_callback
+X(a, STATIC,   REPEATED, MESSAGE,  subscribed_codecs,   3)
+#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_CALLBACK NULL
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_DEFAULT NULL
 #define livekit_pb_subscribed_quality_update_t_subscribed_codecs_MSGTYPE livekit_pb_subscribed_codec_t
 
@@ -1198,6 +1217,7 @@ extern const pb_msgdesc_t livekit_pb_track_subscribed_t_msg;
 /* livekit_pb_MuteTrackRequest_size depends on runtime parameters */
 /* livekit_pb_JoinResponse_size depends on runtime parameters */
 /* livekit_pb_ReconnectResponse_size depends on runtime parameters */
+/* livekit_pb_TrackPublishedResponse_size depends on runtime parameters */
 /* livekit_pb_TrackUnpublishedResponse_size depends on runtime parameters */
 /* livekit_pb_SessionDescription_size depends on runtime parameters */
 /* livekit_pb_ParticipantUpdate_size depends on runtime parameters */
@@ -1213,8 +1233,6 @@ extern const pb_msgdesc_t livekit_pb_track_subscribed_t_msg;
 /* livekit_pb_ConnectionQualityUpdate_size depends on runtime parameters */
 /* livekit_pb_StreamStateInfo_size depends on runtime parameters */
 /* livekit_pb_StreamStateUpdate_size depends on runtime parameters */
-/* livekit_pb_SubscribedCodec_size depends on runtime parameters */
-/* livekit_pb_SubscribedQualityUpdate_size depends on runtime parameters */
 /* livekit_pb_TrackPermission_size depends on runtime parameters */
 /* livekit_pb_SubscriptionPermission_size depends on runtime parameters */
 /* livekit_pb_SubscriptionPermissionUpdate_size depends on runtime parameters */
@@ -1228,12 +1246,14 @@ extern const pb_msgdesc_t livekit_pb_track_subscribed_t_msg;
 /* livekit_pb_RequestResponse_size depends on runtime parameters */
 #define LIVEKIT_LIVEKIT_RTC_PB_H_MAX_SIZE        LIVEKIT_PB_ADD_TRACK_REQUEST_SIZE
 #define LIVEKIT_PB_ADD_TRACK_REQUEST_SIZE        81
+#define LIVEKIT_PB_DATA_CHANNEL_INFO_SIZE        25
 #define LIVEKIT_PB_LEAVE_REQUEST_SIZE            4
 #define LIVEKIT_PB_PING_SIZE                     22
 #define LIVEKIT_PB_PONG_SIZE                     22
 #define LIVEKIT_PB_SIMULATE_SCENARIO_SIZE        11
+#define LIVEKIT_PB_SUBSCRIBED_CODEC_SIZE         18
 #define LIVEKIT_PB_SUBSCRIBED_QUALITY_SIZE       4
-#define LIVEKIT_PB_TRACK_PUBLISHED_RESPONSE_SIZE 0
+#define LIVEKIT_PB_SUBSCRIBED_QUALITY_UPDATE_SIZE 40
 #define LIVEKIT_PB_TRACK_SUBSCRIBED_SIZE         0
 #if defined(livekit_pb_Room_size)
 #define LIVEKIT_PB_ROOM_UPDATE_SIZE              (6 + livekit_pb_Room_size)